@@ -112,6 +112,8 @@ int main(int argc, char** argv)
   bool integrity_check_failed_ = false;
   bool RawDataAndFeatures_loaded_ = false;
   bool run_remote_workflow_ = true;
+  uint64_t feature_line_plot_generation_ = 0; // generation of the feature matrix shown by the line plot
+  std::tuple<uint64_t, uint64_t, uint64_t, uint64_t> statistics_generations_; // generations of the data shown by the statistics
   ApplicationHandler application_handler_;
   SessionHandler session_handler_;
   WorkflowManager workflow_manager_;
@@ -786,21 +788,21 @@ int main(int argc, char** argv)
     if (sequence_main_window_->visible_)
     {
       sequence_main_window_->checked_rows_ = session_handler_.getSequenceTableFilters();
-      sequence_main_window_->table_data_ = session_handler_.sequence_table;
+      sequence_main_window_->setTableData(session_handler_.sequence_table);
     }
 
     // Transitions
     if (transitions_main_window_->visible_)
     {
       transitions_main_window_->checked_rows_ = session_handler_.getTransitionsTableFilters();
-      transitions_main_window_->table_data_ = session_handler_.transitions_table;
+      transitions_main_window_->setTableData(session_handler_.transitions_table);
     }
 
     // spectrum
     if (spectrum_main_window_->visible_)
     {
       spectrum_main_window_->checked_rows_ = session_handler_.getSpectrumTableFilters();
-      spectrum_main_window_->table_data_ = session_handler_.spectrum_table;
+      spectrum_main_window_->setTableData(session_handler_.spectrum_table);
     }
 
     // feature table
@@ -815,7 +817,7 @@ int main(int argc, char** argv)
     if (feature_matrix_main_window_->visible_)
     {
         session_handler_.setFeatureMatrix(application_handler_.sequenceHandler_);
-        feature_matrix_main_window_->table_data_ = session_handler_.feature_pivot_table;
+        feature_matrix_main_window_->setTableData(session_handler_.feature_pivot_table);
         feature_matrix_main_window_->checked_rows_ = Eigen::Tensor<bool, 1>();
     }
 
@@ -823,18 +825,31 @@ int main(int argc, char** argv)
     if (feature_line_plot_->visible_)
     {
       session_handler_.setFeatureMatrix(application_handler_.sequenceHandler_);
-      Eigen::Tensor<float, 2> x_data = session_handler_.feat_sample_data.shuffle(Eigen::array<Eigen::Index, 2>({ 1,0 }));
-      Eigen::Tensor<float, 2> y_data = session_handler_.feat_value_data.shuffle(Eigen::array<Eigen::Index, 2>({ 1,0 }));
-      feature_line_plot_->setValues(x_data, y_data, &session_handler_.feat_col_labels, &session_handler_.feat_row_labels, session_handler_.feat_line_x_axis_title, session_handler_.feat_line_y_axis_title,
-        session_handler_.feat_line_sample_min, session_handler_.feat_line_sample_max, session_handler_.feat_value_min, session_handler_.feat_value_max,
-        "FeaturesLineMainWindow");
+      if (feature_line_plot_generation_ != session_handler_.feature_pivot_table.generation_)
+      {
+        Eigen::Tensor<float, 2> x_data = session_handler_.feat_sample_data.shuffle(Eigen::array<Eigen::Index, 2>({ 1,0 }));
+        Eigen::Tensor<float, 2> y_data = session_handler_.feat_value_data.shuffle(Eigen::array<Eigen::Index, 2>({ 1,0 }));
+        feature_line_plot_->setValues(x_data, y_data, &session_handler_.feat_col_labels, &session_handler_.feat_row_labels, session_handler_.feat_line_x_axis_title, session_handler_.feat_line_y_axis_title,
+          session_handler_.feat_line_sample_min, session_handler_.feat_line_sample_max, session_handler_.feat_value_min, session_handler_.feat_value_max,
+          "FeaturesLineMainWindow");
+        feature_line_plot_generation_ = session_handler_.feature_pivot_table.generation_;
+      }
     }
 
     //statistics
     if (statistics_->visible_)
     {
-      statistics_->setInjections(session_handler_.injection_explorer_data.checkbox_body, session_handler_.getInjectionExplorerBody());
-      statistics_->setTransitions(&session_handler_.transitions_table.body_, session_handler_.transition_explorer_data.checkbox_body, session_handler_.getTransitionExplorerBody());
+      session_handler_.updateExplorerGeneration(session_handler_.injection_explorer_data);
+      session_handler_.updateExplorerGeneration(session_handler_.transition_explorer_data);
+      const auto statistics_generations = std::make_tuple(
+        session_handler_.sequence_table.generation_, session_handler_.injection_explorer_data.generation_,
+        session_handler_.transitions_table.generation_, session_handler_.transition_explorer_data.generation_);
+      if (statistics_generations_ != statistics_generations)
+      {
+        statistics_->setInjections(session_handler_.injection_explorer_data.checkbox_body, session_handler_.getInjectionExplorerBody());
+        statistics_->setTransitions(&session_handler_.transitions_table.body_, session_handler_.transition_explorer_data.checkbox_body, session_handler_.getTransitionExplorerBody());
+        statistics_generations_ = statistics_generations;
+      }
     }
 
     // info
@@ -846,8 +861,14 @@ int main(int argc, char** argv)
     // injections 
     if (injections_explorer_window_->visible_)
     {
-      injections_explorer_window_->table_data_.headers_ = session_handler_.getInjectionExplorerHeader();
-      injections_explorer_window_->table_data_.body_ = session_handler_.getInjectionExplorerBody();
+      if (injections_explorer_window_->getTableGeneration() != session_handler_.sequence_table.generation_)
+      {
+        SessionHandler::GenericTableData explorer_table;
+        explorer_table.headers_ = session_handler_.getInjectionExplorerHeader();
+        explorer_table.body_ = session_handler_.getInjectionExplorerBody();
+        explorer_table.generation_ = session_handler_.sequence_table.generation_;
+        injections_explorer_window_->setTableData(std::move(explorer_table));
+      }
       injections_explorer_window_->checked_rows_ = session_handler_.injection_explorer_data.checked_rows;
       injections_explorer_window_->checkbox_headers_ = session_handler_.injection_explorer_data.checkbox_headers;
       injections_explorer_window_->checkbox_columns_ = &session_handler_.injection_explorer_data.checkbox_body;
@@ -856,8 +877,14 @@ int main(int argc, char** argv)
     // transitions
     if (transitions_explorer_window_->visible_)
     {
-      transitions_explorer_window_->table_data_.headers_ = session_handler_.getTransitionExplorerHeader();
-      transitions_explorer_window_->table_data_.body_ = session_handler_.getTransitionExplorerBody();
+      if (transitions_explorer_window_->getTableGeneration() != session_handler_.transitions_table.generation_)
+      {
+        SessionHandler::GenericTableData explorer_table;
+        explorer_table.headers_ = session_handler_.getTransitionExplorerHeader();
+        explorer_table.body_ = session_handler_.getTransitionExplorerBody();
+        explorer_table.generation_ = session_handler_.transitions_table.generation_;
+        transitions_explorer_window_->setTableData(std::move(explorer_table));
+      }
       transitions_explorer_window_->checked_rows_ = session_handler_.transition_explorer_data.checked_rows;
       transitions_explorer_window_->checkbox_headers_ = session_handler_.transition_explorer_data.checkbox_headers;
       transitions_explorer_window_->checkbox_columns_ = &session_handler_.transition_explorer_data.checkbox_body;
@@ -867,7 +894,7 @@ int main(int argc, char** argv)
     if (features_explorer_window_->visible_)
     {
       session_handler_.setFeatureExplorer();
-      features_explorer_window_->table_data_ = session_handler_.feature_table;
+      features_explorer_window_->setTableData(session_handler_.feature_table);
       features_explorer_window_->checked_rows_ = session_handler_.feature_explorer_data.checked_rows;
       features_explorer_window_->checkbox_headers_ = session_handler_.feature_explorer_data.checkbox_headers;
       features_explorer_window_->checkbox_columns_ = &session_handler_.feature_explorer_data.checkbox_body;
@@ -26,6 +26,15 @@
 #include <SmartPeak/core/Utilities.h>
 
 #include "workflow_grpc.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/ext/proto_server_reflection_plugin.h>
 #include <grpcpp/health_check_service_interface.h>
@@ -45,10 +54,20 @@ public:
     const std::string& username,
     const std::string& password);
   
-  void getLogstream();
+  /**
+    @brief Prints the server logs.
+
+    @param[in] follow Keep reading the logs as they are produced until the running workflow ends
+  */
+  void getLogstream(bool follow = false);
   
   std::string getProgressInfo();
 
+  /**
+    @brief Calls `on_progress` with the status of the workflows as it changes, until the running workflows end.
+  */
+  void followProgressInfo(const std::function<void(const std::string&)>& on_progress);
+
   void getEvent(
     SmartPeak::IApplicationProcessorObserver* application_observer,
     SmartPeak::ISampleGroupProcessorObserver* sample_group_observer,
@@ -56,10 +75,32 @@ public:
     SmartPeak::ISequenceSegmentProcessorObserver* sequence_segment_processor_observer,
     SmartPeak::ISequenceObserver* sequence_observer,
     SmartPeak::ITransitionsObserver* transition_observer);
+
+  /**
+    @brief Notifies the observers of the workflow events as they are produced, until the running workflows end.
+  */
+  void followEvents(
+    SmartPeak::IApplicationProcessorObserver* application_observer,
+    SmartPeak::ISampleGroupProcessorObserver* sample_group_observer,
+    SmartPeak::ISequenceProcessorObserver* sequence_processor_observer,
+    SmartPeak::ISequenceSegmentProcessorObserver* sequence_segment_processor_observer,
+    SmartPeak::ISequenceObserver* sequence_observer,
+    SmartPeak::ITransitionsObserver* transition_observer);
   
   void stopRunningWorkflow();
 
 private:
+  static void printLogStream(const SmartPeakServer::LogStream& log_stream);
+
+  static void dispatchEvent(
+    const SmartPeakServer::WorkflowEvent& workflow_event,
+    SmartPeak::IApplicationProcessorObserver* application_observer,
+    SmartPeak::ISampleGroupProcessorObserver* sample_group_observer,
+    SmartPeak::ISequenceProcessorObserver* sequence_processor_observer,
+    SmartPeak::ISequenceSegmentProcessorObserver* sequence_segment_processor_observer,
+    SmartPeak::ISequenceObserver* sequence_observer,
+    SmartPeak::ITransitionsObserver* transition_observer);
+
   std::unique_ptr<SmartPeakServer::Workflow::Stub> stub_;
   bool channel_set = false;
 };
@@ -67,13 +108,8 @@ private:
 // server-side
 class WorkflowService final : public SmartPeakServer::Workflow::Service
 {
-  enum class WorkflowStatus {
-    IDLE,
-    RUNNING
-  };
-  
 public:
-  explicit WorkflowService() : is_logger_init_(false)
+  explicit WorkflowService() : is_logger_init_(false), job_queue_(getMaxConcurrentWorkflows())
   {
     auto [logfilepath, logdir_created] = SmartPeak::Utilities::getLogFilepath("smartpeak_log");
     console_handler_ = &SmartPeak::ConsoleHandler::get_instance();
@@ -110,16 +146,49 @@ public:
     ::grpc::ServerContext* context,
     const ::SmartPeakServer::InquireLogs* request,
     ::grpc::ServerWriter<::SmartPeakServer::LogStream>* writer) override;
+
+  virtual ::grpc::Status followProgressInfo(
+    ::grpc::ServerContext* context,
+    const ::SmartPeakServer::WorkflowParameters* request,
+    ::grpc::ServerWriter<::SmartPeakServer::ProgressInfo>* writer) override;
+
+  virtual ::grpc::Status followWorkflowEvents(
+    ::grpc::ServerContext* context,
+    const ::SmartPeakServer::WorkflowParameters* request,
+    ::grpc::ServerWriter<::SmartPeakServer::WorkflowEvent>* writer) override;
+
+  virtual ::grpc::Status followLogStream(
+    ::grpc::ServerContext* context,
+    const ::SmartPeakServer::InquireLogs* request,
+    ::grpc::ServerWriter<::SmartPeakServer::LogStream>* writer) override;
   
 private:
+  /**
+    @brief writes the log records to the client, returns false if the client is gone
+  */
+  static bool writeLogStream(
+    const std::vector<SmartPeak::ServerAppender::ServerAppenderRecord>& logstream,
+    ::grpc::ServerWriter<::SmartPeakServer::LogStream>* writer);
+
+  static void setWorkflowEvent(
+    const SmartPeak::serv::SeverEventDispatcherObserver::Event& event,
+    ::SmartPeakServer::WorkflowEvent* response);
+
+  /**
+    @brief number of workflows run at the same time, from SMARTPEAK_SERVER_MAX_WORKFLOWS (default 2)
+  */
+  static size_t getMaxConcurrentWorkflows();
+
   bool is_logger_init_;
-  std::string session_id_ = "";
   SmartPeak::ConsoleHandler* console_handler_;
-  SmartPeak::serv::ServerManager server_manager_;
-  std::future<bool> handle_workflow_future_;
+  SmartPeak::WorkflowManager job_queue_; ///< runs the workflows of all the requests
+  std::mutex server_managers_mutex_;
+  std::list<std::shared_ptr<SmartPeak::serv::ServerManager>> server_managers_; ///< requests being processed
+  std::shared_ptr<SmartPeak::serv::ServerManager> latest_server_manager_; ///< the events and progress are reported for the latest request
   ::SmartPeakServer::ProgressInfo progress_info_;
-  WorkflowStatus workflow_status_ = WorkflowStatus::IDLE;
-  bool workflow_process_interrupted = false;
+  size_t progress_info_updates_ = 0; ///< number of updates of progress_info_, guarded by server_managers_mutex_
+  std::condition_variable progress_info_cv_;
+  std::atomic_int n_running_workflows_ { 0 };
 };
 
 void runSmartPeakServer(std::string server_address);
@@ -170,48 +239,55 @@ std::string WorkflowClient::runWorkflow(
   }
 }
 
-void WorkflowClient::getLogstream()
+void WorkflowClient::getLogstream(bool follow)
 {
   SmartPeakServer::InquireLogs inquire_logs;
   SmartPeakServer::LogStream log_stream;
   grpc::ClientContext context;
 
-  std::unique_ptr<grpc::ClientReader<SmartPeakServer::LogStream> > reader(
+  // the followed stream has its own position in the server logs, the others read the logs only once
+  std::unique_ptr<grpc::ClientReader<SmartPeakServer::LogStream> > reader(follow ?
+      stub_->followLogStream(&context, inquire_logs) :
       stub_->getLogStream(&context, inquire_logs)  );
   while (reader->Read(&log_stream))
   {
-    if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_NONE)
-    {
-      LOGN << "SERVER LOG : " << log_stream.log_line();
-    }
-    if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_FATAL)
-    {
-      LOGF << "SERVER LOG : " << log_stream.log_line();
-    }
-    if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_ERROR)
-    {
-      LOGE << "SERVER LOG : " << log_stream.log_line();
-    }
-    if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_WARNING)
-    {
-      LOGW << "SERVER LOG : " << log_stream.log_line();
-    }
-    if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_INFO)
-    {
-      LOGI << "SERVER LOG : " << log_stream.log_line();
-    }
-    if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_DEBUG)
-    {
-      LOGD << "SERVER LOG : " << log_stream.log_line();
-    }
-    if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_VERBOSE)
-    {
-      LOGV << "SERVER LOG : " << log_stream.log_line();
-    }
+    printLogStream(log_stream);
   }
   grpc::Status status = reader->Finish();
 }
 
+void WorkflowClient::printLogStream(const SmartPeakServer::LogStream& log_stream)
+{
+  if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_NONE)
+  {
+    LOGN << "SERVER LOG : " << log_stream.log_line();
+  }
+  if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_FATAL)
+  {
+    LOGF << "SERVER LOG : " << log_stream.log_line();
+  }
+  if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_ERROR)
+  {
+    LOGE << "SERVER LOG : " << log_stream.log_line();
+  }
+  if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_WARNING)
+  {
+    LOGW << "SERVER LOG : " << log_stream.log_line();
+  }
+  if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_INFO)
+  {
+    LOGI << "SERVER LOG : " << log_stream.log_line();
+  }
+  if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_DEBUG)
+  {
+    LOGD << "SERVER LOG : " << log_stream.log_line();
+  }
+  if (log_stream.log_severity() == ::SmartPeakServer::LogStream_LogSeverity_VERBOSE)
+  {
+    LOGV << "SERVER LOG : " << log_stream.log_line();
+  }
+}
+
 std::string WorkflowClient::getProgressInfo()
 {
   SmartPeakServer::WorkflowParameters workflow_parameters;
@@ -230,6 +306,21 @@ std::string WorkflowClient::getProgressInfo()
   }
 }
 
+void WorkflowClient::followProgressInfo(const std::function<void(const std::string&)>& on_progress)
+{
+  SmartPeakServer::WorkflowParameters workflow_parameters;
+  SmartPeakServer::ProgressInfo progress_info;
+  grpc::ClientContext context;
+
+  std::unique_ptr<grpc::ClientReader<SmartPeakServer::ProgressInfo> > reader(
+      stub_->followProgressInfo(&context, workflow_parameters)  );
+  while (reader->Read(&progress_info))
+  {
+    on_progress(progress_info.status_code());
+  }
+  grpc::Status status = reader->Finish();
+}
+
 void WorkflowClient::getEvent(
   SmartPeak::IApplicationProcessorObserver* application_observer,
   SmartPeak::ISampleGroupProcessorObserver* sample_group_observer,
@@ -246,103 +337,140 @@ void WorkflowClient::getEvent(
   grpc::Status status = stub_->getWorkflowEvent(&context, workflow_parameters, &workflow_event);
   if (status.ok())
   {
-    /**
-    IApplicationProcessorObserver
-    */
-    if (workflow_event.event_name() == "onApplicationProcessorStart")
-    {
-      std::vector<std::string> command_list;
-      for (const auto command : workflow_event.command_list())
-      {
-        command_list.push_back(command);
-      }
-      application_observer->onApplicationProcessorStart(command_list);
-    }
-    if (workflow_event.event_name() == "onApplicationProcessorCommandStart")
-    {
-      application_observer->onApplicationProcessorCommandStart(workflow_event.event_index(), workflow_event.item_name());
-    }
-    if (workflow_event.event_name() == "onApplicationProcessorCommandEnd")
-    {
-      application_observer->onApplicationProcessorCommandStart(workflow_event.event_index(), workflow_event.item_name());
-    }
-    if (workflow_event.event_name() == "onApplicationProcessorEnd")
-    {
-      application_observer->onApplicationProcessorEnd();
-    }
-    /**
-      ISampleGroupProcessorObserver
-    */
-    if (workflow_event.event_name() == "onSampleGroupProcessorStart")
-    {
-      sample_group_observer->onSampleGroupProcessorStart(workflow_event.event_index());
-    }
-    if (workflow_event.event_name() == "onSampleGroupProcessorSampleStart")
-    {
-      sample_group_observer->onSampleGroupProcessorSampleStart(workflow_event.item_name());
-    }
-    if (workflow_event.event_name() == "onSampleGroupProcessorSampleEnd")
-    {
-      sample_group_observer->onSampleGroupProcessorSampleEnd(workflow_event.item_name());
-    }
-    if (workflow_event.event_name() == "onSampleGroupProcessorEnd")
-    {
-      sample_group_observer->onSampleGroupProcessorEnd();
-    }
-    /**
-     ISequenceProcessorObserver
-    */
-    if (workflow_event.event_name() == "onSequenceProcessorStart")
-    {
-      sequence_processor_observer->onSequenceProcessorStart(workflow_event.event_index());
-    }
-    if (workflow_event.event_name() == "onSequenceProcessorSampleStart")
-    {
-      sequence_processor_observer->onSequenceProcessorSampleStart(workflow_event.item_name());
-    }
-    if (workflow_event.event_name() == "onSequenceProcessorEnd")
-    {
-      sequence_processor_observer->onSequenceProcessorEnd();
-    }
-    if (workflow_event.event_name() == "onSequenceProcessorSampleEnd")
-    {
-      sequence_processor_observer->onSequenceProcessorSampleEnd(workflow_event.item_name());
-    }
-    /**
-      ISequenceSegmentProcessorObserver
-    */
-    if (workflow_event.event_name() == "onSequenceSegmentProcessorStart")
-    {
-      sequence_segment_processor_observer->onSequenceSegmentProcessorStart(workflow_event.event_index());
-    }
-    if (workflow_event.event_name() == "onSequenceSegmentProcessorSampleStart")
-    {
-      sequence_segment_processor_observer->onSequenceSegmentProcessorSampleStart(workflow_event.item_name());
-    }
-    if (workflow_event.event_name() == "onSequenceSegmentProcessorEnd")
-    {
-      sequence_segment_processor_observer->onSequenceSegmentProcessorEnd();
-    }
-    if (workflow_event.event_name() == "onSequenceSegmentProcessorSampleEnd")
-    {
-      sequence_segment_processor_observer->onSequenceSegmentProcessorSampleEnd(workflow_event.item_name());
-    }
-    /**
-      ISequenceObserver
-    */
-    if (workflow_event.event_name() == "onSequenceUpdated")
-    {
-      sequence_observer->onSequenceUpdated();
-    }
-    /**
-      ITransitionsObserver
-    */
-    if (workflow_event.event_name() == "onTransitionsUpdated")
+    dispatchEvent(workflow_event,
+      application_observer, sample_group_observer, sequence_processor_observer,
+      sequence_segment_processor_observer, sequence_observer, transition_observer);
+  }
+}
+
+void WorkflowClient::followEvents(
+  SmartPeak::IApplicationProcessorObserver* application_observer,
+  SmartPeak::ISampleGroupProcessorObserver* sample_group_observer,
+  SmartPeak::ISequenceProcessorObserver* sequence_processor_observer,
+  SmartPeak::ISequenceSegmentProcessorObserver* sequence_segment_processor_observer,
+  SmartPeak::ISequenceObserver* sequence_observer,
+  SmartPeak::ITransitionsObserver* transition_observer)
+{
+  SmartPeakServer::WorkflowParameters workflow_parameters;
+  SmartPeakServer::WorkflowEvent workflow_event;
+  grpc::ClientContext context;
+
+  std::unique_ptr<grpc::ClientReader<SmartPeakServer::WorkflowEvent> > reader(
+      stub_->followWorkflowEvents(&context, workflow_parameters)  );
+  while (reader->Read(&workflow_event))
+  {
+    dispatchEvent(workflow_event,
+      application_observer, sample_group_observer, sequence_processor_observer,
+      sequence_segment_processor_observer, sequence_observer, transition_observer);
+  }
+  grpc::Status status = reader->Finish();
+}
+
+void WorkflowClient::dispatchEvent(
+  const SmartPeakServer::WorkflowEvent& workflow_event,
+  SmartPeak::IApplicationProcessorObserver* application_observer,
+  SmartPeak::ISampleGroupProcessorObserver* sample_group_observer,
+  SmartPeak::ISequenceProcessorObserver* sequence_processor_observer,
+  SmartPeak::ISequenceSegmentProcessorObserver* sequence_segment_processor_observer,
+  SmartPeak::ISequenceObserver* sequence_observer,
+  SmartPeak::ITransitionsObserver* transition_observer)
+{
+  /**
+  IApplicationProcessorObserver
+  */
+  if (workflow_event.event_name() == "onApplicationProcessorStart")
+  {
+    std::vector<std::string> command_list;
+    for (const auto command : workflow_event.command_list())
     {
-      transition_observer->onTransitionsUpdated();
+      command_list.push_back(command);
     }
+    application_observer->onApplicationProcessorStart(command_list);
+  }
+  if (workflow_event.event_name() == "onApplicationProcessorCommandStart")
+  {
+    application_observer->onApplicationProcessorCommandStart(workflow_event.event_index(), workflow_event.item_name());
+  }
+  if (workflow_event.event_name() == "onApplicationProcessorCommandEnd")
+  {
+    application_observer->onApplicationProcessorCommandStart(workflow_event.event_index(), workflow_event.item_name());
   }
- }
+  if (workflow_event.event_name() == "onApplicationProcessorEnd")
+  {
+    application_observer->onApplicationProcessorEnd();
+  }
+  /**
+    ISampleGroupProcessorObserver
+  */
+  if (workflow_event.event_name() == "onSampleGroupProcessorStart")
+  {
+    sample_group_observer->onSampleGroupProcessorStart(workflow_event.event_index());
+  }
+  if (workflow_event.event_name() == "onSampleGroupProcessorSampleStart")
+  {
+    sample_group_observer->onSampleGroupProcessorSampleStart(workflow_event.item_name());
+  }
+  if (workflow_event.event_name() == "onSampleGroupProcessorSampleEnd")
+  {
+    sample_group_observer->onSampleGroupProcessorSampleEnd(workflow_event.item_name());
+  }
+  if (workflow_event.event_name() == "onSampleGroupProcessorEnd")
+  {
+    sample_group_observer->onSampleGroupProcessorEnd();
+  }
+  /**
+   ISequenceProcessorObserver
+  */
+  if (workflow_event.event_name() == "onSequenceProcessorStart")
+  {
+    sequence_processor_observer->onSequenceProcessorStart(workflow_event.event_index());
+  }
+  if (workflow_event.event_name() == "onSequenceProcessorSampleStart")
+  {
+    sequence_processor_observer->onSequenceProcessorSampleStart(workflow_event.item_name());
+  }
+  if (workflow_event.event_name() == "onSequenceProcessorEnd")
+  {
+    sequence_processor_observer->onSequenceProcessorEnd();
+  }
+  if (workflow_event.event_name() == "onSequenceProcessorSampleEnd")
+  {
+    sequence_processor_observer->onSequenceProcessorSampleEnd(workflow_event.item_name());
+  }
+  /**
+    ISequenceSegmentProcessorObserver
+  */
+  if (workflow_event.event_name() == "onSequenceSegmentProcessorStart")
+  {
+    sequence_segment_processor_observer->onSequenceSegmentProcessorStart(workflow_event.event_index());
+  }
+  if (workflow_event.event_name() == "onSequenceSegmentProcessorSampleStart")
+  {
+    sequence_segment_processor_observer->onSequenceSegmentProcessorSampleStart(workflow_event.item_name());
+  }
+  if (workflow_event.event_name() == "onSequenceSegmentProcessorEnd")
+  {
+    sequence_segment_processor_observer->onSequenceSegmentProcessorEnd();
+  }
+  if (workflow_event.event_name() == "onSequenceSegmentProcessorSampleEnd")
+  {
+    sequence_segment_processor_observer->onSequenceSegmentProcessorSampleEnd(workflow_event.item_name());
+  }
+  /**
+    ISequenceObserver
+  */
+  if (workflow_event.event_name() == "onSequenceUpdated")
+  {
+    sequence_observer->onSequenceUpdated();
+  }
+  /**
+    ITransitionsObserver
+  */
+  if (workflow_event.event_name() == "onTransitionsUpdated")
+  {
+    transition_observer->onTransitionsUpdated();
+  }
+}
 
 void WorkflowClient::stopRunningWorkflow()
 {
@@ -405,19 +533,43 @@ bool WorkflowService::validateCredentials(const std::string& username, const std
   const ::SmartPeakServer::Interrupter* request,
   ::SmartPeakServer::Interrupter* response)
 {
-  workflow_process_interrupted = true;
+  std::lock_guard<std::mutex> lock(server_managers_mutex_);
+  for (auto& server_manager : server_managers_)
+  {
+    if (server_manager->cancel_workflow())
+    {
+      LOGW << "Cancelling workflow : " << server_manager->dataset_path;
+    }
+  }
   return grpc::Status(grpc::StatusCode::CANCELLED, "CANCELLED");
 }
 
+size_t WorkflowService::getMaxConcurrentWorkflows()
+{
+  std::string max_workflows;
+  SmartPeak::Utilities::getEnvVariable("SMARTPEAK_SERVER_MAX_WORKFLOWS", &max_workflows);
+  try
+  {
+    if (!max_workflows.empty())
+    {
+      return std::max(std::stoul(max_workflows), 1ul);
+    }
+  }
+  catch (const std::exception& e)
+  {
+    LOGW << "Invalid SMARTPEAK_SERVER_MAX_WORKFLOWS : " << max_workflows;
+  }
+  return 2;
+}
+
 ::grpc::Status WorkflowService::runWorkflow(
   ::grpc::ServerContext* context,
   const ::SmartPeakServer::WorkflowParameters* request,
   ::SmartPeakServer::WorkflowResult* response)
 {
   std::string started_at = SmartPeak::Utilities::getCurrentTime();
-  session_id_ = SmartPeak::Utilities::makeUniqueStringFromTime();
-  server_manager_.dataset_path = request->dataset_path();
-  bool export_all;
+  const std::string session_id = SmartPeak::Utilities::makeUniqueStringFromTime();
+  bool export_all = false;
   if (SmartPeakServer::WorkflowParameters_ExportReport_ALL == request->export_()) export_all = true;
   
   auto client_metadata = context->client_metadata();
@@ -429,70 +581,56 @@ bool WorkflowService::validateCredentials(const std::string& username, const std
     LOGW << "Username not provided! Aborting ..";
     return grpc::Status(grpc::StatusCode::UNAUTHENTICATED, "UNAUTHORIZED");
   }
-  if (username == client_metadata.end())
+  if (password == client_metadata.end())
   {
     LOGW << "Password not provided! Aborting ..";
     return grpc::Status(grpc::StatusCode::UNAUTHENTICATED, "UNAUTHORIZED");
   }
+  // the metadata values are not null-terminated
+  const std::string username_str(username->second.data(), username->second.size());
+  const std::string password_str(password->second.data(), password->second.size());
   
-  if (validateCredentials(username->second.data(), password->second.data()))
+  if (validateCredentials(username_str, password_str))
   {
-    LOGI << "Successfully logged in as: " << username->second.data() << " ...";
-    if (workflow_status_ == WorkflowStatus::IDLE || workflow_process_interrupted) {
-      
-      if (workflow_process_interrupted)
-      {
-        server_manager_.reset();
-      }
-      
-      workflow_status_ = WorkflowStatus::RUNNING;
-      handle_workflow_future_ = std::async(
-        std::launch::async,
-        &SmartPeak::serv::handleWorkflowRequest,
-        &server_manager_,
-        export_all
-      );
-      
-      if (workflow_process_interrupted)
-      {
-        workflow_process_interrupted = false;
-        return grpc::Status(grpc::StatusCode::CANCELLED, "CANCELLED");
-      }
-      
-      if (handle_workflow_future_.valid())
-      {
-        response->set_status_code(handle_workflow_future_.get() ? "YES" : "NO");
-        progress_info_.set_status_code(response->status_code());
-      }
-      
-      const auto app_hand = server_manager_.get_application_handler();
-      const auto seq_hand = app_hand.sequenceHandler_;
-        
-      LOGD << "Writing to serversession in : " << app_hand.main_dir_.string();
-      SmartPeak::Utilities::writeToServerSessionFile(
-        app_hand.main_dir_.string(),
-        username->second.data(), app_hand.main_dir_.string(),
-        response->status_code(),
-        started_at, SmartPeak::Utilities::getCurrentTime(),
-        app_hand.main_dir_.string()+"/"+"exports",
-        console_handler_->get_log_filepath());
-      
-      if (response->status_code() == "NO")
-      {
-        return grpc::Status(grpc::StatusCode::ABORTED, "ABORTED");
-      }
-      
-      response->set_session_id(session_id_);
-      response->set_path_to_results(app_hand.main_dir_.string()+"/"+"exports");
-      server_manager_.reset();
-      workflow_status_ = WorkflowStatus::IDLE;
-      return grpc::Status::OK;
-    }
-    else
+    LOGI << "Successfully logged in as: " << username_str << " ...";
+    // each request has its own session, the workflows are run by the shared job queue
+    auto server_manager = std::make_shared<SmartPeak::serv::ServerManager>(&job_queue_);
+    server_manager->dataset_path = request->dataset_path();
+    {
+      std::lock_guard<std::mutex> lock(server_managers_mutex_);
+      server_managers_.push_back(server_manager);
+      latest_server_manager_ = server_manager;
+    }
+    ++n_running_workflows_;
+    const bool workflow_done = SmartPeak::serv::handleWorkflowRequest(server_manager.get(), export_all);
+    --n_running_workflows_;
+    response->set_status_code(workflow_done ? "YES" : "NO");
+    {
+      std::lock_guard<std::mutex> lock(server_managers_mutex_);
+      server_managers_.remove(server_manager);
+      progress_info_.set_status_code(response->status_code());
+      ++progress_info_updates_;
+    }
+    progress_info_cv_.notify_all();
+
+    const auto& app_hand = server_manager->get_application_handler();
+    LOGD << "Writing to serversession in : " << app_hand.main_dir_.string();
+    SmartPeak::Utilities::writeToServerSessionFile(
+      app_hand.main_dir_.string(),
+      username_str, app_hand.main_dir_.string(),
+      response->status_code(),
+      started_at, SmartPeak::Utilities::getCurrentTime(),
+      app_hand.main_dir_.string()+"/"+"exports",
+      console_handler_->get_log_filepath());
+
+    if (response->status_code() == "NO")
     {
-      LOGW << "SERVER BUSY -- NOT PROCESSING : " << server_manager_.dataset_path;
-      return grpc::Status(grpc::StatusCode::UNAVAILABLE, "BUSY");
+      return grpc::Status(grpc::StatusCode::ABORTED, "ABORTED");
     }
+
+    response->set_session_id(session_id);
+    response->set_path_to_results(app_hand.main_dir_.string()+"/"+"exports");
+    return grpc::Status::OK;
   }
   else
   {
@@ -505,6 +643,7 @@ bool WorkflowService::validateCredentials(const std::string& username, const std
   const ::SmartPeakServer::WorkflowParameters* request,
   ::SmartPeakServer::ProgressInfo* response)
 {
+  std::lock_guard<std::mutex> lock(server_managers_mutex_);
   response->set_status_code(progress_info_.status_code());
   return grpc::Status::OK;
 }
@@ -514,38 +653,59 @@ bool WorkflowService::validateCredentials(const std::string& username, const std
   const ::SmartPeakServer::WorkflowParameters* request,
   ::SmartPeakServer::WorkflowEvent* response)
 {
-  auto &event_dispatcher = server_manager_.get_event_dispatcher();
-  event_dispatcher.dispatchEvents();
-  auto& server_event_dispatcher_observer = server_manager_.get_server_event_dispatcher_observer();
-  if (server_event_dispatcher_observer.events_.empty())
+  std::shared_ptr<SmartPeak::serv::ServerManager> latest_server_manager;
+  {
+    // the events are dispatched by the thread running the request
+    std::lock_guard<std::mutex> lock(server_managers_mutex_);
+    latest_server_manager = latest_server_manager_;
+  }
+  if (!latest_server_manager)
+  {
+    return grpc::Status::CANCELLED;
+  }
+  auto& server_event_dispatcher_observer = latest_server_manager->get_server_event_dispatcher_observer();
+  auto event = server_event_dispatcher_observer.popEvent();
+  if (!event)
   {
     return grpc::Status::CANCELLED;
   }
   else
   {
-    auto [event_name, event_index, item_name, commands_list] = server_event_dispatcher_observer.events_[0];
-    server_event_dispatcher_observer.events_.erase(server_event_dispatcher_observer.events_.begin());
-    response->set_event_name(event_name);
-    response->set_event_index(event_index);
-    response->set_item_name(item_name);
-    google::protobuf::RepeatedField<std::string> data(commands_list.begin(), commands_list.end());
-    response->mutable_command_list()->Add(commands_list.begin(), commands_list.end());
+    setWorkflowEvent(*event, response);
   }
   return grpc::Status::OK;
 }
 
+void WorkflowService::setWorkflowEvent(
+  const SmartPeak::serv::SeverEventDispatcherObserver::Event& event,
+  ::SmartPeakServer::WorkflowEvent* response)
+{
+  auto& [event_name, event_index, item_name, commands_list] = event;
+  response->set_event_name(event_name);
+  response->set_event_index(event_index);
+  response->set_item_name(item_name);
+  response->mutable_command_list()->Add(commands_list.begin(), commands_list.end());
+}
+
 ::grpc::Status WorkflowService::getLogStream(
   ::grpc::ServerContext* context,
   const ::SmartPeakServer::InquireLogs* request,
   ::grpc::ServerWriter<::SmartPeakServer::LogStream>* writer)
 {
-  auto logstream = console_handler_->server_appender_.getAppenderRecordList(plog::verbose);
+  writeLogStream(console_handler_->server_appender_.getAppenderRecordList(plog::verbose), writer);
+  return grpc::Status::OK;
+}
+
+bool WorkflowService::writeLogStream(
+  const std::vector<SmartPeak::ServerAppender::ServerAppenderRecord>& logstream,
+  ::grpc::ServerWriter<::SmartPeakServer::LogStream>* writer)
+{
   for (int i = 0; i < logstream.size(); ++i)
   {
     std::string logline_str(logstream.at(i).second.data(), logstream.at(i).second.data() + logstream.at(i).second.size());
     SmartPeakServer::LogStream logline;
     logline.set_log_line(logline_str);
-    
+
     if (logstream.at(i).first == plog::none)
     {
       logline.set_log_severity(::SmartPeakServer::LogStream_LogSeverity_NONE);
@@ -574,8 +734,132 @@ bool WorkflowService::validateCredentials(const std::string& username, const std
     {
       logline.set_log_severity(::SmartPeakServer::LogStream_LogSeverity_VERBOSE);
     }
-    
-    writer->Write(logline);
+
+    // blocks while the client is not reading, the appender keeps the latest records meanwhile
+    if (!writer->Write(logline))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+::grpc::Status WorkflowService::followProgressInfo(
+  ::grpc::ServerContext* context,
+  const ::SmartPeakServer::WorkflowParameters* request,
+  ::grpc::ServerWriter<::SmartPeakServer::ProgressInfo>* writer)
+{
+  std::unique_lock<std::mutex> lock(server_managers_mutex_);
+  size_t progress_info_updates = progress_info_updates_;
+  ::SmartPeakServer::ProgressInfo progress_info = progress_info_;
+  lock.unlock();
+  if (!writer->Write(progress_info))
+  {
+    return grpc::Status::OK;
+  }
+  while (!context->IsCancelled())
+  {
+    const bool workflow_running = (n_running_workflows_ > 0);
+    lock.lock();
+    if (progress_info_cv_.wait_for(lock, std::chrono::milliseconds(500),
+      [&]() { return progress_info_updates_ != progress_info_updates; }))
+    {
+      progress_info_updates = progress_info_updates_;
+      progress_info = progress_info_;
+      lock.unlock();
+      if (!writer->Write(progress_info))
+      {
+        break;
+      }
+    }
+    else
+    {
+      lock.unlock();
+      if (!workflow_running)
+      {
+        break;
+      }
+    }
+  }
+  return grpc::Status::OK;
+}
+
+::grpc::Status WorkflowService::followWorkflowEvents(
+  ::grpc::ServerContext* context,
+  const ::SmartPeakServer::WorkflowParameters* request,
+  ::grpc::ServerWriter<::SmartPeakServer::WorkflowEvent>* writer)
+{
+  // the events of the latest request, read with a cursor of this stream. They are
+  // dispatched to the server event dispatcher observer by the thread running the request.
+  std::shared_ptr<SmartPeak::serv::ServerManager> server_manager;
+  size_t cursor = 0;
+  while (!context->IsCancelled())
+  {
+    const bool workflow_running = (n_running_workflows_ > 0);
+    {
+      std::lock_guard<std::mutex> lock(server_managers_mutex_);
+      if (latest_server_manager_ != server_manager)
+      {
+        server_manager = latest_server_manager_;
+        cursor = server_manager->get_server_event_dispatcher_observer().getCursor();
+      }
+    }
+    if (server_manager && server_manager->get_server_event_dispatcher_observer().waitForEvent(cursor, std::chrono::milliseconds(500)))
+    {
+      while (const auto event = server_manager->get_server_event_dispatcher_observer().getEvent(cursor))
+      {
+        ::SmartPeakServer::WorkflowEvent workflow_event;
+        setWorkflowEvent(*event, &workflow_event);
+        if (!writer->Write(workflow_event))
+        {
+          return grpc::Status::OK;
+        }
+      }
+    }
+    else if (!workflow_running)
+    {
+      break;
+    }
+  }
+  return grpc::Status::OK;
+}
+
+::grpc::Status WorkflowService::followLogStream(
+  ::grpc::ServerContext* context,
+  const ::SmartPeakServer::InquireLogs* request,
+  ::grpc::ServerWriter<::SmartPeakServer::LogStream>* writer)
+{
+  // stream the records as they are produced while a workflow is running, with the
+  // cursor of this stream: the records read by the other clients are not taken from it
+  auto& server_appender = console_handler_->server_appender_;
+  SmartPeak::ServerAppender::Cursor cursor = server_appender.getCursor();
+  size_t nb_dropped_records = 0;
+  while (!context->IsCancelled())
+  {
+    const bool workflow_running = (n_running_workflows_ > 0);
+    if (server_appender.waitForRecords(cursor, std::chrono::milliseconds(500)))
+    {
+      const auto logstream = server_appender.getAppenderRecordList(plog::verbose, cursor);
+      if (cursor.nb_dropped_records != nb_dropped_records)
+      {
+        SmartPeakServer::LogStream logline;
+        logline.set_log_line(std::to_string(cursor.nb_dropped_records - nb_dropped_records) + " log records dropped, the client is not reading fast enough\n");
+        logline.set_log_severity(::SmartPeakServer::LogStream_LogSeverity_WARNING);
+        nb_dropped_records = cursor.nb_dropped_records;
+        if (!writer->Write(logline))
+        {
+          break;
+        }
+      }
+      if (!writeLogStream(logstream, writer))
+      {
+        break;
+      }
+    }
+    else if (!workflow_running)
+    {
+      break;
+    }
   }
   return grpc::Status::OK;
 }
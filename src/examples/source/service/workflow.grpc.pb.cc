@@ -27,6 +27,9 @@ static const char* Workflow_method_names[] = {
   "/SmartPeakServer.Workflow/getProgressInfo",
   "/SmartPeakServer.Workflow/getWorkflowEvent",
   "/SmartPeakServer.Workflow/stopRunningWorkflow",
+  "/SmartPeakServer.Workflow/followProgressInfo",
+  "/SmartPeakServer.Workflow/followWorkflowEvents",
+  "/SmartPeakServer.Workflow/followLogStream",
 };
 
 std::unique_ptr< Workflow::Stub> Workflow::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
@@ -41,6 +44,9 @@ Workflow::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& channel,
   , rpcmethod_getProgressInfo_(Workflow_method_names[2], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_getWorkflowEvent_(Workflow_method_names[3], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_stopRunningWorkflow_(Workflow_method_names[4], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
+  , rpcmethod_followProgressInfo_(Workflow_method_names[5], options.suffix_for_stats(),::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+  , rpcmethod_followWorkflowEvents_(Workflow_method_names[6], options.suffix_for_stats(),::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
+  , rpcmethod_followLogStream_(Workflow_method_names[7], options.suffix_for_stats(),::grpc::internal::RpcMethod::SERVER_STREAMING, channel)
   {}
 
 ::grpc::Status Workflow::Stub::runWorkflow(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::SmartPeakServer::WorkflowResult* response) {
@@ -151,6 +157,54 @@ void Workflow::Stub::async::stopRunningWorkflow(::grpc::ClientContext* context,
   return result;
 }
 
+::grpc::ClientReader< ::SmartPeakServer::ProgressInfo>* Workflow::Stub::followProgressInfoRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request) {
+  return ::grpc::internal::ClientReaderFactory< ::SmartPeakServer::ProgressInfo>::Create(channel_.get(), rpcmethod_followProgressInfo_, context, request);
+}
+
+void Workflow::Stub::async::followProgressInfo(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::grpc::ClientReadReactor< ::SmartPeakServer::ProgressInfo>* reactor) {
+  ::grpc::internal::ClientCallbackReaderFactory< ::SmartPeakServer::ProgressInfo>::Create(stub_->channel_.get(), stub_->rpcmethod_followProgressInfo_, context, request, reactor);
+}
+
+::grpc::ClientAsyncReader< ::SmartPeakServer::ProgressInfo>* Workflow::Stub::AsyncfollowProgressInfoRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::SmartPeakServer::ProgressInfo>::Create(channel_.get(), cq, rpcmethod_followProgressInfo_, context, request, true, tag);
+}
+
+::grpc::ClientAsyncReader< ::SmartPeakServer::ProgressInfo>* Workflow::Stub::PrepareAsyncfollowProgressInfoRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::SmartPeakServer::ProgressInfo>::Create(channel_.get(), cq, rpcmethod_followProgressInfo_, context, request, false, nullptr);
+}
+
+::grpc::ClientReader< ::SmartPeakServer::WorkflowEvent>* Workflow::Stub::followWorkflowEventsRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request) {
+  return ::grpc::internal::ClientReaderFactory< ::SmartPeakServer::WorkflowEvent>::Create(channel_.get(), rpcmethod_followWorkflowEvents_, context, request);
+}
+
+void Workflow::Stub::async::followWorkflowEvents(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::grpc::ClientReadReactor< ::SmartPeakServer::WorkflowEvent>* reactor) {
+  ::grpc::internal::ClientCallbackReaderFactory< ::SmartPeakServer::WorkflowEvent>::Create(stub_->channel_.get(), stub_->rpcmethod_followWorkflowEvents_, context, request, reactor);
+}
+
+::grpc::ClientAsyncReader< ::SmartPeakServer::WorkflowEvent>* Workflow::Stub::AsyncfollowWorkflowEventsRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::SmartPeakServer::WorkflowEvent>::Create(channel_.get(), cq, rpcmethod_followWorkflowEvents_, context, request, true, tag);
+}
+
+::grpc::ClientAsyncReader< ::SmartPeakServer::WorkflowEvent>* Workflow::Stub::PrepareAsyncfollowWorkflowEventsRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::SmartPeakServer::WorkflowEvent>::Create(channel_.get(), cq, rpcmethod_followWorkflowEvents_, context, request, false, nullptr);
+}
+
+::grpc::ClientReader< ::SmartPeakServer::LogStream>* Workflow::Stub::followLogStreamRaw(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request) {
+  return ::grpc::internal::ClientReaderFactory< ::SmartPeakServer::LogStream>::Create(channel_.get(), rpcmethod_followLogStream_, context, request);
+}
+
+void Workflow::Stub::async::followLogStream(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs* request, ::grpc::ClientReadReactor< ::SmartPeakServer::LogStream>* reactor) {
+  ::grpc::internal::ClientCallbackReaderFactory< ::SmartPeakServer::LogStream>::Create(stub_->channel_.get(), stub_->rpcmethod_followLogStream_, context, request, reactor);
+}
+
+::grpc::ClientAsyncReader< ::SmartPeakServer::LogStream>* Workflow::Stub::AsyncfollowLogStreamRaw(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request, ::grpc::CompletionQueue* cq, void* tag) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::SmartPeakServer::LogStream>::Create(channel_.get(), cq, rpcmethod_followLogStream_, context, request, true, tag);
+}
+
+::grpc::ClientAsyncReader< ::SmartPeakServer::LogStream>* Workflow::Stub::PrepareAsyncfollowLogStreamRaw(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncReaderFactory< ::SmartPeakServer::LogStream>::Create(channel_.get(), cq, rpcmethod_followLogStream_, context, request, false, nullptr);
+}
+
 Workflow::Service::Service() {
   AddMethod(new ::grpc::internal::RpcServiceMethod(
       Workflow_method_names[0],
@@ -202,6 +256,36 @@ Workflow::Service::Service() {
              ::SmartPeakServer::Interrupter* resp) {
                return service->stopRunningWorkflow(ctx, req, resp);
              }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      Workflow_method_names[5],
+      ::grpc::internal::RpcMethod::SERVER_STREAMING,
+      new ::grpc::internal::ServerStreamingHandler< Workflow::Service, ::SmartPeakServer::WorkflowParameters, ::SmartPeakServer::ProgressInfo>(
+          [](Workflow::Service* service,
+             ::grpc::ServerContext* ctx,
+             const ::SmartPeakServer::WorkflowParameters* req,
+             ::grpc::ServerWriter<::SmartPeakServer::ProgressInfo>* writer) {
+               return service->followProgressInfo(ctx, req, writer);
+             }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      Workflow_method_names[6],
+      ::grpc::internal::RpcMethod::SERVER_STREAMING,
+      new ::grpc::internal::ServerStreamingHandler< Workflow::Service, ::SmartPeakServer::WorkflowParameters, ::SmartPeakServer::WorkflowEvent>(
+          [](Workflow::Service* service,
+             ::grpc::ServerContext* ctx,
+             const ::SmartPeakServer::WorkflowParameters* req,
+             ::grpc::ServerWriter<::SmartPeakServer::WorkflowEvent>* writer) {
+               return service->followWorkflowEvents(ctx, req, writer);
+             }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      Workflow_method_names[7],
+      ::grpc::internal::RpcMethod::SERVER_STREAMING,
+      new ::grpc::internal::ServerStreamingHandler< Workflow::Service, ::SmartPeakServer::InquireLogs, ::SmartPeakServer::LogStream>(
+          [](Workflow::Service* service,
+             ::grpc::ServerContext* ctx,
+             const ::SmartPeakServer::InquireLogs* req,
+             ::grpc::ServerWriter<::SmartPeakServer::LogStream>* writer) {
+               return service->followLogStream(ctx, req, writer);
+             }, this)));
 }
 
 Workflow::Service::~Service() {
@@ -242,6 +326,27 @@ Workflow::Service::~Service() {
   return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
 }
 
+::grpc::Status Workflow::Service::followProgressInfo(::grpc::ServerContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::grpc::ServerWriter< ::SmartPeakServer::ProgressInfo>* writer) {
+  (void) context;
+  (void) request;
+  (void) writer;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status Workflow::Service::followWorkflowEvents(::grpc::ServerContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::grpc::ServerWriter< ::SmartPeakServer::WorkflowEvent>* writer) {
+  (void) context;
+  (void) request;
+  (void) writer;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status Workflow::Service::followLogStream(::grpc::ServerContext* context, const ::SmartPeakServer::InquireLogs* request, ::grpc::ServerWriter< ::SmartPeakServer::LogStream>* writer) {
+  (void) context;
+  (void) request;
+  (void) writer;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
 
 }  // namespace SmartPeakServer
 
@@ -100,6 +100,33 @@ class Workflow final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::SmartPeakServer::Interrupter>> PrepareAsyncstopRunningWorkflow(::grpc::ClientContext* context, const ::SmartPeakServer::Interrupter& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::SmartPeakServer::Interrupter>>(PrepareAsyncstopRunningWorkflowRaw(context, request, cq));
     }
+    std::unique_ptr< ::grpc::ClientReaderInterface< ::SmartPeakServer::ProgressInfo>> followProgressInfo(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request) {
+      return std::unique_ptr< ::grpc::ClientReaderInterface< ::SmartPeakServer::ProgressInfo>>(followProgressInfoRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::ProgressInfo>> AsyncfollowProgressInfo(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::ProgressInfo>>(AsyncfollowProgressInfoRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::ProgressInfo>> PrepareAsyncfollowProgressInfo(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::ProgressInfo>>(PrepareAsyncfollowProgressInfoRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReaderInterface< ::SmartPeakServer::WorkflowEvent>> followWorkflowEvents(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request) {
+      return std::unique_ptr< ::grpc::ClientReaderInterface< ::SmartPeakServer::WorkflowEvent>>(followWorkflowEventsRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::WorkflowEvent>> AsyncfollowWorkflowEvents(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::WorkflowEvent>>(AsyncfollowWorkflowEventsRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::WorkflowEvent>> PrepareAsyncfollowWorkflowEvents(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::WorkflowEvent>>(PrepareAsyncfollowWorkflowEventsRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReaderInterface< ::SmartPeakServer::LogStream>> followLogStream(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request) {
+      return std::unique_ptr< ::grpc::ClientReaderInterface< ::SmartPeakServer::LogStream>>(followLogStreamRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::LogStream>> AsyncfollowLogStream(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::LogStream>>(AsyncfollowLogStreamRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::LogStream>> PrepareAsyncfollowLogStream(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::LogStream>>(PrepareAsyncfollowLogStreamRaw(context, request, cq));
+    }
     class async_interface {
      public:
       virtual ~async_interface() {}
@@ -112,6 +139,9 @@ class Workflow final {
       virtual void getWorkflowEvent(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::SmartPeakServer::WorkflowEvent* response, ::grpc::ClientUnaryReactor* reactor) = 0;
       virtual void stopRunningWorkflow(::grpc::ClientContext* context, const ::SmartPeakServer::Interrupter* request, ::SmartPeakServer::Interrupter* response, std::function<void(::grpc::Status)>) = 0;
       virtual void stopRunningWorkflow(::grpc::ClientContext* context, const ::SmartPeakServer::Interrupter* request, ::SmartPeakServer::Interrupter* response, ::grpc::ClientUnaryReactor* reactor) = 0;
+      virtual void followProgressInfo(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::grpc::ClientReadReactor< ::SmartPeakServer::ProgressInfo>* reactor) = 0;
+      virtual void followWorkflowEvents(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::grpc::ClientReadReactor< ::SmartPeakServer::WorkflowEvent>* reactor) = 0;
+      virtual void followLogStream(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs* request, ::grpc::ClientReadReactor< ::SmartPeakServer::LogStream>* reactor) = 0;
     };
     typedef class async_interface experimental_async_interface;
     virtual class async_interface* async() { return nullptr; }
@@ -128,6 +158,15 @@ class Workflow final {
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::SmartPeakServer::WorkflowEvent>* PrepareAsyncgetWorkflowEventRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::SmartPeakServer::Interrupter>* AsyncstopRunningWorkflowRaw(::grpc::ClientContext* context, const ::SmartPeakServer::Interrupter& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::SmartPeakServer::Interrupter>* PrepareAsyncstopRunningWorkflowRaw(::grpc::ClientContext* context, const ::SmartPeakServer::Interrupter& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderInterface< ::SmartPeakServer::ProgressInfo>* followProgressInfoRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::ProgressInfo>* AsyncfollowProgressInfoRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::ProgressInfo>* PrepareAsyncfollowProgressInfoRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderInterface< ::SmartPeakServer::WorkflowEvent>* followWorkflowEventsRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::WorkflowEvent>* AsyncfollowWorkflowEventsRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::WorkflowEvent>* PrepareAsyncfollowWorkflowEventsRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientReaderInterface< ::SmartPeakServer::LogStream>* followLogStreamRaw(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::LogStream>* AsyncfollowLogStreamRaw(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request, ::grpc::CompletionQueue* cq, void* tag) = 0;
+    virtual ::grpc::ClientAsyncReaderInterface< ::SmartPeakServer::LogStream>* PrepareAsyncfollowLogStreamRaw(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request, ::grpc::CompletionQueue* cq) = 0;
   };
   class Stub final : public StubInterface {
    public:
@@ -169,6 +208,33 @@ class Workflow final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::SmartPeakServer::Interrupter>> PrepareAsyncstopRunningWorkflow(::grpc::ClientContext* context, const ::SmartPeakServer::Interrupter& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::SmartPeakServer::Interrupter>>(PrepareAsyncstopRunningWorkflowRaw(context, request, cq));
     }
+    std::unique_ptr< ::grpc::ClientReader< ::SmartPeakServer::ProgressInfo>> followProgressInfo(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request) {
+      return std::unique_ptr< ::grpc::ClientReader< ::SmartPeakServer::ProgressInfo>>(followProgressInfoRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::ProgressInfo>> AsyncfollowProgressInfo(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::ProgressInfo>>(AsyncfollowProgressInfoRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::ProgressInfo>> PrepareAsyncfollowProgressInfo(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::ProgressInfo>>(PrepareAsyncfollowProgressInfoRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReader< ::SmartPeakServer::WorkflowEvent>> followWorkflowEvents(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request) {
+      return std::unique_ptr< ::grpc::ClientReader< ::SmartPeakServer::WorkflowEvent>>(followWorkflowEventsRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::WorkflowEvent>> AsyncfollowWorkflowEvents(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::WorkflowEvent>>(AsyncfollowWorkflowEventsRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::WorkflowEvent>> PrepareAsyncfollowWorkflowEvents(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::WorkflowEvent>>(PrepareAsyncfollowWorkflowEventsRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientReader< ::SmartPeakServer::LogStream>> followLogStream(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request) {
+      return std::unique_ptr< ::grpc::ClientReader< ::SmartPeakServer::LogStream>>(followLogStreamRaw(context, request));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::LogStream>> AsyncfollowLogStream(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request, ::grpc::CompletionQueue* cq, void* tag) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::LogStream>>(AsyncfollowLogStreamRaw(context, request, cq, tag));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::LogStream>> PrepareAsyncfollowLogStream(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncReader< ::SmartPeakServer::LogStream>>(PrepareAsyncfollowLogStreamRaw(context, request, cq));
+    }
     class async final :
       public StubInterface::async_interface {
      public:
@@ -181,6 +247,9 @@ class Workflow final {
       void getWorkflowEvent(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::SmartPeakServer::WorkflowEvent* response, ::grpc::ClientUnaryReactor* reactor) override;
       void stopRunningWorkflow(::grpc::ClientContext* context, const ::SmartPeakServer::Interrupter* request, ::SmartPeakServer::Interrupter* response, std::function<void(::grpc::Status)>) override;
       void stopRunningWorkflow(::grpc::ClientContext* context, const ::SmartPeakServer::Interrupter* request, ::SmartPeakServer::Interrupter* response, ::grpc::ClientUnaryReactor* reactor) override;
+      void followProgressInfo(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::grpc::ClientReadReactor< ::SmartPeakServer::ProgressInfo>* reactor) override;
+      void followWorkflowEvents(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::grpc::ClientReadReactor< ::SmartPeakServer::WorkflowEvent>* reactor) override;
+      void followLogStream(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs* request, ::grpc::ClientReadReactor< ::SmartPeakServer::LogStream>* reactor) override;
      private:
       friend class Stub;
       explicit async(Stub* stub): stub_(stub) { }
@@ -203,11 +272,23 @@ class Workflow final {
     ::grpc::ClientAsyncResponseReader< ::SmartPeakServer::WorkflowEvent>* PrepareAsyncgetWorkflowEventRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::SmartPeakServer::Interrupter>* AsyncstopRunningWorkflowRaw(::grpc::ClientContext* context, const ::SmartPeakServer::Interrupter& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::SmartPeakServer::Interrupter>* PrepareAsyncstopRunningWorkflowRaw(::grpc::ClientContext* context, const ::SmartPeakServer::Interrupter& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReader< ::SmartPeakServer::ProgressInfo>* followProgressInfoRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request) override;
+    ::grpc::ClientAsyncReader< ::SmartPeakServer::ProgressInfo>* AsyncfollowProgressInfoRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReader< ::SmartPeakServer::ProgressInfo>* PrepareAsyncfollowProgressInfoRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReader< ::SmartPeakServer::WorkflowEvent>* followWorkflowEventsRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request) override;
+    ::grpc::ClientAsyncReader< ::SmartPeakServer::WorkflowEvent>* AsyncfollowWorkflowEventsRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReader< ::SmartPeakServer::WorkflowEvent>* PrepareAsyncfollowWorkflowEventsRaw(::grpc::ClientContext* context, const ::SmartPeakServer::WorkflowParameters& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientReader< ::SmartPeakServer::LogStream>* followLogStreamRaw(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request) override;
+    ::grpc::ClientAsyncReader< ::SmartPeakServer::LogStream>* AsyncfollowLogStreamRaw(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request, ::grpc::CompletionQueue* cq, void* tag) override;
+    ::grpc::ClientAsyncReader< ::SmartPeakServer::LogStream>* PrepareAsyncfollowLogStreamRaw(::grpc::ClientContext* context, const ::SmartPeakServer::InquireLogs& request, ::grpc::CompletionQueue* cq) override;
     const ::grpc::internal::RpcMethod rpcmethod_runWorkflow_;
     const ::grpc::internal::RpcMethod rpcmethod_getLogStream_;
     const ::grpc::internal::RpcMethod rpcmethod_getProgressInfo_;
     const ::grpc::internal::RpcMethod rpcmethod_getWorkflowEvent_;
     const ::grpc::internal::RpcMethod rpcmethod_stopRunningWorkflow_;
+    const ::grpc::internal::RpcMethod rpcmethod_followProgressInfo_;
+    const ::grpc::internal::RpcMethod rpcmethod_followWorkflowEvents_;
+    const ::grpc::internal::RpcMethod rpcmethod_followLogStream_;
   };
   static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
 
@@ -220,6 +301,9 @@ class Workflow final {
     virtual ::grpc::Status getProgressInfo(::grpc::ServerContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::SmartPeakServer::ProgressInfo* response);
     virtual ::grpc::Status getWorkflowEvent(::grpc::ServerContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::SmartPeakServer::WorkflowEvent* response);
     virtual ::grpc::Status stopRunningWorkflow(::grpc::ServerContext* context, const ::SmartPeakServer::Interrupter* request, ::SmartPeakServer::Interrupter* response);
+    virtual ::grpc::Status followProgressInfo(::grpc::ServerContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::grpc::ServerWriter< ::SmartPeakServer::ProgressInfo>* writer);
+    virtual ::grpc::Status followWorkflowEvents(::grpc::ServerContext* context, const ::SmartPeakServer::WorkflowParameters* request, ::grpc::ServerWriter< ::SmartPeakServer::WorkflowEvent>* writer);
+    virtual ::grpc::Status followLogStream(::grpc::ServerContext* context, const ::SmartPeakServer::InquireLogs* request, ::grpc::ServerWriter< ::SmartPeakServer::LogStream>* writer);
   };
   template <class BaseClass>
   class WithAsyncMethod_runWorkflow : public BaseClass {
@@ -321,7 +405,67 @@ class Workflow final {
       ::grpc::Service::RequestAsyncUnary(4, context, request, response, new_call_cq, notification_cq, tag);
     }
   };
-  typedef WithAsyncMethod_runWorkflow<WithAsyncMethod_getLogStream<WithAsyncMethod_getProgressInfo<WithAsyncMethod_getWorkflowEvent<WithAsyncMethod_stopRunningWorkflow<Service > > > > > AsyncService;
+  template <class BaseClass>
+  class WithAsyncMethod_followProgressInfo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_followProgressInfo() {
+      ::grpc::Service::MarkMethodAsync(5);
+    }
+    ~WithAsyncMethod_followProgressInfo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followProgressInfo(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::ProgressInfo>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestfollowProgressInfo(::grpc::ServerContext* context, ::SmartPeakServer::WorkflowParameters* request, ::grpc::ServerAsyncWriter< ::SmartPeakServer::ProgressInfo>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(5, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithAsyncMethod_followWorkflowEvents : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_followWorkflowEvents() {
+      ::grpc::Service::MarkMethodAsync(6);
+    }
+    ~WithAsyncMethod_followWorkflowEvents() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followWorkflowEvents(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::WorkflowEvent>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestfollowWorkflowEvents(::grpc::ServerContext* context, ::SmartPeakServer::WorkflowParameters* request, ::grpc::ServerAsyncWriter< ::SmartPeakServer::WorkflowEvent>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(6, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithAsyncMethod_followLogStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_followLogStream() {
+      ::grpc::Service::MarkMethodAsync(7);
+    }
+    ~WithAsyncMethod_followLogStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followLogStream(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::InquireLogs* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::LogStream>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestfollowLogStream(::grpc::ServerContext* context, ::SmartPeakServer::InquireLogs* request, ::grpc::ServerAsyncWriter< ::SmartPeakServer::LogStream>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(7, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  typedef WithAsyncMethod_runWorkflow<WithAsyncMethod_getLogStream<WithAsyncMethod_getProgressInfo<WithAsyncMethod_getWorkflowEvent<WithAsyncMethod_stopRunningWorkflow<WithAsyncMethod_followProgressInfo<WithAsyncMethod_followWorkflowEvents<WithAsyncMethod_followLogStream<Service > > > > > > > > AsyncService;
   template <class BaseClass>
   class WithCallbackMethod_runWorkflow : public BaseClass {
    private:
@@ -452,7 +596,73 @@ class Workflow final {
     virtual ::grpc::ServerUnaryReactor* stopRunningWorkflow(
       ::grpc::CallbackServerContext* /*context*/, const ::SmartPeakServer::Interrupter* /*request*/, ::SmartPeakServer::Interrupter* /*response*/)  { return nullptr; }
   };
-  typedef WithCallbackMethod_runWorkflow<WithCallbackMethod_getLogStream<WithCallbackMethod_getProgressInfo<WithCallbackMethod_getWorkflowEvent<WithCallbackMethod_stopRunningWorkflow<Service > > > > > CallbackService;
+  template <class BaseClass>
+  class WithCallbackMethod_followProgressInfo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithCallbackMethod_followProgressInfo() {
+      ::grpc::Service::MarkMethodCallback(5,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::SmartPeakServer::WorkflowParameters, ::SmartPeakServer::ProgressInfo>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::SmartPeakServer::WorkflowParameters* request) { return this->followProgressInfo(context, request); }));
+    }
+    ~WithCallbackMethod_followProgressInfo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followProgressInfo(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::ProgressInfo>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::SmartPeakServer::ProgressInfo>* followProgressInfo(
+      ::grpc::CallbackServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithCallbackMethod_followWorkflowEvents : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithCallbackMethod_followWorkflowEvents() {
+      ::grpc::Service::MarkMethodCallback(6,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::SmartPeakServer::WorkflowParameters, ::SmartPeakServer::WorkflowEvent>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::SmartPeakServer::WorkflowParameters* request) { return this->followWorkflowEvents(context, request); }));
+    }
+    ~WithCallbackMethod_followWorkflowEvents() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followWorkflowEvents(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::WorkflowEvent>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::SmartPeakServer::WorkflowEvent>* followWorkflowEvents(
+      ::grpc::CallbackServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithCallbackMethod_followLogStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithCallbackMethod_followLogStream() {
+      ::grpc::Service::MarkMethodCallback(7,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::SmartPeakServer::InquireLogs, ::SmartPeakServer::LogStream>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::SmartPeakServer::InquireLogs* request) { return this->followLogStream(context, request); }));
+    }
+    ~WithCallbackMethod_followLogStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followLogStream(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::InquireLogs* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::LogStream>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::SmartPeakServer::LogStream>* followLogStream(
+      ::grpc::CallbackServerContext* /*context*/, const ::SmartPeakServer::InquireLogs* /*request*/)  { return nullptr; }
+  };
+  typedef WithCallbackMethod_runWorkflow<WithCallbackMethod_getLogStream<WithCallbackMethod_getProgressInfo<WithCallbackMethod_getWorkflowEvent<WithCallbackMethod_stopRunningWorkflow<WithCallbackMethod_followProgressInfo<WithCallbackMethod_followWorkflowEvents<WithCallbackMethod_followLogStream<Service > > > > > > > > CallbackService;
   typedef CallbackService ExperimentalCallbackService;
   template <class BaseClass>
   class WithGenericMethod_runWorkflow : public BaseClass {
@@ -540,6 +750,57 @@ class Workflow final {
     }
   };
   template <class BaseClass>
+  class WithGenericMethod_followProgressInfo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_followProgressInfo() {
+      ::grpc::Service::MarkMethodGeneric(5);
+    }
+    ~WithGenericMethod_followProgressInfo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followProgressInfo(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::ProgressInfo>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
+  class WithGenericMethod_followWorkflowEvents : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_followWorkflowEvents() {
+      ::grpc::Service::MarkMethodGeneric(6);
+    }
+    ~WithGenericMethod_followWorkflowEvents() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followWorkflowEvents(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::WorkflowEvent>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
+  class WithGenericMethod_followLogStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_followLogStream() {
+      ::grpc::Service::MarkMethodGeneric(7);
+    }
+    ~WithGenericMethod_followLogStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followLogStream(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::InquireLogs* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::LogStream>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
   class WithRawMethod_runWorkflow : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -640,6 +901,66 @@ class Workflow final {
     }
   };
   template <class BaseClass>
+  class WithRawMethod_followProgressInfo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_followProgressInfo() {
+      ::grpc::Service::MarkMethodRaw(5);
+    }
+    ~WithRawMethod_followProgressInfo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followProgressInfo(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::ProgressInfo>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestfollowProgressInfo(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(5, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_followWorkflowEvents : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_followWorkflowEvents() {
+      ::grpc::Service::MarkMethodRaw(6);
+    }
+    ~WithRawMethod_followWorkflowEvents() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followWorkflowEvents(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::WorkflowEvent>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestfollowWorkflowEvents(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(6, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_followLogStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_followLogStream() {
+      ::grpc::Service::MarkMethodRaw(7);
+    }
+    ~WithRawMethod_followLogStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followLogStream(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::InquireLogs* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::LogStream>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestfollowLogStream(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncWriter< ::grpc::ByteBuffer>* writer, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncServerStreaming(7, context, request, writer, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
   class WithRawCallbackMethod_runWorkflow : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -750,6 +1071,72 @@ class Workflow final {
       ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
   };
   template <class BaseClass>
+  class WithRawCallbackMethod_followProgressInfo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_followProgressInfo() {
+      ::grpc::Service::MarkMethodRawCallback(5,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const::grpc::ByteBuffer* request) { return this->followProgressInfo(context, request); }));
+    }
+    ~WithRawCallbackMethod_followProgressInfo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followProgressInfo(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::ProgressInfo>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::grpc::ByteBuffer>* followProgressInfo(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_followWorkflowEvents : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_followWorkflowEvents() {
+      ::grpc::Service::MarkMethodRawCallback(6,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const::grpc::ByteBuffer* request) { return this->followWorkflowEvents(context, request); }));
+    }
+    ~WithRawCallbackMethod_followWorkflowEvents() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followWorkflowEvents(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::WorkflowEvent>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::grpc::ByteBuffer>* followWorkflowEvents(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_followLogStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_followLogStream() {
+      ::grpc::Service::MarkMethodRawCallback(7,
+          new ::grpc::internal::CallbackServerStreamingHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const::grpc::ByteBuffer* request) { return this->followLogStream(context, request); }));
+    }
+    ~WithRawCallbackMethod_followLogStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status followLogStream(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::InquireLogs* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::LogStream>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerWriteReactor< ::grpc::ByteBuffer>* followLogStream(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/)  { return nullptr; }
+  };
+  template <class BaseClass>
   class WithStreamedUnaryMethod_runWorkflow : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -885,8 +1272,89 @@ class Workflow final {
     // replace default version of method with split streamed
     virtual ::grpc::Status StreamedgetLogStream(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::SmartPeakServer::InquireLogs,::SmartPeakServer::LogStream>* server_split_streamer) = 0;
   };
-  typedef WithSplitStreamingMethod_getLogStream<Service > SplitStreamedService;
-  typedef WithStreamedUnaryMethod_runWorkflow<WithSplitStreamingMethod_getLogStream<WithStreamedUnaryMethod_getProgressInfo<WithStreamedUnaryMethod_getWorkflowEvent<WithStreamedUnaryMethod_stopRunningWorkflow<Service > > > > > StreamedService;
+  template <class BaseClass>
+  class WithSplitStreamingMethod_followProgressInfo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithSplitStreamingMethod_followProgressInfo() {
+      ::grpc::Service::MarkMethodStreamed(5,
+        new ::grpc::internal::SplitServerStreamingHandler<
+          ::SmartPeakServer::WorkflowParameters, ::SmartPeakServer::ProgressInfo>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerSplitStreamer<
+                     ::SmartPeakServer::WorkflowParameters, ::SmartPeakServer::ProgressInfo>* streamer) {
+                       return this->StreamedfollowProgressInfo(context,
+                         streamer);
+                  }));
+    }
+    ~WithSplitStreamingMethod_followProgressInfo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status followProgressInfo(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::ProgressInfo>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with split streamed
+    virtual ::grpc::Status StreamedfollowProgressInfo(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::SmartPeakServer::WorkflowParameters,::SmartPeakServer::ProgressInfo>* server_split_streamer) = 0;
+  };
+  template <class BaseClass>
+  class WithSplitStreamingMethod_followWorkflowEvents : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithSplitStreamingMethod_followWorkflowEvents() {
+      ::grpc::Service::MarkMethodStreamed(6,
+        new ::grpc::internal::SplitServerStreamingHandler<
+          ::SmartPeakServer::WorkflowParameters, ::SmartPeakServer::WorkflowEvent>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerSplitStreamer<
+                     ::SmartPeakServer::WorkflowParameters, ::SmartPeakServer::WorkflowEvent>* streamer) {
+                       return this->StreamedfollowWorkflowEvents(context,
+                         streamer);
+                  }));
+    }
+    ~WithSplitStreamingMethod_followWorkflowEvents() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status followWorkflowEvents(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::WorkflowParameters* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::WorkflowEvent>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with split streamed
+    virtual ::grpc::Status StreamedfollowWorkflowEvents(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::SmartPeakServer::WorkflowParameters,::SmartPeakServer::WorkflowEvent>* server_split_streamer) = 0;
+  };
+  template <class BaseClass>
+  class WithSplitStreamingMethod_followLogStream : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithSplitStreamingMethod_followLogStream() {
+      ::grpc::Service::MarkMethodStreamed(7,
+        new ::grpc::internal::SplitServerStreamingHandler<
+          ::SmartPeakServer::InquireLogs, ::SmartPeakServer::LogStream>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerSplitStreamer<
+                     ::SmartPeakServer::InquireLogs, ::SmartPeakServer::LogStream>* streamer) {
+                       return this->StreamedfollowLogStream(context,
+                         streamer);
+                  }));
+    }
+    ~WithSplitStreamingMethod_followLogStream() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status followLogStream(::grpc::ServerContext* /*context*/, const ::SmartPeakServer::InquireLogs* /*request*/, ::grpc::ServerWriter< ::SmartPeakServer::LogStream>* /*writer*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with split streamed
+    virtual ::grpc::Status StreamedfollowLogStream(::grpc::ServerContext* context, ::grpc::ServerSplitStreamer< ::SmartPeakServer::InquireLogs,::SmartPeakServer::LogStream>* server_split_streamer) = 0;
+  };
+  typedef WithSplitStreamingMethod_getLogStream<WithSplitStreamingMethod_followProgressInfo<WithSplitStreamingMethod_followWorkflowEvents<WithSplitStreamingMethod_followLogStream<Service > > > > SplitStreamedService;
+  typedef WithStreamedUnaryMethod_runWorkflow<WithSplitStreamingMethod_getLogStream<WithStreamedUnaryMethod_getProgressInfo<WithStreamedUnaryMethod_getWorkflowEvent<WithStreamedUnaryMethod_stopRunningWorkflow<WithSplitStreamingMethod_followProgressInfo<WithSplitStreamingMethod_followWorkflowEvents<WithSplitStreamingMethod_followLogStream<Service > > > > > > > > StreamedService;
 };
 
 }  // namespace SmartPeakServer
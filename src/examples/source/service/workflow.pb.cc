@@ -214,7 +214,7 @@ const char descriptor_table_protodef_workflow_2eproto[] PROTOBUF_SECTION_VARIABL
   "#\n\014ProgressInfo\022\023\n\013status_code\030\001 \001(\t\"a\n\r"
   "WorkflowEvent\022\022\n\nevent_name\030\001 \001(\t\022\023\n\013eve"
   "nt_index\030\002 \001(\003\022\021\n\titem_name\030\003 \001(\t\022\024\n\014com"
-  "mand_list\030\004 \003(\t2\270\003\n\010Workflow\022U\n\013runWorkf"
+  "mand_list\030\004 \003(\t2\310\005\n\010Workflow\022U\n\013runWorkf"
   "low\022#.SmartPeakServer.WorkflowParameters"
   "\032\037.SmartPeakServer.WorkflowResult\"\000\022L\n\014g"
   "etLogStream\022\034.SmartPeakServer.InquireLog"
@@ -225,11 +225,18 @@ const char descriptor_table_protodef_workflow_2eproto[] PROTOBUF_SECTION_VARIABL
   ".WorkflowParameters\032\036.SmartPeakServer.Wo"
   "rkflowEvent\"\000\022S\n\023stopRunningWorkflow\022\034.S"
   "martPeakServer.Interrupter\032\034.SmartPeakSe"
-  "rver.Interrupter\"\000b\006proto3"
+  "rver.Interrupter\"\000\022\\\n\022followProgressInfo"
+  "\022#.SmartPeakServer.WorkflowParameters\032\035."
+  "SmartPeakServer.ProgressInfo\"\0000\001\022_\n\024foll"
+  "owWorkflowEvents\022#.SmartPeakServer.Workf"
+  "lowParameters\032\036.SmartPeakServer.Workflow"
+  "Event\"\0000\001\022O\n\017followLogStream\022\034.SmartPeak"
+  "Server.InquireLogs\032\032.SmartPeakServer.Log"
+  "Stream\"\0000\001b\006proto3"
   ;
 static ::PROTOBUF_NAMESPACE_ID::internal::once_flag descriptor_table_workflow_2eproto_once;
 const ::PROTOBUF_NAMESPACE_ID::internal::DescriptorTable descriptor_table_workflow_2eproto = {
-  false, false, 1226, descriptor_table_protodef_workflow_2eproto, "workflow.proto", 
+  false, false, 1498, descriptor_table_protodef_workflow_2eproto, "workflow.proto", 
   &descriptor_table_workflow_2eproto_once, nullptr, 0, 7,
   schemas, file_default_instances, TableStruct_workflow_2eproto::offsets,
   file_level_metadata_workflow_2eproto, file_level_enum_descriptors_workflow_2eproto, file_level_service_descriptors_workflow_2eproto,
@@ -0,0 +1,141 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/ANALYSIS/ID/AccurateMassSearchEngine.h>
+
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace SmartPeak
+{
+  /**
+    An initialised accurate mass search engine shared by the injections and worker threads.
+
+    AccurateMassSearchEngine::run updates the engine's internal state,
+    hence the runs on the same engine are serialized.
+  */
+  class SharedAccurateMassSearchEngine
+  {
+  public:
+    /**
+      @param[in] parameters parameters of the AccurateMassSearchEngine
+      @throw std::exception if the engine could not be initialised
+    */
+    explicit SharedAccurateMassSearchEngine(const OpenMS::Param& parameters);
+
+    SharedAccurateMassSearchEngine(const SharedAccurateMassSearchEngine&) = delete;
+    SharedAccurateMassSearchEngine& operator=(const SharedAccurateMassSearchEngine&) = delete;
+
+    /**
+      @brief search the features, waiting for the runs of the other users of the engine
+
+      @param[in,out] features the features, annotated with the hits
+      @param[out] mztab_out the hits
+    */
+    void run(OpenMS::FeatureMap& features, OpenMS::MzTab& mztab_out);
+
+    /**
+      @brief parameters the engine was initialised with
+    */
+    const OpenMS::Param& getParameters() const;
+
+  protected:
+    std::mutex mutex_;
+    OpenMS::AccurateMassSearchEngine engine_;
+  };
+
+  /**
+    Process-wide registry of initialised accurate mass search engines.
+
+    Initialising an AccurateMassSearchEngine parses its mapping, struct and adducts files.
+    The registry does it once per distinct configuration, i.e. engine parameters and
+    modification time and size of the database files, and shares the engine
+    with all the injections and worker threads.
+    The most recently used configurations are kept, up to a maximum number.
+  */
+  class AccurateMassSearchEngineRegistry
+  {
+  public:
+    /**
+      @param[in] max_engines maximum number of engines kept
+    */
+    explicit AccurateMassSearchEngineRegistry(size_t max_engines = default_max_engines);
+
+    AccurateMassSearchEngineRegistry(const AccurateMassSearchEngineRegistry&) = delete;
+    AccurateMassSearchEngineRegistry& operator=(const AccurateMassSearchEngineRegistry&) = delete;
+
+    /**
+      @brief the process-wide registry
+    */
+    static AccurateMassSearchEngineRegistry& instance();
+
+    /**
+      @brief get an initialised engine for the given parameters
+
+      Concurrent requests for the same configuration wait for a single initialisation.
+
+      @param[in] parameters parameters of the AccurateMassSearchEngine
+      @throw std::exception if the engine could not be initialised
+    */
+    std::shared_ptr<SharedAccurateMassSearchEngine> getEngine(const OpenMS::Param& parameters);
+
+    /**
+      @brief number of engines kept
+    */
+    size_t size() const;
+
+    /**
+      @brief release all the engines
+    */
+    void clear();
+
+    static constexpr size_t default_max_engines = 4;
+
+  protected:
+    struct Entry
+    {
+      std::shared_future<std::shared_ptr<SharedAccurateMassSearchEngine>> engine;
+      std::list<std::string>::iterator lru_position;
+      size_t init_id = 0; ///< identifies the initialisation that fills the entry
+    };
+
+    /**
+      @brief the configuration key: all the parameters, and the state of the database files
+    */
+    static std::string makeKey(const OpenMS::Param& parameters);
+    void erase(std::map<std::string, Entry>::iterator entry);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Entry> entries_;
+    std::list<std::string> lru_; ///< most recently used first
+    size_t max_engines_;
+    size_t next_init_id_ = 0;
+  };
+}
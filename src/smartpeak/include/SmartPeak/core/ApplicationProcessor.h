@@ -71,7 +71,8 @@ namespace SmartPeak
       IApplicationProcessorObserver* application_processor_observer = nullptr,
       ISequenceProcessorObserver* sequence_processor_observer = nullptr,
       ISequenceSegmentProcessorObserver* sequence_segment_processor_observer = nullptr,
-      ISampleGroupProcessorObserver* sample_group_processor_observer = nullptr);
+      ISampleGroupProcessorObserver* sample_group_processor_observer = nullptr,
+      const CancellationToken& token = CancellationToken());
   }
 
 }
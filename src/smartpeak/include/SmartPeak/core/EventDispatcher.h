@@ -37,9 +37,14 @@
 #include <SmartPeak/core/TransitionsObservable.h>
 #include <SmartPeak/iface/IFeaturesObserver.h>
 #include <SmartPeak/core/FeaturesObservable.h>
+#include <SmartPeak/core/MPSCRingBuffer.h>
 
 #include <plog/Log.h>
-#include <future>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <thread>
 #include <string>
 #include <vector>
@@ -49,6 +54,16 @@ namespace SmartPeak
 
   /**
     The EventDispatcher can be used to store and dispatch Observer events to another thread.
+
+    Events are stored as plain records in a bounded lock-free ring, filled by the worker
+    threads and drained by the thread calling dispatchEvents. When the ring is full, the
+    workers wait for it to be drained; the dispatcher thread drains it itself.
+
+    If nothing drains the ring for longer than max_queue_wait_, the workers stop waiting
+    until the next dispatch: the progress events (command, sample, segment and group
+    start and end) are dropped and counted, the updates of the sequence, transitions and
+    features are coalesced, and the other events (start and end of the processors and
+    errors) are kept in an unbounded overflow list. They are all dispatched in order.
   */
   struct EventDispatcher : public
     IApplicationProcessorObserver,
@@ -66,7 +81,12 @@ namespace SmartPeak
     TransitionsObservable,
     FeaturesObservable
   {
-    EventDispatcher() = default;
+    /**
+      @param[in] capacity maximum number of events waiting to be dispatched in the ring
+      @param[in] max_queue_wait time after which the workers stop waiting for the ring to be drained
+    */
+    explicit EventDispatcher(size_t capacity = 4096,
+                             std::chrono::milliseconds max_queue_wait = std::chrono::milliseconds(1000));
 
     /**
       IApplicationProcessorObserver
@@ -122,14 +142,82 @@ namespace SmartPeak
   public:
     /**
       @brief Send stored events to the dispatcher's observers.
+
+      Only the events stored before the call are sent, the observers are called on the calling thread.
     */
     void dispatchEvents();
 
+    /**
+      @brief Blocks until events are stored or the timeout expires.
+
+      @returns true if events are waiting to be dispatched
+    */
+    bool waitForEvents(std::chrono::milliseconds timeout);
+
+    /**
+      @brief Number of progress events dropped because the events were not dispatched in time.
+    */
+    size_t getNbDroppedEvents() const { return nb_dropped_events_.load(); }
+
   private:
-    void queueEvent(std::shared_ptr<std::future<void>> event);
+    struct Event
+    {
+      enum class Type
+      {
+        ApplicationProcessorStart,
+        ApplicationProcessorCommandStart,
+        ApplicationProcessorCommandEnd,
+        ApplicationProcessorEnd,
+        ApplicationProcessorError,
+        FeaturesUpdated,
+        SequenceProcessorStart,
+        SequenceProcessorSampleStart,
+        SequenceProcessorSampleEnd,
+        SequenceProcessorEnd,
+        SequenceProcessorError,
+        SequenceSegmentProcessorStart,
+        SequenceSegmentProcessorSampleStart,
+        SequenceSegmentProcessorSampleEnd,
+        SequenceSegmentProcessorEnd,
+        SequenceSegmentProcessorError,
+        SampleGroupProcessorStart,
+        SampleGroupProcessorSampleStart,
+        SampleGroupProcessorSampleEnd,
+        SampleGroupProcessorEnd,
+        SampleGroupProcessorError,
+        SequenceUpdated,
+        TransitionsUpdated
+      };
+      Type type = Type::SequenceUpdated;
+      size_t index = 0; ///< command index, number of injections, segments or groups
+      std::string name; ///< command, sample, segment or group name
+      std::string processor_name;
+      std::string error;
+      std::vector<std::string> commands;
+    };
+
+    void queueEvent(Event::Type type, size_t index = 0, const std::string& name = "",
+                    const std::string& processor_name = "", const std::string& error = "");
+    void queueEvent(Event& event);
+    void deferEvent(Event& event);
+    void dispatchEvent(const Event& event);
+    void notifyWaitingThreads();
+    static bool isProgressEvent(Event::Type type);
+    static bool isUpdateEvent(Event::Type type);
 
   private:
-    std::mutex event_queue_mutex_;
-    std::vector<std::shared_ptr<std::future<void>>> events_;
+    MPSCRingBuffer<Event> events_;
+    std::recursive_mutex dispatch_mutex_; // observers may emit events while being dispatched
+    std::atomic<std::thread::id> dispatcher_thread_;
+    std::atomic_bool dispatcher_stalled_ { false }; // true if the events have not been dispatched for max_queue_wait_
+    std::atomic<size_t> nb_dropped_events_ { 0 };
+    const std::chrono::milliseconds max_queue_wait_;
+    std::mutex overflow_mutex_;
+    std::deque<Event> overflow_events_; // events deferred while the ring was not drained, guarded by overflow_mutex_
+    std::vector<Event::Type> overflow_updates_; // update events in overflow_events_, guarded by overflow_mutex_
+    std::atomic_bool has_overflow_events_ { false };
+    std::mutex wait_mutex_;
+    std::condition_variable events_cv_;
+    std::atomic<size_t> nb_waiting_threads_ { 0 }; // the workers only lock wait_mutex_ if a thread waits for the events
   };
 }
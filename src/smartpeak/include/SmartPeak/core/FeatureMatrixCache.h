@@ -0,0 +1,127 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <SmartPeak/core/SampleType.h>
+#include <unsupported/Eigen/CXX11/Tensor>
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace SmartPeak
+{
+  class InjectionHandler;
+  class SequenceHandler;
+
+  /**
+    Cache of the feature values used by the feature matrix and the heatmap.
+
+    The values of a meta value are extracted from the feature history of an
+    injection on the first request only, and kept as (row id, value) cells where
+    the row ids are interned (component group, component, meta value) triplets.
+    A change of the selection of the samples, transitions or meta values then only
+    filters the cached cells to add or remove rows and columns of the matrix.
+
+    The cached values are dropped when the features are updated, see setGeneration.
+  */
+  class FeatureMatrixCache
+  {
+  public:
+    /**
+      @brief drop the cached values if the features have changed since they were extracted
+
+      @param[in] features_generation generation of the features, changes each time the features may have been updated
+    */
+    void setGeneration(uint64_t features_generation);
+
+    /**
+      @brief drop all the cached values
+    */
+    void clear();
+
+    /**
+      @brief make the data matrix of the selected meta values, see SequenceParser::makeDataMatrixFromMetaValue
+
+      @param[in] sequenceHandler the sequence
+      @param[out] data_out the matrix of values, one row per (component, component group, meta value) and one column per sample
+      @param[out] columns_out the sample names, sorted
+      @param[out] rows_out the component name, component group name and meta value name of each row
+      @param[in] meta_data the meta values
+      @param[in] sample_types the sample types to include
+      @param[in] sample_names the samples to include, all if empty
+      @param[in] component_group_names the component groups to include, all if empty
+      @param[in] component_names the components to include, all if empty
+    */
+    void makeDataMatrix(
+      const SequenceHandler& sequenceHandler,
+      Eigen::Tensor<float, 2>& data_out,
+      Eigen::Tensor<std::string, 1>& columns_out,
+      Eigen::Tensor<std::string, 2>& rows_out,
+      const std::vector<std::string>& meta_data,
+      const std::set<SampleType>& sample_types,
+      const std::set<std::string>& sample_names,
+      const std::set<std::string>& component_group_names,
+      const std::set<std::string>& component_names
+    );
+
+    /**
+      @brief number of (injection, meta value) pairs extracted from the features since the last clear
+    */
+    size_t getNExtractions() const { return n_extractions_; }
+
+  private:
+    struct RowInfo
+    {
+      std::string component_group_name;
+      std::string component_name;
+      std::string meta_value_name;
+      bool is_subordinate = false;
+    };
+
+    struct Cell
+    {
+      uint32_t row;
+      float value;
+    };
+
+    const std::vector<Cell>& getCells(const InjectionHandler& injection, const std::string& meta_value_name);
+    uint32_t internRow(const std::string& component_group_name, const std::string& component_name,
+                       const std::string& meta_value_name, bool is_subordinate);
+    static uint32_t intern(std::map<std::string, uint32_t>& ids, const std::string& name);
+
+    std::map<std::string, uint32_t> row_ids_; ///< ordered as the rows of the matrix
+    std::vector<RowInfo> rows_;
+    std::map<std::string, uint32_t> injection_ids_;
+    std::map<std::string, uint32_t> meta_value_ids_;
+    std::unordered_map<uint64_t, std::vector<Cell>> cells_; ///< keyed by (injection id, meta value id)
+    uint64_t generation_ = 0;
+    size_t n_extractions_ = 0;
+  };
+}
@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SmartPeak
+{
+  /**
+    Typed, column major table of features.
+
+    Numeric columns keep their values as integers or floats, and the strings of text
+    columns are interned in a pool shared by all the columns, so that the many repeated
+    values of a feature table (sample names, component names...) are stored once.
+    Cells are formatted as text only when displayed or exported, with the same
+    representation as the previous string tables.
+
+    The table is filled row by row: one value is appended to each column per row.
+    A column takes the type of its first value. If a later value has another type,
+    the column falls back to text.
+  */
+  class FeatureTable
+  {
+  public:
+    enum class ColumnType
+    {
+      Text,
+      Integer,
+      Real ///< formatted with std::to_string, missing values are empty
+    };
+
+    using StringId = uint32_t;
+
+    /**
+      @brief add a column, before any row is added
+
+      @param[in] header the name of the column
+      @returns the index of the column
+    */
+    size_t addColumn(const std::string& header);
+
+    /**
+      @brief reserve the memory of the given number of rows in each column
+    */
+    void reserve(size_t n_rows);
+
+    /**
+      @brief intern a string, to append it to text columns by id
+    */
+    StringId intern(const std::string& text);
+
+    void appendText(size_t col, const std::string& text);
+    void appendText(size_t col, StringId id);
+    void appendInteger(size_t col, int64_t value);
+    void appendReal(size_t col, float value);
+    void appendEmpty(size_t col); ///< missing value
+
+    size_t getNRows() const; ///< number of complete rows
+    size_t getNColumns() const { return columns_.size(); };
+    const std::vector<std::string>& getHeaders() const { return headers_; };
+    ColumnType getColumnType(size_t col) const { return columns_.at(col).type; };
+
+    /**
+      @brief the text representation of a cell, as displayed or exported
+    */
+    std::string getText(size_t row, size_t col) const;
+
+    /**
+      @brief the value of a numeric cell, NaN for text and missing values
+    */
+    double getNumber(size_t row, size_t col) const;
+
+    /**
+      @brief the text representation of a row
+    */
+    void getRow(size_t row, std::vector<std::string>& row_out) const;
+
+    /**
+      @brief the text representation of the whole table (row major)
+    */
+    std::vector<std::vector<std::string>> toRows() const;
+
+    void clear();
+
+  protected:
+    struct Column
+    {
+      ColumnType type = ColumnType::Real;
+      bool typed = false;            ///< false until the first value is appended
+      std::vector<StringId> texts;   ///< Text columns
+      std::vector<int64_t> integers; ///< Integer columns
+      std::vector<float> reals;      ///< Real columns, NaN when missing
+      size_t size() const;
+    };
+
+    Column& appendable(size_t col, ColumnType type);
+    void reserveColumn(Column& column) const;
+    void convertToText(Column& column);
+    std::string format(const Column& column, size_t row) const;
+
+    std::vector<std::string> headers_;
+    std::vector<Column> columns_;
+    size_t reserved_rows_ = 0;
+    std::deque<std::string> strings_; ///< stable storage of the interned strings
+    std::unordered_map<std::string_view, StringId> string_ids_;
+  };
+}
@@ -0,0 +1,148 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace SmartPeak
+{
+  /**
+    Bounded lock-free multi-producer/single-consumer ring buffer.
+
+    Each slot carries a sequence number telling whether it is free for the producer
+    of a given position or published for the consumer, so that producers only contend
+    on the reservation of a position and the consumer never takes a lock.
+    Elements are popped in the order their positions were reserved: the pushes of a
+    given thread are popped in the order they were made.
+
+    Only one thread at a time may pop.
+  */
+  template<typename T>
+  class MPSCRingBuffer
+  {
+  public:
+    /**
+      @param[in] capacity maximum number of elements, rounded up to a power of 2
+    */
+    explicit MPSCRingBuffer(size_t capacity = 1024)
+    {
+      size_t rounded_capacity = 2;
+      while (rounded_capacity < capacity) rounded_capacity <<= 1;
+      mask_ = rounded_capacity - 1;
+      slots_ = std::make_unique<Slot[]>(rounded_capacity);
+      for (size_t i = 0; i < rounded_capacity; ++i)
+      {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    MPSCRingBuffer(const MPSCRingBuffer&) = delete;
+    MPSCRingBuffer& operator=(const MPSCRingBuffer&) = delete;
+
+    /**
+      @brief push an element, from any thread
+
+      @param[in,out] value the element, moved from only if it was pushed
+      @return false if the buffer is full
+    */
+    bool tryPush(T& value)
+    {
+      size_t position = enqueue_position_.load(std::memory_order_relaxed);
+      Slot* slot;
+      for (;;)
+      {
+        slot = &slots_[position & mask_];
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::make_signed_t<size_t>>(sequence - position);
+        if (difference == 0)
+        {
+          if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+          {
+            break;
+          }
+        }
+        else if (difference < 0)
+        {
+          return false; // the consumer has not freed this slot yet
+        }
+        else
+        {
+          position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+      }
+      slot->value = std::move(value);
+      slot->sequence.store(position + 1, std::memory_order_release);
+      return true;
+    }
+
+    /**
+      @brief pop the oldest element, from the consumer thread only
+
+      @param[out] value the element
+      @return false if the buffer is empty or the oldest element is still being pushed
+    */
+    bool tryPop(T& value)
+    {
+      const size_t position = dequeue_position_.load(std::memory_order_relaxed);
+      Slot& slot = slots_[position & mask_];
+      const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+      if (static_cast<std::make_signed_t<size_t>>(sequence - (position + 1)) < 0)
+      {
+        return false;
+      }
+      value = std::move(slot.value);
+      slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+      dequeue_position_.store(position + 1, std::memory_order_relaxed);
+      return true;
+    }
+
+    /**
+      @brief number of elements reserved and not popped yet, approximate while pushing or popping
+    */
+    size_t size() const
+    {
+      const size_t dequeue_position = dequeue_position_.load(std::memory_order_relaxed);
+      const size_t enqueue_position = enqueue_position_.load(std::memory_order_relaxed);
+      return enqueue_position > dequeue_position ? enqueue_position - dequeue_position : 0;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+  private:
+    struct Slot
+    {
+      std::atomic<size_t> sequence { 0 };
+      T value {};
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueue_position_ { 0 };
+    alignas(64) std::atomic<size_t> dequeue_position_ { 0 };
+  };
+}
@@ -0,0 +1,110 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <SmartPeak/core/Parameters.h>
+#include <SmartPeak/iface/IProcessorDescription.h>
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+
+namespace SmartPeak
+{
+  /**
+    Process-wide cache of the parameter schemas of the processors.
+
+    The schema of a processor type is built once, often by constructing the underlying
+    OpenMS algorithms, and shared read-only by all the injections and worker threads.
+    The user parameters completed with the schema are resolved once as well, and
+    resolved again only when the user parameters change, i.e. in practice once per
+    workflow run for each processor type.
+  */
+  class ParameterSchemaCache
+  {
+  public:
+    ParameterSchemaCache() = default;
+
+    ParameterSchemaCache(const ParameterSchemaCache&) = delete;
+    ParameterSchemaCache& operator=(const ParameterSchemaCache&) = delete;
+
+    /**
+      @brief the process-wide cache
+    */
+    static ParameterSchemaCache& instance();
+
+    /**
+      @brief get the schema of a processor, building it on the first request for its type
+
+      Concurrent requests for the same processor type wait for a single build.
+
+      @param[in] processor the processor
+      @throw std::exception if the schema could not be built
+    */
+    std::shared_ptr<const ParameterSet> getSchema(const IProcessorDescription& processor);
+
+    /**
+      @brief get the user parameters completed with the schema of a processor
+
+      Same as merging the schema into a copy of the user parameters, without rebuilding
+      the schema or merging again as long as the user parameters are unchanged.
+
+      @param[in] processor the processor
+      @param[in] user_parameters the user parameters
+      @throw std::exception if the schema could not be built
+    */
+    std::shared_ptr<const ParameterSet> getParameters(const IProcessorDescription& processor, const ParameterSet& user_parameters);
+
+    /**
+      @brief number of cached schemas
+    */
+    size_t size() const;
+
+    /**
+      @brief remove all the schemas and resolved parameters from the cache
+    */
+    void clear();
+
+  protected:
+    struct Resolved
+    {
+      ParameterSet user_parameters;
+      ParameterSet parameters; ///< user_parameters completed with the schema
+    };
+
+    struct Entry
+    {
+      std::shared_future<std::shared_ptr<const ParameterSet>> schema;
+      size_t build_id = 0; ///< identifies the build that fills the entry
+      std::shared_ptr<const Resolved> resolved; ///< last resolved user parameters
+    };
+
+    mutable std::mutex mutex_;
+    std::map<std::type_index, Entry> entries_;
+    size_t next_build_id_ = 0;
+  };
+}
@@ -137,6 +137,7 @@ public:
     const OpenMS::FeatureMap& getFeatureMapHistory() const;
 
     void setExperiment(const OpenMS::MSExperiment& experiment);
+    void setExperiment(OpenMS::MSExperiment&& experiment);
     OpenMS::MSExperiment& getExperiment();
     const OpenMS::MSExperiment& getExperiment() const;
 
@@ -170,6 +171,9 @@ public:
       All new features are initialized as "used_" = True with the "modified_" attribute set to the current time-stamp.
       All removed features are changed to "used_" = False with the "modified_" attribute set to the current time-stamp.
 
+      Features are matched by unique ID and subordinates by "native_id" through hash
+      indices, so that the update is linear in the number of features.
+
       ASSUMPTIONS: the unique ID attribute is set within OpenMS
     */
     void updateFeatureMapHistory();
@@ -24,6 +24,8 @@
 #pragma once
 
 #include <SmartPeak/core/RawDataProcessor.h>
+#include <OpenMS/MATH/MISC/EmgGradientDescent.h>
+#include <OpenMS/DATASTRUCTURES/ConvexHull2D.h>
 
 #include <map>
 #include <vector>
@@ -44,6 +46,9 @@ namespace SmartPeak
     virtual std::set<std::string> getInputs() const override;
 
     /** Apply the EMG peak reconstruction technique to the data points.
+
+      The subordinates are fitted concurrently on the shared ThreadPool,
+      the feature map is then updated in its original order.
     */
     void doProcess(
       RawDataHandler& rawDataHandler_IO,
@@ -52,6 +57,28 @@ namespace SmartPeak
     ) const override;
 
   private:
+    /** Input and result of the fit of a single subordinate
+    */
+    struct EmgFit
+    {
+      OpenMS::Feature* subfeature = nullptr;
+      const OpenMS::MSChromatogram* chromatogram = nullptr;
+      double left = 0.0;
+      double right = 0.0;
+      size_t n_points = 0;
+      OpenMS::ConvexHull2D hull;
+      double peak_integral = 0.0;
+      double peak_apex_position = 0.0;
+      double peak_apex_int = 0.0;
+      double area_background_level = 0.0;
+      double noise_background_level = 0.0;
+    };
+
+    void fitSubordinate(
+      OpenMS::EmgGradientDescent& emg,
+      EmgFit& fit
+    ) const;
+
     void extractPointsIntoVectors(
       const OpenMS::MSChromatogram& chromatogram,
       const double left,
@@ -25,6 +25,12 @@
 
 #include <SmartPeak/core/SampleGroupProcessor.h>
 
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
 namespace SmartPeak
 {
 
@@ -53,11 +59,51 @@ namespace SmartPeak
     typedef std::tuple<std::string, std::pair<float, float>, float> mergeKeyType;
     typedef std::pair<std::string, std::string> componentKeyType;
 
-    static bool selectDilutions(
+    enum class MergeRule { Sum, Min, Max, Mean, WeightedMean };
+
+    /**
+      Merge of a list of injection sets into their union, based on one feature.
+
+      Features and injection sets are interned: they are referred to by their index.
+    */
+    struct MergeStep
+    {
+      size_t feature = 0; ///< feature the merge is based on
+      MergeRule rule = MergeRule::Sum;
+      std::vector<size_t> injection_sets; ///< injection sets to merge, in order
+      size_t merged_injection_set = 0; ///< union of the injection sets
+      std::vector<size_t> removed_injection_sets; ///< single injection sets replaced by the union, if it holds more than one injection
+    };
+
+    /**
+      Values of the features of one component, stored column-wise:
+      one row of injection sets per feature.
+    */
+    struct ComponentTable
+    {
+      ComponentTable(size_t n_features, size_t n_injection_sets);
+
+      float& value(size_t feature, size_t injection_set) { return values[feature * n_injection_sets + injection_set]; }
+      bool isSet(size_t feature, size_t injection_set) const { return is_set[feature * n_injection_sets + injection_set]; }
+      void set(size_t feature, size_t injection_set, float v);
+      void erase(size_t feature, size_t injection_set) { is_set[feature * n_injection_sets + injection_set] = 0; }
+      void clear();
+
+      size_t n_features;
+      size_t n_injection_sets;
+      std::vector<float> values;
+      std::vector<char> is_set;
+    };
+
+    /// (single injection set, feature, value) as read from the injections
+    typedef std::tuple<size_t, size_t, float> injectionValueType;
+
+    static MergeRule parseMergeRule(const std::string& merge_rule);
+
+    static bool readPreferredDilutions(
       const ParameterSet& params,
       const Filenames& filenames_I,
-      const SequenceHandler& sequenceHandler_I,
-      std::map<componentKeyType, std::map<std::string, std::map<std::set<std::string>, float>>>& component_to_feature_to_injection_to_values);
+      std::map<std::string, int>& select_dilution_map);
 
     static void getMergeKeysToInjections(const SampleGroupHandler& sampleGroupHandler_IO,
       const SequenceHandler& sequenceHandler_I, 
@@ -71,21 +117,33 @@ namespace SmartPeak
       const std::set<float>& dilution_factors,
       std::map<mergeKeyType, std::vector<std::set<std::string>>>& merge_keys_to_injection_name);
 
-    static void getComponentsToFeaturesToInjectionsToValues(const SampleGroupHandler& sampleGroupHandler_IO,
-      const SequenceHandler& sequenceHandler_I,
-      const bool& merge_subordinates,
-      std::map<componentKeyType, std::map<std::string, std::map<std::set<std::string>, float>>>& component_to_feature_to_injection_to_values);
-
-    static void mergeComponentsToFeaturesToInjectionsToValues(const std::string& feature_name, const std::string& merge_rule,
+    static void addMergeSteps(const std::string& feature_name,
+      const MergeRule rule,
       const std::set<std::string>& scan_polarities,
       const std::set<std::pair<float, float>>& scan_mass_ranges,
       const std::set<float>& dilution_factors,
       const std::map<mergeKeyType, std::vector<std::set<std::string>>>& merge_keys_to_injection_name,
-      std::map<componentKeyType, std::map<std::string, std::map<std::set<std::string>, float>>>& component_to_feature_to_injection_to_values);
+      const std::vector<std::string>& feature_names,
+      std::map<std::set<std::string>, size_t>& injection_set_indices,
+      std::vector<MergeStep>& merge_steps);
+
+    static void getComponentsToInjectionValues(const SampleGroupHandler& sampleGroupHandler_IO,
+      const SequenceHandler& sequenceHandler_I,
+      const bool& merge_subordinates,
+      const std::vector<std::string>& feature_names,
+      std::map<std::set<std::string>, size_t>& injection_set_indices,
+      std::map<componentKeyType, std::vector<injectionValueType>>& component_to_injection_values);
+
+    static void mergeComponent(const std::vector<MergeStep>& merge_steps,
+      const std::vector<char>& preferred_injection_sets,
+      ComponentTable& table);
+
+    static void applyMergeStep(const MergeStep& merge_step, ComponentTable& table);
 
     static void makeFeatureMap(const bool& merge_subordinates,
-      std::set<std::string>& injection_names_set,
-      const std::map<componentKeyType, std::map<std::string, std::map<std::set<std::string>, float>>>& component_to_feature_to_injection_to_values,
+      const std::vector<std::string>& feature_names,
+      const std::map<componentKeyType, std::vector<injectionValueType>>& component_to_injection_values,
+      const std::vector<std::vector<std::pair<size_t, float>>>& merged_values,
       OpenMS::FeatureMap& feature_map);
   };
 
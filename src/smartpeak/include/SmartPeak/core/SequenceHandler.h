@@ -73,12 +73,45 @@ public:
       const std::set<std::string>& injection_names
     ) const;
 
+    /**
+      @brief A meta value name resolved by `resolveMetaValue`, to extract the same
+      meta value from many features without comparing or looking up its name again.
+    */
+    struct MetaValueKey
+    {
+      enum class Field { RT, mz, charge, intensity, peak_area, validation, meta_value };
+
+      /// index of the names that are not in the OpenMS meta info registry, thus set on no feature
+      static constexpr OpenMS::UInt unknown_index = OpenMS::UInt(-1);
+
+      std::string name;
+      Field field = Field::meta_value;
+      OpenMS::UInt index = unknown_index; ///< index of the name in the OpenMS meta info registry
+    };
+
+    static MetaValueKey resolveMetaValue(const std::string& meta_value);
+
+    static std::vector<MetaValueKey> resolveMetaValues(const std::vector<std::string>& meta_values);
+
     static CastValue getMetaValue(
       const OpenMS::Feature& feature,
       const OpenMS::Feature& subordinate,
       const std::string& meta_value
     );
 
+    /**
+      @brief Same as `getMetaValue` with a meta value name, for hot loops over features.
+
+      @param[in] feature The feature
+      @param[in] subordinate The subordinate, or the feature itself when it has none
+      @param[in] meta_value The meta value, as returned by `resolveMetaValue`
+    */
+    static CastValue getMetaValue(
+      const OpenMS::Feature& feature,
+      const OpenMS::Feature& subordinate,
+      const MetaValueKey& meta_value
+    );
+
     std::string getRawDataFilesInfo() const;
     std::string getAnalyzedFeaturesInfo() const;
     std::string getSelectedFeaturesInfo() const;
@@ -31,6 +31,7 @@
 #include <SmartPeak/core/SampleGroupProcessorObservable.h>
 #include <SmartPeak/core/SequenceProcessorObservable.h>
 #include <SmartPeak/core/SequenceSegmentProcessorObservable.h>
+#include <SmartPeak/core/ThreadPool.h>
 #include <SmartPeak/iface/IProcessorDescription.h>
 #include <SmartPeak/iface/IFilenamesHandler.h>
 #include <SmartPeak/io/InputDataValidation.h>
@@ -45,6 +46,37 @@
 
 namespace SmartPeak
 {
+  /**
+    Error raised while processing an item (injection, sequence segment or sample group)
+    of a workflow
+  */
+  class WorkflowException : public std::exception
+  {
+  public:
+
+    explicit WorkflowException(const std::string& item, const std::string& processor, const std::string& message)
+      : item_(item), processor_(processor), msg_(message)  {}
+
+    virtual ~WorkflowException() noexcept {}
+
+    virtual const char* what() const noexcept override {
+      return msg_.c_str();
+    }
+
+    virtual const std::string item() const noexcept {
+      return item_;
+    }
+
+    virtual const std::string processor() const noexcept {
+      return processor_;
+    }
+
+  protected:
+    std::string item_;
+    std::string processor_;
+    std::string msg_;
+  };
+
   /**
     Multithreaded execution processor
   */
@@ -52,14 +84,39 @@ namespace SmartPeak
   public:
     /**
       Determine the number of workers available based on the maximum available
-      threads and the desired thread count. 1 thread will always be preserved for
-      the GUI unless the maximum number of available threads couldn't be determined
+      threads and the desired thread count. The workers are tasks of the shared
+      ThreadPool, so the count never exceeds the hardware concurrency.
 
       @param[in] n_threads desired number of threads to use
     */
-    size_t getNumWorkers(unsigned int n_threads) const;
+    static size_t getNumWorkers(unsigned int n_threads);
+
+    /**
+      Submit a number of workers equal to the desired number of threads to the
+      shared ThreadPool and wait for them to process all items
+
+      @note If the API is unable to fetch the required information, only a
+      single worker will be used
+    */
+    void spawn_workers(unsigned int n_threads);
+
+    /**
+      Cancel the processing of the i-th item. An item that has already started
+      stops before its next processing step.
+    */
+    void cancel(size_t i) { cancellation_tokens_.at(i).cancel(); }
+
+    /**
+      Cancel the processing of all the items
+    */
+    void cancelAll() { for (CancellationToken& token : cancellation_tokens_) token.cancel(); }
     
     virtual void run_processing() = 0;
+
+  protected:
+    explicit ProcessorMultithread(size_t n_items) : cancellation_tokens_(n_items) {}
+
+    std::vector<CancellationToken> cancellation_tokens_; ///< one token per item to process
   };
 
   /**
@@ -72,16 +129,7 @@ namespace SmartPeak
       std::map<std::string, Filenames>& filenames,
       const std::vector<std::shared_ptr<RawDataProcessor>>& methods,
       SequenceProcessorObservable* observable = nullptr
-    ) : injections_(injections), filenames_(filenames), methods_(methods), observable_(observable) {}
-
-    /**
-      Spawn a number of workers equal to the number of threads of execution
-      offered by the CPU
-
-      @note If the API is unable to fetch the required information, only a
-      single thread will be used
-    */
-    void spawn_workers(unsigned int n_threads);
+    ) : ProcessorMultithread(injections.size()), injections_(injections), filenames_(filenames), methods_(methods), observable_(observable) {}
 
     /**
       Workers run this function. It implements a loop that runs the following steps:
@@ -89,7 +137,7 @@ namespace SmartPeak
       - process all methods on it
 
       Workers decide on which injection to work according to an index fetched and
-      incremented atomically (i_).
+      incremented atomically (i_). Cancelled injections are skipped.
 
       The loop ends when the worker fetches an index that is out of range.
     */
@@ -114,20 +162,12 @@ namespace SmartPeak
       std::vector<std::shared_ptr<SequenceSegmentProcessor>>& sequence_segment_processing_methods_,
       std::map<std::string, Filenames>& filenames,
       SequenceSegmentProcessorObservable* observable = nullptr
-    ) : sequence_segment_(sequenceSegmentHandler_IO),
+    ) : ProcessorMultithread(sequenceSegmentHandler_IO.size()),
+        sequence_segment_(sequenceSegmentHandler_IO),
         sequenceHandler_IO(sequenceHandler_I),
         sequence_segment_processing_methods_(sequence_segment_processing_methods_),
         filenames_(filenames),
         observable_(observable) {}
-    
-    /**
-      Spawn a number of workers equal to the number of threads of execution
-      offered by the CPU
-
-      @note If the API is unable to fetch the required information, only a
-      single thread will be used
-    */
-    void spawn_workers(unsigned int n_threads);
 
     /**
       Workers run this function. It implements a loop that runs the following steps:
@@ -135,7 +175,7 @@ namespace SmartPeak
       - process all methods on it
 
       Workers decide on which sequence segment to work according to an index fetched and
-      incremented atomically (i_).
+      incremented atomically (i_). Cancelled sequence segments are skipped.
 
       The loop ends when the worker fetches an index that is out of range.
     */
@@ -161,20 +201,12 @@ namespace SmartPeak
       std::vector<std::shared_ptr<SampleGroupProcessor>>& sample_group_processing_methods,
       std::map<std::string, Filenames>& filenames,
       SampleGroupProcessorObservable* observable = nullptr
-    ) : sample_group_(sequenceSegmentHandler_IO),
+    ) : ProcessorMultithread(sequenceSegmentHandler_IO.size()),
+        sample_group_(sequenceSegmentHandler_IO),
         sequenceHandler_IO(sequenceHandler_I),
         sample_group_processing_methods_(sample_group_processing_methods),
         filenames_(filenames),
         observable_(observable) {}
-    
-    /**
-      Spawn a number of workers equal to the number of threads of execution
-      offered by the CPU
-
-      @note If the API is unable to fetch the required information, only a
-      single thread will be used
-    */
-    void spawn_workers(unsigned int n_threads);
 
     /**
       Workers run this function. It implements a loop that runs the following steps:
@@ -182,7 +214,7 @@ namespace SmartPeak
       - process all methods on it
 
       Workers decide on which sequence segment to work according to an index fetched and
-      incremented atomically (i_).
+      incremented atomically (i_). Cancelled sequence segments are skipped.
 
       The loop ends when the worker fetches an index that is out of range.
     */
@@ -203,11 +235,13 @@ namespace SmartPeak
     @param[in,out] injection The injection to process
     @param[in] filenames Used by the methods
     @param[in] methods Methods to process on the injection
+    @param[in] token Checked before each method, the remaining methods are skipped once cancelled
   */
   void processInjection(
     InjectionHandler& injection,
     Filenames& filenames_I,
-    const std::vector<std::shared_ptr<RawDataProcessor>>& methods
+    const std::vector<std::shared_ptr<RawDataProcessor>>& methods,
+    const CancellationToken& token = CancellationToken()
   );
 
   /**
@@ -217,11 +251,13 @@ namespace SmartPeak
     @param[in] SequenceHandler Sequence Segment IO
     @param[in] filenames Used by the methods
     @param[in] methods Methods to process on the sequence segment
+    @param[in] token Checked before each method, the remaining methods are skipped once cancelled
   */
   void processSegment(SequenceSegmentHandler& sequence_segment,
                       SequenceHandler& sequenceHandler_IO,
                       Filenames& filenames,
-                      const std::vector<std::shared_ptr<SequenceSegmentProcessor>>& methods);
+                      const std::vector<std::shared_ptr<SequenceSegmentProcessor>>& methods,
+                      const CancellationToken& token = CancellationToken());
 
   /**
     Apply a processing workflow to a single sample group
@@ -230,11 +266,13 @@ namespace SmartPeak
     @param[in] SequenceHandler Sequence Segment IO
     @param[in] filenames Used by the methods
     @param[in] methods Methods to process on the sample group
+    @param[in] token Checked before each method, the remaining methods are skipped once cancelled
   */
   void processSampleGroup(SampleGroupHandler& sample_group,
                           SequenceHandler& sequenceHandler_IO,
                           Filenames& filenames,
-                          const std::vector<std::shared_ptr<SampleGroupProcessor>>& methods);
+                          const std::vector<std::shared_ptr<SampleGroupProcessor>>& methods,
+                          const CancellationToken& token = CancellationToken());
 
   struct SequenceProcessor : IProcessorDescription, IFilenamesHandler {
     explicit SequenceProcessor(SequenceHandler& sh) : sequenceHandler_IO(&sh) {}
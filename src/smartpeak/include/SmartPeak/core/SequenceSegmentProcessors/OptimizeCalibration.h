@@ -25,6 +25,8 @@
 
 #include <SmartPeak/core/SequenceSegmentProcessor.h>
 
+#include <OpenMS/ANALYSIS/QUANTITATION/AbsoluteQuantitation.h>
+
 namespace SmartPeak
 {
   struct OptimizeCalibration : SequenceSegmentProcessor
@@ -39,6 +41,9 @@ namespace SmartPeak
 
     /**
       Optimize the calibration curve for all components.
+
+      The components are optimized concurrently on the shared ThreadPool,
+      the results are merged back in the order of the quantitation methods.
     */
     void doProcess(
       SequenceSegmentHandler& sequenceSegmentHandler_IO,
@@ -46,6 +51,35 @@ namespace SmartPeak
       const ParameterSet& params_I,
       Filenames& filenames_I
     ) const override;
+
+  private:
+    /** Result of the optimization of a single component
+    */
+    struct ComponentCalibration
+    {
+      bool optimized = false;
+      OpenMS::AbsoluteQuantitationMethod method;
+      std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration> feature_concentrations;
+      std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration> excluded_feature_concentrations;
+      std::string warning;
+    };
+
+    /**
+      @brief optimize the calibration curve of a single component
+
+      @param[in] absoluteQuantitation holds the user parameters, its quantitation methods are replaced
+      @param[in] row the quantitation method of the component
+      @param[in] sequenceSegmentHandler_I provides the concentrations pruning
+      @param[in] feature_concentrations the standards mapped to the features of the component
+      @param[out] calibration the result of the optimization
+    */
+    void optimizeComponent(
+      OpenMS::AbsoluteQuantitation& absoluteQuantitation,
+      const OpenMS::AbsoluteQuantitationMethod& row,
+      const SequenceSegmentHandler& sequenceSegmentHandler_I,
+      const std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration>& feature_concentrations,
+      ComponentCalibration& calibration
+    ) const;
   };
 
 }
@@ -0,0 +1,116 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace SmartPeak
+{
+  /**
+    Multi-resolution pyramid of a plotted series (chromatogram, spectrum).
+
+    Each level keeps, for every bucket of points of the level below it, the
+    minimum and the maximum point in their original order, so peaks keep
+    their apex and their baseline at every level. Level 0 is the full
+    resolution series which is owned by the caller; the pyramid only stores
+    the decimated levels, each one about half the size of the previous one.
+  */
+  class SeriesPyramid
+  {
+  public:
+    /**
+      Contiguous range of points of one level, ready to be plotted.
+    */
+    struct View
+    {
+      const float* x = nullptr;
+      const float* y = nullptr;
+      size_t size = 0;
+      size_t level = 0;
+    };
+
+    SeriesPyramid() = default;
+
+    /**
+      @brief build the decimated levels of a series
+
+      Levels are built until a level has at most `min_points` points. A series
+      whose x values are not sorted is not decimated.
+
+      @param[in] x full resolution x values
+      @param[in] y full resolution y values
+      @param[in] min_points size under which no further level is built
+    */
+    SeriesPyramid(const std::vector<float>& x, const std::vector<float>& y, size_t min_points = 256);
+
+    /**
+      @brief get the finest level having at most `max_points` points in the visible range
+
+      The view includes the points just outside of the range so that lines are drawn up to the
+      plot borders. The coarsest level is returned if none of the levels fits.
+
+      @param[in] x full resolution x values the pyramid has been built from
+      @param[in] y full resolution y values the pyramid has been built from
+      @param[in] x_min lower bound of the visible range
+      @param[in] x_max upper bound of the visible range
+      @param[in] max_points maximum number of points to draw
+    */
+    View getView(const std::vector<float>& x, const std::vector<float>& y,
+                 double x_min, double x_max, size_t max_points) const;
+
+    /**
+      @brief number of levels, including the full resolution one
+    */
+    size_t getNLevels() const { return x_levels_.size() + 1; }
+
+    /**
+      @brief number of points of the full resolution series
+    */
+    size_t getNPoints() const { return n_points_; }
+
+    /**
+      @brief min-max decimation of a series
+
+      The points are split in `n_buckets` buckets of consecutive points. For each bucket
+      the minimum and the maximum y are kept, in their original order.
+
+      @param[in] x x values
+      @param[in] y y values
+      @param[in] n number of points
+      @param[in] n_buckets number of buckets, the output has at most 2 * n_buckets points
+      @param[out] x_out decimated x values
+      @param[out] y_out decimated y values
+    */
+    static void decimateMinMax(const float* x, const float* y, size_t n, size_t n_buckets,
+                               std::vector<float>& x_out, std::vector<float>& y_out);
+
+  private:
+    std::vector<std::vector<float>> x_levels_; ///< levels 1..n, level 0 is owned by the caller
+    std::vector<std::vector<float>> y_levels_;
+    bool sorted_ = true;
+    size_t n_points_ = 0;
+  };
+}
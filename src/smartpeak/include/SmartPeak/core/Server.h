@@ -47,7 +47,11 @@
 #include <sqlite3.h>
 
 #include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <optional>
 #include <algorithm>
 #include <vector>
 #include <memory>
@@ -59,6 +63,14 @@
 namespace SmartPeak {
   namespace serv {
   
+    /**
+      Keeps the workflow events until they are requested by the clients.
+
+      The events are received on the thread dispatching the EventDispatcher events, the
+      thread running the request, and read by the gRPC threads, which can wait for them. At most max_events_ events are kept, the oldest ones
+      are dropped first. Reading does not remove the events: each reader keeps its own
+      cursor, popEvent() reads with a default one.
+    */
     struct SeverEventDispatcherObserver :
       IApplicationProcessorObserver,
       ISequenceProcessorObserver,
@@ -72,92 +84,92 @@ namespace SmartPeak {
       */
       virtual void onApplicationProcessorStart(const std::vector<std::string>& commands) override
       {
-        events_.push_back(std::make_tuple("onApplicationProcessorStart", 0, "", commands));
+        pushEvent(std::make_tuple("onApplicationProcessorStart", 0, "", commands));
       }
       virtual void onApplicationProcessorCommandStart(size_t command_index, const std::string& command_name) override
       {
-        events_.push_back(std::make_tuple("onApplicationProcessorCommandStart", command_index, command_name, std::vector<std::string>()));
+        pushEvent(std::make_tuple("onApplicationProcessorCommandStart", command_index, command_name, std::vector<std::string>()));
       }
       virtual void onApplicationProcessorCommandEnd(size_t command_index, const std::string& command_name) override
       {
-        events_.push_back(std::make_tuple("onApplicationProcessorCommandEnd", command_index, command_name, std::vector<std::string>()));
+        pushEvent(std::make_tuple("onApplicationProcessorCommandEnd", command_index, command_name, std::vector<std::string>()));
       }
       virtual void onApplicationProcessorEnd() override
       {
-        events_.push_back(std::make_tuple("onApplicationProcessorEnd", 0, "", std::vector<std::string>()));
+        pushEvent(std::make_tuple("onApplicationProcessorEnd", 0, "", std::vector<std::string>()));
       }
       virtual void onApplicationProcessorError(const std::string& error) override
       {
-        events_.push_back(std::make_tuple("onApplicationProcessorError", 0, "", std::vector<std::string>({ error })));
+        pushEvent(std::make_tuple("onApplicationProcessorError", 0, "", std::vector<std::string>({ error })));
       }
       /**
         ISequenceProcessorObserver
       */
       virtual void onSequenceProcessorStart(const size_t nb_injections) override
       {
-        events_.push_back(std::make_tuple("onSequenceProcessorStart", nb_injections, "", std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSequenceProcessorStart", nb_injections, "", std::vector<std::string>()));
       }
       virtual void onSequenceProcessorSampleStart(const std::string& sample_name) override
       {
-        events_.push_back(std::make_tuple("onSequenceProcessorSampleStart", 0, sample_name, std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSequenceProcessorSampleStart", 0, sample_name, std::vector<std::string>()));
       }
       virtual void onSequenceProcessorSampleEnd(const std::string& sample_name) override
       {
-        events_.push_back(std::make_tuple("onSequenceProcessorSampleEnd", 0, sample_name, std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSequenceProcessorSampleEnd", 0, sample_name, std::vector<std::string>()));
       }
       virtual void onSequenceProcessorEnd() override
       {
-        events_.push_back(std::make_tuple("onSequenceProcessorEnd", 0, "", std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSequenceProcessorEnd", 0, "", std::vector<std::string>()));
       }
       virtual void onSequenceProcessorError(const std::string& sample_name, const std::string& processor_name, const std::string& error) override
       {
-        events_.push_back(std::make_tuple("onSequenceProcessorError", 0, sample_name, std::vector<std::string>({ processor_name , error })));
+        pushEvent(std::make_tuple("onSequenceProcessorError", 0, sample_name, std::vector<std::string>({ processor_name , error })));
       }
       /**
         ISequenceSegmentProcessorObserver
       */
       virtual void onSequenceSegmentProcessorStart(const size_t nb_segments) override
       {
-        events_.push_back(std::make_tuple("onSequenceSegmentProcessorStart", nb_segments, "", std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSequenceSegmentProcessorStart", nb_segments, "", std::vector<std::string>()));
       }
       virtual void onSequenceSegmentProcessorSampleStart(const std::string& segment_name) override
       {
-        events_.push_back(std::make_tuple("onSequenceSegmentProcessorSampleStart", 0, segment_name, std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSequenceSegmentProcessorSampleStart", 0, segment_name, std::vector<std::string>()));
       }
       virtual void onSequenceSegmentProcessorSampleEnd(const std::string& segment_name) override
       {
-        events_.push_back(std::make_tuple("onSequenceSegmentProcessorSampleEnd", 0, segment_name, std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSequenceSegmentProcessorSampleEnd", 0, segment_name, std::vector<std::string>()));
       }
       virtual void onSequenceSegmentProcessorEnd() override
       {
-        events_.push_back(std::make_tuple("onSequenceSegmentProcessorEnd", 0, "", std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSequenceSegmentProcessorEnd", 0, "", std::vector<std::string>()));
       }
       virtual void onSequenceSegmentProcessorError(const std::string& segment_name, const std::string& processor_name, const std::string& error) override
       {
-        events_.push_back(std::make_tuple("onSequenceSegmentProcessorError", 0, segment_name, std::vector<std::string>({ processor_name , error })));
+        pushEvent(std::make_tuple("onSequenceSegmentProcessorError", 0, segment_name, std::vector<std::string>({ processor_name , error })));
       }
       /**
         ISampleGroupProcessorObserver
       */
       virtual void onSampleGroupProcessorStart(const size_t nb_groups) override
       {
-        events_.push_back(std::make_tuple("onSampleGroupProcessorStart", nb_groups, "", std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSampleGroupProcessorStart", nb_groups, "", std::vector<std::string>()));
       }
       virtual void onSampleGroupProcessorSampleStart(const std::string& group_name) override
       {
-        events_.push_back(std::make_tuple("onSampleGroupProcessorSampleStart", 0, group_name, std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSampleGroupProcessorSampleStart", 0, group_name, std::vector<std::string>()));
       }
       virtual void onSampleGroupProcessorSampleEnd(const std::string& group_name) override
       {
-        events_.push_back(std::make_tuple("onSampleGroupProcessorSampleEnd", 0, group_name, std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSampleGroupProcessorSampleEnd", 0, group_name, std::vector<std::string>()));
       }
       virtual void onSampleGroupProcessorEnd() override
       {
-        events_.push_back(std::make_tuple("onSampleGroupProcessorEnd", 0, "", std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSampleGroupProcessorEnd", 0, "", std::vector<std::string>()));
       }
       virtual void onSampleGroupProcessorError(const std::string& group_name, const std::string& processor_name, const std::string& error)
       {
-        events_.push_back(std::make_tuple("onSampleGroupProcessorError", 0, group_name, std::vector<std::string>({ processor_name , error})));
+        pushEvent(std::make_tuple("onSampleGroupProcessorError", 0, group_name, std::vector<std::string>({ processor_name , error})));
       }
 
       /**
@@ -165,7 +177,7 @@ namespace SmartPeak {
       */
       virtual void onSequenceUpdated() override
       {
-        events_.push_back(std::make_tuple("onSequenceUpdated", 0, "", std::vector<std::string>()));
+        pushEvent(std::make_tuple("onSequenceUpdated", 0, "", std::vector<std::string>()));
       }
 
       /**
@@ -173,23 +185,108 @@ namespace SmartPeak {
       */
       virtual void onTransitionsUpdated() override
       {
-        events_.push_back(std::make_tuple("onTransitionsUpdated", 0, "", std::vector<std::string>()));
+        pushEvent(std::make_tuple("onTransitionsUpdated", 0, "", std::vector<std::string>()));
+      }
+
+      using Event = std::tuple<std::string, size_t, std::string, std::vector<std::string>>;
+
+      /**
+        @brief cursor of a new reader, on the oldest event kept
+      */
+      size_t getCursor() const
+      {
+        std::lock_guard<std::mutex> lock(events_mutex_);
+        return first_event_;
+      }
+
+      /**
+        @brief the event at `cursor`, if any, and moves `cursor` to the next one
+
+        The events dropped before the reader got them are skipped.
+      */
+      std::optional<Event> getEvent(size_t& cursor) const
+      {
+        std::lock_guard<std::mutex> lock(events_mutex_);
+        cursor = std::max(cursor, first_event_);
+        if (cursor >= first_event_ + events_.size())
+        {
+          return std::nullopt;
+        }
+        return events_[cursor++ - first_event_];
+      }
+
+      /**
+        @brief Blocks until an event at or after `cursor` is available or the timeout expires.
+
+        @returns true if an event is available
+      */
+      bool waitForEvent(size_t cursor, std::chrono::milliseconds timeout) const
+      {
+        std::unique_lock<std::mutex> lock(events_mutex_);
+        return events_cv_.wait_for(lock, timeout, [this, cursor]() { return first_event_ + events_.size() > cursor; });
       }
 
-      std::vector<std::tuple<std::string, size_t, std::string, std::vector<std::string>>> events_;
+      /**
+        @brief the oldest event not read yet by the default reader, if any
+      */
+      std::optional<Event> popEvent()
+      {
+        return getEvent(default_cursor_);
+      }
+
+      /**
+        @brief number of events not read yet by the default reader
+      */
+      size_t size() const
+      {
+        std::lock_guard<std::mutex> lock(events_mutex_);
+        return first_event_ + events_.size() - std::max(default_cursor_, first_event_);
+      }
+
+      size_t max_events_ = 10000;
+
+    private:
+      void pushEvent(Event&& event)
+      {
+        {
+          std::lock_guard<std::mutex> lock(events_mutex_);
+          if (events_.size() >= max_events_)
+          {
+            events_.pop_front();
+            ++first_event_;
+          }
+          events_.push_back(std::move(event));
+        }
+        events_cv_.notify_all();
+      }
+
+      mutable std::mutex events_mutex_;
+      mutable std::condition_variable events_cv_;
+      std::deque<Event> events_;
+      size_t first_event_ = 0; ///< sequence number of the oldest event kept
+      size_t default_cursor_ = 0;
     };
   
     class ServerManager {
     public:
       /**
        * Constructs the ServerManager object.
+       *
+       * @param[in] job_queue runs the workflow of the requests, shared by the ServerManager objects
+       *   of the concurrent requests. The workflow manager of this object is used if null.
        */
-      ServerManager()
+      explicit ServerManager(WorkflowManager* job_queue = nullptr) : job_queue_(job_queue)
       {
         application_handler_.sequenceHandler_.addTransitionsObserver(&event_dispatcher_);
         application_handler_.sequenceHandler_.addSequenceObserver(&event_dispatcher_);
         event_dispatcher_.addTransitionsObserver(&session_handler_);
         event_dispatcher_.addSequenceObserver(&session_handler_);
+        event_dispatcher_.addApplicationProcessorObserver(&server_event_dispatcher_observer_);
+        event_dispatcher_.addSequenceProcessorObserver(&server_event_dispatcher_observer_);
+        event_dispatcher_.addSequenceSegmentProcessorObserver(&server_event_dispatcher_observer_);
+        event_dispatcher_.addSampleGroupProcessorObserver(&server_event_dispatcher_observer_);
+        event_dispatcher_.addSequenceObserver(&server_event_dispatcher_observer_);
+        event_dispatcher_.addTransitionsObserver(&server_event_dispatcher_observer_);
         progress_info_ptr_ = std::make_shared<ProgressInfo>(
             event_dispatcher_, event_dispatcher_, event_dispatcher_, event_dispatcher_);
       }
@@ -205,6 +302,13 @@ namespace SmartPeak {
       inline WorkflowManager& get_workflow_manager() { return workflow_manager_; }
       inline const WorkflowManager& get_workflow_manager() const { return workflow_manager_; }
 
+      inline WorkflowManager& get_job_queue() { return job_queue_ ? *job_queue_ : workflow_manager_; }
+
+      /**
+       * @brief cancel the workflow of the request, if it is queued or running
+       */
+      inline bool cancel_workflow() { return job_id && get_job_queue().cancelJob(job_id); }
+
       inline EventDispatcher& get_event_dispatcher() { return event_dispatcher_; }
       inline const EventDispatcher& get_event_dispatcher() const { return event_dispatcher_; }
       
@@ -226,11 +330,13 @@ namespace SmartPeak {
       std::vector<std::string>  input_files;
       std::string               mzml_dir {"./mzML"};
       std::string               reports_out_dir {"exports"};
+      std::atomic_size_t        job_id {0}; ///< id of the workflow in the job queue, 0 if none
       
     private:
       ApplicationHandler application_handler_;
       SessionHandler session_handler_;
       WorkflowManager workflow_manager_;
+      WorkflowManager* job_queue_ = nullptr;
       EventDispatcher event_dispatcher_;
       SeverEventDispatcherObserver server_event_dispatcher_observer_;
       std::shared_ptr<ProgressInfo> progress_info_ptr_;
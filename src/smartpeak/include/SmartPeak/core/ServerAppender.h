@@ -23,21 +23,93 @@
 
 #pragma once
 #include <plog/Log.h>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 #include <vector>
 
 namespace SmartPeak {
+	/**
+	  @brief plog appender that keeps the latest log records for the server clients.
+
+	  The records are stored in a fixed-capacity ring: the oldest records are overwritten
+	  when it is full, so that the memory used by a long running server stays bounded.
+	  Reading does not remove the records, each reader follows the ring with its own
+	  Cursor and the records overwritten before it reads them are counted as dropped for
+	  that reader only.
+	*/
 	class ServerAppender : public plog::IAppender
 	{
 	public:
 		typedef std::pair<plog::Severity, plog::util::nstring> ServerAppenderRecord;
-		
+
+		/**
+		  @brief Position of a reader in the stream of records.
+		*/
+		struct Cursor
+		{
+			size_t next_record = 0; ///< sequence number of the next record to read
+			size_t nb_dropped_records = 0; ///< records overwritten before this reader read them
+		};
+
+		/**
+		  @param[in] capacity Maximum number of records kept
+		*/
+		explicit ServerAppender(size_t capacity = 10000);
+
 		void write(const plog::Record& record) override;
-		
+
+		/**
+		  @brief Cursor of a new reader, positioned on the oldest record kept.
+		*/
+		Cursor getCursor() const;
+
+		/**
+		  @brief Returns the records after `cursor` with a severity up to `severity`, and moves `cursor` past them.
+
+		  The records are copied, they stay available to the other readers.
+		*/
+		std::vector<ServerAppenderRecord> getAppenderRecordList(plog::Severity severity, Cursor& cursor) const;
+
+		/**
+		  @brief Blocks until records after `cursor` are available or the timeout expires.
+
+		  @param[in] cursor Position of the reader
+		  @param[in] timeout Maximum time to wait
+		  @returns true if records are available
+		*/
+		bool waitForRecords(const Cursor& cursor, std::chrono::milliseconds timeout) const;
+
+		/**
+		  @brief Returns the records not read yet by the default reader with a severity up to `severity`.
+		*/
 		std::vector<ServerAppenderRecord> getAppenderRecordList(plog::Severity severity);
 
+		/**
+		  @brief Blocks until records not read by the default reader are available or the timeout expires.
+		*/
+		bool waitForRecords(std::chrono::milliseconds timeout);
+
+		/**
+		  @brief Number of records overwritten before the default reader read them.
+		*/
+		size_t getNbDroppedRecords() const;
+
+		/**
+		  @brief Number of records kept and not read yet by the default reader.
+		*/
+		size_t size() const;
+		size_t capacity() const { return messages.size(); }
+
 	private:
+		size_t firstRecord() const { return next_record_ - size_; }
+		void skipDroppedRecords(Cursor& cursor) const;
+
 		std::vector<ServerAppenderRecord> messages;
+		size_t next_record_ = 0; ///< sequence number of the next record written
+		size_t size_ = 0;
+		Cursor default_cursor_;
 		mutable std::mutex messages_mutex;
+		mutable std::condition_variable messages_cv;
 	};
 }
@@ -25,8 +25,16 @@
 
 #include <SmartPeak/core/SequenceHandler.h>
 #include <SmartPeak/core/ApplicationHandler.h>
+#include <SmartPeak/core/FeatureMatrixCache.h>
+#include <SmartPeak/core/FeatureTable.h>
+#include <SmartPeak/core/SeriesPyramid.h>
 #include <unsupported/Eigen/CXX11/Tensor>
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <tuple>
+
 namespace SmartPeak
 {
   extern bool run_on_server;
@@ -53,17 +61,40 @@ namespace SmartPeak
     */
     virtual void onTransitionsUpdated() override;
 
+    /**
+    @brief Returns a new generation, unique across the session data.
+
+    Generations are used to know when data displayed by the widgets needs to be refreshed.
+    */
+    static uint64_t nextGeneration();
+
     /*
     @ brief data for generic tables: one line header, and body data
     */
     struct GenericTableData
     {
       Eigen::Tensor<std::string, 1> headers_;
-      Eigen::Tensor<std::string, 2> body_;
+      Eigen::Tensor<std::string, 2> body_; ///< text cells, empty when the table is made from a FeatureTable
+      std::shared_ptr<const FeatureTable> typed_body_; ///< typed cells, formatted when displayed
+      uint64_t generation_ = 0; ///< changes each time the headers or the body change
+      size_t getNRows() const
+      {
+        return typed_body_ ? typed_body_->getNRows() : body_.dimension(0);
+      }
+      std::string getText(size_t row, size_t col) const
+      {
+        return typed_body_ ? typed_body_->getText(row, col) : body_(row, col);
+      }
       void clear()
       {
         headers_.resize(0);
         body_.resize(0, 0);
+        typed_body_.reset();
+        markChanged();
+      }
+      void markChanged()
+      {
+        generation_ = nextGeneration();
       }
     };
 
@@ -75,6 +106,10 @@ namespace SmartPeak
       Eigen::Tensor<std::string, 1> checkbox_headers;
       Eigen::Tensor<bool, 2> checkbox_body;
       Eigen::Tensor<bool, 1> checked_rows;
+      uint64_t generation_ = 0; ///< changes each time the checkboxes change, see updateExplorerGeneration
+    private:
+      friend class SessionHandler;
+      Eigen::Tensor<bool, 2> checkbox_body_snapshot_; ///< checkbox_body at the last generation
     };
 
     /*
@@ -86,6 +121,17 @@ namespace SmartPeak
     @returns true if all rows/columns were added and false if rows/columns were omitted due to performance
     */
     void setMinimalDataAndFilters(const SequenceHandler& sequence_handler);
+
+    /*
+    @brief Moves the generation of the explorer data when its checkboxes were changed since the last call.
+
+    The explorer widgets edit the checkboxes in place, the changes are detected by comparison with a snapshot.
+
+    @param[in,out] explorer_data
+
+    @returns true if the checkboxes were changed
+    */
+    bool updateExplorerGeneration(ExplorerData& explorer_data);
     
     void setInjectionExplorer(GenericTableData& generic_table_data); ///< set the InjectionExplorer-specific data
     void setTransitionExplorer(GenericTableData& generic_table_data); ///< set the TransitionExplorer-specific data
@@ -151,9 +197,11 @@ namespace SmartPeak
       float x_max_ = 0.0f;
       float y_min_ = 0.0f;
       float y_max_ = 0.0f;
-      bool points_overflow_ = false; // true if all points were added and false if points were omitted due to performance concern
+      bool points_overflow_ = false; // true if some series were added at a reduced resolution due to performance concern
       int nb_points_ = 0;
       int max_nb_points_ = 0;
+      int overflow_series_points_ = 2000; // resolution of the series added once max_nb_points_ is reached
+      std::vector<std::shared_ptr<const SeriesPyramid>> pyramids_area_; // level of details of each area series
 
       void reset(const std::string& x_axis_title, const std::string& y_axis_title, const std::optional<std::string>& z_axis_title, int max_nb_points)
       {
@@ -171,14 +219,38 @@ namespace SmartPeak
         x_data_area_.clear();
         y_data_area_.clear();
         z_data_area_.clear();
+        // the levels of details of the series plotted again are reused, unless the data changed
+        previous_pyramids_area_.clear();
+        if (pyramids_generation_ == data_generation_)
+        {
+          for (size_t i = 0; i < pyramids_area_.size(); ++i)
+          {
+            previous_pyramids_area_.emplace(series_names_area_.at(i), std::move(pyramids_area_[i]));
+          }
+        }
+        pyramids_generation_ = data_generation_;
         series_names_area_.clear();
+        pyramids_area_.clear();
         points_overflow_ = false;
         nb_points_ = 0;
       }
 
       bool addData(const std::vector<float>& x_data, const std::vector<float>& y_data, const std::string& data_name)
       {
-        return addData(x_data_area_, y_data_area_, series_names_area_, x_data, y_data, data_name);
+        if (!addData(x_data_area_, y_data_area_, series_names_area_, x_data, y_data, data_name))
+        {
+          return false;
+        }
+        const auto previous_pyramid = previous_pyramids_area_.find(data_name);
+        if (previous_pyramid != previous_pyramids_area_.end() && previous_pyramid->second->getNPoints() == x_data_area_.back().size())
+        {
+          pyramids_area_.push_back(previous_pyramid->second);
+        }
+        else
+        {
+          pyramids_area_.push_back(std::make_shared<const SeriesPyramid>(x_data_area_.back(), y_data_area_.back()));
+        }
+        return true;
       }
 
       bool addScatterData(const std::vector<float>& x_data, const std::vector<float>& y_data, const std::string& data_name)
@@ -186,8 +258,31 @@ namespace SmartPeak
         return addData(x_data_scatter_, y_data_scatter_, series_names_scatter_, x_data, y_data, data_name);
       }
 
-    
+      /**
+        @brief get the points of an area series to draw for the visible range
+
+        @param[in] i index of the area series
+        @param[in] x_min lower bound of the visible range
+        @param[in] x_max upper bound of the visible range
+        @param[in] max_points maximum number of points to draw for the series
+      */
+      SeriesPyramid::View getAreaView(size_t i, double x_min, double x_max, size_t max_points) const
+      {
+        return pyramids_area_.at(i)->getView(x_data_area_.at(i), y_data_area_.at(i), x_min, x_max, max_points);
+      }
+
+      /**
+        @brief to be called when the data the series are made from change, so that their levels of details are rebuilt
+      */
+      void invalidateSeries()
+      {
+        data_generation_ = nextGeneration();
+      }
+
     private:
+      std::map<std::string, std::shared_ptr<const SeriesPyramid>> previous_pyramids_area_; // levels of details of the series before the last reset
+      uint64_t data_generation_ = 0;
+      uint64_t pyramids_generation_ = 0; // data generation of the levels of details
 
       bool addData(std::vector<std::vector<float>>& v_x_data,
                    std::vector<std::vector<float>>& v_y_data,
@@ -196,24 +291,34 @@ namespace SmartPeak
                    const std::vector<float>& y_data,
                    const std::string& data_name)
       {
-        if (!points_overflow_)
+        if (x_data.size() != y_data.size())
         {
-          if (nb_points_ + x_data.size() < max_nb_points_)
-          {
-            nb_points_ += x_data.size();
-            v_x_data.push_back(x_data);
-            v_y_data.push_back(y_data);
-            data_names.push_back(data_name);
-            setMinMax(x_data, x_min_, x_max_);
-            setMinMax(y_data, y_min_, y_max_);
-          }
-          else
+          LOGE << "Unable to add " << data_name << " to the graph: x and y sizes differ";
+          return false;
+        }
+        if (nb_points_ + x_data.size() < max_nb_points_)
+        {
+          v_x_data.push_back(x_data);
+          v_y_data.push_back(y_data);
+        }
+        else
+        {
+          // keep the series at a reduced resolution rather than dropping it
+          if (!points_overflow_)
           {
-            LOGD << "Stopped adding points to the graph";
-            points_overflow_ = true;
+            LOGD << "Graph points budget reached, adding the next series at a reduced resolution";
           }
+          points_overflow_ = true;
+          std::vector<float> x_reduced, y_reduced;
+          SeriesPyramid::decimateMinMax(x_data.data(), y_data.data(), x_data.size(), std::max(overflow_series_points_ / 2, 1), x_reduced, y_reduced);
+          v_x_data.push_back(std::move(x_reduced));
+          v_y_data.push_back(std::move(y_reduced));
         }
-        return (!points_overflow_);
+        nb_points_ += v_x_data.back().size();
+        data_names.push_back(data_name);
+        setMinMax(x_data, x_min_, x_max_);
+        setMinMax(y_data, y_min_, y_max_);
+        return true;
       }
 
       void setMinMax(const std::vector<float> v, float& current_min, float& current_max)
@@ -434,7 +539,15 @@ namespace SmartPeak
     float feat_line_sample_min, feat_line_sample_max, feat_value_min, feat_value_max;
     Eigen::Tensor<std::string, 1> feat_row_labels, feat_col_labels;
   private:
-    int feature_table_unique_samples_transitions_ = 0; // used to decide when to update the feature table data
-    int feature_matrix_unique_transitions_ = 0; // used to decide when to update the feature matrix data
+    /*
+    @brief Returns the generations of the features and of the selections the feature table and matrix are made of.
+    */
+    std::tuple<uint64_t, uint64_t, uint64_t, uint64_t> getFeatureSelectionGenerations();
+
+    uint64_t features_generation_ = nextGeneration(); // changes each time the features may have been updated
+    std::tuple<uint64_t, uint64_t, uint64_t, uint64_t> feature_table_generations_; // used to decide when to update the feature table data
+    uint64_t feature_table_generation_ = 0; // generation of the last feature table made
+    std::tuple<uint64_t, uint64_t, uint64_t, uint64_t> feature_matrix_generations_; // used to decide when to update the feature matrix data
+    FeatureMatrixCache feature_matrix_cache_; // feature values of the feature matrix and heatmap, kept across selection changes
   };
 }
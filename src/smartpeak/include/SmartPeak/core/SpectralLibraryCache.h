@@ -0,0 +1,126 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+
+#include <OpenMS/ANALYSIS/OPENSWATH/TargetedSpectraExtractor.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace SmartPeak
+{
+  /**
+    Process-wide cache of the spectral libraries used to match spectra.
+
+    A library is loaded from its MSP file, sorted and binned once, and the resulting
+    comparator is shared read-only by all the injections and worker threads.
+    Entries are keyed by the path of the file and invalidated when its modification
+    time or size changes. When the estimated memory used by the cached libraries
+    exceeds the memory limit, the least recently used libraries are evicted.
+    Libraries still in use stay alive until their last user releases them.
+  */
+  class SpectralLibraryCache
+  {
+  public:
+    using Comparator = OpenMS::TargetedSpectraExtractor::BinnedSpectrumComparator;
+
+    /**
+      @param[in] memory_limit maximum estimated memory of the cached libraries, in bytes
+    */
+    explicit SpectralLibraryCache(size_t memory_limit = default_memory_limit);
+
+    SpectralLibraryCache(const SpectralLibraryCache&) = delete;
+    SpectralLibraryCache& operator=(const SpectralLibraryCache&) = delete;
+
+    /**
+      @brief the process-wide cache
+    */
+    static SpectralLibraryCache& instance();
+
+    /**
+      @brief get the comparator of a library, loading it if it is not cached or out of date
+
+      Concurrent requests for the same library wait for a single load.
+
+      @param[in] msp_file path of the library, in MSP format
+      @throw std::exception if the library could not be loaded
+    */
+    std::shared_ptr<const Comparator> getComparator(const std::filesystem::path& msp_file);
+
+    /**
+      @brief set the maximum estimated memory of the cached libraries, in bytes
+    */
+    void setMemoryLimit(size_t memory_limit);
+
+    /**
+      @brief maximum estimated memory of the cached libraries, in bytes
+    */
+    size_t getMemoryLimit() const;
+
+    /**
+      @brief estimated memory of the cached libraries, in bytes
+    */
+    size_t getMemoryUsage() const;
+
+    /**
+      @brief number of cached libraries
+    */
+    size_t size() const;
+
+    /**
+      @brief remove all the libraries from the cache
+    */
+    void clear();
+
+    static constexpr size_t default_memory_limit = 1024 * 1024 * 1024; ///< 1 GiB
+
+  protected:
+    struct Entry
+    {
+      std::filesystem::file_time_type last_write_time;
+      std::uintmax_t file_size = 0;
+      std::shared_future<std::shared_ptr<const Comparator>> comparator;
+      size_t memory_usage = 0; ///< 0 while loading
+      size_t load_id = 0;      ///< identifies the load that fills the entry
+      std::list<std::string>::iterator lru_position;
+    };
+
+    void evict(const std::string& keep);
+    void erase(std::map<std::string, Entry>::iterator entry);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Entry> entries_;
+    std::list<std::string> lru_; ///< most recently used first
+    size_t memory_limit_;
+    size_t memory_usage_ = 0;
+    size_t next_load_id_ = 0;
+  };
+}
@@ -0,0 +1,141 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SmartPeak
+{
+  /**
+    Cooperative cancellation flag shared between the submitter of a task and
+    the task itself. Copies share the same flag.
+  */
+  class CancellationToken
+  {
+  public:
+    CancellationToken() : cancelled_(std::make_shared<std::atomic_bool>(false)) {}
+
+    void cancel() { cancelled_->store(true); }
+    bool isCancelled() const { return cancelled_->load(); }
+
+  private:
+    std::shared_ptr<std::atomic_bool> cancelled_;
+  };
+
+  /**
+    Long-lived work-stealing thread pool.
+
+    Each worker owns a task queue. Tasks submitted from a worker go to its own
+    queue (LIFO for the owner), tasks submitted from any other thread are
+    distributed round-robin. Idle workers steal from the front of the queues of
+    the other workers.
+
+    A single process-wide instance, sized to the hardware concurrency, is
+    shared by all the sequence, sequence segment and sample group processors.
+  */
+  class ThreadPool
+  {
+  public:
+    /**
+      @param[in] n_threads number of workers, 0 means hardware concurrency
+    */
+    explicit ThreadPool(size_t n_threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+      @brief the process-wide pool
+    */
+    static ThreadPool& instance();
+
+    /**
+      @brief number of workers
+    */
+    size_t size() const { return threads_.size(); }
+
+    /**
+      @brief queue a task for execution
+
+      The task is skipped (and its future made ready) if the token has been
+      cancelled before a worker picks it up. Exceptions thrown by the task are
+      forwarded to the returned future.
+    */
+    std::future<void> submit(std::function<void()> task, CancellationToken token = CancellationToken());
+
+    /**
+      @brief wait for a future obtained from this pool
+
+      When called from one of the workers, the calling worker keeps executing
+      queued tasks while waiting, so nested submissions cannot dead-lock the pool.
+    */
+    void wait(std::future<void>& future);
+
+    /**
+      @brief whether the calling thread is one of the workers of this pool
+    */
+    bool isWorkerThread() const;
+
+    /**
+      @brief execute one queued task on the calling thread, if any
+
+      @return true if a task has been executed
+    */
+    bool runPendingTask();
+
+  private:
+    struct Task
+    {
+      std::shared_ptr<std::packaged_task<void()>> run;
+    };
+
+    struct WorkQueue
+    {
+      std::deque<Task> tasks;
+      std::mutex mutex;
+    };
+
+    void workerLoop(size_t index);
+    void push(Task&& task);
+    bool pop(size_t index, Task& task);
+    bool steal(size_t thief, Task& task);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    std::atomic_size_t pending_ { 0 };
+    std::atomic_size_t next_queue_ { 0 };
+    bool stop_ = false;
+  };
+}
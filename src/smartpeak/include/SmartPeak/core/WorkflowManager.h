@@ -24,11 +24,20 @@
 #pragma once
 
 #include <SmartPeak/core/ApplicationHandler.h>
+#include <SmartPeak/core/ThreadPool.h>
 #include <SmartPeak/iface/IApplicationProcessorObserver.h>
 #include <SmartPeak/iface/ISequenceProcessorObserver.h>
 #include <SmartPeak/iface/ISequenceSegmentProcessorObserver.h>
 #include <SmartPeak/iface/ISampleGroupProcessorObserver.h>
 
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
 namespace SmartPeak {
   //TODO: implement a detailed workflow status
   enum class WorkFlowStatus
@@ -39,11 +48,51 @@ namespace SmartPeak {
     SIZE_OF_WORKFLOWSTATUS
   };
 
+  enum class WorkflowJobStatus
+  {
+    QUEUED,
+    RUNNING,
+    FINISHED,
+    FAILED,
+    CANCELLED
+  };
+
+  /**
+    Runs workflows, possibly several at the same time.
+
+    Workflows are submitted as jobs, identified by an id, and run on a copy of the
+    application handler. At most getMaxConcurrentWorkflows() jobs run at the same time;
+    all of them share the process-wide ThreadPool, which bounds the total CPU usage.
+
+    The copy of the application handler shares the session data (raw data, quantitation
+    methods, parameters, ...) with its source. When it starts, a job copies the data of the
+    injections and sequence segments its commands write, and the data they share with the
+    sequence, so that neither its source nor the other jobs see its changes, and it does not
+    see theirs. The data of the other items is not copied: the job does not use it.
+
+    addWorkflow(), isWorkflowDone() and updateApplicationHandler() manage a single workflow
+    on top of the queue, for the GUI and the CLI. Those workflows keep writing to the data
+    shared with their source. A job waits for the running jobs writing the same data to finish,
+    and a job writing data waits for the running jobs copying them.
+  */
   class WorkflowManager {
   public:
+    /**
+      @param[in] max_concurrent_workflows maximum number of jobs running at the same time
+    */
+    explicit WorkflowManager(size_t max_concurrent_workflows = 1);
+
+    /**
+      Cancels the jobs and waits for the running ones to end.
+    */
+    ~WorkflowManager();
+
+    WorkflowManager(const WorkflowManager&) = delete;
+    WorkflowManager& operator=(const WorkflowManager&) = delete;
+
     /**
       Copies the passed application_handler and sets up the async run of the workflow. Only one
-      workflow is managed at a time
+      workflow is managed at a time by this method, it is queued with the jobs of submitWorkflow()
 
       @param[in,out] The application_handler that gets copied and then updated at the end of the workflow run
       @param[in] injection_names Injection names to use for Sequence Processing
@@ -94,38 +143,133 @@ namespace SmartPeak {
     */
     bool isMissingRequirements(const Filenames& filenames, const std::set<std::string>& requirements) const;
 
-  private:
     /**
-      Spawns a thread that runs the workflow, and waits for it to finish. The
-      modified application_handler is copied back to the source, keeping the application_handler of the app
-      up-to-date
-
-      @param[in,out] application_handler Points to the class' application_handler member
-      @param[in,out] done Points to the class' done member
-      @param[in,out] run_time time taken to run the workflow
-      @param[out] source_app_handler The modified application_handler is copied back here
+      @brief Queues a workflow, run on a copy of source_state.
+
+      @param[in] source_state The application_handler that gets copied
       @param[in] injection_names Injection names to use for Sequence Processing
       @param[in] sequence_segment_names Sequence Segment Names to use for Sequence Segment Processing
       @param[in] sample_group_names Sample Group Names to use for Sample Group Processing
       @param[in] commands Workflow steps
-      @param[in] number_of_threads number of threads to use to execute the workflow
+      @param[in] number_of_threads maximum number of tasks of this workflow running at the same time
       @param[in] sequence_processor_observer an observer for sequence, used to report progress
       @param[in] sequence_segment_processor_observer an observer for sequence segment, used to report progress
       @param[in] sample_group_processor_observer, used to report progress
+
+      @returns the id of the job
     */
-    static void run_and_join(ApplicationHandler& application_handler, 
-      bool& done,
-      const std::set<std::string>& injection_names, 
+    size_t submitWorkflow(const ApplicationHandler& source_state,
+      const std::set<std::string>& injection_names,
       const std::set<std::string>& sequence_segment_names,
       const std::set<std::string>& sample_group_names,
       const std::vector<ApplicationHandler::Command>& commands,
       const int number_of_threads,
       IApplicationProcessorObserver* application_processor_observer = nullptr,
       ISequenceProcessorObserver* sequence_processor_observer = nullptr,
-      ISequenceSegmentProcessorObserver * sequence_segment_processor_observer = nullptr,
+      ISequenceSegmentProcessorObserver* sequence_segment_processor_observer = nullptr,
       ISampleGroupProcessorObserver* sample_group_processor_observer = nullptr);
 
-    ApplicationHandler application_handler_; ///< The workflow is run on this copy
-    bool done_ = true;
+    /**
+      @brief Status of a job.
+
+      @throws std::out_of_range if the job is unknown, or has been released
+    */
+    WorkflowJobStatus getJobStatus(size_t job_id) const;
+
+    /**
+      @brief Cancels a job.
+
+      A queued job is cancelled right away. A running job skips the remaining processing
+      of its injections, sequence segments and sample groups, and ends as cancelled.
+
+      @returns false if the job is unknown or already ended
+    */
+    bool cancelJob(size_t job_id);
+
+    /**
+      @brief Blocks until the job has ended.
+
+      @throws std::out_of_range if the job is unknown, or has been released
+    */
+    WorkflowJobStatus waitForJob(size_t job_id);
+
+    /**
+      @brief Forgets an ended job.
+
+      @returns the application handler the job has been run on
+      @throws std::out_of_range if the job is unknown, or has been released
+      @throws std::logic_error if the job has not ended
+    */
+    std::shared_ptr<ApplicationHandler> releaseJob(size_t job_id);
+
+    /**
+      @brief Ids of the jobs not released yet, in submission order.
+    */
+    std::vector<size_t> getJobIds() const;
+
+    void setMaxConcurrentWorkflows(size_t max_concurrent_workflows);
+    size_t getMaxConcurrentWorkflows() const;
+
+    /**
+      @brief Number of jobs currently running.
+    */
+    size_t getNumberOfRunningWorkflows() const;
+
+  private:
+    struct Job
+    {
+      size_t id = 0;
+      WorkflowJobStatus status = WorkflowJobStatus::QUEUED;
+      std::shared_ptr<ApplicationHandler> application_handler;
+      std::set<std::string> injection_names;
+      std::set<std::string> sequence_segment_names;
+      std::set<std::string> sample_group_names;
+      std::vector<ApplicationHandler::Command> commands;
+      int number_of_threads = 1;
+      IApplicationProcessorObserver* application_processor_observer = nullptr;
+      ISequenceProcessorObserver* sequence_processor_observer = nullptr;
+      ISequenceSegmentProcessorObserver* sequence_segment_processor_observer = nullptr;
+      ISampleGroupProcessorObserver* sample_group_processor_observer = nullptr;
+      CancellationToken token;
+      bool isolated = true; ///< runs on its own copy of the shared data; false for the workflows of addWorkflow()
+      std::set<size_t> written_injections; ///< indices of the injections written by the commands
+      std::set<size_t> written_sequence_segments; ///< indices of the sequence segments written by the commands
+      std::vector<const void*> locked_data; ///< shared data copied by the job when isolated, written by the job otherwise
+    };
+
+    std::shared_ptr<Job> makeJob(const ApplicationHandler& source_state,
+      const std::set<std::string>& injection_names,
+      const std::set<std::string>& sequence_segment_names,
+      const std::set<std::string>& sample_group_names,
+      const std::vector<ApplicationHandler::Command>& commands,
+      const int number_of_threads,
+      IApplicationProcessorObserver* application_processor_observer,
+      ISequenceProcessorObserver* sequence_processor_observer,
+      ISequenceSegmentProcessorObserver* sequence_segment_processor_observer,
+      ISampleGroupProcessorObserver* sample_group_processor_observer,
+      bool isolated);
+    size_t queueJob(std::shared_ptr<Job> job);
+    std::shared_ptr<Job> getJob(size_t job_id) const;
+    void startJobs();
+    void runJob(std::shared_ptr<Job> job);
+    void unlockData(const Job& job);
+
+    /**
+      @brief Copies the shared data of the injections and sequence segments written by the job,
+      keeping the data shared between them shared between the copies.
+    */
+    static void copySharedData(Job& job);
+
+    mutable std::mutex mutex_;
+    std::condition_variable job_ended_cv_;
+    std::map<size_t, std::shared_ptr<Job>> jobs_;
+    std::deque<std::shared_ptr<Job>> queue_;
+    std::multiset<const void*> data_written_; ///< shared data being written by the running jobs
+    std::multiset<const void*> data_copied_; ///< shared data being copied by the running jobs
+    size_t max_concurrent_workflows_;
+    size_t n_running_ = 0;
+    size_t n_job_threads_ = 0;
+    size_t next_job_id_ = 1;
+    size_t workflow_job_id_ = 0; ///< job of addWorkflow(), 0 if none
   };
 }
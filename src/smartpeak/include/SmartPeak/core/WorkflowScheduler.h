@@ -0,0 +1,179 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <SmartPeak/core/ApplicationHandler.h>
+#include <SmartPeak/core/ApplicationProcessorObservable.h>
+#include <SmartPeak/core/SequenceHandler.h>
+#include <SmartPeak/core/SequenceProcessorObservable.h>
+#include <SmartPeak/core/SequenceSegmentProcessorObservable.h>
+#include <SmartPeak/core/SampleGroupProcessorObservable.h>
+#include <SmartPeak/core/ThreadPool.h>
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace SmartPeak
+{
+  /**
+    Dependency-driven execution of a workflow.
+
+    A workflow is made of stages, i.e. runs of consecutive commands of the same type.
+    Each stage is split into tasks: one per injection, sequence segment or sample group.
+    A task depends on the latest tasks of the previous stages that processed any of its
+    injections, instead of waiting for the whole previous stage to be done. As an example,
+    a sequence segment calibration starts as soon as all the injections of that segment
+    went through the preceding raw data steps.
+
+    Tasks run on the shared ThreadPool. Deeper stages are preferred when several tasks
+    are ready, so that results flow through the workflow as early as possible.
+    The observers are notified outside of the scheduler's lock.
+  */
+  class WorkflowScheduler
+  {
+  public:
+    explicit WorkflowScheduler(SequenceHandler& sequence_handler);
+
+    WorkflowScheduler(const WorkflowScheduler&) = delete;
+    WorkflowScheduler& operator=(const WorkflowScheduler&) = delete;
+
+    /**
+      @brief add a stage of raw data commands
+
+      @param[in] command_index index of the first command of the stage in the workflow
+      @param[in] commands the raw data commands of the stage, with their dynamic filenames
+      @param[in] injection_names injections to process (all if empty)
+      @param[in] observer notified of the progress of the stage
+    */
+    void addRawDataStage(
+      size_t command_index,
+      const std::vector<ApplicationHandler::Command>& commands,
+      const std::set<std::string>& injection_names,
+      ISequenceProcessorObserver* observer = nullptr);
+
+    /**
+      @brief add a stage of sequence segment commands
+
+      @param[in] command_index index of the first command of the stage in the workflow
+      @param[in] commands the sequence segment commands of the stage, with their dynamic filenames
+      @param[in] sequence_segment_names sequence segments to process (all if empty)
+      @param[in] observer notified of the progress of the stage
+    */
+    void addSequenceSegmentStage(
+      size_t command_index,
+      const std::vector<ApplicationHandler::Command>& commands,
+      const std::set<std::string>& sequence_segment_names,
+      ISequenceSegmentProcessorObserver* observer = nullptr);
+
+    /**
+      @brief add a stage of sample group commands
+
+      @param[in] command_index index of the first command of the stage in the workflow
+      @param[in] commands the sample group commands of the stage, with their dynamic filenames
+      @param[in] sample_group_names sample groups to process (all if empty)
+      @param[in] observer notified of the progress of the stage
+    */
+    void addSampleGroupStage(
+      size_t command_index,
+      const std::vector<ApplicationHandler::Command>& commands,
+      const std::set<std::string>& sample_group_names,
+      ISampleGroupProcessorObserver* observer = nullptr);
+
+    /**
+      @brief run all the stages and wait for them to be done
+
+      @param[in] n_threads maximum number of tasks running at the same time
+      @param[in] observable notified when the commands of a stage start and end
+      @param[in] token once cancelled, the remaining processing of the tasks is skipped
+    */
+    void run(unsigned int n_threads, ApplicationProcessorObservable* observable = nullptr,
+      const CancellationToken& token = CancellationToken());
+
+    /**
+      @brief number of tasks scheduled so far
+    */
+    size_t getNumberOfTasks() const { return tasks_.size(); }
+
+    /**
+      @brief indices of the tasks a given task waits for
+    */
+    std::vector<size_t> getDependencies(size_t task_index) const;
+
+  protected:
+    struct Stage
+    {
+      ApplicationHandler::Command::CommandType type;
+      std::string name;
+      size_t command_index = 0;
+      std::vector<std::string> command_names;
+      std::vector<std::shared_ptr<RawDataProcessor>> raw_data_methods;
+      std::vector<std::shared_ptr<SequenceSegmentProcessor>> sequence_segment_methods;
+      std::vector<std::shared_ptr<SampleGroupProcessor>> sample_group_methods;
+      std::map<std::string, Filenames> filenames;
+      SequenceProcessorObservable sequence_observable;
+      SequenceSegmentProcessorObservable sequence_segment_observable;
+      SampleGroupProcessorObservable sample_group_observable;
+      size_t n_tasks = 0;
+      std::once_flag started; ///< the first task of the stage notifies its start, the others wait for it
+      size_t n_done = 0;
+    };
+
+    struct Task
+    {
+      size_t stage;
+      size_t item; ///< index of the injection, sequence segment or sample group
+      std::vector<size_t> dependencies;
+      std::vector<size_t> dependents;
+      size_t n_pending = 0; ///< dependencies not done yet
+    };
+
+    Stage& addStage(
+      ApplicationHandler::Command::CommandType type,
+      const std::string& name,
+      size_t command_index,
+      const std::vector<ApplicationHandler::Command>& commands);
+    void addTask(size_t item, const std::vector<size_t>& injection_indices);
+    void runTask(size_t task_index);
+    void onStageStart(Stage& stage);
+    void onStageEnd(Stage& stage);
+
+    SequenceHandler& sequence_handler_;
+    std::vector<std::unique_ptr<Stage>> stages_;
+    std::vector<Task> tasks_;
+    std::vector<size_t> last_task_per_injection_;
+    ApplicationProcessorObservable* observable_ = nullptr;
+    CancellationToken token_;
+
+    std::mutex mutex_;
+    std::condition_variable task_done_cv_;
+    std::set<std::pair<size_t, size_t>> ready_; ///< (reversed stage, task) of the tasks ready to run
+    size_t n_running_ = 0;
+    size_t n_done_ = 0;
+  };
+}
@@ -3,6 +3,7 @@ set(directory include/SmartPeak/core)
 
 ### list all header files of the directory here
 set(sources_list_h
+	AccurateMassSearchEngineRegistry.h
 	ApplicationHandler.h
 	ApplicationProcessor.h
 	ApplicationProcessorObservable.h
@@ -13,10 +14,14 @@ set(sources_list_h
 	FeaturesObservable.h
 	FeatureFiltersUtils.h
 	FeatureFiltersUtilsMode.h
+	FeatureMatrixCache.h
 	FeatureMetadata.h
+	FeatureTable.h
 	Helloworld.h
 	InjectionHandler.h
 	MetaDataHandler.h
+	MPSCRingBuffer.h
+	ParameterSchemaCache.h
 	Parameters.h
 	ParametersObservable.h
 	ProgressInfo.h
@@ -34,14 +39,18 @@ set(sources_list_h
 	SequenceSegmentObservable.h
 	SequenceSegmentProcessor.h
 	SequenceSegmentProcessorObservable.h
+	SeriesPyramid.h
 	SessionHandler.h
 	ServerAppender.h
 	SessionLoaderGenerator.h
 	SharedProcessors.h
+	SpectralLibraryCache.h
 	Server.h
+	ThreadPool.h
 	TransitionsObservable.h
 	Utilities.h
 	WorkflowManager.h
+	WorkflowScheduler.h
 	WorkflowObservable.h
 )
 
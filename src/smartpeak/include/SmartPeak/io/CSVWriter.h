@@ -26,7 +26,11 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <plog/Log.h>
 
 namespace SmartPeak
@@ -37,20 +41,24 @@ namespace SmartPeak
 
     based on the following:
         http://thispointer.com/how-to-write-data-in-a-csv-file-in-c/
+
+    The file is opened once, on the first written row, and rows are collected
+    in a user-space buffer that is written out when full, on `flush()`, on
+    `close()` and on destruction. In async mode the full buffers are handed
+    over to a background thread, so that formatting and disk I/O overlap.
   */
   class CSVWriter
   {
 public:
-    CSVWriter(const std::string& filename, const std::string& delm = ",") :
-      filename_(filename), delimeter_(delm) {}
-    CSVWriter()                            = default; ///< Default constructor
-    ~CSVWriter()                           = default; ///< Default destructor
-    CSVWriter(const CSVWriter&)            = default;
-    CSVWriter& operator=(const CSVWriter&) = default;
-    CSVWriter(CSVWriter&&)                 = default;
-    CSVWriter& operator=(CSVWriter&&)      = default;
-
-    void setFilename(const std::string& filename); ///< filename setter
+    CSVWriter(const std::string& filename, const std::string& delm = ",");
+    CSVWriter(); ///< Default constructor
+    ~CSVWriter(); ///< Flushes and closes the file
+    CSVWriter(const CSVWriter&)            = delete;
+    CSVWriter& operator=(const CSVWriter&) = delete;
+    CSVWriter(CSVWriter&&) noexcept;
+    CSVWriter& operator=(CSVWriter&&) noexcept;
+
+    void setFilename(const std::string& filename); ///< filename setter, closes the current file
     std::string getFilename() const; ///< filename getter
 
     void setDelimeter(const std::string& delimeter); ///< delimeter setter
@@ -59,10 +67,19 @@ public:
     void setLineCount(const int line_count); ///< line_count setter
     int getLineCount() const; ///< line_count getter
 
+    void setBufferSize(const size_t buffer_size); ///< buffer_size setter, in bytes
+    size_t getBufferSize() const; ///< buffer_size getter
+
+    void setAsync(const bool async); ///< async setter, takes effect when the file is opened
+    bool getAsync() const; ///< async getter
+
     /**
       @brief This Function accepts a range and appends all the elements in the range
         to the last row, seperated by delimeter (Default is comma)
 
+      Strings are copied as they are, numbers are formatted with `std::to_chars`
+      (floating points with the same "%g" format as the stream insertion).
+
       @param first Iterator to the first element
       @param last Iterator to the last element
     */
@@ -70,9 +87,7 @@ public:
     std::optional<size_t> writeDataInRow(T first, T last)
     {
       // Open the file in truncate mode if first line, else in append mode
-      std::ofstream ofs(filename_, line_count_ ? std::ios::app : std::ios::trunc);
-
-      if (!ofs.is_open()) {
+      if (!open()) {
         LOGE << "Cannot open file: " << filename_;
         return std::nullopt;
       }
@@ -80,22 +95,67 @@ public:
       size_t cnt {0};
 
       if (first != last) {
-        ofs << *first++;
+        appendField(*first++);
         ++cnt;
       }
       while (first != last) {
-        ofs << delimeter_ << *first++;
+        buffer_.append(delimeter_);
+        appendField(*first++);
         ++cnt;
       }
 
-      ofs << "\n";
+      buffer_.push_back('\n');
       ++line_count_;
+      if (buffer_.size() >= buffer_size_) {
+        flushBuffer();
+      }
       return cnt;
     }
 
+    /**
+      @brief Write the buffered rows to the file, and wait for them to be written in async mode
+    */
+    void flush();
+
+    /**
+      @brief Flush and close the file; the next written row opens it again in append mode
+    */
+    void close();
+
 private:
+    struct BackgroundWriter;
+
+    bool open();
+    void flushBuffer();
+    void appendNumber(double value);
+    void appendNumber(long long value);
+    void appendNumber(unsigned long long value);
+
+    template<typename V>
+    void appendField(const V& value)
+    {
+      if constexpr (std::is_same_v<V, bool>) {
+        buffer_.push_back(value ? '1' : '0');
+      } else if constexpr (std::is_same_v<V, char>) {
+        buffer_.push_back(value);
+      } else if constexpr (std::is_floating_point_v<V>) {
+        appendNumber(static_cast<double>(value));
+      } else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+        appendNumber(static_cast<long long>(value));
+      } else if constexpr (std::is_integral_v<V>) {
+        appendNumber(static_cast<unsigned long long>(value));
+      } else {
+        buffer_.append(std::string_view(value));
+      }
+    }
+
     std::string filename_;
     std::string delimeter_;
     int line_count_ = 0;
+    size_t buffer_size_ = 1 << 20;
+    bool async_ = false;
+    std::string buffer_;
+    std::unique_ptr<std::ofstream> ofs_;
+    std::unique_ptr<BackgroundWriter> background_writer_;
   };
-}
\ No newline at end of file
+}
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <SmartPeak/core/FeatureMetadata.h>
+#include <SmartPeak/core/FeatureTable.h>
 #include <SmartPeak/core/SampleType.h>
 #include <SmartPeak/core/SequenceHandler.h>
 #include <SmartPeak/core/Utilities.h>
@@ -100,6 +101,21 @@ public:
       const std::string& delimiter = "\t"
     );
 
+    /*
+    @brief make a typed table of all meta_data for all sample_types in the feature history.
+
+    Numbers are kept as numbers, and converted to strings by the table only when displayed or exported.
+    */
+    static void makeFeatureTableFromMetaValue(
+      const SequenceHandler& sequenceHandler,
+      FeatureTable& table_out,
+      const std::vector<std::string>& meta_data,
+      const std::set<SampleType>& sample_types,
+      const std::set<std::string>& sample_names,
+      const std::set<std::string>& component_group_names,
+      const std::set<std::string>& component_names
+    );
+
     /*
     @brief make a table (row major) of string representations of
       all meta_data for all sample_types in the feature history.
@@ -124,6 +140,19 @@ public:
       const std::set<SampleType>& sample_types
     );
 
+    /*
+    @brief make a typed table of all meta_data of the merged features of the sample groups.
+    */
+    static void makeGroupFeatureTableFromMetaValue(
+      const SequenceHandler& sequenceHandler,
+      FeatureTable& table_out,
+      const std::vector<std::string>& meta_data,
+      const std::set<SampleType>& sample_types,
+      const std::set<std::string>& sample_names,
+      const std::set<std::string>& component_group_names,
+      const std::set<std::string>& component_names
+    );
+
     static void makeGroupDataTableFromMetaValue(
       const SequenceHandler& sequenceHandler,
       std::vector<std::vector<std::string>>& rows_out,
@@ -27,8 +27,11 @@
 #include <filesystem>
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 #include <optional>
+#include <sstream>
+#include <type_traits>
 #include <plog/Log.h>
 #include <SmartPeak/iface/IPropertiesHandler.h>
 
@@ -44,20 +47,38 @@ namespace SmartPeak
       std::vector<std::string> columns;
       std::string table;
       sqlite3_stmt* stmt = nullptr;
+      bool cached_stmt = false; ///< stmt belongs to the statement cache of the connection
+      bool in_transaction = false;
     };
 
-    void setDBFilePath(std::filesystem::path session_file_name)
-    {
-      session_file_name_ = session_file_name;
-      smartpeak_version_ = "Unknown";
-      session_info_logged_ = false;
-    }
+    /**
+     * @brief Sets the session file, and starts a new pool of connections to it.
+     *
+     * The copies of the SessionDB made afterwards share the same pool.
+     */
+    void setDBFilePath(std::filesystem::path session_file_name);
 
     const std::filesystem::path& getDBFilePath() const
     {
       return session_file_name_;
     }
 
+    /**
+     * @brief Use the write-ahead log journal with `synchronous=NORMAL` when writing.
+     *
+     * Faster, but the journal mode is persistent: the session file comes with
+     * -wal and -shm files while it is open.
+     */
+    void setWriteAheadLog(bool write_ahead_log)
+    {
+      write_ahead_log_ = write_ahead_log;
+    }
+
+    bool getWriteAheadLog() const
+    {
+      return write_ahead_log_;
+    }
+
     /**
      * @brief Writes a IPropertiesHandler to the Session DB file.
      * @return false if write failed.
@@ -81,12 +102,23 @@ namespace SmartPeak
 
     void endRead(SessionDB::DBContext& db_context);
 
+    /**
+     * @brief (Re)creates the table and prepares the insertion of rows.
+     *
+     * All the writes up to `endWrite` are done in a single transaction.
+     */
     template<typename Value, typename ...Args>
     std::optional<DBContext> beginWrite(const std::string& table_name, const Value& value, const char* value_type, const Args& ...args);
 
+    /**
+     * @brief Inserts a row, binding the values to the statement prepared by `beginWrite`.
+     */
     template<typename Value, typename ...Args>
     void write(SessionDB::DBContext& db_context, const Value& value, const Args& ...args);
 
+    /**
+     * @brief Commits the rows written since `beginWrite` and closes the DB.
+     */
     void endWrite(SessionDB::DBContext& db_context);
 
     int64_t getLastInsertedRowId(SessionDB::DBContext& db_context) const;
@@ -105,10 +137,23 @@ namespace SmartPeak
     void beginWrite(std::ostringstream& os, std::vector<std::string>& columns, const Value& value, const char* value_type);
 
     template<typename Value, typename ...Args>
-    void write(std::ostringstream& os, SessionDB::DBContext& db_context, const Value& value, const Args& ...args);
+    void bindValues(SessionDB::DBContext& db_context, int column, const Value& value, const Args& ...args);
 
     template<typename Value>
-    void write(std::ostringstream& os, SessionDB::DBContext& db_context, const Value& value);
+    void bindValues(SessionDB::DBContext& db_context, int column, const Value& value);
+
+    /**
+     * @brief Binds the text without copying it: it must stay alive until the statement is stepped.
+     */
+    void bindValue(sqlite3_stmt* stmt, int column, const std::string& value);
+    void bindValue(sqlite3_stmt* stmt, int column, const char* value);
+    void bindValue(sqlite3_stmt* stmt, int column, double value);
+    void bindValue(sqlite3_stmt* stmt, int column, int64_t value);
+
+    /**
+     * @brief Binds a copy of the text, for temporaries destroyed before the statement is stepped.
+     */
+    void bindTransientValue(sqlite3_stmt* stmt, int column, const std::string& value);
 
     template<typename Value, typename ...Args>
     void readRowFromDB(SessionDB::DBContext& db_context, int column, Value& value, Args& ...args);
@@ -116,22 +161,39 @@ namespace SmartPeak
     template<typename Value>
     void readRowFromDB(SessionDB::DBContext& db_context, int column, Value& value);
 
+    /**
+     * @brief Takes a connection from the pool, opening a new one if none is idle.
+     */
     std::optional<sqlite3*> openSessionDB();
 
+    /**
+     * @brief Gives the connection back to the pool.
+     */
     void closeSessionDB(sqlite3* db);
 
+    /**
+     * @brief Returns the prepared statement of the connection for that SQL, preparing it on first use.
+     */
+    sqlite3_stmt* prepareCachedStatement(sqlite3* db, const std::string& sql);
+
     void updateSessionInfo(sqlite3* db);
 
     void displaySessionInfo();
 
     void writeSessionInfo(sqlite3* db);
 
+    bool beginTransaction(sqlite3* db);
+
+    bool commitTransaction(SessionDB::DBContext& db_context);
+
     void logSQLError(const std::string& error_message, const std::string& sql_command = "") const;
 
   protected:
+    struct ConnectionPool;
+
     std::filesystem::path session_file_name_;
-    std::string smartpeak_version_ = "Unknown";
-    bool session_info_logged_ = false;
+    bool write_ahead_log_ = false;
+    std::shared_ptr<ConnectionPool> connection_pool_;
   };
 
   template<typename Value, typename ...Args>
@@ -154,14 +216,23 @@ namespace SmartPeak
     db_context.table = table_name;
     db_context.db = *db;
 
+    if (!beginTransaction(*db))
+    {
+      closeSessionDB(*db);
+      return std::nullopt;
+    }
+    db_context.in_transaction = true;
+
     // first, we delete table (to remove)
     os.str("");
-    os << "DROP TABLE ";
+    os << "DROP TABLE IF EXISTS ";
     os << table_name;
     os << ";";
     std::string sql = os.str();
     rc = sqlite3_exec(*db, sql.c_str(), NULL, 0, &zErrMsg);
     // -- ignore error
+    sqlite3_free(zErrMsg);
+    zErrMsg = nullptr;
 
     // create table
     os.str("");
@@ -177,6 +248,31 @@ namespace SmartPeak
     {
       logSQLError(zErrMsg, sql);
       sqlite3_free(zErrMsg);
+      endWrite(db_context);
+      return std::nullopt;
+    }
+
+    // prepare the insertion, the values are bound for each row
+    os.str("");
+    os << "INSERT INTO ";
+    os << table_name;
+    os << " (";
+    for (size_t i = 0; i < db_context.columns.size(); ++i)
+    {
+      os << (i ? ", " : "") << db_context.columns[i];
+    }
+    os << ") VALUES (";
+    for (size_t i = 0; i < db_context.columns.size(); ++i)
+    {
+      os << (i ? ", ?" : "?");
+    }
+    os << ");";
+    sql = os.str();
+    rc = sqlite3_prepare_v2(*db, sql.c_str(), static_cast<int>(sql.size()), &db_context.stmt, NULL);
+    if (rc != SQLITE_OK)
+    {
+      logSQLError(sqlite3_errmsg(*db), sql);
+      endWrite(db_context);
       return std::nullopt;
     }
     return db_context;
@@ -203,53 +299,63 @@ namespace SmartPeak
   template<typename Value, typename ...Args>
   void SessionDB::write(SessionDB::DBContext& db_context, const Value& value, const Args& ...args)
   {
-    std::ostringstream os;
-    int rc;
-    char* zErrMsg = nullptr;
-
-    os << "INSERT INTO ";
-    os << db_context.table;
-    os << " (";
-    for (size_t i = 0; i < db_context.columns.size(); ++i)
+    if (!db_context.stmt)
     {
-      const auto& column = db_context.columns[i];
-      os << column;
-      if (i < (db_context.columns.size() - 1))
-      {
-        os << ", ";
-      }
+      return;
     }
-    os << ") ";
-    os << "VALUES (";
-    write(os, db_context, value, args...);
-    os << "); ";
-    std::string sql = os.str();
-    rc = sqlite3_exec(db_context.db, sql.c_str(), NULL, 0, &zErrMsg);
-    if (rc != SQLITE_OK) {
-      logSQLError(zErrMsg, sql);
-      sqlite3_free(zErrMsg);
+    bindValues(db_context, 1, value, args...);
+    const int rc = sqlite3_step(db_context.stmt);
+    if (rc != SQLITE_DONE)
+    {
+      logSQLError(sqlite3_errmsg(db_context.db), sqlite3_sql(db_context.stmt));
     }
+    sqlite3_reset(db_context.stmt);
+    sqlite3_clear_bindings(db_context.stmt);
   }
 
   template<typename Value, typename ...Args>
-  void SessionDB::write(std::ostringstream& os, SessionDB::DBContext& db_context, const Value& value, const Args& ...args)
+  void SessionDB::bindValues(SessionDB::DBContext& db_context, int column, const Value& value, const Args& ...args)
   {
-    write(os, db_context, value);
-    os << ", ";
-    write(os, db_context, args...);
+    bindValues(db_context, column, value);
+    bindValues(db_context, column + 1, args...);
   }
 
   template<typename Value>
-  void SessionDB::write(std::ostringstream& os, SessionDB::DBContext& db_context, const Value& value)
+  void SessionDB::bindValues(SessionDB::DBContext& db_context, int column, const Value& value)
   {
-    os << "'" << value << "'";
+    if constexpr (std::is_same_v<Value, bool>)
+    {
+      bindValue(db_context.stmt, column, static_cast<int64_t>(value ? 1 : 0));
+    }
+    else if constexpr (std::is_integral_v<Value>)
+    {
+      bindValue(db_context.stmt, column, static_cast<int64_t>(value));
+    }
+    else if constexpr (std::is_floating_point_v<Value>)
+    {
+      bindValue(db_context.stmt, column, static_cast<double>(value));
+    }
+    else if constexpr (std::is_same_v<Value, std::string> || std::is_convertible_v<const Value&, const char*>)
+    {
+      // the caller's value outlives the step of the statement
+      bindValue(db_context.stmt, column, value);
+    }
+    else if constexpr (std::is_convertible_v<const Value&, std::string>)
+    {
+      bindTransientValue(db_context.stmt, column, value);
+    }
+    else
+    {
+      std::ostringstream os;
+      os << value;
+      bindTransientValue(db_context.stmt, column, os.str());
+    }
   }
 
   template<typename Value, typename ...Args>
   std::optional<SessionDB::DBContext> SessionDB::beginRead(const std::string& table_name, const Value& value, const Args& ...args)
   {
     std::ostringstream os;
-    int rc;
     DBContext db_context;
 
     // open DB
@@ -272,12 +378,13 @@ namespace SmartPeak
     os << table_name;
     os << "; ";
     std::string sql = os.str();
-    rc = sqlite3_prepare(*db, sql.c_str(), sql.size(), &db_context.stmt, NULL);
-    if (rc != SQLITE_OK)
+    db_context.stmt = prepareCachedStatement(*db, sql);
+    if (!db_context.stmt)
     {
-      logSQLError(sqlite3_errmsg(*db), sql);
+      closeSessionDB(*db);
       return std::nullopt;
     }
+    db_context.cached_stmt = true;
     return db_context;
   }
 
@@ -285,7 +392,6 @@ namespace SmartPeak
   std::optional<SessionDB::DBContext> SessionDB::beginReadWhere(const std::string& table_name, const std::string& where_id, const WhereValue& where_value, const Value& value, const Args& ...args)
   {
     std::ostringstream os;
-    int rc;
     DBContext db_context;
 
     // open DB
@@ -308,14 +414,30 @@ namespace SmartPeak
     os << table_name;
     os << " ";
     os << " WHERE ";
-    os << where_id << "=" << where_value << "; ";
+    os << where_id << "=?; ";
     std::string sql = os.str();
-    rc = sqlite3_prepare(*db, sql.c_str(), sql.size(), &db_context.stmt, NULL);
-    if (rc != SQLITE_OK)
+    db_context.stmt = prepareCachedStatement(*db, sql);
+    if (!db_context.stmt)
     {
-      logSQLError(sqlite3_errmsg(*db), sql);
+      closeSessionDB(*db);
       return std::nullopt;
     }
+    db_context.cached_stmt = true;
+    // the statement is stepped by read(), once the where value may have been destroyed
+    if constexpr (std::is_arithmetic_v<WhereValue>)
+    {
+      bindValues(db_context, 1, where_value);
+    }
+    else if constexpr (std::is_convertible_v<const WhereValue&, std::string>)
+    {
+      bindTransientValue(db_context.stmt, 1, where_value);
+    }
+    else
+    {
+      std::ostringstream where_os;
+      where_os << where_value;
+      bindTransientValue(db_context.stmt, 1, where_os.str());
+    }
     return db_context;
   }
 
@@ -359,7 +481,4 @@ namespace SmartPeak
     readRowFromDB(db_context, column++, args...);
   }
 
-  template <>
-  void SessionDB::write<std::string>(std::ostringstream& os, SessionDB::DBContext& db_context, const std::string& value);
-
 }
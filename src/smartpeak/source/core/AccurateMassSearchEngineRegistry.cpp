@@ -0,0 +1,177 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <SmartPeak/core/AccurateMassSearchEngineRegistry.h>
+
+#include <plog/Log.h>
+
+#include <exception>
+#include <filesystem>
+#include <sstream>
+#include <system_error>
+
+namespace SmartPeak
+{
+  SharedAccurateMassSearchEngine::SharedAccurateMassSearchEngine(const OpenMS::Param& parameters)
+  {
+    engine_.setParameters(parameters);
+    engine_.init();
+  }
+
+  void SharedAccurateMassSearchEngine::run(OpenMS::FeatureMap& features, OpenMS::MzTab& mztab_out)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    engine_.run(features, mztab_out);
+  }
+
+  const OpenMS::Param& SharedAccurateMassSearchEngine::getParameters() const
+  {
+    return engine_.getParameters();
+  }
+
+  AccurateMassSearchEngineRegistry::AccurateMassSearchEngineRegistry(size_t max_engines)
+    : max_engines_(max_engines)
+  {
+  }
+
+  AccurateMassSearchEngineRegistry& AccurateMassSearchEngineRegistry::instance()
+  {
+    static AccurateMassSearchEngineRegistry registry;
+    return registry;
+  }
+
+  std::string AccurateMassSearchEngineRegistry::makeKey(const OpenMS::Param& parameters)
+  {
+    std::ostringstream key;
+    for (auto it = parameters.begin(); it != parameters.end(); ++it)
+    {
+      key << it.getName() << "=" << it->value.toString() << "\n";
+    }
+    // the same parameters may point to files that have been updated
+    std::vector<std::string> files;
+    for (const std::string db_file_list : { "db:mapping", "db:struct" })
+    {
+      if (parameters.exists(db_file_list))
+      {
+        for (const auto& file : parameters.getValue(db_file_list).toStringVector())
+        {
+          files.push_back(file);
+        }
+      }
+    }
+    for (const std::string adducts_file : { "positive_adducts", "negative_adducts" })
+    {
+      if (parameters.exists(adducts_file))
+      {
+        files.push_back(parameters.getValue(adducts_file).toString());
+      }
+    }
+    for (const auto& file : files)
+    {
+      std::error_code ec;
+      const auto last_write_time = std::filesystem::last_write_time(file, ec);
+      if (ec)
+      {
+        continue; // not a local file, e.g. relative to the OpenMS data path
+      }
+      const auto file_size = std::filesystem::file_size(file, ec);
+      key << file << "@" << last_write_time.time_since_epoch().count() << ":" << (ec ? 0 : file_size) << "\n";
+    }
+    return key.str();
+  }
+
+  std::shared_ptr<SharedAccurateMassSearchEngine> AccurateMassSearchEngineRegistry::getEngine(const OpenMS::Param& parameters)
+  {
+    const std::string key = makeKey(parameters);
+
+    std::promise<std::shared_ptr<SharedAccurateMassSearchEngine>> promise;
+    std::shared_future<std::shared_ptr<SharedAccurateMassSearchEngine>> registered_engine;
+    size_t init_id = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entry = entries_.find(key);
+      if (entry != entries_.end())
+      {
+        lru_.splice(lru_.begin(), lru_, entry->second.lru_position);
+        registered_engine = entry->second.engine;
+      }
+      else
+      {
+        Entry& new_entry = entries_[key];
+        new_entry.engine = promise.get_future().share();
+        new_entry.init_id = init_id = ++next_init_id_;
+        lru_.push_front(key);
+        new_entry.lru_position = lru_.begin();
+        while (entries_.size() > max_engines_)
+        {
+          // engines still in use are released by their last user
+          erase(entries_.find(lru_.back()));
+        }
+      }
+    }
+    if (registered_engine.valid())
+    {
+      // initialised, or being initialised by another thread
+      return registered_engine.get();
+    }
+
+    try
+    {
+      LOGI << "Initializing AccurateMassSearchEngine";
+      auto engine = std::make_shared<SharedAccurateMassSearchEngine>(parameters);
+      promise.set_value(engine);
+      return engine;
+    }
+    catch (...)
+    {
+      promise.set_exception(std::current_exception());
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entry = entries_.find(key);
+      if (entry != entries_.end() && entry->second.init_id == init_id)
+      {
+        erase(entry);
+      }
+      throw;
+    }
+  }
+
+  size_t AccurateMassSearchEngineRegistry::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+  void AccurateMassSearchEngineRegistry::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+  }
+
+  void AccurateMassSearchEngineRegistry::erase(std::map<std::string, Entry>::iterator entry)
+  {
+    lru_.erase(entry->second.lru_position);
+    entries_.erase(entry);
+  }
+}
@@ -22,6 +22,7 @@
 // --------------------------------------------------------------------------
 
 #include <SmartPeak/core/ApplicationHandler.h>
+#include <SmartPeak/core/ParameterSchemaCache.h>
 #include <SmartPeak/core/SharedProcessors.h>
 #include <SmartPeak/core/SequenceProcessor.h>
 #include <SmartPeak/core/RawDataProcessors/LoadTransitions.h>
@@ -165,7 +166,7 @@ namespace SmartPeak
   ParameterSet ApplicationHandler::Command::getParameterSchema() const
   {
     const auto description = getIProcessorDescription();
-    return (description ? description->getParameterSchema() : ParameterSet());
+    return (description ? *ParameterSchemaCache::instance().getSchema(*description) : ParameterSet());
   }
 
   std::string ApplicationHandler::Command::getDescription() const
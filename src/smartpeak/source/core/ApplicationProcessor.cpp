@@ -23,6 +23,7 @@
 
 #include <SmartPeak/core/ApplicationProcessor.h>
 #include <SmartPeak/core/SequenceProcessor.h>
+#include <SmartPeak/core/WorkflowScheduler.h>
 
 namespace SmartPeak
 {
@@ -45,26 +46,6 @@ namespace SmartPeak
 
   namespace ApplicationProcessors {
 
-  template<typename COMMANDS_LIST_TYPE>
-  void notifyStartCommands(ApplicationProcessorObservable& observable, size_t start_index, const COMMANDS_LIST_TYPE& commands)
-  {
-    for (const auto command : commands)
-    {
-      observable.notifyApplicationProcessorCommandStart(start_index, command->getName());
-      start_index++;
-    }
-  }
-
-  template<typename COMMANDS_LIST_TYPE>
-  void notifyEndCommands(ApplicationProcessorObservable& observable, size_t start_index, const COMMANDS_LIST_TYPE& commands)
-  {
-    for (const auto command : commands)
-    {
-      observable.notifyApplicationProcessorCommandEnd(start_index, command->getName());
-      start_index++;
-    }
-  }
-
   void processCommands(ApplicationHandler& application_handler,
     std::vector<ApplicationHandler::Command> commands,
     const std::set<std::string>& injection_names, 
@@ -74,7 +55,8 @@ namespace SmartPeak
     IApplicationProcessorObserver* application_processor_observer,
     ISequenceProcessorObserver* sequence_processor_observer,
     ISequenceSegmentProcessorObserver* sequence_segment_processor_observer,
-    ISampleGroupProcessorObserver* sample_group_processor_observer)
+    ISampleGroupProcessorObserver* sample_group_processor_observer,
+    const CancellationToken& token)
   {
     ApplicationProcessorObservable observable;
     observable.addApplicationProcessorObserver(application_processor_observer);
@@ -86,6 +68,7 @@ namespace SmartPeak
     }
     observable.notifyApplicationProcessorStart(commands_names);
 
+    WorkflowScheduler scheduler(application_handler.sequenceHandler_);
     size_t i = 0;
     while (i < commands.size()) {
       const ApplicationHandler::Command::CommandType type = commands[i].type;
@@ -94,87 +77,13 @@ namespace SmartPeak
         // empty body
       }
       const ApplicationHandler::Command& cmd = commands[i];
+      const std::vector<ApplicationHandler::Command> stage_commands(commands.begin() + i, commands.begin() + j);
       if (cmd.type == ApplicationHandler::Command::RawDataMethod) {
-        std::vector<std::shared_ptr<RawDataProcessor>> raw_methods;
-        std::map<std::string, Filenames> filenames;
-        std::for_each(commands.begin() + i, commands.begin() + j,
-          [&](const ApplicationHandler::Command& command) 
-        { 
-          raw_methods.push_back(command.raw_data_method);
-          for (const auto& filename_to_merge : command.dynamic_filenames)
-          {
-            if (filenames.find(filename_to_merge.first) == filenames.end())
-            {
-              filenames.emplace(filename_to_merge.first, filename_to_merge.second);
-            }
-            else
-            {
-              filenames.at(filename_to_merge.first).merge(filename_to_merge.second);
-            }
-          }
-        });
-        ProcessSequence ps(application_handler.sequenceHandler_, sequence_processor_observer);
-        ps.filenames_ = filenames;
-        ps.raw_data_processing_methods_ = raw_methods;
-        ps.injection_names_ = injection_names;
-        ps.number_of_threads_ = number_of_threads;
-        notifyStartCommands<decltype(raw_methods)>(observable, i, raw_methods);
-        ps.process(application_handler.filenames_);
-        notifyEndCommands<decltype(raw_methods)>(observable, i, raw_methods);
+        scheduler.addRawDataStage(i, stage_commands, injection_names, sequence_processor_observer);
       } else if (cmd.type == ApplicationHandler::Command::SequenceSegmentMethod) {
-        std::vector<std::shared_ptr<SequenceSegmentProcessor>> seq_seg_methods;
-        std::map<std::string, Filenames> filenames;
-        std::for_each(commands.begin() + i, commands.begin() + j,
-          [&](const ApplicationHandler::Command& command)
-        {
-          seq_seg_methods.push_back(command.seq_seg_method);
-          for (const auto& filename_to_merge : command.dynamic_filenames)
-          {
-            if (filenames.find(filename_to_merge.first) == filenames.end())
-            {
-              filenames.emplace(filename_to_merge.first, filename_to_merge.second);
-            }
-            else
-            {
-              filenames.at(filename_to_merge.first).merge(filename_to_merge.second);
-            }
-          }
-        });
-        ProcessSequenceSegments pss(application_handler.sequenceHandler_, sequence_segment_processor_observer);
-        pss.filenames_ = filenames;
-        pss.sequence_segment_processing_methods_ = seq_seg_methods;
-        pss.sequence_segment_names_ = sequence_segment_names;
-        pss.number_of_threads_ = number_of_threads;
-        notifyStartCommands<decltype(seq_seg_methods)>(observable, i, seq_seg_methods);
-        pss.process(application_handler.filenames_);
-        notifyEndCommands<decltype(seq_seg_methods)>(observable, i, seq_seg_methods);
+        scheduler.addSequenceSegmentStage(i, stage_commands, sequence_segment_names, sequence_segment_processor_observer);
       } else if (cmd.type == ApplicationHandler::Command::SampleGroupMethod) {
-        std::vector<std::shared_ptr<SampleGroupProcessor>> sample_group_methods;
-        std::map<std::string, Filenames> filenames;
-        std::for_each(commands.begin() + i, commands.begin() + j,
-          [&](const ApplicationHandler::Command& command)
-        {
-          sample_group_methods.push_back(command.sample_group_method);
-          for (const auto& filename_to_merge : command.dynamic_filenames)
-          {
-            if (filenames.find(filename_to_merge.first) == filenames.end())
-            {
-              filenames.emplace(filename_to_merge.first, filename_to_merge.second);
-            }
-            else
-            {
-              filenames.at(filename_to_merge.first).merge(filename_to_merge.second);
-            }
-          }
-        });
-        ProcessSampleGroups psg(application_handler.sequenceHandler_, sample_group_processor_observer);
-        psg.filenames_ = filenames;
-        psg.sample_group_processing_methods_ = sample_group_methods;
-        psg.sample_group_names_ = sample_group_names;
-        psg.number_of_threads_ = number_of_threads;
-        notifyStartCommands<decltype(sample_group_methods)>(observable, i, sample_group_methods);
-        psg.process(application_handler.filenames_);
-        notifyEndCommands<decltype(sample_group_methods)>(observable, i, sample_group_methods);
+        scheduler.addSampleGroupStage(i, stage_commands, sample_group_names, sample_group_processor_observer);
       }
       else 
       {
@@ -182,6 +91,9 @@ namespace SmartPeak
       }
       i = j;
     }
+    // Each injection, sequence segment and sample group starts as soon as the injections it
+    // depends on are done with the previous commands
+    scheduler.run(number_of_threads, &observable, token);
     observable.notifyApplicationProcessorEnd();
   }
   }
@@ -26,6 +26,17 @@
 #include <SmartPeak/core/ApplicationProcessors/LoadPropertiesHandlers.h>
 #include <SmartPeak/core/ApplicationProcessors/BuildCommandsFromNames.h>
 #include <SmartPeak/core/SequenceProcessor.h>
+#include <SmartPeak/core/RawDataProcessors/LoadParameters.h>
+#include <SmartPeak/core/RawDataProcessors/LoadTransitions.h>
+#include <SmartPeak/core/ThreadPool.h>
+#include <plog/Log.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
 
 namespace SmartPeak
 {
@@ -62,8 +73,134 @@ namespace SmartPeak
     return true;
   }
 
+  namespace
+  {
+    /**
+      Loading steps that must run one after the other, because they fill the same data
+      (e.g. the component and the component group filters of a sequence segment).
+    */
+    struct LoadingChain
+    {
+      std::vector<std::string> descriptions;
+      std::vector<std::function<void(Filenames&)>> steps;
+    };
+
+    std::string describeLoadingProcessor(const std::shared_ptr<IFilenamesHandler>& loading_processor, const std::string& scope)
+    {
+      Filenames loading_processor_filenames;
+      loading_processor->getFilenames(loading_processor_filenames);
+      std::string description;
+      for (const auto& file_id : loading_processor_filenames.getFileIds())
+      {
+        description += (description.empty() ? "" : ", ") + file_id;
+      }
+      if (!scope.empty())
+      {
+        description += " (" + scope + ")";
+      }
+      return description;
+    }
+
+    /**
+      Notifications of the loaders running on the worker threads.
+      They are sent to the observers of the session from the loading thread, once all the files are loaded,
+      each notification once.
+    */
+    template<typename Observable>
+    class DeferredNotifications
+    {
+    public:
+      explicit DeferredNotifications(Observable* target) : target_(target) {}
+
+      void defer(void (Observable::*notify)())
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (std::find(pending_.begin(), pending_.end(), notify) == pending_.end())
+        {
+          pending_.push_back(notify);
+        }
+      }
+
+      void send()
+      {
+        for (auto notify : pending_)
+        {
+          (target_->*notify)();
+        }
+        pending_.clear();
+      }
+
+    protected:
+      Observable* target_;
+      std::mutex mutex_;
+      std::vector<void (Observable::*)()> pending_;
+    };
+
+    class DeferredSequenceSegmentNotifications :
+      public SequenceSegmentObservable,
+      public ISequenceSegmentObserver,
+      public DeferredNotifications<SequenceSegmentObservable>
+    {
+    public:
+      explicit DeferredSequenceSegmentNotifications(SequenceSegmentObservable* target) : DeferredNotifications(target)
+      {
+        addSequenceSegmentObserver(this);
+      }
+      void onQuantitationMethodsUpdated() override { defer(&SequenceSegmentObservable::notifyQuantitationMethodsUpdated); }
+      void onStandardsConcentrationsUpdated() override { defer(&SequenceSegmentObservable::notifyStandardsConcentrationsUpdated); }
+      void onFeatureFiltersComponentsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureFiltersComponentsUpdated); }
+      void onFeatureFiltersComponentGroupsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureFiltersComponentGroupsUpdated); }
+      void onFeatureQCComponentsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureQCComponentsUpdated); }
+      void onFeatureQCComponentGroupsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureQCComponentGroupsUpdated); }
+      void onFeatureRSDFilterComponentsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureRSDFilterComponentsUpdated); }
+      void onFeatureRSDFilterComponentGroupsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureRSDFilterComponentGroupsUpdated); }
+      void onFeatureRSDQCComponentsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureRSDQCComponentsUpdated); }
+      void onFeatureRSDQCComponentGroupsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureRSDQCComponentGroupsUpdated); }
+      void onFeatureBackgroundFilterComponentsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureBackgroundFilterComponentsUpdated); }
+      void onFeatureBackgroundFilterComponentGroupsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureBackgroundFilterComponentGroupsUpdated); }
+      void onFeatureBackgroundQCComponentsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureBackgroundQCComponentsUpdated); }
+      void onFeatureBackgroundQCComponentGroupsUpdated() override { defer(&SequenceSegmentObservable::notifyFeatureBackgroundQCComponentGroupsUpdated); }
+    };
+
+    class DeferredParametersNotifications :
+      public ParametersObservable,
+      public IParametersObserver,
+      public DeferredNotifications<ParametersObservable>
+    {
+    public:
+      explicit DeferredParametersNotifications(ParametersObservable* target) : DeferredNotifications(target)
+      {
+        addParametersObserver(this);
+      }
+      void onParametersUpdated() override { defer(&ParametersObservable::notifyParametersUpdated); }
+    };
+
+    class DeferredTransitionsNotifications :
+      public TransitionsObservable,
+      public ITransitionsObserver,
+      public DeferredNotifications<TransitionsObservable>
+    {
+    public:
+      explicit DeferredTransitionsNotifications(TransitionsObservable* target) : DeferredNotifications(target)
+      {
+        addTransitionsObserver(this);
+      }
+      void onTransitionsUpdated() override { defer(&TransitionsObservable::notifyTransitionsUpdated); }
+    };
+
+    void loadTimed(const std::string& description, const std::function<void()>& load)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      load();
+      const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+      LOGI << "Loaded " << description << " in " << elapsed.count() << " ms";
+    }
+  }
+
   bool LoadSession::readInputFiles()
   {
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<IFilenamesHandler>> loading_processors;
     for (auto& loading_processor : application_handler_.loading_processors_)
     {
       // check if we need to use that loading processor
@@ -75,76 +212,179 @@ namespace SmartPeak
         load_it |= (filenames_->isEmbedded(file_id)
           || (!filenames_->getFullPath(file_id).empty()));
       }
-
       if (load_it)
       {
-        auto sequence_processor = std::dynamic_pointer_cast<SequenceProcessor>(loading_processor);
-        if (sequence_processor)
+        loading_processors.push_back(loading_processor);
+      }
+    }
+
+    // The sequence processors create the injections and sequence segments that the other files are loaded into
+    for (auto& loading_processor : loading_processors)
+    {
+      auto sequence_processor = std::dynamic_pointer_cast<SequenceProcessor>(loading_processor);
+      if (sequence_processor)
+      {
+        try
         {
-          try
-          {
-            sequence_processor->process(*filenames_);
-          }
-          catch (const std::exception& e)
+          loadTimed(describeLoadingProcessor(loading_processor, ""), [&]() { sequence_processor->process(*filenames_); });
+        }
+        catch (const std::exception& e)
+        {
+          LOGE << e.what();
+          notifyApplicationProcessorError(e.what());
+          return false;
+        }
+      }
+    }
+
+    // The remaining files are independent, except when they fill the same outputs of the same handler
+    std::vector<LoadingChain> chains;
+    std::map<std::string, size_t> chain_per_output;
+    auto add_step = [&](const std::shared_ptr<IFilenamesHandler>& loading_processor, const std::string& scope, std::function<void(Filenames&)> step)
+    {
+      std::set<std::string> outputs;
+      auto processor_description = std::dynamic_pointer_cast<IProcessorDescription>(loading_processor);
+      if (processor_description)
+      {
+        outputs = processor_description->getOutputs();
+      }
+      size_t chain_index = chains.size();
+      for (const auto& output : outputs)
+      {
+        auto chain = chain_per_output.find(scope + "/" + output);
+        if (chain != chain_per_output.end())
+        {
+          chain_index = chain->second;
+          break;
+        }
+      }
+      if (chain_index == chains.size())
+      {
+        chains.emplace_back();
+      }
+      for (const auto& output : outputs)
+      {
+        chain_per_output.emplace(scope + "/" + output, chain_index);
+      }
+      chains[chain_index].descriptions.push_back(describeLoadingProcessor(loading_processor, scope));
+      chains[chain_index].steps.push_back(std::move(step));
+    };
+
+    for (auto& loading_processor : loading_processors)
+    {
+      auto raw_data_processor = std::dynamic_pointer_cast<RawDataProcessor>(loading_processor);
+      if (raw_data_processor)
+      {
+        if (!application_handler_.sequenceHandler_.getSequence().empty())
+        {
+          RawDataHandler& rawDataHandler = application_handler_.sequenceHandler_.getSequence()[0].getRawData();
+          add_step(loading_processor, "", [raw_data_processor, &rawDataHandler](Filenames& filenames)
           {
-            LOGE << e.what();
-            notifyApplicationProcessorError(e.what());
-            return false;
-          }
+            raw_data_processor->process(rawDataHandler, {}, filenames);
+          });
         }
-        auto raw_data_processor = std::dynamic_pointer_cast<RawDataProcessor>(loading_processor);
-        if (raw_data_processor)
+        else
         {
-          if (!application_handler_.sequenceHandler_.getSequence().empty())
+          LOGE << "No Sequence available, Loading process aborted.";
+          notifyApplicationProcessorError("Failed to load session");
+          return false;
+        }
+      }
+      auto sequence_segment_processor = std::dynamic_pointer_cast<SequenceSegmentProcessor>(loading_processor);
+      if (sequence_segment_processor)
+      {
+        if (!application_handler_.sequenceHandler_.getSequenceSegments().empty())
+        {
+          sequence_segment_processor->sequence_segment_observable_ = &application_handler_.sequenceHandler_;
+          for (auto& sequenceSegmentHandler : application_handler_.sequenceHandler_.getSequenceSegments())
           {
-            RawDataHandler& rawDataHandler = application_handler_.sequenceHandler_.getSequence()[0].getRawData();
-            try
-            {
-              raw_data_processor->process(rawDataHandler, {}, *filenames_);
-            }
-            catch (const std::exception& e)
+            add_step(loading_processor, sequenceSegmentHandler.getSequenceSegmentName(), [sequence_segment_processor, &sequenceSegmentHandler](Filenames& filenames)
             {
-              LOGE << e.what();
-              notifyApplicationProcessorError(e.what());
-              return false;
-            }
-          }
-          else
-          {
-            LOGE << "No Sequence available, Loading process aborted.";
-            notifyApplicationProcessorError("Failed to load session");
-            return false;
+              sequence_segment_processor->process(sequenceSegmentHandler, SequenceHandler(), {}, filenames);
+            });
           }
         }
-        auto sequence_segment_processor = std::dynamic_pointer_cast<SequenceSegmentProcessor>(loading_processor);
-        if (sequence_segment_processor)
+        else
+        {
+          LOGE << "No Sequence Segment available, Loading process aborted.";
+          notifyApplicationProcessorError("Failed to load session");
+          return false;
+        }
+      }
+    }
+
+    // the observers of the session are notified from this thread, once all the files are loaded
+    DeferredSequenceSegmentNotifications sequence_segment_notifications(&application_handler_.sequenceHandler_);
+    DeferredParametersNotifications parameters_notifications(&application_handler_.sequenceHandler_);
+    DeferredTransitionsNotifications transitions_notifications(&application_handler_.sequenceHandler_);
+    std::vector<std::function<void()>> restore_observables;
+    for (auto& loading_processor : loading_processors)
+    {
+      if (auto processor = std::dynamic_pointer_cast<SequenceSegmentProcessor>(loading_processor); processor && processor->sequence_segment_observable_)
+      {
+        restore_observables.push_back([processor, observable = processor->sequence_segment_observable_]() { processor->sequence_segment_observable_ = observable; });
+        processor->sequence_segment_observable_ = &sequence_segment_notifications;
+      }
+      if (auto processor = std::dynamic_pointer_cast<LoadParameters>(loading_processor); processor && processor->parameters_observable_)
+      {
+        restore_observables.push_back([processor, observable = processor->parameters_observable_]() { processor->parameters_observable_ = observable; });
+        processor->parameters_observable_ = &parameters_notifications;
+      }
+      if (auto processor = std::dynamic_pointer_cast<LoadTransitions>(loading_processor); processor && processor->transitions_observable_)
+      {
+        restore_observables.push_back([processor, observable = processor->transitions_observable_]() { processor->transitions_observable_ = observable; });
+        processor->transitions_observable_ = &transitions_notifications;
+      }
+    }
+
+    CancellationToken token;
+    std::mutex error_mutex;
+    std::string error;
+    std::vector<std::future<void>> futures;
+    for (auto& chain : chains)
+    {
+      futures.push_back(ThreadPool::instance().submit([&]()
+      {
+        // the loading processors register their file ids, each chain works on its own copy
+        Filenames filenames = *filenames_;
+        for (size_t i = 0; i < chain.steps.size() && !token.isCancelled(); ++i)
         {
-          if (!application_handler_.sequenceHandler_.getSequenceSegments().empty())
+          try
           {
-            for (auto& sequenceSegmentHandler : application_handler_.sequenceHandler_.getSequenceSegments())
-            {
-              sequence_segment_processor->sequence_segment_observable_ = &application_handler_.sequenceHandler_;
-              try
-              {
-                sequence_segment_processor->process(sequenceSegmentHandler, SequenceHandler(), {}, *filenames_);
-              }
-              catch (const std::exception& e)
-              {
-                LOGE << e.what();
-                notifyApplicationProcessorError(e.what());
-                return false;
-              }
-            }
+            loadTimed(chain.descriptions[i], [&]() { chain.steps[i](filenames); });
           }
-          else
+          catch (const std::exception& e)
           {
-            LOGE << "No Sequence Segment available, Loading process aborted.";
-            notifyApplicationProcessorError("Failed to load session");
-            return false;
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (error.empty())
+            {
+              error = e.what();
+            }
+            token.cancel();
           }
         }
-      }
+      }, token));
     }
+    for (auto& future : futures)
+    {
+      ThreadPool::instance().wait(future);
+    }
+    for (const auto& restore_observable : restore_observables)
+    {
+      restore_observable();
+    }
+    sequence_segment_notifications.send();
+    parameters_notifications.send();
+    transitions_notifications.send();
+    if (!error.empty())
+    {
+      LOGE << error;
+      notifyApplicationProcessorError(error);
+      return false;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    LOGI << "Loaded session input files in " << elapsed.count() << " ms";
     return true;
   }
   
@@ -26,7 +26,8 @@
 #include <SmartPeak/core/EventDispatcher.h>
 
 #include <plog/Log.h>
-#include <future>
+#include <algorithm>
+#include <chrono>
 #include <thread>
 #include <string>
 #include <vector>
@@ -34,38 +35,38 @@
 namespace SmartPeak
 {
 
+    EventDispatcher::EventDispatcher(size_t capacity, std::chrono::milliseconds max_queue_wait) :
+      events_(capacity),
+      dispatcher_thread_(std::this_thread::get_id()),
+      max_queue_wait_(max_queue_wait)
+    {
+    }
+
     /**
       IApplicationProcessorObserver
     */
     void EventDispatcher::onApplicationProcessorStart(const std::vector<std::string>& commands)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, commands] { this->notifyApplicationProcessorStart(commands); }
-      )));
+      Event event;
+      event.type = Event::Type::ApplicationProcessorStart;
+      event.commands = commands;
+      queueEvent(event);
     }
     void EventDispatcher::onApplicationProcessorCommandStart(size_t command_index, const std::string& command_name)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, command_index, command_name] { this->notifyApplicationProcessorCommandStart(command_index, command_name); }
-      )));
+      queueEvent(Event::Type::ApplicationProcessorCommandStart, command_index, command_name);
     }
     void EventDispatcher::onApplicationProcessorCommandEnd(size_t command_index, const std::string& command_name)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, command_index, command_name] { this->notifyApplicationProcessorCommandEnd(command_index, command_name); }
-      )));
+      queueEvent(Event::Type::ApplicationProcessorCommandEnd, command_index, command_name);
     }
     void EventDispatcher::onApplicationProcessorEnd()
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this] { this->notifyApplicationProcessorEnd(); }
-      )));
+      queueEvent(Event::Type::ApplicationProcessorEnd);
     }
     void EventDispatcher::onApplicationProcessorError(const std::string& error)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, error] { this->notifyApplicationProcessorError(error); }
-      )));
+      queueEvent(Event::Type::ApplicationProcessorError, 0, "", "", error);
     }
 
     /**
@@ -73,9 +74,7 @@ namespace SmartPeak
     */
     void EventDispatcher::onFeaturesUpdated()
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this] { this->notifyFeaturesUpdated(); }
-      )));
+      queueEvent(Event::Type::FeaturesUpdated);
     }
 
     /**
@@ -83,67 +82,47 @@ namespace SmartPeak
     */
     void EventDispatcher::onSequenceProcessorStart(const size_t nb_injections)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, nb_injections] { this->notifySequenceProcessorStart(nb_injections); }
-      )));
+      queueEvent(Event::Type::SequenceProcessorStart, nb_injections);
     }
     void EventDispatcher::onSequenceProcessorSampleStart(const std::string& sample_name)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, sample_name] { this->notifySequenceProcessorSampleStart(sample_name); }
-      )));
+      queueEvent(Event::Type::SequenceProcessorSampleStart, 0, sample_name);
     }
     void EventDispatcher::onSequenceProcessorSampleEnd(const std::string& sample_name)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, sample_name] { this->notifySequenceProcessorSampleEnd(sample_name); }
-      )));
+      queueEvent(Event::Type::SequenceProcessorSampleEnd, 0, sample_name);
     }
     void EventDispatcher::onSequenceProcessorEnd()
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this] { this->notifySequenceProcessorEnd(); }
-      )));
+      queueEvent(Event::Type::SequenceProcessorEnd);
+    }
+    void EventDispatcher::onSequenceProcessorError(const std::string& sample_name, const std::string& processor_name, const std::string& error)
+    {
+      queueEvent(Event::Type::SequenceProcessorError, 0, sample_name, processor_name, error);
     }
 
     /**
       ISequenceSegmentProcessorObserver
     */
-    void EventDispatcher::onSequenceProcessorError(const std::string& sample_name, const std::string& processor_name, const std::string& error)
-    {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, sample_name, processor_name, error] { this->notifySequenceProcessorError(sample_name, processor_name, error); }
-      )));
-    }
     void EventDispatcher::onSequenceSegmentProcessorStart(const size_t nb_segments)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, nb_segments] { this->notifySequenceSegmentProcessorStart(nb_segments); }
-      )));
+      queueEvent(Event::Type::SequenceSegmentProcessorStart, nb_segments);
     }
     void EventDispatcher::onSequenceSegmentProcessorSampleStart(const std::string& segment_name)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, segment_name] { this->notifySequenceSegmentProcessorSampleStart(segment_name); }
-      )));
+      queueEvent(Event::Type::SequenceSegmentProcessorSampleStart, 0, segment_name);
     }
     void EventDispatcher::onSequenceSegmentProcessorSampleEnd(const std::string& segment_name)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, segment_name] { this->notifySequenceSegmentProcessorSampleEnd(segment_name); }
-      )));
+      queueEvent(Event::Type::SequenceSegmentProcessorSampleEnd, 0, segment_name);
     }
     void EventDispatcher::onSequenceSegmentProcessorEnd()
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this] { this->notifySequenceSegmentProcessorEnd(); }
-      )));
+      queueEvent(Event::Type::SequenceSegmentProcessorEnd);
     }
     void EventDispatcher::onSequenceSegmentProcessorError(const std::string& segment_name, const std::string& processor_name, const std::string& error)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, segment_name, processor_name, error] { this->notifySequenceSegmentProcessorError(segment_name, processor_name, error); }
-      )));
+      queueEvent(Event::Type::SequenceSegmentProcessorError, 0, segment_name, processor_name, error);
     }
 
     /**
@@ -151,33 +130,23 @@ namespace SmartPeak
     */
     void EventDispatcher::onSampleGroupProcessorStart(const size_t nb_groups)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, nb_groups] { this->notifySampleGroupProcessorStart(nb_groups); }
-      )));
+      queueEvent(Event::Type::SampleGroupProcessorStart, nb_groups);
     }
     void EventDispatcher::onSampleGroupProcessorSampleStart(const std::string& group_name)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, group_name] { this->notifySampleGroupProcessorSampleStart(group_name); }
-      )));
+      queueEvent(Event::Type::SampleGroupProcessorSampleStart, 0, group_name);
     }
     void EventDispatcher::onSampleGroupProcessorSampleEnd(const std::string& group_name)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, group_name] { this->notifySampleGroupProcessorSampleEnd(group_name); }
-      )));
+      queueEvent(Event::Type::SampleGroupProcessorSampleEnd, 0, group_name);
     }
     void EventDispatcher::onSampleGroupProcessorEnd()
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this] { this->notifySampleGroupProcessorEnd(); }
-      )));
+      queueEvent(Event::Type::SampleGroupProcessorEnd);
     }
     void EventDispatcher::onSampleGroupProcessorError(const std::string& group_name, const std::string& processor_name, const std::string& error)
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this, group_name, processor_name, error] { this->notifySampleGroupProcessorError(group_name, processor_name, error); }
-      )));
+      queueEvent(Event::Type::SampleGroupProcessorError, 0, group_name, processor_name, error);
     }
 
     /**
@@ -185,9 +154,7 @@ namespace SmartPeak
     */
     void EventDispatcher::onSequenceUpdated()
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this] { this->notifySequenceUpdated(); }
-      )));
+      queueEvent(Event::Type::SequenceUpdated);
     }
 
     /**
@@ -195,30 +162,234 @@ namespace SmartPeak
     */
     void EventDispatcher::onTransitionsUpdated()
     {
-      queueEvent(std::make_shared<std::future<void>>(std::async(std::launch::deferred,
-        [this] { this->notifyTransitionsUpdated(); }
-      )));
+      queueEvent(Event::Type::TransitionsUpdated);
     }
 
     void EventDispatcher::dispatchEvents()
     {
-      decltype(events_) events_to_dispatch;
+      std::lock_guard<std::recursive_mutex> lock(dispatch_mutex_);
+      dispatcher_thread_.store(std::this_thread::get_id());
+      dispatcher_stalled_.store(false);
+      // we will only dispatch the events already stored to avoid
+      // feeding events while we are dispatching them.
+      size_t nb_events = events_.size();
+      Event event;
+      while (nb_events-- && events_.tryPop(event))
+      {
+        dispatchEvent(event);
+      }
+      // then the events deferred while the ring was not drained, they are newer than the ones of the ring
+      std::deque<Event> overflow_events;
+      {
+        std::lock_guard<std::mutex> overflow_lock(overflow_mutex_);
+        overflow_events.swap(overflow_events_);
+        overflow_updates_.clear();
+        has_overflow_events_.store(false);
+      }
+      for (const Event& overflow_event : overflow_events)
+      {
+        dispatchEvent(overflow_event);
+      }
+    }
+
+    void EventDispatcher::queueEvent(Event::Type type, size_t index, const std::string& name,
+                                     const std::string& processor_name, const std::string& error)
+    {
+      Event event;
+      event.type = type;
+      event.index = index;
+      event.name = name;
+      event.processor_name = processor_name;
+      event.error = error;
+      queueEvent(event);
+    }
+
+    void EventDispatcher::queueEvent(Event& event)
+    {
+      if (has_overflow_events_.load())
+      {
+        // keep the order with the events already deferred
+        deferEvent(event);
+        notifyWaitingThreads();
+        return;
+      }
+      const auto deadline = std::chrono::steady_clock::now() + max_queue_wait_;
+      size_t nb_attempts = 0;
+      while (!events_.tryPush(event))
+      {
+        if (std::this_thread::get_id() == dispatcher_thread_.load())
+        {
+          // nobody else will drain the events
+          dispatchEvents();
+        }
+        else if (dispatcher_stalled_.load())
+        {
+          deferEvent(event);
+          notifyWaitingThreads();
+          return;
+        }
+        else if (++nb_attempts < 64)
+        {
+          std::this_thread::yield();
+        }
+        else if (std::chrono::steady_clock::now() < deadline)
+        {
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        else if (!dispatcher_stalled_.exchange(true))
+        {
+          LOGW << "Events are not dispatched, dropping the progress events until the next dispatch";
+        }
+      }
+      notifyWaitingThreads();
+    }
+
+    bool EventDispatcher::waitForEvents(std::chrono::milliseconds timeout)
+    {
+      std::unique_lock<std::mutex> lock(wait_mutex_);
+      ++nb_waiting_threads_;
+      const bool has_events = events_cv_.wait_for(lock, timeout, [this]() {
+        // pairs with the fence of notifyWaitingThreads: either the worker sees this thread waiting, or this thread sees its event
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return events_.size() > 0 || has_overflow_events_.load();
+      });
+      --nb_waiting_threads_;
+      return has_events;
+    }
+
+    void EventDispatcher::notifyWaitingThreads()
+    {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (nb_waiting_threads_.load())
       {
-        // we will dispatch a copy of the events to avoid
-        // feeding events while we are dispatching them.
-        std::scoped_lock lock(event_queue_mutex_);
-        events_to_dispatch.swap(events_);
+        {
+          // a waiting thread is then either before its check of the events, or waiting
+          std::lock_guard<std::mutex> lock(wait_mutex_);
+        }
+        events_cv_.notify_all();
       }
-      for (auto& event : events_to_dispatch)
+    }
+
+    void EventDispatcher::deferEvent(Event& event)
+    {
+      if (isProgressEvent(event.type))
       {
-        event->get();
+        ++nb_dropped_events_;
+        return;
+      }
+      std::lock_guard<std::mutex> overflow_lock(overflow_mutex_);
+      if (isUpdateEvent(event.type))
+      {
+        // the observers read the current state, one notification is enough
+        if (std::find(overflow_updates_.begin(), overflow_updates_.end(), event.type) != overflow_updates_.end())
+        {
+          return;
+        }
+        overflow_updates_.push_back(event.type);
+      }
+      overflow_events_.push_back(std::move(event));
+      has_overflow_events_.store(true);
+    }
+
+    bool EventDispatcher::isProgressEvent(Event::Type type)
+    {
+      switch (type)
+      {
+      case Event::Type::ApplicationProcessorCommandStart:
+      case Event::Type::ApplicationProcessorCommandEnd:
+      case Event::Type::SequenceProcessorSampleStart:
+      case Event::Type::SequenceProcessorSampleEnd:
+      case Event::Type::SequenceSegmentProcessorSampleStart:
+      case Event::Type::SequenceSegmentProcessorSampleEnd:
+      case Event::Type::SampleGroupProcessorSampleStart:
+      case Event::Type::SampleGroupProcessorSampleEnd:
+        return true;
+      default:
+        return false;
       }
     }
 
-    void EventDispatcher::queueEvent(std::shared_ptr<std::future<void>> event)
+    bool EventDispatcher::isUpdateEvent(Event::Type type)
     {
-      std::scoped_lock lock(event_queue_mutex_);
-      events_.push_back(event);
+      return type == Event::Type::FeaturesUpdated ||
+             type == Event::Type::SequenceUpdated ||
+             type == Event::Type::TransitionsUpdated;
+    }
+
+    void EventDispatcher::dispatchEvent(const Event& event)
+    {
+      switch (event.type)
+      {
+      case Event::Type::ApplicationProcessorStart:
+        notifyApplicationProcessorStart(event.commands);
+        break;
+      case Event::Type::ApplicationProcessorCommandStart:
+        notifyApplicationProcessorCommandStart(event.index, event.name);
+        break;
+      case Event::Type::ApplicationProcessorCommandEnd:
+        notifyApplicationProcessorCommandEnd(event.index, event.name);
+        break;
+      case Event::Type::ApplicationProcessorEnd:
+        notifyApplicationProcessorEnd();
+        break;
+      case Event::Type::ApplicationProcessorError:
+        notifyApplicationProcessorError(event.error);
+        break;
+      case Event::Type::FeaturesUpdated:
+        notifyFeaturesUpdated();
+        break;
+      case Event::Type::SequenceProcessorStart:
+        notifySequenceProcessorStart(event.index);
+        break;
+      case Event::Type::SequenceProcessorSampleStart:
+        notifySequenceProcessorSampleStart(event.name);
+        break;
+      case Event::Type::SequenceProcessorSampleEnd:
+        notifySequenceProcessorSampleEnd(event.name);
+        break;
+      case Event::Type::SequenceProcessorEnd:
+        notifySequenceProcessorEnd();
+        break;
+      case Event::Type::SequenceProcessorError:
+        notifySequenceProcessorError(event.name, event.processor_name, event.error);
+        break;
+      case Event::Type::SequenceSegmentProcessorStart:
+        notifySequenceSegmentProcessorStart(event.index);
+        break;
+      case Event::Type::SequenceSegmentProcessorSampleStart:
+        notifySequenceSegmentProcessorSampleStart(event.name);
+        break;
+      case Event::Type::SequenceSegmentProcessorSampleEnd:
+        notifySequenceSegmentProcessorSampleEnd(event.name);
+        break;
+      case Event::Type::SequenceSegmentProcessorEnd:
+        notifySequenceSegmentProcessorEnd();
+        break;
+      case Event::Type::SequenceSegmentProcessorError:
+        notifySequenceSegmentProcessorError(event.name, event.processor_name, event.error);
+        break;
+      case Event::Type::SampleGroupProcessorStart:
+        notifySampleGroupProcessorStart(event.index);
+        break;
+      case Event::Type::SampleGroupProcessorSampleStart:
+        notifySampleGroupProcessorSampleStart(event.name);
+        break;
+      case Event::Type::SampleGroupProcessorSampleEnd:
+        notifySampleGroupProcessorSampleEnd(event.name);
+        break;
+      case Event::Type::SampleGroupProcessorEnd:
+        notifySampleGroupProcessorEnd();
+        break;
+      case Event::Type::SampleGroupProcessorError:
+        notifySampleGroupProcessorError(event.name, event.processor_name, event.error);
+        break;
+      case Event::Type::SequenceUpdated:
+        notifySequenceUpdated();
+        break;
+      case Event::Type::TransitionsUpdated:
+        notifyTransitionsUpdated();
+        break;
+      }
     }
 
 }
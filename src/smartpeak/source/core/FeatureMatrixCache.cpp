@@ -0,0 +1,223 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <SmartPeak/core/FeatureMatrixCache.h>
+#include <SmartPeak/core/CastValue.h>
+#include <SmartPeak/core/InjectionHandler.h>
+#include <SmartPeak/core/SequenceHandler.h>
+
+#include <cmath>
+#include <unordered_set>
+
+namespace SmartPeak
+{
+  namespace
+  {
+    constexpr char const * const s_PeptideRef {"PeptideRef"};
+    constexpr char const * const s_native_id {"native_id"};
+
+    bool isUsed(const OpenMS::Feature& feature)
+    {
+      if (feature.metaValueExists("used_")) {
+        const std::string used = feature.getMetaValue("used_").toString();
+        if (used.empty() || used[0] == 'f' || used[0] == 'F')
+          return false;
+      }
+      return true;
+    }
+  }
+
+  void FeatureMatrixCache::setGeneration(uint64_t features_generation)
+  {
+    if (features_generation != generation_) {
+      clear();
+      generation_ = features_generation;
+    }
+  }
+
+  void FeatureMatrixCache::clear()
+  {
+    row_ids_.clear();
+    rows_.clear();
+    injection_ids_.clear();
+    meta_value_ids_.clear();
+    cells_.clear();
+    n_extractions_ = 0;
+  }
+
+  uint32_t FeatureMatrixCache::intern(std::map<std::string, uint32_t>& ids, const std::string& name)
+  {
+    return ids.emplace(name, static_cast<uint32_t>(ids.size())).first->second;
+  }
+
+  uint32_t FeatureMatrixCache::internRow(const std::string& component_group_name, const std::string& component_name,
+                                         const std::string& meta_value_name, bool is_subordinate)
+  {
+    // same ordering and equality as the rows of SequenceParser::makeDataMatrixFromMetaValue
+    const auto inserted = row_ids_.emplace(component_group_name + component_name + meta_value_name, static_cast<uint32_t>(rows_.size()));
+    if (inserted.second) {
+      rows_.push_back({ component_group_name, component_name, meta_value_name, is_subordinate });
+    }
+    return inserted.first->second;
+  }
+
+  const std::vector<FeatureMatrixCache::Cell>& FeatureMatrixCache::getCells(const InjectionHandler& injection, const std::string& meta_value_name)
+  {
+    const uint64_t key = (static_cast<uint64_t>(intern(injection_ids_, injection.getMetaData().getInjectionName())) << 32)
+      | intern(meta_value_ids_, meta_value_name);
+    auto cached_cells = cells_.find(key);
+    if (cached_cells != cells_.end()) {
+      return cached_cells->second;
+    }
+    ++n_extractions_;
+    std::vector<Cell>& cells = cells_[key];
+    std::unordered_set<uint32_t> extracted_rows; // the first value of a row is kept
+    const auto add_cell = [&](uint32_t row, const CastValue& datum) {
+      if (extracted_rows.insert(row).second) {
+        // NAN are replaced by 0
+        const bool is_number = datum.getTag() == CastValue::Type::FLOAT && !std::isnan(datum.f_);
+        cells.push_back({ row, is_number ? datum.f_ : 0.0f });
+      }
+    };
+    const bool is_validation_metric = meta_value_name == "accuracy" || meta_value_name == "n_features";
+    const SequenceHandler::MetaValueKey meta_value = SequenceHandler::resolveMetaValue(meta_value_name);
+    const std::map<std::string, float>& validation_metrics = injection.getRawData().getValidationMetrics();
+    for (const OpenMS::Feature& feature : injection.getRawData().getFeatureMapHistory()) {
+      if (!isUsed(feature))
+        continue;
+      const std::string component_group_name = feature.getMetaValue(s_PeptideRef).toString();
+
+      // Case #1 Features only
+      if (feature.getSubordinates().empty()) {
+        const uint32_t row = internRow(component_group_name, "", meta_value_name, false);
+        add_cell(row, is_validation_metric ? CastValue(validation_metrics.at(meta_value_name))
+                                           : SequenceHandler::getMetaValue(feature, feature, meta_value));
+      }
+
+      // Case #2 Features and subordinates
+      for (const OpenMS::Feature& subordinate : feature.getSubordinates()) {
+        if (!isUsed(subordinate))
+          continue;
+        const uint32_t row = internRow(component_group_name, subordinate.getMetaValue(s_native_id).toString(), meta_value_name, true);
+        CastValue datum = is_validation_metric ? CastValue(validation_metrics.at(meta_value_name))
+                                               : SequenceHandler::getMetaValue(feature, subordinate, meta_value);
+        if (meta_value.field == SequenceHandler::MetaValueKey::Field::validation) {
+          if (datum.s_ == "TP") datum = static_cast<float>(1.0);
+          else if (datum.s_ == "FP") datum = static_cast<float>(-1.0);
+          else datum = static_cast<float>(-2.0);
+        }
+        add_cell(row, datum);
+      }
+    }
+    return cells;
+  }
+
+  void FeatureMatrixCache::makeDataMatrix(
+    const SequenceHandler& sequenceHandler,
+    Eigen::Tensor<float, 2>& data_out,
+    Eigen::Tensor<std::string, 1>& columns_out,
+    Eigen::Tensor<std::string, 2>& rows_out,
+    const std::vector<std::string>& meta_data,
+    const std::set<SampleType>& sample_types,
+    const std::set<std::string>& sample_names,
+    const std::set<std::string>& component_group_names,
+    const std::set<std::string>& component_names
+  )
+  {
+    // cells of the selected rows, by sample name, in the order of the injections and meta values
+    std::map<std::string, std::vector<Cell>> column_cells;
+    std::vector<signed char> selected_rows; // -1: not evaluated yet, 0: filtered out, 1: selected
+    const auto is_selected_row = [&](uint32_t row) {
+      if (row >= selected_rows.size()) {
+        selected_rows.resize(rows_.size(), -1);
+      }
+      if (selected_rows[row] < 0) {
+        const RowInfo& row_info = rows_[row];
+        selected_rows[row] =
+          (component_group_names.empty() || component_group_names.count(row_info.component_group_name)) &&
+          (!row_info.is_subordinate || component_names.empty() || component_names.count(row_info.component_name));
+      }
+      return selected_rows[row] == 1;
+    };
+    for (const InjectionHandler& injection : sequenceHandler.getSequence()) {
+      const MetaDataHandler& mdh = injection.getMetaData();
+      const std::string& sample_name = mdh.getSampleName();
+      if (sample_names.size() && sample_names.count(sample_name) == 0)
+        continue;
+      if (sample_types.count(mdh.getSampleType()) == 0)
+        continue;
+      for (const std::string& meta_value_name : meta_data) {
+        for (const Cell& cell : getCells(injection, meta_value_name)) {
+          if (is_selected_row(cell.row)) {
+            column_cells[sample_name].push_back(cell);
+          }
+        }
+      }
+    }
+
+    // index the rows of the matrix
+    std::vector<int> row_index(rows_.size(), -1);
+    for (const auto& [sample_name, cells] : column_cells) {
+      for (const Cell& cell : cells) {
+        row_index[cell.row] = 0;
+      }
+    }
+    int n_rows = 0;
+    for (const auto& [key, row] : row_ids_) {
+      if (row_index[row] >= 0) {
+        row_index[row] = n_rows++;
+      }
+    }
+
+    // Copy over the rows
+    rows_out.resize(n_rows, 3);
+    for (const auto& [key, row] : row_ids_) {
+      if (row_index[row] >= 0) {
+        rows_out(row_index[row], 0) = rows_[row].component_name;
+        rows_out(row_index[row], 1) = rows_[row].component_group_name;
+        rows_out(row_index[row], 2) = rows_[row].meta_value_name;
+      }
+    }
+
+    // Copy over the columns and the data
+    const int n_cols = static_cast<int>(column_cells.size());
+    columns_out.resize(n_cols);
+    data_out.resize(n_rows, n_cols);
+    data_out.setConstant(0.0); // for now, initialize to 0 instead of NAN even though there are clear benefits to using NAN in packages that support NAN
+    std::vector<bool> assigned(static_cast<size_t>(n_rows) * n_cols, false);
+    int col = 0;
+    for (const auto& [sample_name, cells] : column_cells) {
+      columns_out(col) = sample_name;
+      for (const Cell& cell : cells) {
+        const int row = row_index[cell.row];
+        // the first injection of a sample name wins
+        if (!assigned[static_cast<size_t>(col) * n_rows + row]) {
+          assigned[static_cast<size_t>(col) * n_rows + row] = true;
+          data_out(row, col) = cell.value;
+        }
+      }
+      ++col;
+    }
+  }
+}
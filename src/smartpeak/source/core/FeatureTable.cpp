@@ -0,0 +1,272 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+#include <SmartPeak/core/FeatureTable.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace SmartPeak
+{
+  size_t FeatureTable::Column::size() const
+  {
+    switch (type)
+    {
+    case ColumnType::Text:
+      return texts.size();
+    case ColumnType::Integer:
+      return integers.size();
+    default:
+      return reals.size();
+    }
+  }
+
+  size_t FeatureTable::addColumn(const std::string& header)
+  {
+    if (getNRows() > 0)
+    {
+      throw std::logic_error("Columns must be added before the rows.");
+    }
+    headers_.push_back(header);
+    columns_.emplace_back();
+    return columns_.size() - 1;
+  }
+
+  void FeatureTable::reserve(size_t n_rows)
+  {
+    reserved_rows_ = n_rows;
+    for (auto& column : columns_)
+    {
+      if (column.typed)
+      {
+        reserveColumn(column);
+      }
+    }
+  }
+
+  void FeatureTable::reserveColumn(Column& column) const
+  {
+    switch (column.type)
+    {
+    case ColumnType::Text:
+      column.texts.reserve(reserved_rows_);
+      break;
+    case ColumnType::Integer:
+      column.integers.reserve(reserved_rows_);
+      break;
+    default:
+      column.reals.reserve(reserved_rows_);
+    }
+  }
+
+  FeatureTable::StringId FeatureTable::intern(const std::string& text)
+  {
+    const auto found = string_ids_.find(std::string_view(text));
+    if (found != string_ids_.end())
+    {
+      return found->second;
+    }
+    const StringId id = static_cast<StringId>(strings_.size());
+    strings_.push_back(text);
+    string_ids_.emplace(std::string_view(strings_.back()), id);
+    return id;
+  }
+
+  FeatureTable::Column& FeatureTable::appendable(size_t col, ColumnType type)
+  {
+    Column& column = columns_.at(col);
+    if (!column.typed)
+    {
+      // only missing values so far, stored as Real
+      column.typed = true;
+      if (type == ColumnType::Text || (type == ColumnType::Integer && column.reals.size()))
+      {
+        convertToText(column);
+      }
+      else
+      {
+        column.type = type;
+      }
+      reserveColumn(column);
+    }
+    else if (column.type != type)
+    {
+      convertToText(column);
+    }
+    return column;
+  }
+
+  void FeatureTable::convertToText(Column& column)
+  {
+    if (column.type == ColumnType::Text)
+    {
+      return;
+    }
+    std::vector<StringId> texts;
+    texts.reserve(std::max(column.size(), reserved_rows_));
+    for (size_t row = 0; row < column.size(); ++row)
+    {
+      texts.push_back(intern(format(column, row)));
+    }
+    column.texts = std::move(texts);
+    column.integers = std::vector<int64_t>();
+    column.reals = std::vector<float>();
+    column.type = ColumnType::Text;
+  }
+
+  void FeatureTable::appendText(size_t col, const std::string& text)
+  {
+    appendText(col, intern(text));
+  }
+
+  void FeatureTable::appendText(size_t col, StringId id)
+  {
+    appendable(col, ColumnType::Text).texts.push_back(id);
+  }
+
+  void FeatureTable::appendInteger(size_t col, int64_t value)
+  {
+    Column& column = appendable(col, ColumnType::Integer);
+    if (column.type == ColumnType::Integer)
+    {
+      column.integers.push_back(value);
+    }
+    else
+    {
+      column.texts.push_back(intern(std::to_string(value)));
+    }
+  }
+
+  void FeatureTable::appendReal(size_t col, float value)
+  {
+    Column& column = appendable(col, ColumnType::Real);
+    if (column.type == ColumnType::Real)
+    {
+      column.reals.push_back(value);
+    }
+    else
+    {
+      column.texts.push_back(intern(std::isnan(value) ? std::string() : std::to_string(value)));
+    }
+  }
+
+  void FeatureTable::appendEmpty(size_t col)
+  {
+    Column& column = columns_.at(col);
+    if (!column.typed || column.type == ColumnType::Real)
+    {
+      column.reals.push_back(std::numeric_limits<float>::quiet_NaN());
+    }
+    else
+    {
+      appendText(col, std::string());
+    }
+  }
+
+  size_t FeatureTable::getNRows() const
+  {
+    if (columns_.empty())
+    {
+      return 0;
+    }
+    size_t n_rows = columns_.front().size();
+    for (const auto& column : columns_)
+    {
+      n_rows = std::min(n_rows, column.size());
+    }
+    return n_rows;
+  }
+
+  std::string FeatureTable::format(const Column& column, size_t row) const
+  {
+    switch (column.type)
+    {
+    case ColumnType::Text:
+      return strings_[column.texts[row]];
+    case ColumnType::Integer:
+      return std::to_string(column.integers[row]);
+    default:
+      // NOTE: to_string() rounds at 1e-6. Therefore, some precision might be lost.
+      return std::isnan(column.reals[row]) ? std::string() : std::to_string(column.reals[row]);
+    }
+  }
+
+  std::string FeatureTable::getText(size_t row, size_t col) const
+  {
+    const Column& column = columns_.at(col);
+    if (row >= column.size())
+    {
+      throw std::out_of_range("Row out of range.");
+    }
+    return format(column, row);
+  }
+
+  double FeatureTable::getNumber(size_t row, size_t col) const
+  {
+    const Column& column = columns_.at(col);
+    if (row >= column.size())
+    {
+      throw std::out_of_range("Row out of range.");
+    }
+    switch (column.type)
+    {
+    case ColumnType::Integer:
+      return static_cast<double>(column.integers[row]);
+    case ColumnType::Real:
+      return column.reals[row];
+    default:
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+  }
+
+  void FeatureTable::getRow(size_t row, std::vector<std::string>& row_out) const
+  {
+    row_out.resize(columns_.size());
+    for (size_t col = 0; col < columns_.size(); ++col)
+    {
+      row_out[col] = getText(row, col);
+    }
+  }
+
+  std::vector<std::vector<std::string>> FeatureTable::toRows() const
+  {
+    const size_t n_rows = getNRows();
+    std::vector<std::vector<std::string>> rows(n_rows);
+    for (size_t row = 0; row < n_rows; ++row)
+    {
+      getRow(row, rows[row]);
+    }
+    return rows;
+  }
+
+  void FeatureTable::clear()
+  {
+    headers_.clear();
+    columns_.clear();
+    reserved_rows_ = 0;
+    string_ids_.clear();
+    strings_.clear();
+  }
+}
@@ -0,0 +1,129 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+#include <SmartPeak/core/ParameterSchemaCache.h>
+
+#include <plog/Log.h>
+
+#include <exception>
+#include <typeinfo>
+
+namespace SmartPeak
+{
+  ParameterSchemaCache& ParameterSchemaCache::instance()
+  {
+    static ParameterSchemaCache cache;
+    return cache;
+  }
+
+  std::shared_ptr<const ParameterSet> ParameterSchemaCache::getSchema(const IProcessorDescription& processor)
+  {
+    const std::type_index key(typeid(processor));
+
+    std::promise<std::shared_ptr<const ParameterSet>> promise;
+    std::shared_future<std::shared_ptr<const ParameterSet>> cached_schema;
+    size_t build_id = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entry = entries_.find(key);
+      if (entry != entries_.end())
+      {
+        cached_schema = entry->second.schema;
+      }
+      else
+      {
+        Entry& new_entry = entries_[key];
+        new_entry.schema = promise.get_future().share();
+        new_entry.build_id = build_id = ++next_build_id_;
+      }
+    }
+    if (cached_schema.valid())
+    {
+      // built, or being built by another thread
+      return cached_schema.get();
+    }
+
+    try
+    {
+      LOGD << "Building parameter schema of " << processor.getName();
+      auto schema = std::make_shared<const ParameterSet>(processor.getParameterSchema());
+      promise.set_value(schema);
+      return schema;
+    }
+    catch (...)
+    {
+      promise.set_exception(std::current_exception());
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entry = entries_.find(key);
+      if (entry != entries_.end() && entry->second.build_id == build_id)
+      {
+        entries_.erase(entry);
+      }
+      throw;
+    }
+  }
+
+  std::shared_ptr<const ParameterSet> ParameterSchemaCache::getParameters(const IProcessorDescription& processor, const ParameterSet& user_parameters)
+  {
+    const std::type_index key(typeid(processor));
+
+    std::shared_ptr<const Resolved> resolved;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entry = entries_.find(key);
+      if (entry != entries_.end())
+      {
+        resolved = entry->second.resolved;
+      }
+    }
+    // resolved parameters are immutable, compare them outside of the lock
+    if (!resolved || resolved->user_parameters != user_parameters)
+    {
+      const auto schema = getSchema(processor);
+      auto new_resolved = std::make_shared<Resolved>();
+      new_resolved->user_parameters = user_parameters;
+      new_resolved->parameters = user_parameters;
+      new_resolved->parameters.merge(*schema);
+      resolved = new_resolved;
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entry = entries_.find(key);
+      if (entry != entries_.end())
+      {
+        entry->second.resolved = resolved;
+      }
+    }
+    return std::shared_ptr<const ParameterSet>(resolved, &resolved->parameters);
+  }
+
+  size_t ParameterSchemaCache::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+  void ParameterSchemaCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+  }
+}
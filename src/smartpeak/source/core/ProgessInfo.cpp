@@ -136,10 +136,13 @@ namespace SmartPeak
 
   void ProgressInfo::onRunningBatchEndItem(const std::string& item_name)
   {
-    running_batch_->running_items_.erase(std::remove(running_batch_->running_items_.begin(),
-      running_batch_->running_items_.end(),
-      item_name),
-      running_batch_->running_items_.end());
+    // stages of a workflow can overlap; items ending after the next batch started are not counted
+    auto running_item = std::find(running_batch_->running_items_.begin(), running_batch_->running_items_.end(), item_name);
+    if (running_item == running_batch_->running_items_.end())
+    {
+      return;
+    }
+    running_batch_->running_items_.erase(running_item);
     running_batch_->current_step_++;
     running_batch_->last_item_end_time_point_ = std::chrono::steady_clock::now();
   }
@@ -24,6 +24,9 @@
 #include <SmartPeak/core/RawDataHandler.h>
 #include <ctime> // time format
 #include <chrono> // current time
+#include <plog/Log.h>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace SmartPeak
 {
@@ -420,6 +423,11 @@ namespace SmartPeak
     experiment_ = experiment;
   }
 
+  void RawDataHandler::setExperiment(OpenMS::MSExperiment&& experiment)
+  {
+    experiment_ = std::move(experiment);
+  }
+
   OpenMS::MSExperiment& RawDataHandler::getExperiment()
   {
     return experiment_;
@@ -541,163 +549,227 @@ namespace SmartPeak
     mz_tab_ = OpenMS::MzTab();
   }
 
+  namespace
+  {
+    /**
+      Registry indices of the meta values used to track the feature map history,
+      registered once so that the hot loops below do not need any registry lookup.
+    */
+    struct FeatureHistoryMetaKeys
+    {
+      FeatureHistoryMetaKeys() :
+        used(OpenMS::MetaInfoInterface::metaRegistry().registerName("used_")),
+        timestamp(OpenMS::MetaInfoInterface::metaRegistry().registerName("timestamp_")),
+        native_id(OpenMS::MetaInfoInterface::metaRegistry().registerName("native_id")),
+        peptide_ref(OpenMS::MetaInfoInterface::metaRegistry().registerName("PeptideRef"))
+      {
+      }
+      const OpenMS::UInt used;
+      const OpenMS::UInt timestamp;
+      const OpenMS::UInt native_id;
+      const OpenMS::UInt peptide_ref;
+    };
+
+    const FeatureHistoryMetaKeys& featureHistoryMetaKeys()
+    {
+      static const FeatureHistoryMetaKeys keys;
+      return keys;
+    }
+
+    std::string currentTimestamp()
+    {
+      std::chrono::time_point<std::chrono::system_clock> time_now = std::chrono::system_clock::now();
+      std::time_t time_now_t = std::chrono::system_clock::to_time_t(time_now);
+      std::tm now_tm;
+      plog::util::localtime_s(&now_tm, &time_now_t); // std::localtime is not thread safe
+      char timestamp_char[64];
+      std::strftime(timestamp_char, 64, "%Y-%m-%d-%H-%M-%S", &now_tm);
+      return std::string(timestamp_char);
+    }
+
+    /**
+      Maps native_ids to small integers, so that subordinates can be compared
+      without copying and comparing strings over and over.
+    */
+    class NativeIdInterner
+    {
+    public:
+      size_t intern(const OpenMS::Feature& subordinate, OpenMS::UInt native_id_key)
+      {
+        // same conversion as before: throws if the native_id is not a string
+        const std::string native_id = subordinate.getMetaValue(native_id_key);
+        return ids_.emplace(native_id, ids_.size()).first->second;
+      }
+    private:
+      std::unordered_map<std::string, size_t> ids_;
+    };
+  }
+
   void RawDataHandler::updateFeatureMapHistory()
   {
-    // Current time stamp
-    std::chrono::time_point<std::chrono::system_clock> time_now = std::chrono::system_clock::now();
-    std::time_t time_now_t = std::chrono::system_clock::to_time_t(time_now);
-    std::tm now_tm = *std::localtime(&time_now_t);
-    char timestamp_char[64];
-    std::strftime(timestamp_char, 64, "%Y-%m-%d-%H-%M-%S", &now_tm);
-    std::string timestamp(timestamp_char);
+    const FeatureHistoryMetaKeys& keys = featureHistoryMetaKeys();
+    const OpenMS::DataValue timestamp(currentTimestamp());
+    const OpenMS::DataValue used_true("true");
+    const OpenMS::DataValue used_false("false");
 
     // Case 1: Copy the current featuremap and timestamp
     if (feature_map_history_.empty()) {
       feature_map_history_ = feature_map_; // ensures PrimaryMSRunPath is copied
       for (OpenMS::Feature& feature_new : feature_map_history_) {
-        if (!feature_new.metaValueExists("used_")) { // prevents overwriting feature_maps with existing "used_" attributes
-          feature_new.setMetaValue("used_", "true");
+        if (!feature_new.metaValueExists(keys.used)) { // prevents overwriting feature_maps with existing "used_" attributes
+          feature_new.setMetaValue(keys.used, used_true);
         }
-        if (!feature_new.metaValueExists("timestamp_")) { // prevents overwriting feature_maps with existing "timestamp_" attributes
-          feature_new.setMetaValue("timestamp_", timestamp);
+        if (!feature_new.metaValueExists(keys.timestamp)) { // prevents overwriting feature_maps with existing "timestamp_" attributes
+          feature_new.setMetaValue(keys.timestamp, timestamp);
         }
         for (OpenMS::Feature& subordinate_new : feature_new.getSubordinates()) {
-          if (!subordinate_new.metaValueExists("used_")) { // prevents overwriting feature_maps with existing "used_" attributes
-            subordinate_new.setMetaValue("used_", "true");
+          if (!subordinate_new.metaValueExists(keys.used)) { // prevents overwriting feature_maps with existing "used_" attributes
+            subordinate_new.setMetaValue(keys.used, used_true);
           }
-          if (!subordinate_new.metaValueExists("timestamp_")) { // prevents overwriting feature_maps with existing "timestamp_" attributes
-            subordinate_new.setMetaValue("timestamp_", timestamp);
+          if (!subordinate_new.metaValueExists(keys.timestamp)) { // prevents overwriting feature_maps with existing "timestamp_" attributes
+            subordinate_new.setMetaValue(keys.timestamp, timestamp);
           }
         }
       }
+      return;
     }
 
     // Case 2: "Remove" filtered/non-selected features and "Add" new features via "used_" and "timestamp_" feature metadata attributes
-    else 
-    {
-      std::vector<OpenMS::Feature> new_features;
-      std::set<OpenMS::UInt64> unique_ids_feat_history, unique_ids_feat_select; // Get all feature IDs
-      for (const OpenMS::Feature& feature_copy : feature_map_history_) {
-        unique_ids_feat_history.insert(feature_copy.getUniqueId());
+    auto set_used = [&keys, &timestamp](OpenMS::Feature& feature, const OpenMS::DataValue& used) {
+      feature.setMetaValue(keys.used, used);
+      feature.setMetaValue(keys.timestamp, timestamp);
+    };
+
+    // Index the current features by unique id, keeping their order for duplicated ids
+    std::unordered_map<OpenMS::UInt64, std::vector<size_t>> feat_select_by_unique_id;
+    feat_select_by_unique_id.reserve(feature_map_.size());
+    for (size_t i = 0; i < feature_map_.size(); ++i) {
+      feat_select_by_unique_id[feature_map_[i].getUniqueId()].push_back(i);
+    }
+    std::unordered_set<OpenMS::UInt64> unique_ids_feat_history;
+    unique_ids_feat_history.reserve(feature_map_history_.size());
+    for (const OpenMS::Feature& feature_copy : feature_map_history_) {
+      unique_ids_feat_history.insert(feature_copy.getUniqueId());
+    }
+
+    // New features are added to the history at the end
+    std::vector<OpenMS::Feature> new_features;
+    for (const OpenMS::Feature& feature_select : feature_map_) {
+      if (unique_ids_feat_history.count(feature_select.getUniqueId())) {
+        continue;
       }
-      for (const OpenMS::Feature& feature_select : feature_map_) {
-        unique_ids_feat_select.insert(feature_select.getUniqueId());
-        if (unique_ids_feat_history.count(feature_select.getUniqueId())) {
-          continue;
-        }
-        // New Feature
-        OpenMS::Feature new_feature = feature_select;
-        new_feature.setMetaValue("used_", "true");
-        new_feature.setMetaValue("timestamp_", timestamp);
-        for (OpenMS::Feature& subordinate_new : new_feature.getSubordinates()) {
-          subordinate_new.setMetaValue("used_", "true");
-          subordinate_new.setMetaValue("timestamp_", timestamp);
-        }
-        new_features.push_back(new_feature); // add the new feature to the list; we will add them to the history at the end
+      OpenMS::Feature new_feature = feature_select;
+      set_used(new_feature, used_true);
+      for (OpenMS::Feature& subordinate_new : new_feature.getSubordinates()) {
+        set_used(subordinate_new, used_true);
       }
+      new_features.push_back(std::move(new_feature));
+    }
 
-      for (OpenMS::Feature& feature_copy : feature_map_history_) {
-        if (unique_ids_feat_select.count(feature_copy.getUniqueId()) == 0) { // Removed feature
-          feature_copy.setMetaValue("used_", "false");
-          feature_copy.setMetaValue("timestamp_", timestamp);
-          for (OpenMS::Feature& subordinate_copy : feature_copy.getSubordinates()) {
-            subordinate_copy.setMetaValue("used_", "false");
-            subordinate_copy.setMetaValue("timestamp_", timestamp);
-          }
-          continue; // move on to the next feature in the history
+    NativeIdInterner native_ids;
+    std::vector<size_t> native_ids_sub_history;
+    std::unordered_set<size_t> unique_ids_sub_history;
+    std::unordered_map<size_t, std::vector<size_t>> sub_select_by_native_id;
+    for (OpenMS::Feature& feature_copy : feature_map_history_) {
+      const auto candidates = feat_select_by_unique_id.find(feature_copy.getUniqueId());
+      if (candidates == feat_select_by_unique_id.end()) { // Removed feature
+        set_used(feature_copy, used_false);
+        for (OpenMS::Feature& subordinate_copy : feature_copy.getSubordinates()) {
+          set_used(subordinate_copy, used_false);
         }
-        for (const OpenMS::Feature& feature_select : feature_map_) {
-          // skip feature if any of the following is true:
-          // - unique ids differ
-          // - peptide refs differ
-          if (feature_select.getUniqueId() != feature_copy.getUniqueId() ||
-              feature_select.getMetaValue("PeptideRef") !=
-               feature_copy.getMetaValue("PeptideRef")) {
-            continue;
-          }
+        continue; // move on to the next feature in the history
+      }
 
-          // Matching feature
-          OpenMS::Feature feature_tmp = feature_select; // Make a temporary feature based on the selected feature that will be later swapped for the feature in the history
-          bool update_feature = false;
-          std::vector<OpenMS::Feature> new_subordinates;
-          // get the unique subordinate names (and not unique ids!)
-          std::set<std::string> unique_ids_sub_history, unique_ids_sub_select;
-          for (const OpenMS::Feature& subordinate_copy : feature_copy.getSubordinates()) {
-            unique_ids_sub_history.insert(subordinate_copy.getMetaValue("native_id"));
-          }
-          for (const OpenMS::Feature& subordinate_select : feature_select.getSubordinates()) {
-            unique_ids_sub_select.insert(subordinate_select.getMetaValue("native_id"));
-            if (unique_ids_sub_history.count(subordinate_select.getMetaValue("native_id"))) {
-              continue;
-            }
-            // New subordinate
-            OpenMS::Feature new_subordinate = subordinate_select;
-            new_subordinate.setMetaValue("used_", "true");
-            new_subordinate.setMetaValue("timestamp_", timestamp);
-            // add the new subordinate to the list; we will add them to the feature subordinate list at the end
-            new_subordinates.push_back(new_subordinate);
-            update_feature = true;
-          }
+      // the first current feature with the same unique id and peptide ref
+      const OpenMS::Feature* feature_select_ptr = nullptr;
+      for (const size_t i : candidates->second) {
+        if (feature_map_[i].getMetaValue(keys.peptide_ref) == feature_copy.getMetaValue(keys.peptide_ref)) {
+          feature_select_ptr = &feature_map_[i];
+          break;
+        }
+      }
+      if (!feature_select_ptr) {
+        continue;
+      }
+      const OpenMS::Feature& feature_select = *feature_select_ptr;
+
+      // Matching feature
+      bool update_feature = false;
+      std::vector<OpenMS::Feature> new_subordinates;
+      // index the subordinates by their interned names (and not unique ids!)
+      std::vector<OpenMS::Feature>& subordinates_copy = feature_copy.getSubordinates();
+      const std::vector<OpenMS::Feature>& subordinates_select = feature_select.getSubordinates();
+      native_ids_sub_history.clear();
+      unique_ids_sub_history.clear();
+      sub_select_by_native_id.clear();
+      for (const OpenMS::Feature& subordinate_copy : subordinates_copy) {
+        native_ids_sub_history.push_back(native_ids.intern(subordinate_copy, keys.native_id));
+        unique_ids_sub_history.insert(native_ids_sub_history.back());
+      }
+      for (size_t i = 0; i < subordinates_select.size(); ++i) {
+        const size_t native_id = native_ids.intern(subordinates_select[i], keys.native_id);
+        sub_select_by_native_id[native_id].push_back(i);
+        if (unique_ids_sub_history.count(native_id)) {
+          continue;
+        }
+        // New subordinate
+        OpenMS::Feature new_subordinate = subordinates_select[i];
+        set_used(new_subordinate, used_true);
+        new_subordinates.push_back(std::move(new_subordinate));
+        update_feature = true;
+      }
 
-          // Check the subordinates for changes
-          for (OpenMS::Feature& subordinate_copy : feature_copy.getSubordinates()) {
-            if (unique_ids_sub_select.count(subordinate_copy.getMetaValue("native_id")) == 0) { // Removed subordinate
-              subordinate_copy.setMetaValue("used_", "false");
-              subordinate_copy.setMetaValue("timestamp_", timestamp);
-              update_feature = true;
-              continue; // move on to the next subordinate from the history
-            } 
-            for (const OpenMS::Feature& subordinate_select : feature_select.getSubordinates()) {
-              if (subordinate_select.getUniqueId() == subordinate_copy.getUniqueId() &&
-                  subordinate_select.getMetaValue("native_id") == subordinate_copy.getMetaValue("native_id")) { // Matching subordinate
-                subordinate_copy = subordinate_select; // copy over changed meta values from the current feature map subordinate
-                if (!subordinate_copy.metaValueExists("used_"))  // overwrite "used_" only if it does not exist
-                  subordinate_copy.setMetaValue("used_", "true");
-                subordinate_copy.setMetaValue("timestamp_", timestamp);
-                update_feature = true;
-                break; // break the loop and move on to the next subordinate from the history
-              }
-            }
-          }
-          
-          // Case of no subordinates
-          if (feature_select.getSubordinates().size() <= 0) {
+      // Check the subordinates for changes
+      for (size_t i = 0; i < subordinates_copy.size(); ++i) {
+        OpenMS::Feature& subordinate_copy = subordinates_copy[i];
+        const auto matches = sub_select_by_native_id.find(native_ids_sub_history[i]);
+        if (matches == sub_select_by_native_id.end()) { // Removed subordinate
+          set_used(subordinate_copy, used_false);
+          update_feature = true;
+          continue; // move on to the next subordinate from the history
+        }
+        for (const size_t j : matches->second) {
+          if (subordinates_select[j].getUniqueId() == subordinate_copy.getUniqueId()) { // Matching subordinate
+            subordinate_copy = subordinates_select[j]; // copy over changed meta values from the current feature map subordinate
+            if (!subordinate_copy.metaValueExists(keys.used))  // overwrite "used_" only if it does not exist
+              subordinate_copy.setMetaValue(keys.used, used_true);
+            subordinate_copy.setMetaValue(keys.timestamp, timestamp);
             update_feature = true;
+            break; // move on to the next subordinate from the history
           }
-
-          if (update_feature) { // copy over the updated subordinates and change the feature to the updated version
-            feature_tmp.setSubordinates(feature_copy.getSubordinates());
-            feature_copy = feature_tmp;
-            feature_copy.setMetaValue("used_", "true");
-            feature_copy.setMetaValue("timestamp_", timestamp);
-          }
-          if (new_subordinates.size()) { // append new subordinates to the existing subordinates list
-            for (OpenMS::Feature& subordinate_copy : feature_copy.getSubordinates()) {
-              new_subordinates.insert(new_subordinates.begin(), subordinate_copy);
-            }
-            feature_copy.setSubordinates(new_subordinates);
-          }
-          break; // break the loop and move on to the next feature in the history
         }
       }
 
-      // Add in the new features to the feature history
-      if (new_features.size()) {
-        for (OpenMS::Feature& feature_new : new_features) {
-          feature_map_history_.push_back(feature_new);
-        }
+      // Case of no subordinates
+      if (subordinates_select.empty()) {
+        update_feature = true;
+      }
+
+      if (update_feature) { // copy over the updated subordinates and change the feature to the updated version
+        OpenMS::Feature feature_tmp = feature_select;
+        feature_tmp.getSubordinates().swap(feature_copy.getSubordinates());
+        feature_copy = std::move(feature_tmp);
+        set_used(feature_copy, used_true);
+      }
+      if (new_subordinates.size()) { // append new subordinates to the existing subordinates list
+        // the existing subordinates are prepended one by one, i.e. in reverse order
+        std::vector<OpenMS::Feature>& subordinates = feature_copy.getSubordinates();
+        new_subordinates.insert(new_subordinates.begin(),
+          std::make_move_iterator(subordinates.rbegin()), std::make_move_iterator(subordinates.rend()));
+        subordinates.swap(new_subordinates);
       }
     }
+
+    // Add in the new features to the feature history
+    for (OpenMS::Feature& feature_new : new_features) {
+      feature_map_history_.push_back(std::move(feature_new));
+    }
   }
+
   void RawDataHandler::makeFeatureMapFromHistory()
   {
     // Current time stamp
-    std::chrono::time_point<std::chrono::system_clock> time_now = std::chrono::system_clock::now();
-    std::time_t time_now_t = std::chrono::system_clock::to_time_t(time_now);
-    std::tm now_tm = *std::localtime(&time_now_t);
-    char timestamp_char[64];
-    std::strftime(timestamp_char, 64, "%Y-%m-%d-%H-%M-%S", &now_tm);
-    std::string timestamp(timestamp_char);
+    const std::string timestamp = currentTimestamp();
 
     feature_map_.clear();
     for (OpenMS::Feature& feature_new : feature_map_history_) {
@@ -22,6 +22,7 @@
 // --------------------------------------------------------------------------
 
 #include <SmartPeak/core/RawDataProcessors/CalculateIsotopicPurities.h>
+#include <SmartPeak/core/ParameterSchemaCache.h>
 #include <SmartPeak/core/Filenames.h>
 #include <SmartPeak/core/Utilities.h>
 #include <SmartPeak/core/FeatureFiltersUtils.h>
@@ -80,8 +81,8 @@ namespace SmartPeak
     getFilenames(filenames_I);
 
     // Complete user parameters with schema
-    ParameterSet params(params_I);
-    params.merge(getParameterSchema());
+    const auto resolved_params = ParameterSchemaCache::instance().getParameters(*this, params_I);
+    const ParameterSet& params = *resolved_params;
 
     OpenMS::IsotopeLabelingMDVs isotopelabelingmdvs;
     OpenMS::Param parameters = isotopelabelingmdvs.getParameters();
@@ -24,6 +24,7 @@
 #include <SmartPeak/core/Filenames.h>
 #include <SmartPeak/core/Utilities.h>
 #include <SmartPeak/core/FeatureFiltersUtils.h>
+#include <SmartPeak/core/ThreadPool.h>
 
 #include <OpenMS/MATH/MISC/EmgGradientDescent.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/PeakIntegrator.h>
@@ -32,6 +33,8 @@
 
 #include <algorithm>
 #include <exception>
+#include <future>
+#include <unordered_map>
 
 namespace SmartPeak
 {
@@ -72,98 +75,122 @@ namespace SmartPeak
     const std::vector<OpenMS::MSChromatogram>& chromatograms {
       rawDataHandler_IO.getChromatogramMap().getChromatograms() };
 
-    auto getChromatogramByName = [&chromatograms](const OpenMS::String& name) -> const OpenMS::MSChromatogram&
-    {
-      const std::vector<OpenMS::MSChromatogram>::const_iterator it =
-        std::find_if(chromatograms.cbegin(), chromatograms.cend(), [&name](const OpenMS::MSChromatogram& chrom){
-          return name == chrom.getNativeID();
-        });
-      if (it == chromatograms.cend()) {
-        throw std::string("Can't find a chromatogram with NativeID == ") + name;
-      }
-      return *it;
-    };
+    std::unordered_map<std::string, size_t> chromatogram_index;
+    chromatogram_index.reserve(chromatograms.size());
+    for (size_t i = 0; i < chromatograms.size(); ++i) {
+      chromatogram_index.emplace(chromatograms[i].getNativeID(), i); // keeps the first one, as the linear search did
+    }
 
+    // one fit per subordinate, in the order of the feature map
+    std::vector<EmgFit> fits;
     for (OpenMS::Feature& feature : featureMap) {
-      std::cout << "NEW FEATURE\n";
       const double left { feature.getMetaValue("leftWidth") };
       const double right { feature.getMetaValue("rightWidth") };
-      std::cout << "Boundaries: [" << left << ", " << right << "]\n";
-      std::vector<OpenMS::Feature>& subordinates { feature.getSubordinates() };
-      std::cout << "n. subordinates: " << subordinates.size() << "\n";
-      for (OpenMS::Feature& subfeature : subordinates) {
-        std::cout << "NEW SUBFEATURE\n";
+      for (OpenMS::Feature& subfeature : feature.getSubordinates()) {
         const OpenMS::String name = subfeature.getMetaValue("native_id");
-        std::cout << "Subordinate name: " << name << "\n";
-        const OpenMS::MSChromatogram& chromatogram = getChromatogramByName(name);
-        std::cout << "Chromatogram found!\n";
-        std::vector<double> x;
-        std::vector<double> y;
-        extractPointsIntoVectors(chromatogram, left, right, x, y);
-        std::cout << "Extracted n. points: " << x.size() << "\n";
-
-        if (x.size() < 3) {
-          std::cout << "Less than 2 points. Skipping: " << name << "\n\n";
-          continue;
+        const auto it = chromatogram_index.find(name);
+        if (it == chromatogram_index.cend()) {
+          throw std::string("Can't find a chromatogram with NativeID == ") + name;
         }
+        EmgFit fit;
+        fit.subfeature = &subfeature;
+        fit.chromatogram = &chromatograms[it->second];
+        fit.left = left;
+        fit.right = right;
+        fits.push_back(std::move(fit));
+      }
+    }
 
-        // EMG parameter estimation with gradient descent
-        double h, mu, sigma, tau;
-        std::cout << "Estimating EMG parameters...\n";
-        emg.estimateEmgParameters(x, y, h, mu, sigma, tau);
-
-        // Estimate the intensities for each point
-        std::vector<double> out_xs;
-        std::vector<double> out_ys;
-        std::cout << "Applying estimated parameters...\n";
-        emg.applyEstimatedParameters(x, h, mu, sigma, tau, out_xs, out_ys);
-
-        // integrate area and estimate background, update the subfeature
-
-        std::cout << "emg peak # points: " << out_xs.size() << "\n";
-        OpenMS::ConvexHull2D::PointArrayType hull_points(out_xs.size());
-        OpenMS::MSChromatogram emg_chrom;
-        for (size_t i = 0; i < out_xs.size(); ++i) {
-          emg_chrom.push_back(OpenMS::ChromatogramPeak(out_xs[i], out_ys[i]));
-          hull_points[i][0] = out_xs[i];
-          hull_points[i][1] = out_ys[i];
+    // the fits are independent, each one writes only its own result
+    ThreadPool& pool = ThreadPool::instance();
+    const size_t n_chunks = std::min(fits.size(), pool.size());
+    std::vector<std::future<void>> futures;
+    for (size_t chunk = 0; chunk < n_chunks; ++chunk) {
+      futures.push_back(pool.submit([&, chunk]() {
+        OpenMS::EmgGradientDescent chunk_emg(emg);
+        for (size_t i = chunk; i < fits.size(); i += n_chunks) {
+          fitSubordinate(chunk_emg, fits[i]);
         }
-        OpenMS::ConvexHull2D hull;
-        hull.addPoints(hull_points);
-        subfeature.getConvexHulls().push_back(hull);
-
-        OpenMS::PeakIntegrator pi;
-        std::cout << "Updating ranges...\n";
-        emg_chrom.updateRanges();
-        std::cout << "Ranges updated.\n";
-        const double emg_chrom_left { emg_chrom.getMinRT() };
-        const double emg_chrom_right { emg_chrom.getMaxRT() };
-        std::cout << "Positions calculated.\n";
-        OpenMS::PeakIntegrator::PeakArea pa = pi.integratePeak(emg_chrom, emg_chrom_left, emg_chrom_right);
-        std::cout << "Area calculated.\n";
-        OpenMS::PeakIntegrator::PeakBackground pb = pi.estimateBackground(emg_chrom, emg_chrom_left, emg_chrom_right, pa.apex_pos);
-        std::cout << "Background calculated.\n";
-        double peak_integral { pa.area - pb.area };
-        double peak_apex_int { pa.height - pb.height };
-        if (peak_integral < 0) { peak_integral = 0; }
-        if (peak_apex_int < 0) { peak_apex_int = 0; }
-
-        std::cout << "Intensity: " << subfeature.getIntensity() << "\t" << peak_integral << "\n";
-        std::cout << "peak_apex_position: " << subfeature.getMetaValue("peak_apex_position") << "\t" << pa.apex_pos << "\n";
-        std::cout << "peak_apex_int: " << subfeature.getMetaValue("peak_apex_int") << "\t" << peak_apex_int << "\n";
-        std::cout << "area_background_level: " << subfeature.getMetaValue("area_background_level") << "\t" << pb.area << "\n";
-        std::cout << "noise_background_level: " << subfeature.getMetaValue("noise_background_level") << "\t" << pb.height << "\n\n";
-
-        subfeature.setIntensity(peak_integral);
-        subfeature.setMetaValue("peak_apex_position", pa.apex_pos);
-        subfeature.setMetaValue("peak_apex_int", peak_apex_int);
-        subfeature.setMetaValue("area_background_level", pb.area);
-        subfeature.setMetaValue("noise_background_level", pb.height);
+      }));
+    }
+    for (auto& future : futures) {
+      pool.wait(future);
+    }
+    for (auto& future : futures) {
+      future.get(); // forward the errors of the fits
+    }
+
+    // update the subordinates in the order of the feature map
+    for (EmgFit& fit : fits) {
+      OpenMS::Feature& subfeature = *fit.subfeature;
+      const OpenMS::String name = subfeature.getMetaValue("native_id");
+      if (fit.n_points < 3) {
+        LOGD << "FitFeaturesEMG: " << fit.n_points << " points in [" << fit.left << ", " << fit.right << "], skipping: " << name;
+        continue;
       }
+      LOGD << "FitFeaturesEMG: " << name << " [" << fit.left << ", " << fit.right << "] "
+        << fit.n_points << " points, emg peak " << fit.hull.getHullPoints().size() << " points"
+        << ", intensity: " << subfeature.getIntensity() << " -> " << fit.peak_integral
+        << ", peak_apex_position: " << subfeature.getMetaValue("peak_apex_position") << " -> " << fit.peak_apex_position
+        << ", peak_apex_int: " << subfeature.getMetaValue("peak_apex_int") << " -> " << fit.peak_apex_int
+        << ", area_background_level: " << subfeature.getMetaValue("area_background_level") << " -> " << fit.area_background_level
+        << ", noise_background_level: " << subfeature.getMetaValue("noise_background_level") << " -> " << fit.noise_background_level;
+
+      subfeature.getConvexHulls().push_back(std::move(fit.hull));
+      subfeature.setIntensity(fit.peak_integral);
+      subfeature.setMetaValue("peak_apex_position", fit.peak_apex_position);
+      subfeature.setMetaValue("peak_apex_int", fit.peak_apex_int);
+      subfeature.setMetaValue("area_background_level", fit.area_background_level);
+      subfeature.setMetaValue("noise_background_level", fit.noise_background_level);
     }
     rawDataHandler_IO.updateFeatureMapHistory();
   }
 
+  void FitFeaturesEMG::fitSubordinate(
+    OpenMS::EmgGradientDescent& emg,
+    EmgFit& fit
+  ) const
+  {
+    std::vector<double> x;
+    std::vector<double> y;
+    extractPointsIntoVectors(*fit.chromatogram, fit.left, fit.right, x, y);
+    fit.n_points = x.size();
+    if (x.size() < 3) {
+      return;
+    }
+
+    // EMG parameter estimation with gradient descent
+    double h, mu, sigma, tau;
+    emg.estimateEmgParameters(x, y, h, mu, sigma, tau);
+
+    // Estimate the intensities for each point
+    std::vector<double> out_xs;
+    std::vector<double> out_ys;
+    emg.applyEstimatedParameters(x, h, mu, sigma, tau, out_xs, out_ys);
+
+    // integrate area and estimate background
+    OpenMS::ConvexHull2D::PointArrayType hull_points(out_xs.size());
+    OpenMS::MSChromatogram emg_chrom;
+    for (size_t i = 0; i < out_xs.size(); ++i) {
+      emg_chrom.push_back(OpenMS::ChromatogramPeak(out_xs[i], out_ys[i]));
+      hull_points[i][0] = out_xs[i];
+      hull_points[i][1] = out_ys[i];
+    }
+    fit.hull.addPoints(hull_points);
+
+    OpenMS::PeakIntegrator pi;
+    emg_chrom.updateRanges();
+    const double emg_chrom_left { emg_chrom.getMinRT() };
+    const double emg_chrom_right { emg_chrom.getMaxRT() };
+    OpenMS::PeakIntegrator::PeakArea pa = pi.integratePeak(emg_chrom, emg_chrom_left, emg_chrom_right);
+    OpenMS::PeakIntegrator::PeakBackground pb = pi.estimateBackground(emg_chrom, emg_chrom_left, emg_chrom_right, pa.apex_pos);
+    fit.peak_integral = std::max(pa.area - pb.area, 0.0);
+    fit.peak_apex_int = std::max(pa.height - pb.height, 0.0);
+    fit.peak_apex_position = pa.apex_pos;
+    fit.area_background_level = pb.area;
+    fit.noise_background_level = pb.height;
+  }
+
   void FitFeaturesEMG::extractPointsIntoVectors(
     const OpenMS::MSChromatogram& chromatogram,
     const double left,
@@ -176,7 +203,6 @@ namespace SmartPeak
     y.clear();
     OpenMS::MSChromatogram::ConstIterator it = chromatogram.PosBegin(left);
     const OpenMS::MSChromatogram::ConstIterator end = chromatogram.PosEnd(right);
-    std::cout << "empty range: " << (it == end) << "\n";
     for (; it != end; ++it) {
       x.push_back(it->getPos());
       y.push_back(it->getIntensity());
@@ -34,6 +34,8 @@
 
 #include <algorithm>
 #include <exception>
+#include <memory>
+#include <utility>
 
 namespace SmartPeak
 {
@@ -179,21 +181,25 @@ namespace SmartPeak
         chromatogramExtractor_params.emplace(param.getName(), c);
       }
       // # exctract chromatograms
-      OpenMS::MSExperiment chromatograms_copy = chromatograms;
-      chromatograms.clear(true);
+      // the loaded spectra are moved out and released as soon as the chromatograms are extracted,
+      // so that at most the input and the extracted chromatograms are in memory at the same time
+      OpenMS::MSExperiment spectra;
+      spectra.swap(chromatograms);
       if (chromatogramExtractor_params.count("extract_precursors")) {
-        const std::vector<OpenMS::ReactionMonitoringTransition>& tr_const = targeted_exp.getTransitions();
-        std::vector<OpenMS::ReactionMonitoringTransition> tr = tr_const;
+        // extract on the precursor m/z with a copy of the transitions owned by this injection,
+        // the targeted experiment may be shared with the other injections
+        std::vector<OpenMS::ReactionMonitoringTransition> tr = targeted_exp.getTransitions();
         for (OpenMS::ReactionMonitoringTransition& t : tr) {
           t.setProductMZ(t.getPrecursorMZ());
         }
-        targeted_exp.setTransitions(tr);
-        rawDataHandler_IO.setTargetedExperiment(targeted_exp);
+        auto extraction_targeted_exp = std::make_shared<OpenMS::TargetedExperiment>(targeted_exp);
+        extraction_targeted_exp->setTransitions(std::move(tr));
+        rawDataHandler_IO.setTargetedExperiment(extraction_targeted_exp);
       }
       OpenMS::TransformationDescription transfDescr;
       OpenMS::ChromatogramExtractor chromatogramExtractor;
       chromatogramExtractor.extractChromatograms(
-        chromatograms_copy,
+        spectra,
         chromatograms,
         rawDataHandler_IO.getTargetedExperiment(),
         chromatogramExtractor_params.at("extract_window").f_,
@@ -203,7 +209,7 @@ namespace SmartPeak
         chromatogramExtractor_params.at("filter").s_
       );
     }
-    rawDataHandler_IO.setExperiment(chromatograms);
+    rawDataHandler_IO.setExperiment(std::move(chromatograms));
   }
 
   void LoadRawData::extractMetaData(
@@ -21,11 +21,12 @@
 // $Authors: Douglas McCloskey, Pasquale Domenico Colaianni $
 // --------------------------------------------------------------------------
 #include <SmartPeak/core/RawDataProcessors/MatchSpectra.h>
+#include <SmartPeak/core/ParameterSchemaCache.h>
 #include <SmartPeak/core/Filenames.h>
 #include <SmartPeak/core/Utilities.h>
 #include <SmartPeak/core/FeatureFiltersUtils.h>
+#include <SmartPeak/core/SpectralLibraryCache.h>
 
-#include <OpenMS/FORMAT/MSPGenericFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/TargetedSpectraExtractor.h>
 
 #include <plog/Log.h>
@@ -71,24 +72,17 @@ namespace SmartPeak
     getFilenames(filenames_I);
 
     // Complete user parameters with schema
-    ParameterSet params(params_I);
-    params.merge(getParameterSchema());
+    const auto resolved_params = ParameterSchemaCache::instance().getParameters(*this, params_I);
+    const ParameterSet& params = *resolved_params;
 
     OpenMS::TargetedSpectraExtractor targeted_spectra_extractor;
     Utilities::setUserParameters(targeted_spectra_extractor, params);
 
-    // Load spectra for comparison
-    auto cmp_spectra_file_name = filenames_I.getFullPath("cmp_spectra").generic_string();
-    OpenMS::MSPGenericFile msp_file;
-    OpenMS::MSExperiment library;
-    msp_file.load(cmp_spectra_file_name, library);
-    library.sortSpectra();
+    // Load spectra for comparison, shared with the other injections
+    auto cmp = SpectralLibraryCache::instance().getComparator(filenames_I.getFullPath("cmp_spectra"));
 
     // Compare
-    OpenMS::TargetedSpectraExtractor::BinnedSpectrumComparator cmp;
-    std::map<OpenMS::String, OpenMS::DataValue> options;
-    cmp.init(library.getSpectra(), options);
-    targeted_spectra_extractor.targetedMatching(rawDataHandler_IO.getChromatogramMap().getSpectra(), cmp, rawDataHandler_IO.getFeatureMap("extracted_spectra"));
+    targeted_spectra_extractor.targetedMatching(rawDataHandler_IO.getChromatogramMap().getSpectra(), *cmp, rawDataHandler_IO.getFeatureMap("extracted_spectra"));
 
     rawDataHandler_IO.updateFeatureMapHistory();
   }
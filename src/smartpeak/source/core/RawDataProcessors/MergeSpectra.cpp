@@ -21,17 +21,22 @@
 // $Authors: Douglas McCloskey, Pasquale Domenico Colaianni $
 // --------------------------------------------------------------------------
 #include <SmartPeak/core/RawDataProcessors/MergeSpectra.h>
+#include <SmartPeak/core/ParameterSchemaCache.h>
 #include <SmartPeak/core/Filenames.h>
 #include <SmartPeak/core/Utilities.h>
 #include <SmartPeak/core/FeatureFiltersUtils.h>
 #include <SmartPeak/io/InputDataValidation.h>
+#include <SmartPeak/core/ThreadPool.h>
 
 #include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
 
 #include <plog/Log.h>
 
 #include <algorithm>
+#include <cmath>
 #include <exception>
+#include <future>
+#include <utility>
 
 namespace SmartPeak
 {
@@ -106,8 +111,8 @@ namespace SmartPeak
     getFilenames(filenames_I);
 
     // Complete user parameters with schema
-    ParameterSet params(params_I);
-    params.merge(getParameterSchema());
+    const auto resolved_params = ParameterSchemaCache::instance().getParameters(*this, params_I);
+    const ParameterSet& params = *resolved_params;
 
     float resolution = 0, max_mz = 0, bin_step = 0;
     if (params.count("FIAMS") && params.at("FIAMS").size()) {
@@ -144,40 +149,88 @@ namespace SmartPeak
     }
 
     // calculate the bin sizes and mass buckets
-    int n_bins = max_mz / bin_step;
+    // bin i holds the peaks within [mzs[i], mzs[i + 1])
+    const int n_bins = max_mz / bin_step;
     std::vector<float> mzs;
     std::vector<float> bin_sizes;
-    std::vector<std::vector<OpenMS::MSSpectrum>> binned_spectrum;
     mzs.reserve(n_bins);
     bin_sizes.reserve(n_bins);
-    binned_spectrum.resize(n_bins);
     for (int i = 0; i < n_bins; i++) {
       mzs.push_back((i + 1) * bin_step);
       bin_sizes.push_back(mzs.at(i) / (resolution * 4.0));
-      binned_spectrum.at(i).resize(rawDataHandler_IO.getExperiment().getSpectra().size());
     }
+    const int n_mass_ranges = std::max(n_bins - 1, 0);
 
-    // Divide the spectra into mass ranges
-    for (int s = 0; s < rawDataHandler_IO.getExperiment().getSpectra().size(); ++s) {
-      const OpenMS::MSSpectrum spectrum = rawDataHandler_IO.getExperiment().getSpectra().at(s);
-      for (auto it = spectrum.begin(); it != spectrum.end(); ++it) {
-        for (int i = 0; i < mzs.size() - 1; ++i) {
-          if (it->getMZ() >= mzs.at(i) && it->getMZ() < mzs.at(i + 1)) {
-            binned_spectrum.at(i).at(s).push_back(*it);
-          }
+    // Divide the spectra into mass ranges.
+    // Only the non empty parts of the spectra are kept, in the order of the spectra.
+    const auto& spectra = rawDataHandler_IO.getExperiment().getSpectra();
+    std::vector<std::vector<OpenMS::MSSpectrum>> binned_spectrum(n_mass_ranges);
+    std::vector<size_t> last_spectrum(n_mass_ranges, spectra.size());
+    for (size_t s = 0; s < spectra.size(); ++s) {
+      for (const auto& peak : spectra[s]) {
+        const double mz = peak.getMZ();
+        const double position = mz / bin_step;
+        if (!(position > 0.0 && position < n_bins + 1.0)) {
+          continue;
+        }
+        int i = static_cast<int>(std::floor(position)) - 1;
+        // correct rounding errors around the bin edges
+        i = std::min(i, n_bins - 1);
+        while (i >= 0 && mz < mzs[i]) --i;
+        while (i + 1 < n_bins && mz >= mzs[i + 1]) ++i;
+        if (i < 0 || i >= n_mass_ranges) {
+          continue;
+        }
+        if (last_spectrum[i] != s) {
+          binned_spectrum[i].emplace_back();
+          last_spectrum[i] = s;
         }
+        binned_spectrum[i].back().push_back(peak);
       }
     }
 
     // Merge spectra along time for each of the different mass ranges
-    OpenMS::MSSpectrum output;
-    for (int i = 0; i < mzs.size() - 1; ++i) {
-      OpenMS::MSSpectrum full_spectrum = OpenMS::SpectrumAddition::addUpSpectra(
-        binned_spectrum.at(i), bin_sizes.at(i), false
-      );
-      for (auto it = full_spectrum.begin(); it != full_spectrum.end(); ++it) {
-        output.push_back(*it);
+    std::vector<OpenMS::MSSpectrum> full_spectra(n_mass_ranges);
+    auto merge_mass_range = [&](int i) {
+      std::vector<OpenMS::MSSpectrum>& mass_range_spectra = binned_spectrum[i];
+      if (mass_range_spectra.empty()) {
+        return;
       }
+      // addUpSpectra returns a single spectrum as is; keep resampling it
+      // when it was the only non empty one out of several spectra
+      if (mass_range_spectra.size() == 1 && spectra.size() > 1) {
+        mass_range_spectra.emplace_back();
+      }
+      full_spectra[i] = OpenMS::SpectrumAddition::addUpSpectra(
+        mass_range_spectra, bin_sizes.at(i), false
+      );
+      std::vector<OpenMS::MSSpectrum>().swap(mass_range_spectra);
+    };
+    ThreadPool& pool = ThreadPool::instance();
+    const int n_chunks = std::min<int>(n_mass_ranges, pool.size());
+    std::vector<std::future<void>> futures;
+    for (int chunk = 0; chunk < n_chunks; ++chunk) {
+      futures.push_back(pool.submit([&, chunk]() {
+        for (int i = chunk; i < n_mass_ranges; i += n_chunks) {
+          merge_mass_range(i);
+        }
+      }));
+    }
+    for (auto& future : futures) {
+      pool.wait(future);
+    }
+    for (auto& future : futures) {
+      future.get(); // forward the errors of the merge
+    }
+
+    OpenMS::MSSpectrum output;
+    size_t n_peaks = 0;
+    for (const auto& full_spectrum : full_spectra) {
+      n_peaks += full_spectrum.size();
+    }
+    output.reserve(n_peaks);
+    for (const auto& full_spectrum : full_spectra) {
+      output.insert(output.end(), full_spectrum.begin(), full_spectrum.end());
     }
     output.sortByPosition();
 
@@ -185,7 +238,6 @@ namespace SmartPeak
     output.setNativeID("MergeSpectra");
     OpenMS::Peak1D::CoordinateType lowest_observed = 0.0;
     OpenMS::Peak1D::CoordinateType highest_observed = 0.0;
-    const auto& spectra = rawDataHandler_IO.getExperiment().getSpectra();
     if (spectra.size())
     {
       output.setMSLevel(spectra.front().getMSLevel());
@@ -212,7 +264,9 @@ namespace SmartPeak
     output.setMetaValue("base peak m/z", 0.0);
     output.setMetaValue("base peak intensity", 0.0);
     output.setMetaValue("total ion current", 0.0);
-    rawDataHandler_IO.getExperiment().setSpectra({ output });
+    std::vector<OpenMS::MSSpectrum> merged_spectra;
+    merged_spectra.push_back(std::move(output));
+    rawDataHandler_IO.getExperiment().setSpectra(std::move(merged_spectra));
   }
 
 }
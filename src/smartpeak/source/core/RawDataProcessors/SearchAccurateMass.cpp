@@ -21,10 +21,12 @@
 // $Authors: Douglas McCloskey, Pasquale Domenico Colaianni $
 // --------------------------------------------------------------------------
 #include <SmartPeak/core/RawDataProcessors/SearchAccurateMass.h>
+#include <SmartPeak/core/ParameterSchemaCache.h>
 #include <SmartPeak/core/Filenames.h>
 #include <SmartPeak/core/Utilities.h>
 #include <SmartPeak/core/FeatureFiltersUtils.h>
 #include <SmartPeak/io/InputDataValidation.h>
+#include <SmartPeak/core/AccurateMassSearchEngineRegistry.h>
 
 #include <OpenMS/ANALYSIS/ID/AccurateMassSearchEngine.h>
 
@@ -66,21 +68,21 @@ namespace SmartPeak
     LOGI << "SearchAccurateMass input size: " << rawDataHandler_IO.getFeatureMap().size();
 
     // Complete user parameters with schema
-    ParameterSet params(params_I);
-    params.merge(getParameterSchema());
+    ParameterSet params(*ParameterSchemaCache::instance().getParameters(*this, params_I));
     std::filesystem::path main_path(filenames_I.getTagValue(Filenames::Tag::MAIN_DIR));
     Utilities::prepareFileParameterList(params, "AccurateMassSearchEngine", "db:mapping", main_path);
     Utilities::prepareFileParameterList(params, "AccurateMassSearchEngine", "db:struct", main_path);
     Utilities::prepareFileParameter(params, "AccurateMassSearchEngine", "positive_adducts", main_path);
     Utilities::prepareFileParameter(params, "AccurateMassSearchEngine", "negative_adducts", main_path);
 
-    OpenMS::AccurateMassSearchEngine ams;
-    Utilities::setUserParameters(ams, params);
+    OpenMS::AccurateMassSearchEngine ams_parameters;
+    Utilities::setUserParameters(ams_parameters, params);
 
-    // Run the accurate mass search engine
+    // Run the accurate mass search engine, initialised once for all injections using the same database
+    // (the runs on a shared engine are serialized)
+    auto ams = AccurateMassSearchEngineRegistry::instance().getEngine(ams_parameters.getParameters());
     OpenMS::MzTab output;
-    ams.init();
-    ams.run(rawDataHandler_IO.getFeatureMap(), output);
+    ams->run(rawDataHandler_IO.getFeatureMap(), output);
 
     // Remake the feature map replacing the peptide hits as features/sub-features
     OpenMS::FeatureMap fmap;
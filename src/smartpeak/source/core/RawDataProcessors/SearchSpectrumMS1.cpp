@@ -21,6 +21,7 @@
 // $Authors: Douglas McCloskey $
 // --------------------------------------------------------------------------
 #include <SmartPeak/core/RawDataProcessors/SearchSpectrumMS1.h>
+#include <SmartPeak/core/ParameterSchemaCache.h>
 #include <SmartPeak/core/Filenames.h>
 #include <SmartPeak/core/Utilities.h>
 #include <SmartPeak/core/FeatureFiltersUtils.h>
@@ -65,8 +66,7 @@ namespace SmartPeak
     getFilenames(filenames_I);
 
     // Complete user parameters with schema
-    ParameterSet params(params_I);
-    params.merge(getParameterSchema());
+    ParameterSet params(*ParameterSchemaCache::instance().getParameters(*this, params_I));
     std::filesystem::path main_path(filenames_I.getTagValue(Filenames::Tag::MAIN_DIR));
     Utilities::prepareFileParameterList(params, "TargetedSpectraExtractor", "AccurateMassSearchEngine:db:mapping", main_path);
     Utilities::prepareFileParameterList(params, "TargetedSpectraExtractor", "AccurateMassSearchEngine:db:struct", main_path);
@@ -22,9 +22,14 @@
 // --------------------------------------------------------------------------
 
 #include <SmartPeak/core/SampleGroupProcessors/MergeInjections.h>
+#include <SmartPeak/core/ParameterSchemaCache.h>
 #include <SmartPeak/core/FeatureMetadata.h>
+#include <SmartPeak/core/ThreadPool.h>
 #include <SmartPeak/io/SelectDilutionsParser.h>
 
+#include <algorithm>
+#include <future>
+
 namespace SmartPeak
 {
   std::set<std::string> MergeInjections::getInputs() const
@@ -117,8 +122,8 @@ namespace SmartPeak
     getFilenames(filenames_I);
 
     // Complete user parameters with schema
-    ParameterSet params(params_I);
-    params.merge(getParameterSchema());
+    const auto resolved_params = ParameterSchemaCache::instance().getParameters(*this, params_I);
+    const ParameterSet& params = *resolved_params;
 
     // Extract out the parameters
     std::string scan_polarity_merge_rule; // Sum, Min, Max, Mean, WeightedMean
@@ -191,77 +196,189 @@ namespace SmartPeak
     // Determine the ordering of merge
     orderMergeKeysToInjections(scan_polarities, scan_mass_ranges, dilution_factors, merge_keys_to_injection_name);
 
+    // Intern the feature names, in alphabetical order
+    std::vector<std::string> feature_names;
+    for (const auto& m : metadataFloatToString) {
+      feature_names.push_back(m.second);
+    }
+    std::sort(feature_names.begin(), feature_names.end());
+    feature_names.erase(std::unique(feature_names.begin(), feature_names.end()), feature_names.end());
+
     // Organize the injection `FeatureMaps` into a map of std::pair<PeptideRef, native_id> with a value of
-    // a map of `feature_name` with a value of
-    // a map of a set of injection names with a value of the feature metadata value
-    std::map<componentKeyType, std::map<std::string, std::map<std::set<std::string>, float>>> component_to_feature_to_injection_to_values;
-    getComponentsToFeaturesToInjectionsToValues(sampleGroupHandler_IO, sequenceHandler_I, merge_subordinates, component_to_feature_to_injection_to_values);
+    // the list of (injection, feature, value) found for that component.
+    // The injection sets are interned as they are found, starting with the single injections.
+    std::map<std::set<std::string>, size_t> injection_set_indices;
+    std::map<componentKeyType, std::vector<injectionValueType>> component_to_injection_values;
+    getComponentsToInjectionValues(sampleGroupHandler_IO, sequenceHandler_I, merge_subordinates, feature_names, injection_set_indices, component_to_injection_values);
 
     // Select preferred dilution.
     // If the select_preferred_dilutions parameter is set to true,
     // we will remove from the features all components that are listed
     // in the file set by the select_preferred_dilutions_file and to which the
     // injection dilution does not correspond to the value set in the select_preferred_dilutions_file.
-    if (!selectDilutions(params, filenames_I, sequenceHandler_I, component_to_feature_to_injection_to_values))
+    std::map<std::string, int> select_dilution_map;
+    if (!readPreferredDilutions(params, filenames_I, select_dilution_map))
     {
       return;
     }
 
-    // Merge the components and features in order and in place
+    // Flatten the merge of the components and features in order
+    std::vector<MergeStep> merge_steps;
     // pass 1: dilutions
     std::set<std::string> scan_polarities_keys_tup = scan_polarities;
     std::set<std::pair<float, float>> scan_mass_ranges_keys_tup = scan_mass_ranges;
     std::set<float> dilution_factors_keys_tup({-1});
-    mergeComponentsToFeaturesToInjectionsToValues(dilution_series_merge_feature_name,
-                                                  dilution_series_merge_rule, 
-                                                  scan_polarities_keys_tup,
-                                                  scan_mass_ranges_keys_tup,
-                                                  dilution_factors_keys_tup, 
-                                                  merge_keys_to_injection_name,
-                                                  component_to_feature_to_injection_to_values);
+    addMergeSteps(dilution_series_merge_feature_name,
+                  parseMergeRule(dilution_series_merge_rule),
+                  scan_polarities_keys_tup,
+                  scan_mass_ranges_keys_tup,
+                  dilution_factors_keys_tup,
+                  merge_keys_to_injection_name,
+                  feature_names,
+                  injection_set_indices,
+                  merge_steps);
 
     // pass 2: mass ranges
     scan_mass_ranges_keys_tup = std::set<std::pair<float, float>>({std::make_pair(-1,-1)});
-    mergeComponentsToFeaturesToInjectionsToValues(mass_range_merge_feature_name,
-                                                  mass_range_merge_rule,
-                                                  scan_polarities_keys_tup,
-                                                  scan_mass_ranges_keys_tup,
-                                                  dilution_factors_keys_tup,
-                                                  merge_keys_to_injection_name,
-                                                  component_to_feature_to_injection_to_values);
+    addMergeSteps(mass_range_merge_feature_name,
+                  parseMergeRule(mass_range_merge_rule),
+                  scan_polarities_keys_tup,
+                  scan_mass_ranges_keys_tup,
+                  dilution_factors_keys_tup,
+                  merge_keys_to_injection_name,
+                  feature_names,
+                  injection_set_indices,
+                  merge_steps);
 
     // pass 3: scan polarities
     scan_polarities_keys_tup = std::set<std::string>({ "" });
-    mergeComponentsToFeaturesToInjectionsToValues(scan_polarity_merge_feature_name,
-                                                  scan_polarity_merge_rule,
-                                                  scan_polarities_keys_tup,
-                                                  scan_mass_ranges_keys_tup,
-                                                  dilution_factors_keys_tup,
-                                                  merge_keys_to_injection_name,
-                                                  component_to_feature_to_injection_to_values);
-
-    // Make the final merged feature
+    addMergeSteps(scan_polarity_merge_feature_name,
+                  parseMergeRule(scan_polarity_merge_rule),
+                  scan_polarities_keys_tup,
+                  scan_mass_ranges_keys_tup,
+                  dilution_factors_keys_tup,
+                  merge_keys_to_injection_name,
+                  feature_names,
+                  injection_set_indices,
+                  merge_steps);
+
+    // The final merged feature holds all the injections of the sample group
     std::set<std::string> injection_names_set;
     for (const std::size_t& index : sampleGroupHandler_IO.getSampleIndices()) {
       injection_names_set.insert(sequenceHandler_I.getSequence().at(index).getMetaData().getInjectionName() );
     }
+    const size_t all_injections = injection_set_indices.emplace(injection_names_set, injection_set_indices.size()).first->second;
+    const size_t n_injection_sets = injection_set_indices.size();
+
+    // Dilutions of the single injections, looked up by injection name in the whole sequence
+    std::vector<std::vector<float>> injection_set_dilutions(n_injection_sets);
+    if (!select_dilution_map.empty()) {
+      for (const auto& injection_set_index : injection_set_indices) {
+        if (injection_set_index.first.size() != 1) continue;
+        for (const auto& sample : sequenceHandler_I.getSequence()) {
+          if (sample.getMetaData().getInjectionName() == *injection_set_index.first.begin()) {
+            injection_set_dilutions.at(injection_set_index.second).push_back(sample.getMetaData().dilution_factor);
+          }
+        }
+      }
+    }
+
+    // Merge the components independently, each one into its own result
+    std::vector<std::map<componentKeyType, std::vector<injectionValueType>>::const_iterator> components;
+    for (auto it = component_to_injection_values.cbegin(); it != component_to_injection_values.cend(); ++it) {
+      components.push_back(it);
+    }
+    std::vector<std::vector<std::pair<size_t, float>>> merged_values(components.size());
+    auto merge_component = [&](size_t c, ComponentTable& table) {
+      table.clear();
+      for (const auto& [injection_set, feature, value] : components[c]->second) {
+        if (!table.isSet(feature, injection_set)) { // the first value found is kept
+          table.set(feature, injection_set, value);
+        }
+      }
+      std::vector<char> preferred_injection_sets;
+      const auto select_dilution = select_dilution_map.find(components[c]->first.second);
+      if (select_dilution != select_dilution_map.cend()) {
+        const float preferred_dilution = select_dilution->second;
+        preferred_injection_sets.assign(n_injection_sets, 0);
+        for (size_t injection_set = 0; injection_set < n_injection_sets; ++injection_set) {
+          for (const float dilution : injection_set_dilutions[injection_set]) {
+            if (std::abs(dilution - preferred_dilution) < 1e-6) {
+              preferred_injection_sets[injection_set] = 1;
+            }
+          }
+        }
+      }
+      mergeComponent(merge_steps, preferred_injection_sets, table);
+      for (size_t feature = 0; feature < feature_names.size(); ++feature) {
+        if (table.isSet(feature, all_injections)) {
+          merged_values[c].emplace_back(feature, table.value(feature, all_injections));
+        }
+      }
+    };
+    ThreadPool& pool = ThreadPool::instance();
+    const size_t n_chunks = std::min(components.size(), pool.size());
+    std::vector<std::future<void>> futures;
+    for (size_t chunk = 0; chunk < n_chunks; ++chunk) {
+      futures.push_back(pool.submit([&, chunk]() {
+        ComponentTable table(feature_names.size(), n_injection_sets);
+        for (size_t c = chunk; c < components.size(); c += n_chunks) {
+          merge_component(c, table);
+        }
+      }));
+    }
+    for (auto& future : futures) {
+      pool.wait(future);
+    }
+    for (auto& future : futures) {
+      future.get(); // forward the errors of the merge
+    }
+
+    // Make the final merged feature
     OpenMS::FeatureMap fmap;
-    makeFeatureMap(merge_subordinates, injection_names_set, component_to_feature_to_injection_to_values, fmap);
+    makeFeatureMap(merge_subordinates, feature_names, component_to_injection_values, merged_values, fmap);
 
     sampleGroupHandler_IO.setFeatureMap(fmap);
 
     LOGI << "MergeInjections output size: " << fmap.size();
   }
 
-  bool MergeInjections::selectDilutions(
+  MergeInjections::ComponentTable::ComponentTable(size_t n_features, size_t n_injection_sets) :
+    n_features(n_features),
+    n_injection_sets(n_injection_sets),
+    values(n_features * n_injection_sets, 0.0f),
+    is_set(n_features * n_injection_sets, 0)
+  {
+  }
+
+  void MergeInjections::ComponentTable::set(size_t feature, size_t injection_set, float v)
+  {
+    values[feature * n_injection_sets + injection_set] = v;
+    is_set[feature * n_injection_sets + injection_set] = 1;
+  }
+
+  void MergeInjections::ComponentTable::clear()
+  {
+    std::fill(is_set.begin(), is_set.end(), 0);
+  }
+
+  MergeInjections::MergeRule MergeInjections::parseMergeRule(const std::string& merge_rule)
+  {
+    if (merge_rule == "Sum") return MergeRule::Sum;
+    if (merge_rule == "Min") return MergeRule::Min;
+    if (merge_rule == "Max") return MergeRule::Max;
+    if (merge_rule == "Mean") return MergeRule::Mean;
+    if (merge_rule == "WeightedMean") return MergeRule::WeightedMean;
+    throw std::invalid_argument("Unknown merge rule: " + merge_rule);
+  }
+
+  bool MergeInjections::readPreferredDilutions(
     const ParameterSet& params,
     const Filenames& filenames_I,
-    const SequenceHandler& sequenceHandler_I,
-    std::map<componentKeyType, std::map<std::string, std::map<std::set<std::string>, float>>>& component_to_feature_to_injection_to_values)
+    std::map<std::string, int>& select_dilution_map)
   {
     if (params.at("MergeInjections").findParameter("select_preferred_dilutions")->getValueAsString() == "true")
     {
-      std::map<std::string, int> select_dilution_map;
       std::filesystem::path dilution_file = params.at("MergeInjections").findParameter("select_preferred_dilutions_file")->getValueAsString();
       if (dilution_file.is_relative())
       {
@@ -276,76 +393,6 @@ namespace SmartPeak
         LOGE << "Failed to read select dilutions file [" << dilution_file.generic_string() << "] : " << e.what();
         return false;
       }
-      std::map<componentKeyType, std::map<std::string, std::map<std::set<std::string>, float>>> new_component_to_feature_to_injection_to_values;
-      for (const auto& component_to_feature_to_injection_to_value : component_to_feature_to_injection_to_values)
-      {
-        const auto& component_key = component_to_feature_to_injection_to_value.first;
-        const auto& component_name = component_key.second;
-        if (select_dilution_map.count(component_name))
-        {
-          float preferred_dilution = select_dilution_map.at(component_name);
-          const auto& feature_map = component_to_feature_to_injection_to_value.second;
-          // 1st pass: get selected injections
-          std::set<std::set<std::string>> selected_injections;
-          for (const auto& feature : feature_map)
-          {
-            const auto& feature_name = feature.first;
-            const auto& injections_set_to_value = feature.second;
-            for (const auto& injections_set : injections_set_to_value)
-            {
-              std::set<std::string> selected_injections_set;
-              for (const auto& injection_name : injections_set.first)
-              {
-                // look for dilution of this injection
-                for (const auto& sample : sequenceHandler_I.getSequence())
-                {
-                  if (sample.getMetaData().getInjectionName() == injection_name)
-                  {
-                    float dilution = sample.getMetaData().dilution_factor;
-                    if (std::abs(dilution - preferred_dilution) < 1e-6)
-                    {
-                      selected_injections_set.insert(injection_name);
-                    }
-                  }
-                }
-              }
-              if (!selected_injections_set.empty())
-              {
-                selected_injections.insert(selected_injections_set);
-              }
-            }
-          }
-          // 2nd pass: reconstruct the injection map
-          std::map<std::string, std::map<std::set<std::string>, float>> new_feature_map;
-          if (selected_injections.empty())
-          {
-            // if we haven't found preferred injection among this map, we just let it as it was.
-            new_feature_map = feature_map;
-          }
-          else
-          {
-            for (const auto& feature : feature_map)
-            {
-              const auto& injections_set_to_value = feature.second;
-              std::map<std::set<std::string>, float> new_injections_set_to_value;
-              for (const auto& injections_set : injections_set_to_value)
-              {
-                if (selected_injections.count(injections_set.first))
-                {
-                  new_injections_set_to_value.insert(injections_set);
-                }
-              }
-              new_feature_map.emplace(feature.first, new_injections_set_to_value);
-            }
-          }
-          new_component_to_feature_to_injection_to_values.emplace(component_key, new_feature_map);
-        }
-        else
-        {
-          new_component_to_feature_to_injection_to_values.insert(component_to_feature_to_injection_to_value);
-        }
-      }
-      component_to_feature_to_injection_to_values = std::move(new_component_to_feature_to_injection_to_values);
     }
     return true;
   }
@@ -428,215 +475,243 @@ namespace SmartPeak
     }
   }
 
-  void MergeInjections::getComponentsToFeaturesToInjectionsToValues(const SampleGroupHandler& sampleGroupHandler_IO,
-                                                                    const SequenceHandler& sequenceHandler_I,
-                                                                    const bool& merge_subordinates,
-                                                                    std::map<componentKeyType, std::map<std::string, std::map<std::set<std::string>, float>>>& component_to_feature_to_injection_to_values)
+  void MergeInjections::addMergeSteps(const std::string& feature_name,
+                                      const MergeRule rule,
+                                      const std::set<std::string>& scan_polarities,
+                                      const std::set<std::pair<float, float>>& scan_mass_ranges,
+                                      const std::set<float>& dilution_factors,
+                                      const std::map<mergeKeyType, std::vector<std::set<std::string>>>& merge_keys_to_injection_names,
+                                      const std::vector<std::string>& feature_names,
+                                      std::map<std::set<std::string>, size_t>& injection_set_indices,
+                                      std::vector<MergeStep>& merge_steps)
   {
-    // initialize our map of feature names to values
-    std::map<std::string, std::map<std::set<std::string>, float>> features_to_values;
-    for (const auto& m : metadataFloatToString) {
-      features_to_values.emplace(m.second, std::map<std::set<std::string>, float>());
+    const auto feature = std::lower_bound(feature_names.cbegin(), feature_names.cend(), feature_name);
+    if (feature == feature_names.cend() || *feature != feature_name) {
+      //LOGD << "Feature name: " << feature_name << " was not found in the FeatureMap."; // This will polute the log
+      return;
     }
+    auto intern = [&injection_set_indices](const std::set<std::string>& injection_set) {
+      return injection_set_indices.emplace(injection_set, injection_set_indices.size()).first->second;
+    };
+    for (const auto& scan_polarity : scan_polarities) {
+      for (const auto& scan_mass_range : scan_mass_ranges) {
+        for (const auto& dilution_factor : dilution_factors) {
+          const auto key = std::make_tuple(scan_polarity, scan_mass_range, dilution_factor);
+          if (merge_keys_to_injection_names.count(key) <= 0) continue;
+          MergeStep merge_step;
+          merge_step.feature = std::distance(feature_names.cbegin(), feature);
+          merge_step.rule = rule;
+          std::set<std::string> injections;
+          for (const std::set<std::string>& injection_names_set : merge_keys_to_injection_names.at(key)) {
+            merge_step.injection_sets.push_back(intern(injection_names_set));
+            injections.insert(injection_names_set.cbegin(), injection_names_set.cend());
+          }
+          merge_step.merged_injection_set = intern(injections);
+          // If we are merging two or more injections, the feature associated with each of them is removed
+          if (injections.size() > 1) {
+            for (const auto& injection : injections) {
+              merge_step.removed_injection_sets.push_back(intern(std::set<std::string>({ injection })));
+            }
+          }
+          merge_steps.push_back(std::move(merge_step));
+        }
+      }
+    }
+  }
 
-    // construct the map
+  void MergeInjections::getComponentsToInjectionValues(const SampleGroupHandler& sampleGroupHandler_IO,
+                                                       const SequenceHandler& sequenceHandler_I,
+                                                       const bool& merge_subordinates,
+                                                       const std::vector<std::string>& feature_names,
+                                                       std::map<std::set<std::string>, size_t>& injection_set_indices,
+                                                       std::map<componentKeyType, std::vector<injectionValueType>>& component_to_injection_values)
+  {
+    const std::vector<SequenceHandler::MetaValueKey> feature_keys = SequenceHandler::resolveMetaValues(feature_names);
     for (const std::size_t& index : sampleGroupHandler_IO.getSampleIndices()) {
       const OpenMS::FeatureMap& fmap = sequenceHandler_I.getSequence().at(index).getRawData().getFeatureMap();
       const std::string injection_name = sequenceHandler_I.getSequence().at(index).getMetaData().getInjectionName();
+      const size_t injection_set = injection_set_indices.emplace(std::set<std::string>({ injection_name }), injection_set_indices.size()).first->second;
+
+      auto add_values = [&](const OpenMS::Feature& feature, std::vector<injectionValueType>& values) {
+        for (size_t f = 0; f < feature_names.size(); ++f) {
+          const CastValue& datum = SequenceHandler::getMetaValue(feature, feature, feature_keys[f]);
+          if (datum.getTag() == CastValue::Type::UNINITIALIZED || datum.getTag() == CastValue::Type::STRING) {
+            //LOGD << "Feature name: " << feature_names[f] << " was not found in the FeatureMap."; // This will polute the log
+            continue;
+          }
+          values.emplace_back(injection_set, f, datum.f_);
+        }
+      };
 
       // Get the features/subordinates
-      OpenMS::FeatureMap fmap_tmp;
       for (const OpenMS::Feature& f : fmap) {
         // Feature level merge
         if (!merge_subordinates) {
           componentKeyType component(f.getMetaValue("PeptideRef").toString(), "");
-          component_to_feature_to_injection_to_values.emplace(component, features_to_values);
-          for (const auto& f_to_v : features_to_values) {
-            const CastValue& datum = SequenceHandler::getMetaValue(f, f, f_to_v.first);
-            if (datum.getTag() == CastValue::Type::UNINITIALIZED || datum.getTag() == CastValue::Type::STRING) {
-              //LOGD << "Feature name: " << f_to_v.first << " was not found in the FeatureMap."; // This will polute the log
-              continue;
-            }
-            component_to_feature_to_injection_to_values.at(component).at(f_to_v.first).emplace(std::set<std::string>({ injection_name }), datum.f_);
-          }
+          add_values(f, component_to_injection_values[component]);
         }
         // Subordinate level merge
-        else if (merge_subordinates) 
+        else
         {
           for (const OpenMS::Feature& s : f.getSubordinates()) {
             componentKeyType component(f.getMetaValue("PeptideRef").toString(), s.getMetaValue("native_id").toString());
-            component_to_feature_to_injection_to_values.emplace(component, features_to_values);
-            for (const auto& f_to_v : features_to_values) {
-              const CastValue& datum = SequenceHandler::getMetaValue(s, s, f_to_v.first);
-              if (datum.getTag() == CastValue::Type::UNINITIALIZED || datum.getTag() == CastValue::Type::STRING) {
-                //LOGD << "Feature name: " << f_to_v.first << " was not found in the FeatureMap."; // This will polute the log
-                continue;
-              }
-              component_to_feature_to_injection_to_values.at(component).at(f_to_v.first).emplace(std::set<std::string>({ injection_name }), datum.f_);
-            }
+            add_values(s, component_to_injection_values[component]);
           }
         }
       }
     }
   }
-  void MergeInjections::mergeComponentsToFeaturesToInjectionsToValues(const std::string& feature_name,
-                                                                      const std::string& merge_rule,
-                                                                      const std::set<std::string>& scan_polarities,
-                                                                      const std::set<std::pair<float, float>>& scan_mass_ranges,
-                                                                      const std::set<float>& dilution_factors,
-                                                                      const std::map<mergeKeyType, std::vector<std::set<std::string>>>& merge_keys_to_injection_names,
-                                                                      std::map<componentKeyType, std::map<std::string, std::map<std::set<std::string>, float>>>& component_to_feature_to_injection_to_values)
+
+  void MergeInjections::mergeComponent(const std::vector<MergeStep>& merge_steps,
+                                       const std::vector<char>& preferred_injection_sets,
+                                       ComponentTable& table)
   {
-    for (const auto& scan_polarity : scan_polarities) {
-      for (const auto& scan_mass_range : scan_mass_ranges) {
-        for (const auto& dilution_factor : dilution_factors) {
-          const auto key = std::make_tuple(scan_polarity, scan_mass_range, dilution_factor);
-          for (auto& component_to_feature_to_injection_to_value : component_to_feature_to_injection_to_values) {
-            if (component_to_feature_to_injection_to_value.second.count(feature_name) <= 0) {
-              //LOGD << "Feature name: " << feature_name << " was not found in the FeatureMap."; // This will polute the log
-              continue;
+    // Keep only the preferred dilutions, if any of them has been found
+    if (!preferred_injection_sets.empty()) {
+      bool found = false;
+      for (size_t feature = 0; feature < table.n_features && !found; ++feature) {
+        for (size_t injection_set = 0; injection_set < table.n_injection_sets && !found; ++injection_set) {
+          found = table.isSet(feature, injection_set) && preferred_injection_sets[injection_set];
+        }
+      }
+      if (found) {
+        for (size_t feature = 0; feature < table.n_features; ++feature) {
+          for (size_t injection_set = 0; injection_set < table.n_injection_sets; ++injection_set) {
+            if (!preferred_injection_sets[injection_set]) {
+              table.erase(feature, injection_set);
             }
-            if (merge_keys_to_injection_names.count(key) <= 0) continue;
+          }
+        }
+      }
+    }
 
-            // Find the total value for weighting
-            float total_value = 0;
-            for (const std::set<std::string>& injection_names_set : merge_keys_to_injection_names.at(key)) {
-              if (component_to_feature_to_injection_to_value.second.at(feature_name).count(injection_names_set) <= 0) continue;
-              total_value += component_to_feature_to_injection_to_value.second.at(feature_name).at(injection_names_set);
-            }
+    for (const MergeStep& merge_step : merge_steps) {
+      applyMergeStep(merge_step, table);
+    }
+  }
 
-            // Calculated the weights and representative merged value
-            float merged_value = 0;
-            std::vector<float> weights;
-            std::set<std::string> injections;
-            std::set<std::string> max_or_min_injections;
-            int cnt = 0;
-            for (const std::set<std::string>& injection_names_set : merge_keys_to_injection_names.at(key)) {
-
-              // record the injections
-              // Note: this is done before checking if the feature exists to ensure that all injections are propogated to the next iteration
-              for (const std::string& inj : injection_names_set) {
-                injections.insert(inj);
-              }
-
-              // check if the feature is in the FeatureMap
-              if (component_to_feature_to_injection_to_value.second.at(feature_name).count(injection_names_set) <= 0) continue;
-              float value = component_to_feature_to_injection_to_value.second.at(feature_name).at(injection_names_set);
-              weights.push_back(value / total_value); // add to the weights
-
-              // initializations
-              if (cnt == 0) 
-              {
-                max_or_min_injections = injection_names_set;
-                if (merge_rule == "Min" || merge_rule == "Max") 
-                {
-                  merged_value = value;
-                }
-              }
-
-              // calculations
-              if (merge_rule == "Sum") 
-              {
-                merged_value += value;
-              }
-              else if (merge_rule == "Min") 
-              {
-                if (value < merged_value) {
-                  merged_value = value;
-                  max_or_min_injections = injection_names_set;
-                }
-              }
-              else if (merge_rule == "Max") 
-              {
-                if (value > merged_value) {
-                  merged_value = value;
-                  max_or_min_injections = injection_names_set;
-                }
-              }
-              else if (merge_rule == "Mean") 
-              {
-                merged_value += (value / merge_keys_to_injection_names.at(key).size());
-              }
-              else if (merge_rule == "WeightedMean") 
-              {
-                merged_value += (value * value / total_value);
-              }
-              ++cnt;
-            }
+  void MergeInjections::applyMergeStep(const MergeStep& merge_step, ComponentTable& table)
+  {
+    const size_t feature_name = merge_step.feature;
+    const MergeRule merge_rule = merge_step.rule;
+    const std::vector<size_t>& injection_sets = merge_step.injection_sets;
+
+    // Find the total value for weighting
+    float total_value = 0;
+    for (const size_t injection_names_set : injection_sets) {
+      if (!table.isSet(feature_name, injection_names_set)) continue;
+      total_value += table.value(feature_name, injection_names_set);
+    }
 
-            // Make the merged feature
-            if (weights.size() <= 0) continue; // Note: we use the weights to check instead of the injections as the weights will be empty if no features exist for any of the injections
-            component_to_feature_to_injection_to_value.second.at(feature_name).insert_or_assign(injections, merged_value);
-
-            // If we are merging two or more injections, remove the feature associated with each of them
-            if (injections.size() > 1)
-            {
-              for (const auto& injection : injections)
-              {
-                std::set<std::string> injection_set({ injection });
-                component_to_feature_to_injection_to_value.second.at(feature_name).erase(injection_set);
-              }
-            }
+    // Calculated the weights and representative merged value
+    float merged_value = 0;
+    std::vector<float> weights;
+    size_t max_or_min_injections = 0;
+    int cnt = 0;
+    for (const size_t injection_names_set : injection_sets) {
+      // check if the feature is in the FeatureMap
+      if (!table.isSet(feature_name, injection_names_set)) continue;
+      float value = table.value(feature_name, injection_names_set);
+      weights.push_back(value / total_value); // add to the weights
+
+      // initializations
+      if (cnt == 0)
+      {
+        max_or_min_injections = injection_names_set;
+        if (merge_rule == MergeRule::Min || merge_rule == MergeRule::Max)
+        {
+          merged_value = value;
+        }
+      }
 
-            // Repeat for all other features
-            for (auto& feature_to_injection_to_value : component_to_feature_to_injection_to_value.second) {
-              if (feature_name == feature_to_injection_to_value.first) continue;
-              if (feature_to_injection_to_value.second.count(max_or_min_injections) <= 0) continue;
-
-              // Calculated the merged value
-              float merged_value = 0;
-              if (merge_rule == "Min" || merge_rule == "Max") {
-                merged_value = feature_to_injection_to_value.second.at(max_or_min_injections);
-              }
-              else 
-              {
-                int cnt = 0;
-                for (const std::set<std::string>& injection_names_set : merge_keys_to_injection_names.at(key)) {
-                  if (feature_to_injection_to_value.second.count(injection_names_set) <= 0) continue;
-                  float value = feature_to_injection_to_value.second.at(injection_names_set);
-                  if (merge_rule == "Sum") merged_value += value;
-                  else if (merge_rule == "Mean") merged_value += (value / weights.size());
-                  else if (merge_rule == "WeightedMean") merged_value += (value * weights.at(cnt));
-                  ++cnt;
-                }
-              }
-
-              // Make the merged feature
-              feature_to_injection_to_value.second.insert_or_assign(injections, merged_value);
-
-              // If we are merging two or more injections, remove the feature associated with each of them
-              if (injections.size() > 1)
-              {
-                for (const auto& injection : injections)
-                {
-                  std::set<std::string> injection_set({ injection });
-                  feature_to_injection_to_value.second.erase(injection_set);
-                }
-              }
-            }
-          }
+      // calculations
+      if (merge_rule == MergeRule::Sum)
+      {
+        merged_value += value;
+      }
+      else if (merge_rule == MergeRule::Min)
+      {
+        if (value < merged_value) {
+          merged_value = value;
+          max_or_min_injections = injection_names_set;
+        }
+      }
+      else if (merge_rule == MergeRule::Max)
+      {
+        if (value > merged_value) {
+          merged_value = value;
+          max_or_min_injections = injection_names_set;
+        }
+      }
+      else if (merge_rule == MergeRule::Mean)
+      {
+        merged_value += (value / injection_sets.size());
+      }
+      else if (merge_rule == MergeRule::WeightedMean)
+      {
+        merged_value += (value * value / total_value);
+      }
+      ++cnt;
+    }
+
+    // Make the merged feature
+    if (weights.size() <= 0) return; // Note: we use the weights to check instead of the injections as the weights will be empty if no features exist for any of the injections
+    table.set(feature_name, merge_step.merged_injection_set, merged_value);
+    for (const size_t injection_set : merge_step.removed_injection_sets) {
+      table.erase(feature_name, injection_set);
+    }
+
+    // Repeat for all other features
+    for (size_t feature = 0; feature < table.n_features; ++feature) {
+      if (feature == feature_name) continue;
+      if (!table.isSet(feature, max_or_min_injections)) continue;
+
+      // Calculated the merged value
+      float merged_value = 0;
+      if (merge_rule == MergeRule::Min || merge_rule == MergeRule::Max) {
+        merged_value = table.value(feature, max_or_min_injections);
+      }
+      else
+      {
+        int cnt = 0;
+        for (const size_t injection_names_set : injection_sets) {
+          if (!table.isSet(feature, injection_names_set)) continue;
+          float value = table.value(feature, injection_names_set);
+          if (merge_rule == MergeRule::Sum) merged_value += value;
+          else if (merge_rule == MergeRule::Mean) merged_value += (value / weights.size());
+          else if (merge_rule == MergeRule::WeightedMean) merged_value += (value * weights.at(cnt));
+          ++cnt;
         }
       }
+
+      // Make the merged feature
+      table.set(feature, merge_step.merged_injection_set, merged_value);
+      for (const size_t injection_set : merge_step.removed_injection_sets) {
+        table.erase(feature, injection_set);
+      }
     }
   }
+
   void MergeInjections::makeFeatureMap(const bool& merge_subordinates,
-                                       std::set<std::string>& injection_names_set,
-                                       const std::map<componentKeyType, std::map<std::string, std::map<std::set<std::string>, float>>>& component_to_feature_to_injection_to_values,
+                                       const std::vector<std::string>& feature_names,
+                                       const std::map<componentKeyType, std::vector<injectionValueType>>& component_to_injection_values,
+                                       const std::vector<std::vector<std::pair<size_t, float>>>& merged_values,
                                        OpenMS::FeatureMap& feature_map)
   {
     OpenMS::Feature f, s;
     std::vector<OpenMS::Feature> subs;
     std::string peptide_ref_cur = "";
-    for (const auto& component_to_feature_to_injection_to_value : component_to_feature_to_injection_to_values) {
+    size_t component_index = 0;
+    for (const auto& component_to_injection_value : component_to_injection_values) {
 
       // Decide whether to make a new feature or continue adding subordinates
       if (merge_subordinates) {
         subs.push_back(s);
         s = OpenMS::Feature();
         s.setUniqueId();
-        s.setMetaValue("native_id", component_to_feature_to_injection_to_value.first.second);
+        s.setMetaValue("native_id", component_to_injection_value.first.second);
       }
-      if (component_to_feature_to_injection_to_value.first.first != peptide_ref_cur) {
+      if (component_to_injection_value.first.first != peptide_ref_cur) {
         if (merge_subordinates) {
           f.setSubordinates(subs);
           subs.clear();
@@ -652,68 +727,41 @@ namespace SmartPeak
         feature_map.push_back(f);
         f = OpenMS::Feature();
         f.setUniqueId();
-        f.setMetaValue("PeptideRef", component_to_feature_to_injection_to_value.first.first);
-        peptide_ref_cur = component_to_feature_to_injection_to_value.first.first;              
+        f.setMetaValue("PeptideRef", component_to_injection_value.first.first);
+        peptide_ref_cur = component_to_injection_value.first.first;              
       }
 
       // Get the metadata
-      for (const auto& feature_to_injection_to_value : component_to_feature_to_injection_to_value.second) {
-        if (feature_to_injection_to_value.second.count(injection_names_set) <= 0) continue;
-        float value = feature_to_injection_to_value.second.at(injection_names_set);
-        if (!merge_subordinates) {
-          if (feature_to_injection_to_value.first == "RT") 
-          {
-            f.setRT(value);
-          }
-          else if (feature_to_injection_to_value.first == "Intensity") 
-          {
-            f.setIntensity(value);
-          }
-          else if (feature_to_injection_to_value.first == "peak_area") 
-          {
-            f.setIntensity(value);
-          }
-          else if (feature_to_injection_to_value.first == "mz") 
-          {
-            f.setMZ(value);
-          }
-          else if (feature_to_injection_to_value.first == "charge") 
-          {
-            f.setCharge(static_cast<int>(value));
-          }
-          else 
-          {
-            f.setMetaValue(feature_to_injection_to_value.first, value);
-          }
+      for (const auto& feature_to_value : merged_values.at(component_index)) {
+        const std::string& feature_name = feature_names.at(feature_to_value.first);
+        const float value = feature_to_value.second;
+        OpenMS::Feature& target = merge_subordinates ? s : f;
+        if (feature_name == "RT") 
+        {
+          target.setRT(value);
         }
-        else if (merge_subordinates) 
+        else if (feature_name == "Intensity") 
         {
-          if (feature_to_injection_to_value.first == "RT") 
-          {
-            s.setRT(value);
-          }
-          else if (feature_to_injection_to_value.first == "Intensity") 
-          {
-            s.setIntensity(value);
-          }
-          else if (feature_to_injection_to_value.first == "peak_area") 
-          {
-            s.setIntensity(value);
-          }
-          else if (feature_to_injection_to_value.first == "mz") 
-          {
-            s.setMZ(value);
-          }
-          else if (feature_to_injection_to_value.first == "charge") 
-          {
-            s.setCharge(static_cast<int>(value));
-          }
-          else 
-          {
-            s.setMetaValue(feature_to_injection_to_value.first, value);
-          }
-        }             
+          target.setIntensity(value);
+        }
+        else if (feature_name == "peak_area") 
+        {
+          target.setIntensity(value);
+        }
+        else if (feature_name == "mz") 
+        {
+          target.setMZ(value);
+        }
+        else if (feature_name == "charge") 
+        {
+          target.setCharge(static_cast<int>(value));
+        }
+        else 
+        {
+          target.setMetaValue(feature_name, value);
+        }
       }
+      ++component_index;
     }
 
     // Add in the last feature
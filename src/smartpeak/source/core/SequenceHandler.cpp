@@ -287,6 +287,40 @@ namespace SmartPeak
     return samples;
   }
 
+  SequenceHandler::MetaValueKey SequenceHandler::resolveMetaValue(const std::string& meta_value)
+  {
+    MetaValueKey key;
+    key.name = meta_value;
+    if (meta_value == "RT") {
+      key.field = MetaValueKey::Field::RT;
+    } else if (meta_value == "mz") { // Mass to charge ratio
+      key.field = MetaValueKey::Field::mz;
+    } else if (meta_value == "charge") {
+      key.field = MetaValueKey::Field::charge;
+    } else if (meta_value == "intensity") { // Sum of each subordinate intensity
+      key.field = MetaValueKey::Field::intensity;
+    } else if (meta_value == "peak_area") { // Subordinate intensity (also called "peak area)
+      key.field = MetaValueKey::Field::peak_area;
+    } else if (meta_value == "validation") { // The result of the validation
+      key.field = MetaValueKey::Field::validation;
+    }
+    if (key.field == MetaValueKey::Field::meta_value || key.field == MetaValueKey::Field::validation) {
+      // does not register the name: a name that no feature has set is absent from all of them
+      key.index = OpenMS::MetaInfoInterface::metaRegistry().getIndex(meta_value);
+    }
+    return key;
+  }
+
+  std::vector<SequenceHandler::MetaValueKey> SequenceHandler::resolveMetaValues(const std::vector<std::string>& meta_values)
+  {
+    std::vector<MetaValueKey> keys;
+    keys.reserve(meta_values.size());
+    for (const std::string& meta_value : meta_values) {
+      keys.push_back(resolveMetaValue(meta_value));
+    }
+    return keys;
+  }
+
   CastValue SequenceHandler::getMetaValue(
     const OpenMS::Feature& feature,
     const OpenMS::Feature& subordinate,
@@ -318,6 +352,55 @@ namespace SmartPeak
     return cast;
   }
 
+  CastValue SequenceHandler::getMetaValue(
+    const OpenMS::Feature& feature,
+    const OpenMS::Feature& subordinate,
+    const MetaValueKey& meta_value
+  )
+  {
+    CastValue cast;
+
+    switch (meta_value.field) {
+    case MetaValueKey::Field::RT:
+      cast = static_cast<float>(feature.getRT());
+      return cast;
+    case MetaValueKey::Field::mz:
+      cast = static_cast<float>(feature.getMZ());
+      return cast;
+    case MetaValueKey::Field::charge:
+      cast = static_cast<int>(feature.getCharge());
+      return cast;
+    case MetaValueKey::Field::intensity:
+      cast = static_cast<float>(feature.getIntensity());
+      return cast;
+    case MetaValueKey::Field::peak_area:
+      cast = static_cast<float>(subordinate.getIntensity());
+      return cast;
+    case MetaValueKey::Field::validation:
+      cast = static_cast<std::string>(subordinate.getMetaValue(meta_value.index)); // Prioritize the subordinate over the feature
+      return cast;
+    case MetaValueKey::Field::meta_value:
+      break;
+    }
+
+    // absent meta values are returned as empty values
+    if (meta_value.index != MetaValueKey::unknown_index) {
+      const OpenMS::DataValue& subordinate_value = subordinate.getMetaValue(meta_value.index);
+      if (!subordinate_value.isEmpty()) {
+        cast = Utilities::OpenMSDataValueToCastValue(subordinate_value);
+        return cast;
+      }
+      const OpenMS::DataValue& feature_value = feature.getMetaValue(meta_value.index);
+      if (!feature_value.isEmpty()) {
+        cast = Utilities::OpenMSDataValueToCastValue(feature_value);
+        return cast;
+      }
+    }
+    LOGV << "meta_value not found: " << meta_value.name;
+    cast = "";
+    return cast;
+  }
+
   std::string SequenceHandler::getRawDataFilesInfo() const
   {
     size_t cnt {0};
@@ -41,7 +41,6 @@
 #include <plog/Log.h>
 #include <atomic>
 #include <future>
-#include <list>
 #include <unordered_set>
 #include <filesystem>
 
@@ -63,33 +62,6 @@ namespace SmartPeak
     LOGD << "END " << getName();
   }
 
-  class WorkflowException : public std::exception
-  {
-  public:
-
-    explicit WorkflowException(const std::string& item, const std::string& processor, const std::string& message)
-      : item_(item), processor_(processor), msg_(message)  {}
-
-    virtual ~WorkflowException() noexcept {}
-
-    virtual const char* what() const noexcept override {
-      return msg_.c_str();
-    }
-
-    virtual const std::string item() const noexcept {
-      return item_;
-    }
-
-    virtual const std::string processor() const noexcept {
-      return processor_;
-    }
-
-  protected:
-    std::string item_;
-    std::string processor_;
-    std::string msg_;
-  };
-
   void ProcessSequence::doProcess(Filenames& filenames_I)
   {
     // Check that there are raw data processing methods
@@ -158,11 +130,16 @@ namespace SmartPeak
     SequenceSegmentHandler& sequence_segment,
     SequenceHandler& sequenceHandler_IO,
     Filenames& filenames,
-    const std::vector<std::shared_ptr<SequenceSegmentProcessor>>& methods)
+    const std::vector<std::shared_ptr<SequenceSegmentProcessor>>& methods,
+    const CancellationToken& token)
   {
     const size_t nr_methods = methods.size();
     LOGI << ">>Processing SequenceSegment [" << sequence_segment.getSequenceSegmentName() << "]\n";
     for (size_t i = 0; i < nr_methods; ++i) {
+      if (token.isCancelled()) {
+        LOGD << ">>SequenceSegment [" << sequence_segment.getSequenceSegmentName() << "]: cancelled";
+        return;
+      }
       LOGI << "[" << (i + 1) << "/" << nr_methods << "] steps in processing sequence segments";
       try
       {
@@ -194,23 +171,18 @@ namespace SmartPeak
       }
   
       SequenceSegmentHandler& sequence_seg {sequence_segment_[i]};
+      const CancellationToken& token { cancellation_tokens_[i] };
+      if (token.isCancelled()) {
+        LOGD << ">>SequenceSegment [" << sequence_seg.getSequenceSegmentName() << "]: cancelled";
+        continue;
+      }
       if (observable_) observable_->notifySequenceSegmentProcessorSampleStart(sequence_seg.getSequenceSegmentName());
       
       try {
-        std::future<void> f = std::async(
-        std::launch::async,
-        processSegment,
-        std::ref(sequence_seg),
-        std::ref(sequenceHandler_IO),
-        std::ref(filenames_.at( sequence_seg.getSequenceSegmentName())),
-        std::cref(sequence_segment_processing_methods_));
-          
-        LOGI << ">>SequenceSegment [" << sequence_seg.getSequenceSegmentName() << "]: waiting...";
-        f.wait();
-        LOGI << ">>SequenceSegment [" << sequence_seg.getSequenceSegmentName() << "]: done";
-          
+        Filenames& filenames = filenames_.at(sequence_seg.getSequenceSegmentName());
         try {
-          f.get();
+          processSegment(sequence_seg, sequenceHandler_IO, filenames, sequence_segment_processing_methods_, token);
+          LOGI << ">>SequenceSegment [" << sequence_seg.getSequenceSegmentName() << "]: done";
         }
         catch (const WorkflowException& e)
         {
@@ -244,23 +216,18 @@ namespace SmartPeak
       }
   
       SampleGroupHandler& sequence_seg {sample_group_[i]};
+      const CancellationToken& token { cancellation_tokens_[i] };
+      if (token.isCancelled()) {
+        LOGD << ">>SampleGroup [" << sequence_seg.getSampleGroupName() << "]: cancelled";
+        continue;
+      }
       if (observable_) observable_->notifySampleGroupProcessorSampleStart(sequence_seg.getSampleGroupName());
       
       try {
-        std::future<void> f = std::async(
-        std::launch::async,
-        processSampleGroup,
-        std::ref(sequence_seg),
-        std::ref(sequenceHandler_IO),
-        std::ref(filenames_.at( sequence_seg.getSampleGroupName())),
-        std::cref(sample_group_processing_methods_));
-          
-        LOGI << ">>SampleGroup [" << sequence_seg.getSampleGroupName() << "]: waiting...";
-        f.wait();
-        LOGI << ">>SampleGroup [" << sequence_seg.getSampleGroupName() << "]: done";
-          
+        Filenames& filenames = filenames_.at(sequence_seg.getSampleGroupName());
         try {
-          f.get();
+          processSampleGroup(sequence_seg, sequenceHandler_IO, filenames, sample_group_processing_methods_, token);
+          LOGI << ">>SampleGroup [" << sequence_seg.getSampleGroupName() << "]: done";
         }
         catch (const WorkflowException& e)
         {
@@ -321,10 +288,15 @@ namespace SmartPeak
     SampleGroupHandler& sample_group,
     SequenceHandler& sequenceHandler_IO,
     Filenames& filenames,
-    const std::vector<std::shared_ptr<SampleGroupProcessor>>& methods)
+    const std::vector<std::shared_ptr<SampleGroupProcessor>>& methods,
+    const CancellationToken& token)
   {
     const size_t n = methods.size();
     for (size_t i = 0; i < n; ++i) {
+      if (token.isCancelled()) {
+        LOGD << ">>SampleGroup [" << sample_group.getSampleGroupName() << "]: cancelled";
+        return;
+      }
       LOGI << "[" << (i + 1) << "/" << n << "] steps in processing sample groups";
       try
       {
@@ -347,70 +319,23 @@ namespace SmartPeak
     }
   }
 
-  void SequenceSegmentProcessorMultithread::spawn_workers(unsigned int n_threads)
+  void ProcessorMultithread::spawn_workers(unsigned int n_threads)
   {
     // Refine the # of threads based on the hardware
     size_t n_workers = getNumWorkers(n_threads);
     LOGD << "Number of workers: " << n_workers;
 
-    // Spawn the workers
+    // Submit the workers to the shared pool
     try {
-      std::list<std::future<void>> futures;
-      LOGD << "Spawning workers...";
+      ThreadPool& pool = ThreadPool::instance();
+      std::vector<std::future<void>> futures;
+      LOGD << "Submitting workers...";
       for (size_t i = 0; i < n_workers; ++i) {
-        futures.emplace_back(std::async(std::launch::async, &SequenceSegmentProcessorMultithread::run_processing, this));
+        futures.emplace_back(pool.submit([this]() { run_processing(); }));
       }
       LOGD << "Waiting for workers...";
       for (std::future<void>& f : futures) {
-        f.wait();
-      }
-      LOGD << "Workers are done";
-    }
-    catch (const std::exception& e) {
-      LOGE << e.what();
-    }
-  }
-
-  void SampleGroupProcessorMultithread::spawn_workers(unsigned int n_threads)
-  {
-    // Refine the # of threads based on the hardware
-    size_t n_workers = getNumWorkers(n_threads);
-    LOGD << "Number of workers: " << n_workers;
-
-    // Spawn the workers
-    try {
-      std::list<std::future<void>> futures;
-      LOGD << "Spawning workers...";
-      for (size_t i = 0; i < n_workers; ++i) {
-        futures.emplace_back(std::async(std::launch::async, &SampleGroupProcessorMultithread::run_processing, this));
-      }
-      LOGD << "Waiting for workers...";
-      for (std::future<void>& f : futures) {
-        f.wait();
-      }
-      LOGD << "Workers are done";
-    }
-    catch (const std::exception& e) {
-      LOGE << e.what();
-    }
-  }
-
-  void SequenceProcessorMultithread::spawn_workers(unsigned int n_threads)
-  {
-    // Refine the # of threads based on the hardware
-    size_t n_workers = getNumWorkers(n_threads);
-    LOGD << "Number of workers: " << n_workers;
-
-    // Spawn the workers
-    try {
-      std::list<std::future<void>> futures;
-      LOGD << "Spawning workers...";
-      for (size_t i = 0; i < n_workers; ++i) {
-        futures.emplace_back(std::async(std::launch::async, &SequenceProcessorMultithread::run_processing, this));
-      }
-      LOGD << "Waiting for workers...";
-      for (std::future<void>& f : futures) {
-        f.wait();
+        pool.wait(f);
       }
       LOGD << "Workers are done";
     }
@@ -430,19 +355,17 @@ namespace SmartPeak
 
       // Launch the processing method
       InjectionHandler& injection { injections_[i] };
+      const CancellationToken& token { cancellation_tokens_[i] };
+      if (token.isCancelled()) {
+        LOGD << "Injection [" << i << "]: cancelled";
+        continue;
+      }
       if (observable_) observable_->notifySequenceProcessorSampleStart(injection.getMetaData().getSampleName());
       try {
-        std::future<void> f = std::async(
-          std::launch::async,
-          processInjection,
-          std::ref(injection),
-          std::ref(filenames_.at(injection.getMetaData().getInjectionName())),
-          std::cref(methods_));
-        LOGD << "Injection [" << i << "]: waiting...";
-        f.wait();
-        LOGD << "Injection [" << i << "]: done";
+        Filenames& filenames = filenames_.at(injection.getMetaData().getInjectionName());
         try {
-          f.get(); // check for exceptions
+          processInjection(injection, filenames, methods_, token);
+          LOGD << "Injection [" << i << "]: done";
         }
         catch (const WorkflowException& e)
         {
@@ -467,15 +390,15 @@ namespace SmartPeak
     LOGD << "Worker is done";
   }
 
-  size_t ProcessorMultithread::getNumWorkers(unsigned int n_threads) const {
+  size_t ProcessorMultithread::getNumWorkers(unsigned int n_threads) {
     const unsigned int max_threads = std::thread::hardware_concurrency(); // might return 0
     size_t n_workers = 0;
 
     if (max_threads != 0) {
       if (n_threads > max_threads) {
-        n_workers = max_threads - 1;
+        n_workers = max_threads;
       } else if (n_threads <= max_threads && n_threads > 1) {
-        n_workers = n_threads - 1;
+        n_workers = n_threads;
       } else if (n_threads >= 0) {
         LOGD << "Max available threads: " << max_threads;
         LOGD << "but using just 1 thread.";
@@ -491,13 +414,18 @@ namespace SmartPeak
   void processInjection(
     InjectionHandler& injection,
     Filenames& filenames_I,
-    const std::vector<std::shared_ptr<RawDataProcessor>>& methods
+    const std::vector<std::shared_ptr<RawDataProcessor>>& methods,
+    const CancellationToken& token
   )
   {
     size_t i_step { 1 };
     const size_t n_steps { methods.size() };
     const std::string inj_name { injection.getMetaData().getInjectionName() };
     for (const std::shared_ptr<RawDataProcessor>& p : methods) {
+      if (token.isCancelled()) {
+        LOGD << "Injection [" << inj_name << "]: cancelled";
+        return;
+      }
       try
       {
         LOGI << "[" << (i_step++) << "/" << n_steps << "] method on injection: " << inj_name;
@@ -29,12 +29,16 @@
 #include <SmartPeak/core/Utilities.h>
 #include <SmartPeak/core/ApplicationHandler.h>
 #include <SmartPeak/core/FeatureFiltersUtils.h>
+#include <SmartPeak/core/ThreadPool.h>
 #include <SmartPeak/io/InputDataValidation.h>
 
 #include <OpenMS/ANALYSIS/QUANTITATION/AbsoluteQuantitation.h>
+#include <OpenMS/METADATA/AbsoluteQuantitationStandards.h>
 
 #include <plog/Log.h>
 
+#include <future>
+
 namespace SmartPeak
 {
   std::set<std::string> OptimizeCalibration::getInputs() const
@@ -81,88 +85,147 @@ namespace SmartPeak
       throw std::invalid_argument("standards_indices argument is empty.");
     }
 
-    std::vector<OpenMS::FeatureMap> standards_featureMaps;
-    for (const size_t index : standards_indices) {
-      standards_featureMaps.push_back(sequenceHandler_I.getSequence().at(index).getRawData().getFeatureMap());
+    // map standards to features, once for all the components
+    std::map<OpenMS::String, std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration>> components_to_standards;
+    {
+      // AbsoluteQuantitationStandards only accepts owned feature maps, released once mapped
+      std::vector<OpenMS::FeatureMap> standards_featureMaps;
+      for (const size_t index : standards_indices) {
+        standards_featureMaps.push_back(sequenceHandler_I.getSequence().at(index).getRawData().getFeatureMap());
+      }
+      OpenMS::AbsoluteQuantitationStandards absoluteQuantitationStandards;
+      absoluteQuantitationStandards.mapComponentsToConcentrations(
+        sequenceSegmentHandler_IO.getStandardsConcentrations(),
+        standards_featureMaps,
+        components_to_standards
+      );
     }
 
     // add in the method parameters
     OpenMS::AbsoluteQuantitation absoluteQuantitation;
     Utilities::setUserParameters(absoluteQuantitation, params_I);
 
-    absoluteQuantitation.setQuantMethods(sequenceSegmentHandler_IO.getQuantitationMethods());
+    // the components are optimized independently, each one against its
+    // mapped standards and into its own result slot
+    const std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration> no_standards;
+    const std::vector<OpenMS::AbsoluteQuantitationMethod>& quantitation_methods = sequenceSegmentHandler_IO.getQuantitationMethods();
+    std::vector<ComponentCalibration> calibrations(quantitation_methods.size());
+    ThreadPool& pool = ThreadPool::instance();
+    const size_t n_chunks = std::min(quantitation_methods.size(), pool.size());
+    std::vector<std::future<void>> futures;
+    for (size_t chunk = 0; chunk < n_chunks; ++chunk) {
+      futures.push_back(pool.submit([&, chunk]() {
+        OpenMS::AbsoluteQuantitation chunk_absoluteQuantitation(absoluteQuantitation);
+        for (size_t i = chunk; i < quantitation_methods.size(); i += n_chunks) {
+          const auto standards = components_to_standards.find(quantitation_methods[i].getComponentName());
+          optimizeComponent(
+            chunk_absoluteQuantitation,
+            quantitation_methods[i],
+            sequenceSegmentHandler_IO,
+            (standards != components_to_standards.cend()) ? standards->second : no_standards,
+            calibrations[i]
+          );
+        }
+      }));
+    }
+    for (auto& future : futures) {
+      pool.wait(future);
+    }
+    for (auto& future : futures) {
+      future.get(); // forward the errors of the optimizations
+    }
+
+    // merge the results back in the order of the quantitation methods
+    std::vector<OpenMS::AbsoluteQuantitationMethod> optimized_methods;
+    optimized_methods.reserve(quantitation_methods.size());
     std::map<std::string, std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration>> components_to_concentrations;
     std::map<std::string, std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration>> excluded_components_to_concentrations;
-    for (const OpenMS::AbsoluteQuantitationMethod& row : sequenceSegmentHandler_IO.getQuantitationMethods()) {
-      // map standards to features
-      OpenMS::AbsoluteQuantitationStandards absoluteQuantitationStandards;
-      std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration> feature_concentrations;
-
-      absoluteQuantitationStandards.getComponentFeatureConcentrations(
-        sequenceSegmentHandler_IO.getStandardsConcentrations(),
-        standards_featureMaps,
-        row.getComponentName(),
-        feature_concentrations
-      );
-
-      auto feature_concentrations_pruned = sequenceSegmentHandler_IO.getFeatureConcentrationsPruned(feature_concentrations);
-
-      // remove components without any points
-      if (feature_concentrations_pruned.empty()) {
+    for (size_t i = 0; i < quantitation_methods.size(); ++i) {
+      ComponentCalibration& calibration = calibrations[i];
+      if (!calibration.warning.empty()) {
+        LOGW << calibration.warning;
+      }
+      if (!calibration.optimized) {
+        optimized_methods.push_back(quantitation_methods[i]);
         continue;
       }
+      const std::string& component_name = quantitation_methods[i].getComponentName();
+      optimized_methods.push_back(std::move(calibration.method));
+      components_to_concentrations.erase(component_name);
+      components_to_concentrations.insert({ component_name, std::move(calibration.feature_concentrations) });
+      excluded_components_to_concentrations.erase(component_name);
+      excluded_components_to_concentrations.insert({ component_name, std::move(calibration.excluded_feature_concentrations) });
+    }
+    absoluteQuantitation.setQuantMethods(optimized_methods);
+    // store results
+    sequenceSegmentHandler_IO.setComponentsToConcentrations(components_to_concentrations);
+    sequenceSegmentHandler_IO.setExcludedComponentsToConcentrations(excluded_components_to_concentrations);
+    sequenceSegmentHandler_IO.getQuantitationMethods() = absoluteQuantitation.getQuantMethods();
+  }
 
-      // Keep a copy to compute outer points
-      auto all_feature_concentrations = feature_concentrations_pruned;
+  void OptimizeCalibration::optimizeComponent(
+    OpenMS::AbsoluteQuantitation& absoluteQuantitation,
+    const OpenMS::AbsoluteQuantitationMethod& row,
+    const SequenceSegmentHandler& sequenceSegmentHandler_I,
+    const std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration>& feature_concentrations,
+    ComponentCalibration& calibration
+  ) const
+  {
+    auto feature_concentrations_pruned = sequenceSegmentHandler_I.getFeatureConcentrationsPruned(feature_concentrations);
 
-      try
-      {
-        absoluteQuantitation.optimizeSingleCalibrationCurve(
-          row.getComponentName(),
-          feature_concentrations_pruned
-        );
-      }
-      catch (OpenMS::Exception::DivisionByZero&)
-      {
-        LOGW << "Warning: '" << row.getComponentName() << "' cannot be analysed - division by zero\n";
-        continue;
-      }
-      catch (...)
-      {
-        LOGW << "Warning: '" << row.getComponentName() << "' cannot be analysed.\n";
-        continue;
-      }
+    // remove components without any points
+    if (feature_concentrations_pruned.empty()) {
+      return;
+    }
+
+    // Keep a copy to compute outer points
+    auto all_feature_concentrations = feature_concentrations_pruned;
+
+    std::vector<OpenMS::AbsoluteQuantitationMethod> component_methods { row };
+    absoluteQuantitation.setQuantMethods(component_methods);
+    try
+    {
+      absoluteQuantitation.optimizeSingleCalibrationCurve(
+        row.getComponentName(),
+        feature_concentrations_pruned
+      );
+    }
+    catch (OpenMS::Exception::DivisionByZero&)
+    {
+      calibration.warning = "Warning: '" + row.getComponentName() + "' cannot be analysed - division by zero\n";
+      return;
+    }
+    catch (...)
+    {
+      calibration.warning = "Warning: '" + row.getComponentName() + "' cannot be analysed.\n";
+      return;
+    }
 
-      // Compute outer points
-      std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration> excluded_feature_concentrations;
-      for (const auto& feature : all_feature_concentrations)
+    // Compute outer points
+    std::vector<OpenMS::AbsoluteQuantitationStandards::featureConcentration> excluded_feature_concentrations;
+    for (const auto& feature : all_feature_concentrations)
+    {
+      bool found = false;
+      for (const auto& feature_pruned : feature_concentrations_pruned)
       {
-        bool found = false;
-        for (const auto& feature_pruned : feature_concentrations_pruned)
-        {
-          if ((feature.IS_feature == feature_pruned.IS_feature)
-            && (std::abs(feature.actual_concentration - feature_pruned.actual_concentration) < 1e-9)
-            && (std::abs(feature.IS_actual_concentration - feature_pruned.IS_actual_concentration) < 1e-9)
-            && (std::abs(feature.dilution_factor - feature_pruned.dilution_factor) < 1e-9))
-          {
-            found = true;
-            break;
-          }
-        }
-        if (!found)
+        if ((feature.IS_feature == feature_pruned.IS_feature)
+          && (std::abs(feature.actual_concentration - feature_pruned.actual_concentration) < 1e-9)
+          && (std::abs(feature.IS_actual_concentration - feature_pruned.IS_actual_concentration) < 1e-9)
+          && (std::abs(feature.dilution_factor - feature_pruned.dilution_factor) < 1e-9))
         {
-          excluded_feature_concentrations.push_back(feature);
+          found = true;
+          break;
         }
       }
-      components_to_concentrations.erase(row.getComponentName());
-      components_to_concentrations.insert({ row.getComponentName(), feature_concentrations_pruned });
-      excluded_components_to_concentrations.erase(row.getComponentName());
-      excluded_components_to_concentrations.insert({ row.getComponentName(), excluded_feature_concentrations });
+      if (!found)
+      {
+        excluded_feature_concentrations.push_back(feature);
+      }
     }
-    // store results
-    sequenceSegmentHandler_IO.setComponentsToConcentrations(components_to_concentrations);
-    sequenceSegmentHandler_IO.setExcludedComponentsToConcentrations(excluded_components_to_concentrations);
-    sequenceSegmentHandler_IO.getQuantitationMethods() = absoluteQuantitation.getQuantMethods();
+    calibration.optimized = true;
+    calibration.method = absoluteQuantitation.getQuantMethods().front();
+    calibration.feature_concentrations = std::move(feature_concentrations_pruned);
+    calibration.excluded_feature_concentrations = std::move(excluded_feature_concentrations);
   }
 
 }
@@ -0,0 +1,129 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <SmartPeak/core/SeriesPyramid.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace SmartPeak
+{
+  SeriesPyramid::SeriesPyramid(const std::vector<float>& x, const std::vector<float>& y, size_t min_points)
+  {
+    if (x.size() != y.size())
+    {
+      throw std::invalid_argument("SeriesPyramid: x and y sizes differ.");
+    }
+    n_points_ = x.size();
+    sorted_ = std::is_sorted(x.begin(), x.end());
+    if (!sorted_)
+    {
+      return;
+    }
+    const std::vector<float>* x_previous = &x;
+    const std::vector<float>* y_previous = &y;
+    while (x_previous->size() > std::max<size_t>(min_points, 2))
+    {
+      // buckets of 4 points, i.e. the min and max of 2 buckets of the level below
+      std::vector<float> x_level, y_level;
+      decimateMinMax(x_previous->data(), y_previous->data(), x_previous->size(),
+                     (x_previous->size() + 3) / 4, x_level, y_level);
+      if (x_level.size() >= x_previous->size())
+      {
+        break;
+      }
+      x_levels_.push_back(std::move(x_level));
+      y_levels_.push_back(std::move(y_level));
+      x_previous = &x_levels_.back();
+      y_previous = &y_levels_.back();
+    }
+  }
+
+  SeriesPyramid::View SeriesPyramid::getView(const std::vector<float>& x, const std::vector<float>& y,
+                                             double x_min, double x_max, size_t max_points) const
+  {
+    View view;
+    if (!sorted_)
+    {
+      view.x = x.data();
+      view.y = y.data();
+      view.size = x.size();
+      return view;
+    }
+    for (size_t level = 0; level < getNLevels(); ++level)
+    {
+      const std::vector<float>& x_level = level ? x_levels_[level - 1] : x;
+      const std::vector<float>& y_level = level ? y_levels_[level - 1] : y;
+      auto begin = std::lower_bound(x_level.begin(), x_level.end(), x_min);
+      auto end = std::upper_bound(begin, x_level.end(), x_max);
+      if (begin != x_level.begin()) --begin;
+      if (end != x_level.end()) ++end;
+      const size_t offset = std::distance(x_level.begin(), begin);
+      view.x = x_level.data() + offset;
+      view.y = y_level.data() + offset;
+      view.size = std::distance(begin, end);
+      view.level = level;
+      if (view.size <= max_points)
+      {
+        break;
+      }
+    }
+    return view;
+  }
+
+  void SeriesPyramid::decimateMinMax(const float* x, const float* y, size_t n, size_t n_buckets,
+                                     std::vector<float>& x_out, std::vector<float>& y_out)
+  {
+    x_out.clear();
+    y_out.clear();
+    if (n <= 2 * n_buckets)
+    {
+      x_out.assign(x, x + n);
+      y_out.assign(y, y + n);
+      return;
+    }
+    x_out.reserve(2 * n_buckets);
+    y_out.reserve(2 * n_buckets);
+    for (size_t bucket = 0; bucket < n_buckets; ++bucket)
+    {
+      const size_t begin = bucket * n / n_buckets;
+      const size_t end = (bucket + 1) * n / n_buckets;
+      size_t i_min = begin, i_max = begin;
+      for (size_t i = begin + 1; i < end; ++i)
+      {
+        if (y[i] < y[i_min]) i_min = i;
+        if (y[i] > y[i_max]) i_max = i;
+      }
+      const size_t first = std::min(i_min, i_max);
+      const size_t second = std::max(i_min, i_max);
+      x_out.push_back(x[first]);
+      y_out.push_back(y[first]);
+      if (second != first)
+      {
+        x_out.push_back(x[second]);
+        y_out.push_back(y[second]);
+      }
+    }
+  }
+}
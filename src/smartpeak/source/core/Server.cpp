@@ -209,7 +209,9 @@ namespace SmartPeak {
 
           int number_of_threads = std::thread::hardware_concurrency();
           if (number_of_threads < 1) number_of_threads = 1;
-          workflow_manager.addWorkflow(
+          // the concurrent requests share the job queue, and the CPU budget of the ThreadPool
+          auto& job_queue = application_manager->get_job_queue();
+          const size_t job_id = job_queue.submitWorkflow(
             application_handler,
             injection_names,
             sequence_segment_names,
@@ -219,8 +221,29 @@ namespace SmartPeak {
             &event_dispatcher,
             &event_dispatcher,
             &event_dispatcher,
-            &event_dispatcher,
-            true);
+            &event_dispatcher);
+          application_manager->job_id = job_id;
+          // the events of the workflow are dispatched from this thread, the gRPC streams
+          // wait for them on the server event dispatcher observer
+          WorkflowJobStatus status = job_queue.getJobStatus(job_id);
+          while (status == WorkflowJobStatus::QUEUED || status == WorkflowJobStatus::RUNNING)
+          {
+            if (event_dispatcher.waitForEvents(std::chrono::milliseconds(100)))
+            {
+              event_dispatcher.dispatchEvents();
+            }
+            status = job_queue.getJobStatus(job_id);
+          }
+          event_dispatcher.dispatchEvents();
+          application_manager->job_id = 0;
+          auto workflow_application_handler = job_queue.releaseJob(job_id);
+          workflow_application_handler->session_loader_generator = application_handler.session_loader_generator;
+          application_handler = std::move(*workflow_application_handler);
+          if (status != WorkflowJobStatus::FINISHED)
+          {
+            LOG_ERROR << "Workflow " << (status == WorkflowJobStatus::CANCELLED ? "cancelled" : "failed");
+            return false;
+          }
         }
         catch(const std::exception& e)
         {
@@ -23,8 +23,20 @@
 
 #include <SmartPeak/core/ServerAppender.h>
 
+#include <algorithm>
+#include <stdexcept>
+
 namespace SmartPeak
 {
+  ServerAppender::ServerAppender(size_t capacity)
+  {
+    if (capacity == 0)
+    {
+      throw std::invalid_argument("ServerAppender capacity must be strictly positive.");
+    }
+    messages.resize(capacity);
+  }
+
 	void ServerAppender::write(const plog::Record& record)
     {
       std::ostringstream ss;
@@ -37,21 +49,76 @@ namespace SmartPeak
       #else
       plog::util::nstring str = ss.str();
       #endif
+      {
+        std::lock_guard<std::mutex> g(messages_mutex);
+        // overwrites the oldest record once the ring is full
+        messages[next_record_ % messages.size()] = ServerAppenderRecord(record.getSeverity(), std::move(str));
+        ++next_record_;
+        size_ = std::min(size_ + 1, messages.size());
+      }
+      messages_cv.notify_all();
+    }
+
+    ServerAppender::Cursor ServerAppender::getCursor() const
+    {
       std::lock_guard<std::mutex> g(messages_mutex);
-      messages.emplace_back(record.getSeverity(), str);
+      Cursor cursor;
+      cursor.next_record = firstRecord();
+      return cursor;
     }
 
-    std::vector<ServerAppender::ServerAppenderRecord> ServerAppender::getAppenderRecordList(plog::Severity severity)
+    void ServerAppender::skipDroppedRecords(Cursor& cursor) const
+    {
+      if (cursor.next_record < firstRecord())
+      {
+        cursor.nb_dropped_records += firstRecord() - cursor.next_record;
+        cursor.next_record = firstRecord();
+      }
+    }
+
+    std::vector<ServerAppender::ServerAppenderRecord> ServerAppender::getAppenderRecordList(plog::Severity severity, Cursor& cursor) const
     {
       std::vector<ServerAppender::ServerAppenderRecord> filtered;
       std::lock_guard<std::mutex> g(messages_mutex);
-      for (const ServerAppender::ServerAppenderRecord& p : messages) {
+      skipDroppedRecords(cursor);
+      filtered.reserve(next_record_ - cursor.next_record);
+      for (; cursor.next_record < next_record_; ++cursor.next_record) {
+        const ServerAppender::ServerAppenderRecord& p = messages[cursor.next_record % messages.size()];
         if (p.first <= severity) {
           filtered.push_back(p);
         }
       }
-      messages.clear();
       return filtered;
     }
+
+    bool ServerAppender::waitForRecords(const Cursor& cursor, std::chrono::milliseconds timeout) const
+    {
+      std::unique_lock<std::mutex> g(messages_mutex);
+      return messages_cv.wait_for(g, timeout, [this, &cursor]() { return next_record_ > cursor.next_record; });
+    }
+
+    std::vector<ServerAppender::ServerAppenderRecord> ServerAppender::getAppenderRecordList(plog::Severity severity)
+    {
+      return getAppenderRecordList(severity, default_cursor_);
+    }
+
+    bool ServerAppender::waitForRecords(std::chrono::milliseconds timeout)
+    {
+      return waitForRecords(default_cursor_, timeout);
+    }
+
+    size_t ServerAppender::getNbDroppedRecords() const
+    {
+      std::lock_guard<std::mutex> g(messages_mutex);
+      Cursor cursor = default_cursor_;
+      skipDroppedRecords(cursor);
+      return cursor.nb_dropped_records;
+    }
+
+    size_t ServerAppender::size() const
+    {
+      std::lock_guard<std::mutex> g(messages_mutex);
+      return next_record_ - std::max(default_cursor_.next_record, firstRecord());
+    }
 	
 }
@@ -29,13 +29,23 @@
 
 #include <plog/Log.h>
 
+#include <algorithm>
+#include <atomic>
+
 namespace SmartPeak
 {
   static int max_nb_points = 10000000;
   
+  uint64_t SessionHandler::nextGeneration()
+  {
+    static std::atomic<uint64_t> generation { 0 };
+    return ++generation;
+  }
+
   void SessionHandler::onSequenceUpdated()
   {
     sequence_table.clear();
+    features_generation_ = nextGeneration(); // the features are held by the sequence
   }
 
   void SessionHandler::onTransitionsUpdated()
@@ -43,7 +53,10 @@ namespace SmartPeak
     transitions_table.clear();
   }
 
-  void SessionHandler::onFeaturesUpdated() {}
+  void SessionHandler::onFeaturesUpdated()
+  {
+    features_generation_ = nextGeneration();
+  }
 
   std::string findSampleNameFromStandardConcentration(
     const SmartPeak::SequenceSegmentHandler& sequence_segment,
@@ -80,9 +93,39 @@ namespace SmartPeak
     // Set the minimal data for the spectra
     setSpectrumTable(sequence_handler, spectrum_table);
     setSpectrumExplorer(spectrum_table);
+    updateExplorerGeneration(injection_explorer_data);
+    updateExplorerGeneration(transition_explorer_data);
+    updateExplorerGeneration(feature_explorer_data);
+    updateExplorerGeneration(spectrum_explorer_data);
     //LOGD << "END setMinimalDataAndFilters";
   }
 
+  bool SessionHandler::updateExplorerGeneration(ExplorerData& explorer_data)
+  {
+    const auto& checkbox_body = explorer_data.checkbox_body;
+    auto& snapshot = explorer_data.checkbox_body_snapshot_;
+    if (checkbox_body.dimension(0) == snapshot.dimension(0) &&
+        checkbox_body.dimension(1) == snapshot.dimension(1) &&
+        std::equal(checkbox_body.data(), checkbox_body.data() + checkbox_body.size(), snapshot.data()))
+    {
+      return false;
+    }
+    snapshot = checkbox_body;
+    explorer_data.generation_ = nextGeneration();
+    return true;
+  }
+
+  std::tuple<uint64_t, uint64_t, uint64_t, uint64_t> SessionHandler::getFeatureSelectionGenerations()
+  {
+    updateExplorerGeneration(injection_explorer_data);
+    updateExplorerGeneration(transition_explorer_data);
+    updateExplorerGeneration(feature_explorer_data);
+    return std::make_tuple(features_generation_,
+                           injection_explorer_data.generation_,
+                           transition_explorer_data.generation_,
+                           feature_explorer_data.generation_);
+  }
+
   void SessionHandler::setInjectionExplorer(GenericTableData& table_data) {
     // Make the injection explorer headers
     if (injection_explorer_data.checkbox_headers.size() <= 0) {
@@ -136,6 +179,7 @@ namespace SmartPeak
     if (feature_table.body_.dimension(0) != n_rows) {
       LOGD << "Making feature_table.body_";
       feature_table.body_.resize(n_rows, n_cols);
+      feature_table.markChanged();
       int col = 0, row = 0;
       for (const auto& metadata : metadataFloatToString) {
         feature_table.body_(row, col) = metadata.second;
@@ -185,6 +229,7 @@ namespace SmartPeak
     if (table_data.body_.dimension(0) != n_rows) {
       LOGD << "Making sequence_table_body";
       table_data.body_.resize(n_rows, n_cols);
+      table_data.markChanged();
       int col = 0, row = 0;
       for (const auto& injection : sequence_handler.getSequence()) {
         table_data.body_(row, col) = std::to_string(injection.getMetaData().inj_number);
@@ -235,6 +280,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making transitions_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& transition : targeted_exp.getTransitions()) {
           table_data.body_(row, col) = transition.getPeptideRef();
@@ -279,6 +325,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making spectrum_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& spectrum : spectra) {
           table_data.body_(row, col) = spectrum.getNativeID();
@@ -317,6 +364,7 @@ namespace SmartPeak
     if (table_data.body_.dimension(0) != commands.size()) { // TODO: does not account for case of different commands of the same length!
       LOGD << "Making workflow_table_body";
       table_data.body_.resize(n_rows, n_cols);
+      table_data.markChanged();
       int col = 0, row = 0;
       for (const auto& command : commands) {
         table_data.body_(row, col) = std::to_string(row);
@@ -354,6 +402,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making quant_method_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& seq_segment : sequence_handler.getSequenceSegments()) {
           for (const auto& quant_method : seq_segment.getQuantitationMethods()) {
@@ -422,6 +471,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making stds_concs_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& stds_concs : stand_concs) {
           table_data.body_(row, col) = stds_concs.sample_name;
@@ -465,6 +515,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_filters_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureFilter().component_qcs) {
           table_data.body_(row, col) = comp_qcs.component_name;
@@ -516,6 +567,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_group_filters_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_group_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureFilter().component_group_qcs) {
           table_data.body_(row, col) = comp_group_qcs.component_group_name;
@@ -600,6 +652,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_qcs_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureQC().component_qcs) {
           table_data.body_(row, col) = comp_qcs.component_name;
@@ -651,6 +704,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_group_qcs_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_group_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureQC().component_group_qcs) {
           table_data.body_(row, col) = comp_group_qcs.component_group_name;
@@ -735,6 +789,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_rsd_filters_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_rsd_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureRSDFilter().component_qcs) {
           table_data.body_(row, col) = comp_rsd_qcs.component_name;
@@ -786,6 +841,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_group_rsd_filters_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_group_rsd_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureRSDFilter().component_group_qcs) {
           table_data.body_(row, col) = comp_group_rsd_qcs.component_group_name;
@@ -870,6 +926,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_rsd_qcs_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_rsd_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureRSDQC().component_qcs) {
           table_data.body_(row, col) = comp_rsd_qcs.component_name;
@@ -921,6 +978,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_group_rsd_qcs_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_group_rsd_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureRSDQC().component_group_qcs) {
           table_data.body_(row, col) = comp_group_rsd_qcs.component_group_name;
@@ -1005,6 +1063,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_background_filters_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_background_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureBackgroundFilter().component_qcs) {
           table_data.body_(row, col) = comp_background_qcs.component_name;
@@ -1056,6 +1115,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_group_background_filters_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_group_background_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureBackgroundFilter().component_group_qcs) {
           table_data.body_(row, col) = comp_group_background_qcs.component_group_name;
@@ -1140,6 +1200,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_background_qcs_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_background_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureBackgroundQC().component_qcs) {
           table_data.body_(row, col) = comp_background_qcs.component_name;
@@ -1191,6 +1252,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_group_background_qcs_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_group_background_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureBackgroundQC().component_group_qcs) {
           table_data.body_(row, col) = comp_group_background_qcs.component_group_name;
@@ -1275,6 +1337,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_rsd_estimations_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_rsd_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureRSDEstimations().component_qcs) {
           table_data.body_(row, col) = comp_rsd_qcs.component_name;
@@ -1326,6 +1389,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_group_rsd_estimations_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_group_rsd_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureRSDEstimations().component_group_qcs) {
           table_data.body_(row, col) = comp_group_rsd_qcs.component_group_name;
@@ -1410,6 +1474,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_background_estimations_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_background_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureBackgroundEstimations().component_qcs) {
           table_data.body_(row, col) = comp_background_qcs.component_name;
@@ -1461,6 +1526,7 @@ namespace SmartPeak
       if (table_data.body_.dimension(0) != n_rows) {
         LOGD << "Making comp_group_background_estimations_table_body";
         table_data.body_.resize(n_rows, n_cols);
+        table_data.markChanged();
         int col = 0, row = 0;
         for (const auto& comp_group_background_qcs : sequence_handler.getSequenceSegments().at(0).getFeatureBackgroundEstimations().component_group_qcs) {
           table_data.body_(row, col) = comp_group_background_qcs.component_group_name;
@@ -1530,8 +1596,8 @@ namespace SmartPeak
     if (sequence_handler.getSequence().size() > 0 &&
       sequence_handler.getSequence().at(0).getRawData().getFeatureMapHistory().size() > 0) {
       // Make the feature table headers and body
-      if (feature_table_unique_samples_transitions_ != getNSelectedSampleNamesPlot()*getNSelectedTransitionsPlot()
-          || table_data.body_.dimension(1) != 23 + getNSelectedFeatureMetaValuesTable()) {
+      const auto generations = getFeatureSelectionGenerations();
+      if (feature_table_generations_ != generations || feature_table_generation_ != table_data.generation_) {
         LOGD << "Making feature_table_body and feature_table_headers";
         // get the selected feature names
         Eigen::Tensor<std::string, 1> selected_feature_names = getSelectFeatureMetaValuesTable();
@@ -1564,27 +1630,29 @@ namespace SmartPeak
           if (!selected_transition_groups(i).empty())
             component_group_names.insert(selected_transition_groups(i));
         }
-        // update the number of unique samples, transitions, and feature metavalues
-        feature_table_unique_samples_transitions_ = getNSelectedSampleNamesPlot() * getNSelectedTransitionsPlot();
-        std::vector<std::vector<std::string>> table;
-        std::vector<std::string> headers;
-        SequenceParser::makeDataTableFromMetaValue(sequence_handler, table, headers, feature_names,
-                                                   sample_types, sample_names, component_group_names, component_names);
+        feature_table_generations_ = generations;
+        auto table = std::make_shared<FeatureTable>();
+        SequenceParser::makeFeatureTableFromMetaValue(sequence_handler, *table, feature_names,
+                                                      sample_types, sample_names, component_group_names, component_names);
+        const std::vector<std::string>& headers = table->getHeaders();
         const int n_cols = headers.size();
-        size_t n_rows = table.size();
-        table_data.headers_.resize(n_cols);
-        table_data.body_.resize(n_rows, n_cols);
-        for (size_t row = 0; row < n_rows; ++row) {
-          if (n_cols >= 64) { // 64 max. permitted columns as of ImGui v1.81
-            within_max_size = false;
-            LOGI << "Maximum permitted number of columns reached.";
-            break;
-          }
+        // the cells are formatted when displayed
+        table_data.body_.resize(0, 0);
+        if (n_cols >= 64) { // 64 max. permitted columns as of ImGui v1.81
+          within_max_size = false;
+          LOGI << "Maximum permitted number of columns reached.";
+          table_data.headers_.resize(0);
+          table_data.typed_body_.reset();
+        }
+        else {
+          table_data.headers_.resize(n_cols);
           for (int col = 0; col < n_cols; ++col) {
-            if (row == 0) table_data.headers_(col) = headers.at(col);
-            table_data.body_(row, col) = table.at(row).at(col);
+            table_data.headers_(col) = headers.at(col);
           }
+          table_data.typed_body_ = std::move(table);
         }
+        table_data.markChanged();
+        feature_table_generation_ = table_data.generation_;
       }
     }
     return within_max_size;
@@ -1595,7 +1663,8 @@ namespace SmartPeak
     if (sequence_handler.getSequence().size() > 0 &&
       sequence_handler.getSequence().at(0).getRawData().getFeatureMapHistory().size() > 0) {
       // Make the feature_pivot table headers and body
-      if (feat_value_data.dimension(1) != getNSelectedSampleNamesPlot() || feature_matrix_unique_transitions_ != getNSelectedTransitionsPlot() * getNSelectedFeatureMetaValuesPlot()) {
+      const auto generations = getFeatureSelectionGenerations();
+      if (feature_matrix_generations_ != generations) {
         LOGD << "Making feature matrix, line plot, and data tables";
         // get the selected feature names
         Eigen::Tensor<std::string, 1> selected_feature_names = getSelectFeatureMetaValuesPlot();
@@ -1628,11 +1697,11 @@ namespace SmartPeak
           if (!selected_transition_groups(i).empty())
             component_group_names.insert(selected_transition_groups(i));
         }
-        // Update the unique transitions
-        feature_matrix_unique_transitions_ = getNSelectedTransitionsPlot() * getNSelectedFeatureMetaValuesPlot();
+        feature_matrix_generations_ = generations;
         // get the matrix of data
         Eigen::Tensor<std::string, 2> rows_out;
-        SequenceParser::makeDataMatrixFromMetaValue(sequence_handler, feat_value_data, feat_col_labels, rows_out, feature_names, sample_types, sample_names, component_group_names, component_names);
+        feature_matrix_cache_.setGeneration(features_generation_);
+        feature_matrix_cache_.makeDataMatrix(sequence_handler, feat_value_data, feat_col_labels, rows_out, feature_names, sample_types, sample_names, component_group_names, component_names);
         setFeatureLinePlot();
         // update the pivot table headers with the columns for the pivot table/heatmap rows
         feature_pivot_table.headers_.resize((int)feat_col_labels.size() + 3);
@@ -1645,6 +1714,7 @@ namespace SmartPeak
         // allocate space for the pivot table body and heatmap row labels
         feat_row_labels.resize(n_rows);
         feature_pivot_table.body_.resize(n_rows, n_cols);
+        feature_pivot_table.markChanged();
         // assign the pivot table body data and heatmap row labels
         int col = 0;
         for (int row = 0; row < n_rows; ++row) {
@@ -1892,7 +1962,7 @@ namespace SmartPeak
             result.z_data_area_.push_back(spectra.getRT());
             std::vector<float> x_data, y_data;
             const float rt_threashold = 0.50f;
-            if ((!result.points_overflow_) && (abs(spectra.getRT()-rt)< rt_threashold))
+            if (abs(spectra.getRT()-rt)< rt_threashold)
             {
               for (auto point = spectra.PosBegin(range.first); point != spectra.PosEnd(range.second); ++point)
               {
@@ -1963,23 +2033,22 @@ namespace SmartPeak
       if (!selected_transition_groups(i).empty())
         component_group_names.insert(selected_transition_groups(i));
     }
-    // Update the unique transitions
-    feature_matrix_unique_transitions_ = getNSelectedTransitionsPlot() * getNSelectedFeatureMetaValuesPlot();
     // get the matrix of data
     if (sequence_handler.getSequence().size() > 0 &&
       sequence_handler.getSequence().at(0).getRawData().getFeatureMapHistory().size() > 0)
     {
       Eigen::Tensor<std::string, 2> rows_out;
       Eigen::Tensor<float, 2> heatmap_value_data;
-      SequenceParser::makeDataMatrixFromMetaValue(sequence_handler,
-                                                  heatmap_value_data,
-                                                  result.feat_heatmap_col_labels,
-                                                  rows_out,
-                                                  feature_names,
-                                                  sample_types,
-                                                  sample_names,
-                                                  component_group_names,
-                                                  component_names);
+      feature_matrix_cache_.setGeneration(features_generation_);
+      feature_matrix_cache_.makeDataMatrix(sequence_handler,
+                                           heatmap_value_data,
+                                           result.feat_heatmap_col_labels,
+                                           rows_out,
+                                           feature_names,
+                                           sample_types,
+                                           sample_names,
+                                           component_group_names,
+                                           component_names);
       const int n_rows = heatmap_value_data.dimension(0);
       // allocate space for the pivot table body and heatmap row labels
       result.feat_heatmap_row_labels.resize(n_rows);
@@ -0,0 +1,205 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <SmartPeak/core/SpectralLibraryCache.h>
+
+#include <OpenMS/FORMAT/MSPGenericFile.h>
+
+#include <plog/Log.h>
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+namespace SmartPeak
+{
+  namespace
+  {
+    /**
+      Rough estimate of the memory held by a comparator: its own copy of the
+      library spectra, and their binned version.
+    */
+    size_t estimateMemoryUsage(const std::vector<OpenMS::MSSpectrum>& library)
+    {
+      size_t memory_usage = 0;
+      for (const auto& spectrum : library)
+      {
+        memory_usage += 2 * sizeof(OpenMS::MSSpectrum)
+          + spectrum.size() * (sizeof(OpenMS::Peak1D) + sizeof(float) + sizeof(OpenMS::UInt));
+      }
+      return std::max<size_t>(memory_usage, 1);
+    }
+  }
+
+  SpectralLibraryCache::SpectralLibraryCache(size_t memory_limit)
+    : memory_limit_(memory_limit)
+  {
+  }
+
+  SpectralLibraryCache& SpectralLibraryCache::instance()
+  {
+    static SpectralLibraryCache cache;
+    return cache;
+  }
+
+  std::shared_ptr<const SpectralLibraryCache::Comparator> SpectralLibraryCache::getComparator(const std::filesystem::path& msp_file)
+  {
+    const std::string key = msp_file.lexically_normal().generic_string();
+    const auto last_write_time = std::filesystem::last_write_time(msp_file);
+    const auto file_size = std::filesystem::file_size(msp_file);
+
+    std::promise<std::shared_ptr<const Comparator>> promise;
+    std::shared_future<std::shared_ptr<const Comparator>> cached_comparator;
+    size_t load_id = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entry = entries_.find(key);
+      if (entry != entries_.end()
+        && entry->second.last_write_time == last_write_time
+        && entry->second.file_size == file_size)
+      {
+        lru_.splice(lru_.begin(), lru_, entry->second.lru_position);
+        cached_comparator = entry->second.comparator;
+      }
+      else
+      {
+        if (entry != entries_.end())
+        {
+          LOGD << "Spectral library changed on disk: " << key;
+          erase(entry);
+        }
+        Entry& new_entry = entries_[key];
+        new_entry.last_write_time = last_write_time;
+        new_entry.file_size = file_size;
+        new_entry.comparator = promise.get_future().share();
+        new_entry.load_id = load_id = ++next_load_id_;
+        lru_.push_front(key);
+        new_entry.lru_position = lru_.begin();
+      }
+    }
+    if (cached_comparator.valid())
+    {
+      // cached, or being loaded by another thread
+      return cached_comparator.get();
+    }
+
+    try
+    {
+      LOGI << "Loading spectral library: " << key;
+      OpenMS::MSPGenericFile msp_file_reader;
+      OpenMS::MSExperiment library;
+      msp_file_reader.load(msp_file.generic_string(), library);
+      library.sortSpectra();
+      auto comparator = std::make_shared<Comparator>();
+      std::map<OpenMS::String, OpenMS::DataValue> options;
+      comparator->init(library.getSpectra(), options);
+      const size_t memory_usage = estimateMemoryUsage(library.getSpectra());
+      promise.set_value(comparator);
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entry = entries_.find(key);
+      if (entry != entries_.end() && entry->second.load_id == load_id)
+      {
+        entry->second.memory_usage = memory_usage;
+        memory_usage_ += memory_usage;
+        evict(key);
+      }
+      return comparator;
+    }
+    catch (...)
+    {
+      promise.set_exception(std::current_exception());
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto entry = entries_.find(key);
+      if (entry != entries_.end() && entry->second.load_id == load_id)
+      {
+        erase(entry);
+      }
+      throw;
+    }
+  }
+
+  void SpectralLibraryCache::setMemoryLimit(size_t memory_limit)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    memory_limit_ = memory_limit;
+    evict("");
+  }
+
+  size_t SpectralLibraryCache::getMemoryLimit() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memory_limit_;
+  }
+
+  size_t SpectralLibraryCache::getMemoryUsage() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memory_usage_;
+  }
+
+  size_t SpectralLibraryCache::size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+  void SpectralLibraryCache::clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    memory_usage_ = 0;
+  }
+
+  void SpectralLibraryCache::evict(const std::string& keep)
+  {
+    // least recently used first, libraries being loaded are not accounted for yet
+    for (auto it = lru_.end(); it != lru_.begin() && memory_usage_ > memory_limit_;)
+    {
+      --it;
+      auto entry = entries_.find(*it);
+      if (*it == keep || entry->second.memory_usage == 0)
+      {
+        continue;
+      }
+      LOGD << "Evicting spectral library: " << *it;
+      it = std::next(it);
+      erase(entry);
+    }
+    auto kept = entries_.find(keep);
+    if (memory_usage_ > memory_limit_ && kept != entries_.end())
+    {
+      LOGW << "Spectral library " << keep << " exceeds the memory limit of the cache (" << memory_limit_ << " bytes), it will not be cached";
+      erase(kept);
+    }
+  }
+
+  void SpectralLibraryCache::erase(std::map<std::string, Entry>::iterator entry)
+  {
+    memory_usage_ -= entry->second.memory_usage;
+    lru_.erase(entry->second.lru_position);
+    entries_.erase(entry);
+  }
+}
@@ -0,0 +1,175 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+#include <SmartPeak/core/ThreadPool.h>
+#include <chrono>
+
+namespace SmartPeak
+{
+  namespace
+  {
+    thread_local const ThreadPool* current_pool = nullptr;
+    thread_local size_t current_worker = 0;
+  }
+
+  ThreadPool::ThreadPool(size_t n_threads)
+  {
+    if (n_threads == 0) {
+      n_threads = std::thread::hardware_concurrency(); // might return 0
+    }
+    if (n_threads == 0) {
+      n_threads = 1;
+    }
+    for (size_t i = 0; i < n_threads; ++i) {
+      queues_.emplace_back(std::make_unique<WorkQueue>());
+    }
+    for (size_t i = 0; i < n_threads; ++i) {
+      threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      stop_ = true;
+    }
+    wake_cv_.notify_all();
+    for (std::thread& t : threads_) {
+      if (t.joinable()) {
+        t.join();
+      }
+    }
+  }
+
+  ThreadPool& ThreadPool::instance()
+  {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  bool ThreadPool::isWorkerThread() const
+  {
+    return current_pool == this;
+  }
+
+  std::future<void> ThreadPool::submit(std::function<void()> task, CancellationToken token)
+  {
+    auto run = std::make_shared<std::packaged_task<void()>>(
+      [task = std::move(task), token = std::move(token)]() {
+        if (!token.isCancelled()) {
+          task();
+        }
+      });
+    std::future<void> future = run->get_future();
+    push(Task{ std::move(run) });
+    return future;
+  }
+
+  void ThreadPool::push(Task&& task)
+  {
+    const size_t index = isWorkerThread()
+      ? current_worker
+      : next_queue_.fetch_add(1) % queues_.size();
+    {
+      std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+      queues_[index]->tasks.push_back(std::move(task));
+    }
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      ++pending_;
+    }
+    wake_cv_.notify_one();
+  }
+
+  bool ThreadPool::pop(size_t index, Task& task)
+  {
+    WorkQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    --pending_;
+    return true;
+  }
+
+  bool ThreadPool::steal(size_t thief, Task& task)
+  {
+    const size_t n = queues_.size();
+    for (size_t offset = 1; offset <= n; ++offset) {
+      WorkQueue& queue = *queues_[(thief + offset) % n];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        --pending_;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ThreadPool::runPendingTask()
+  {
+    const size_t index = isWorkerThread() ? current_worker : 0;
+    Task task;
+    if ((isWorkerThread() && pop(index, task)) || steal(index, task)) {
+      (*task.run)();
+      return true;
+    }
+    return false;
+  }
+
+  void ThreadPool::wait(std::future<void>& future)
+  {
+    if (!isWorkerThread()) {
+      future.wait();
+      return;
+    }
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      if (!runPendingTask()) {
+        future.wait_for(std::chrono::milliseconds(1));
+      }
+    }
+  }
+
+  void ThreadPool::workerLoop(size_t index)
+  {
+    current_pool = this;
+    current_worker = index;
+    while (true) {
+      Task task;
+      if (pop(index, task) || steal(index, task)) {
+        (*task.run)();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      wake_cv_.wait(lock, [this]() { return stop_ || pending_ > 0; });
+      if (stop_ && pending_ == 0) {
+        break;
+      }
+    }
+  }
+}
@@ -24,35 +24,205 @@
 #include <SmartPeak/core/WorkflowManager.h>
 #include <SmartPeak/core/ApplicationProcessor.h>
 #include <SmartPeak/core/ApplicationHandler.h>
+
+#include <plog/Log.h>
+
+#include <algorithm>
+#include <stdexcept>
 #include <thread>
-#include <future>
 
 namespace SmartPeak {
 
-  void WorkflowManager::addWorkflow(ApplicationHandler& source_app_handler, 
-    const std::set<std::string>& injection_names, 
-    const std::set<std::string>& sequence_segment_names, 
-    const std::set<std::string>& sample_group_names, 
+  namespace
+  {
+    bool hasEnded(WorkflowJobStatus status)
+    {
+      return status != WorkflowJobStatus::QUEUED && status != WorkflowJobStatus::RUNNING;
+    }
+
+    /**
+      Injections and sequence segments whose data are written by the commands.
+      An empty set of names means all of them, as for the processing.
+    */
+    void getWrittenItems(
+      const SequenceHandler& sequence_handler,
+      const std::vector<ApplicationHandler::Command>& commands,
+      const std::set<std::string>& injection_names,
+      const std::set<std::string>& sequence_segment_names,
+      const std::set<std::string>& sample_group_names,
+      std::set<size_t>& injections,
+      std::set<size_t>& sequence_segments)
+    {
+      const auto has_type = [&commands](ApplicationHandler::Command::CommandType type) {
+        return std::any_of(commands.begin(), commands.end(), [type](const auto& command) { return command.type == type; });
+      };
+      if (has_type(ApplicationHandler::Command::RawDataMethod))
+      {
+        const auto& sequence = sequence_handler.getSequence();
+        for (size_t i = 0; i < sequence.size(); ++i)
+        {
+          if (injection_names.empty() || injection_names.count(sequence[i].getMetaData().getInjectionName()))
+          {
+            injections.insert(i);
+          }
+        }
+      }
+      if (has_type(ApplicationHandler::Command::SequenceSegmentMethod))
+      {
+        const auto& segments = sequence_handler.getSequenceSegments();
+        for (size_t i = 0; i < segments.size(); ++i)
+        {
+          if (sequence_segment_names.empty() || sequence_segment_names.count(segments[i].getSequenceSegmentName()))
+          {
+            sequence_segments.insert(i);
+            injections.insert(segments[i].getSampleIndices().begin(), segments[i].getSampleIndices().end());
+          }
+        }
+      }
+      if (has_type(ApplicationHandler::Command::SampleGroupMethod))
+      {
+        for (const auto& sample_group : sequence_handler.getSampleGroups())
+        {
+          if (sample_group_names.empty() || sample_group_names.count(sample_group.getSampleGroupName()))
+          {
+            injections.insert(sample_group.getSampleIndices().begin(), sample_group.getSampleIndices().end());
+          }
+        }
+      }
+    }
+
+    /**
+      Calls f on the pointers to the data an injection shares: its meta data, its raw data,
+      and the data the raw data shares with the sequence segment and the whole sequence.
+      The raw data is passed before the pointers it holds.
+    */
+    template<typename F>
+    void forEachSharedData(InjectionHandler& injection, F&& f)
+    {
+      f(injection.getMetaDataShared());
+      auto& raw_data = injection.getRawDataShared();
+      f(raw_data);
+      if (!raw_data)
+      {
+        return;
+      }
+      f(raw_data->getMetaDataShared());
+      f(raw_data->getParametersShared());
+      f(raw_data->getTargetedExperimentShared());
+      f(raw_data->getReferenceDataShared());
+      f(raw_data->getQuantitationMethodsShared());
+      f(raw_data->getFeatureFilterShared());
+      f(raw_data->getFeatureQCShared());
+      f(raw_data->getFeatureRSDFilterShared());
+      f(raw_data->getFeatureRSDQCShared());
+      f(raw_data->getFeatureBackgroundFilterShared());
+      f(raw_data->getFeatureBackgroundQCShared());
+      f(raw_data->getFeatureRSDEstimationsShared());
+      f(raw_data->getFeatureBackgroundEstimationsShared());
+    }
+
+    template<typename F>
+    void forEachSharedData(SequenceSegmentHandler& segment, F&& f)
+    {
+      f(segment.getQuantitationMethodsShared());
+      f(segment.getFeatureFilterShared());
+      f(segment.getFeatureQCShared());
+      f(segment.getFeatureRSDFilterShared());
+      f(segment.getFeatureRSDQCShared());
+      f(segment.getFeatureBackgroundFilterShared());
+      f(segment.getFeatureBackgroundQCShared());
+      f(segment.getFeatureRSDEstimationsShared());
+      f(segment.getFeatureBackgroundEstimationsShared());
+    }
+
+    /// copies by original data; the originals are kept alive so that their addresses are not reused
+    using SharedDataCopies = std::map<const void*, std::pair<std::shared_ptr<const void>, std::shared_ptr<void>>>;
+
+    /**
+      Replaces data by its copy, made once for all the pointers to the same data.
+    */
+    template<typename T>
+    void copyShared(std::shared_ptr<T>& data, SharedDataCopies& copies)
+    {
+      if (data)
+      {
+        auto& [original, copy] = copies[data.get()];
+        if (!copy)
+        {
+          original = data;
+          copy = std::make_shared<T>(*data);
+        }
+        data = std::static_pointer_cast<T>(copy);
+      }
+    }
+  }
+
+  WorkflowManager::WorkflowManager(size_t max_concurrent_workflows)
+    : max_concurrent_workflows_(std::max<size_t>(max_concurrent_workflows, 1))
+  {
+  }
+
+  WorkflowManager::~WorkflowManager()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto& job : queue_)
+    {
+      job->status = WorkflowJobStatus::CANCELLED;
+    }
+    queue_.clear();
+    for (auto& [job_id, job] : jobs_)
+    {
+      job->token.cancel();
+    }
+    job_ended_cv_.wait(lock, [this]() { return n_job_threads_ == 0; });
+  }
+
+  std::shared_ptr<WorkflowManager::Job> WorkflowManager::makeJob(const ApplicationHandler& source_state,
+    const std::set<std::string>& injection_names,
+    const std::set<std::string>& sequence_segment_names,
+    const std::set<std::string>& sample_group_names,
     const std::vector<ApplicationHandler::Command>& commands,
     const int number_of_threads,
     IApplicationProcessorObserver* application_processor_observer,
     ISequenceProcessorObserver* sequence_processor_observer,
     ISequenceSegmentProcessorObserver* sequence_segment_processor_observer,
     ISampleGroupProcessorObserver* sample_group_processor_observer,
-    bool blocking)
+    bool isolated)
   {
-    // do not run workflows concurrently
-    if (!done_) {
-      return;
-    }
-    application_handler_ = source_app_handler;
-    done_ = false;
+    auto job = std::make_shared<Job>();
+    job->application_handler = std::make_shared<ApplicationHandler>(source_state);
+    job->injection_names = injection_names;
+    job->sequence_segment_names = sequence_segment_names;
+    job->sample_group_names = sample_group_names;
+    job->commands = commands;
+    job->number_of_threads = number_of_threads;
+    job->application_processor_observer = application_processor_observer;
+    job->sequence_processor_observer = sequence_processor_observer;
+    job->sequence_segment_processor_observer = sequence_segment_processor_observer;
+    job->sample_group_processor_observer = sample_group_processor_observer;
+    job->isolated = isolated;
 
-    // making local copies
-    const std::set<std::string> injection_names_(injection_names);
-    const std::set<std::string> sequence_segment_names_(sequence_segment_names);
-    const std::set<std::string> sample_group_names_(sample_group_names);
-    const std::vector<ApplicationHandler::Command> commands_(commands);
+    // the job writes to the data of the processed items, including the data those items share
+    // with the whole sequence; an isolated job copies them, the other items stay shared
+    SequenceHandler& sequence_handler = job->application_handler->sequenceHandler_;
+    getWrittenItems(sequence_handler, commands, injection_names, sequence_segment_names, sample_group_names,
+                    job->written_injections, job->written_sequence_segments);
+    std::set<const void*> locked_data;
+    const auto lock_data = [&locked_data](const auto& data) {
+      if (data)
+      {
+        locked_data.insert(data.get());
+      }
+    };
+    for (const size_t i : job->written_injections)
+    {
+      forEachSharedData(sequence_handler.getSequence().at(i), lock_data);
+    }
+    for (const size_t i : job->written_sequence_segments)
+    {
+      forEachSharedData(sequence_handler.getSequenceSegments().at(i), lock_data);
+    }
+    job->locked_data.assign(locked_data.begin(), locked_data.end());
 
     // log workflow
     if (!commands.empty())
@@ -63,52 +233,85 @@ namespace SmartPeak {
         LOGD << command.getName();
       }
     }
+    return job;
+  }
 
-    if (!blocking)
+  void WorkflowManager::addWorkflow(ApplicationHandler& source_app_handler, 
+    const std::set<std::string>& injection_names, 
+    const std::set<std::string>& sequence_segment_names, 
+    const std::set<std::string>& sample_group_names, 
+    const std::vector<ApplicationHandler::Command>& commands,
+    const int number_of_threads,
+    IApplicationProcessorObserver* application_processor_observer,
+    ISequenceProcessorObserver* sequence_processor_observer,
+    ISequenceSegmentProcessorObserver* sequence_segment_processor_observer,
+    ISampleGroupProcessorObserver* sample_group_processor_observer,
+    bool blocking)
+  {
+    // do not run workflows concurrently
+    if (!isWorkflowDone()) {
+      return;
+    }
+    size_t previous_job_id = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      previous_job_id = workflow_job_id_;
+    }
+    if (previous_job_id) {
+      // the results of the previous workflow have not been used
+      releaseJob(previous_job_id);
+    }
+
+    auto job = makeJob(source_app_handler,
+      injection_names,
+      sequence_segment_names,
+      sample_group_names,
+      commands,
+      number_of_threads,
+      application_processor_observer,
+      sequence_processor_observer,
+      sequence_segment_processor_observer,
+      sample_group_processor_observer,
+      false);
+    const size_t job_id = queueJob(job);
     {
-      std::thread t(run_and_join, 
-                    std::ref(application_handler_),
-                    std::ref(done_),
-                    injection_names_,
-                    sequence_segment_names_,
-                    sample_group_names_,
-                    commands_,
-                    number_of_threads,
-                    application_processor_observer,
-                    sequence_processor_observer,
-                    sequence_segment_processor_observer,
-                    sample_group_processor_observer);
-      LOGD << "Created thread (to be detached): " << t.get_id();
-      t.detach();
-      LOGD << "Thread has been detached";
+      std::lock_guard<std::mutex> lock(mutex_);
+      workflow_job_id_ = job_id;
     }
-    else
+    if (blocking)
     {
-      run_and_join(
-        application_handler_,
-        done_,
-        injection_names_,
-        sequence_segment_names_,
-        sample_group_names_,
-        commands_,
-        number_of_threads,
-        application_processor_observer,
-        sequence_processor_observer,
-        sequence_segment_processor_observer,
-        sample_group_processor_observer);
+      waitForJob(job_id);
     }
   }
 
   bool WorkflowManager::isWorkflowDone() const
   {
-    return done_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto job = jobs_.find(workflow_job_id_);
+    return job == jobs_.end() || hasEnded(job->second->status);
   }
 
-  void WorkflowManager::run_and_join(ApplicationHandler& application_handler, 
-    bool& done, 
-    const std::set<std::string>& injection_names, 
-    const std::set<std::string>& sequence_segment_names, 
-    const std::set<std::string>& sample_group_names, 
+  void WorkflowManager::updateApplicationHandler(ApplicationHandler& source_app_handler)
+  {
+    size_t job_id = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_id = workflow_job_id_;
+    }
+    if (!job_id)
+    {
+      return;
+    }
+    // update the status for this workflow, to be used from the main thread (gui, client)
+    auto application_handler = releaseJob(job_id);
+    application_handler->session_loader_generator = source_app_handler.session_loader_generator;
+    source_app_handler = std::move(*application_handler);
+  }
+
+  size_t WorkflowManager::submitWorkflow(const ApplicationHandler& source_state,
+    const std::set<std::string>& injection_names,
+    const std::set<std::string>& sequence_segment_names,
+    const std::set<std::string>& sample_group_names,
     const std::vector<ApplicationHandler::Command>& commands,
     const int number_of_threads,
     IApplicationProcessorObserver* application_processor_observer,
@@ -116,42 +319,235 @@ namespace SmartPeak {
     ISequenceSegmentProcessorObserver* sequence_segment_processor_observer,
     ISampleGroupProcessorObserver* sample_group_processor_observer)
   {
-    // run workflow asynchronously
-    std::future<void> f = std::async(
-      std::launch::async,
-      ApplicationProcessors::processCommands,
-      std::ref(application_handler),
-      std::cref(commands),
-      std::cref(injection_names), 
-      std::cref(sequence_segment_names), 
-      std::cref(sample_group_names),
+    return queueJob(makeJob(source_state,
+      injection_names,
+      sequence_segment_names,
+      sample_group_names,
+      commands,
       number_of_threads,
       application_processor_observer,
       sequence_processor_observer,
       sequence_segment_processor_observer,
-      sample_group_processor_observer
-    );
+      sample_group_processor_observer,
+      true));
+  }
 
-    LOGD << "Waiting on async operation...";
-    f.wait();
-    LOGD << "Async operation completed";
+  size_t WorkflowManager::queueJob(std::shared_ptr<Job> job)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job->id = next_job_id_++;
+    jobs_.emplace(job->id, job);
+    queue_.push_back(job);
+    LOGD << "Workflow job " << job->id << " queued";
+    startJobs();
+    return job->id;
+  }
 
-    try {
-      f.get(); // checking for exception
-    } catch (const std::exception& e) {
-      LOGE << e.what();
+  std::shared_ptr<WorkflowManager::Job> WorkflowManager::getJob(size_t job_id) const
+  {
+    const auto job = jobs_.find(job_id);
+    if (job == jobs_.end())
+    {
+      throw std::out_of_range("Unknown workflow job " + std::to_string(job_id));
     }
+    return job->second;
+  }
 
-    done = true;
-    application_handler.sequenceHandler_.notifySequenceUpdated();
+  void WorkflowManager::startJobs()
+  {
+    for (auto it = queue_.begin(); it != queue_.end() && n_running_ < max_concurrent_workflows_;)
+    {
+      Job& job = **it;
+      // the data can be copied by several jobs at the same time, but not while it is written
+      const bool data_in_use = std::any_of(job.locked_data.begin(), job.locked_data.end(),
+        [this, &job](const void* data) { return data_written_.count(data) || (!job.isolated && data_copied_.count(data)); });
+      if (data_in_use)
+      {
+        // wait for the running jobs using the same data, the next jobs may start meanwhile
+        ++it;
+        continue;
+      }
+      auto& data_in_use_by_job = job.isolated ? data_copied_ : data_written_;
+      data_in_use_by_job.insert(job.locked_data.begin(), job.locked_data.end());
+      job.status = WorkflowJobStatus::RUNNING;
+      ++n_running_;
+      ++n_job_threads_;
+      LOGD << "Workflow job " << job.id << " started";
+      std::thread(&WorkflowManager::runJob, this, *it).detach();
+      it = queue_.erase(it);
+    }
+  }
+
+  void WorkflowManager::runJob(std::shared_ptr<Job> job)
+  {
+    WorkflowJobStatus status = WorkflowJobStatus::FINISHED;
+    if (job->isolated)
+    {
+      try
+      {
+        copySharedData(*job);
+      }
+      catch (const std::exception& e)
+      {
+        LOGE << e.what();
+        status = WorkflowJobStatus::FAILED;
+      }
+      // the other jobs can write the original data from now on
+      std::lock_guard<std::mutex> lock(mutex_);
+      unlockData(*job);
+      startJobs();
+    }
+
+    if (status == WorkflowJobStatus::FINISHED)
+    {
+      try
+      {
+        ApplicationProcessors::processCommands(
+          *job->application_handler,
+          job->commands,
+          job->injection_names,
+          job->sequence_segment_names,
+          job->sample_group_names,
+          job->number_of_threads,
+          job->application_processor_observer,
+          job->sequence_processor_observer,
+          job->sequence_segment_processor_observer,
+          job->sample_group_processor_observer,
+          job->token);
+        if (job->token.isCancelled())
+        {
+          status = WorkflowJobStatus::CANCELLED;
+        }
+      }
+      catch (const std::exception& e)
+      {
+        LOGE << e.what();
+        status = WorkflowJobStatus::FAILED;
+      }
+    }
+
+    job->application_handler->sequenceHandler_.notifySequenceUpdated();
     LOGI << "State updated with workflow's results";
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!job->isolated)
+    {
+      unlockData(*job);
+    }
+    job->status = status;
+    --n_running_;
+    startJobs();
+    --n_job_threads_;
+    job_ended_cv_.notify_all();
   }
 
-  void WorkflowManager::updateApplicationHandler(ApplicationHandler& source_app_handler)
+  void WorkflowManager::unlockData(const Job& job)
   {
-    // update the status for this workflow, to be used from the main thread (gui, client)
-    application_handler_.session_loader_generator = source_app_handler.session_loader_generator;
-    source_app_handler = std::move(application_handler_);
+    auto& data_in_use_by_job = job.isolated ? data_copied_ : data_written_;
+    for (const void* data : job.locked_data)
+    {
+      data_in_use_by_job.erase(data_in_use_by_job.find(data));
+    }
+  }
+
+  void WorkflowManager::copySharedData(Job& job)
+  {
+    SharedDataCopies copies;
+    const auto copy_data = [&copies](auto& data) { copyShared(data, copies); };
+    SequenceHandler& sequence_handler = job.application_handler->sequenceHandler_;
+    for (const size_t i : job.written_injections)
+    {
+      forEachSharedData(sequence_handler.getSequence().at(i), copy_data);
+    }
+    for (const size_t i : job.written_sequence_segments)
+    {
+      forEachSharedData(sequence_handler.getSequenceSegments().at(i), copy_data);
+    }
+    LOGD << "Workflow job " << job.id << ": copied " << copies.size() << " shared data";
+  }
+
+  WorkflowJobStatus WorkflowManager::getJobStatus(size_t job_id) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return getJob(job_id)->status;
+  }
+
+  bool WorkflowManager::cancelJob(size_t job_id)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto job_it = jobs_.find(job_id);
+    if (job_it == jobs_.end())
+    {
+      return false;
+    }
+    Job& job = *job_it->second;
+    if (job.status == WorkflowJobStatus::QUEUED)
+    {
+      queue_.erase(std::find(queue_.begin(), queue_.end(), job_it->second));
+      job.status = WorkflowJobStatus::CANCELLED;
+      job_ended_cv_.notify_all();
+      return true;
+    }
+    if (job.status == WorkflowJobStatus::RUNNING)
+    {
+      job.token.cancel();
+      return true;
+    }
+    return false;
+  }
+
+  WorkflowJobStatus WorkflowManager::waitForJob(size_t job_id)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto job = getJob(job_id);
+    job_ended_cv_.wait(lock, [&job]() { return hasEnded(job->status); });
+    return job->status;
+  }
+
+  std::shared_ptr<ApplicationHandler> WorkflowManager::releaseJob(size_t job_id)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto job = getJob(job_id);
+    if (!hasEnded(job->status))
+    {
+      throw std::logic_error("Workflow job " + std::to_string(job_id) + " has not ended");
+    }
+    jobs_.erase(job_id);
+    if (workflow_job_id_ == job_id)
+    {
+      workflow_job_id_ = 0;
+    }
+    return job->application_handler;
+  }
+
+  std::vector<size_t> WorkflowManager::getJobIds() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<size_t> job_ids;
+    for (const auto& [job_id, job] : jobs_)
+    {
+      job_ids.push_back(job_id);
+    }
+    return job_ids;
+  }
+
+  void WorkflowManager::setMaxConcurrentWorkflows(size_t max_concurrent_workflows)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_concurrent_workflows_ = std::max<size_t>(max_concurrent_workflows, 1);
+    startJobs();
+  }
+
+  size_t WorkflowManager::getMaxConcurrentWorkflows() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return max_concurrent_workflows_;
+  }
+
+  size_t WorkflowManager::getNumberOfRunningWorkflows() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return n_running_;
   }
 
   std::set<std::string> WorkflowManager::getRequirements(
@@ -0,0 +1,439 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+#include <SmartPeak/core/WorkflowScheduler.h>
+#include <SmartPeak/core/SequenceProcessor.h>
+#include <SmartPeak/core/ThreadPool.h>
+
+#include <plog/Log.h>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <typeinfo>
+
+namespace SmartPeak
+{
+  namespace
+  {
+    constexpr size_t NO_TASK = std::numeric_limits<size_t>::max();
+  }
+
+  WorkflowScheduler::WorkflowScheduler(SequenceHandler& sequence_handler) :
+    sequence_handler_(sequence_handler),
+    last_task_per_injection_(sequence_handler.getSequence().size(), NO_TASK)
+  {
+  }
+
+  WorkflowScheduler::Stage& WorkflowScheduler::addStage(
+    ApplicationHandler::Command::CommandType type,
+    const std::string& name,
+    size_t command_index,
+    const std::vector<ApplicationHandler::Command>& commands)
+  {
+    auto stage = std::make_unique<Stage>();
+    stage->type = type;
+    stage->name = name;
+    stage->command_index = command_index;
+    for (const ApplicationHandler::Command& command : commands)
+    {
+      stage->command_names.push_back(command.getName());
+      switch (type)
+      {
+      case ApplicationHandler::Command::RawDataMethod:
+        stage->raw_data_methods.push_back(command.raw_data_method);
+        break;
+      case ApplicationHandler::Command::SequenceSegmentMethod:
+        stage->sequence_segment_methods.push_back(command.seq_seg_method);
+        break;
+      case ApplicationHandler::Command::SampleGroupMethod:
+        stage->sample_group_methods.push_back(command.sample_group_method);
+        break;
+      }
+      for (const auto& filename_to_merge : command.dynamic_filenames)
+      {
+        if (stage->filenames.find(filename_to_merge.first) == stage->filenames.end())
+        {
+          stage->filenames.emplace(filename_to_merge.first, filename_to_merge.second);
+        }
+        else
+        {
+          stage->filenames.at(filename_to_merge.first).merge(filename_to_merge.second);
+        }
+      }
+    }
+    if (commands.empty())
+    {
+      throw std::invalid_argument("no processing methods given for " + name);
+    }
+    stages_.push_back(std::move(stage));
+    return *stages_.back();
+  }
+
+  void WorkflowScheduler::addTask(size_t item, const std::vector<size_t>& injection_indices)
+  {
+    const size_t task_index = tasks_.size();
+    Task task;
+    task.stage = stages_.size() - 1;
+    task.item = item;
+    std::set<size_t> dependencies;
+    for (const size_t injection_index : injection_indices)
+    {
+      if (injection_index >= last_task_per_injection_.size())
+      {
+        continue;
+      }
+      if (last_task_per_injection_[injection_index] != NO_TASK)
+      {
+        dependencies.insert(last_task_per_injection_[injection_index]);
+      }
+      last_task_per_injection_[injection_index] = task_index;
+    }
+    task.dependencies.assign(dependencies.begin(), dependencies.end());
+    task.n_pending = dependencies.size();
+    for (const size_t dependency : dependencies)
+    {
+      tasks_[dependency].dependents.push_back(task_index);
+    }
+    tasks_.push_back(std::move(task));
+    ++stages_.back()->n_tasks;
+  }
+
+  std::vector<size_t> WorkflowScheduler::getDependencies(size_t task_index) const
+  {
+    return tasks_.at(task_index).dependencies;
+  }
+
+  void WorkflowScheduler::addRawDataStage(
+    size_t command_index,
+    const std::vector<ApplicationHandler::Command>& commands,
+    const std::set<std::string>& injection_names,
+    ISequenceProcessorObserver* observer)
+  {
+    Stage& stage = addStage(ApplicationHandler::Command::RawDataMethod, "PROCESS_SEQUENCE", command_index, commands);
+    stage.sequence_observable.addSequenceProcessorObserver(observer);
+
+    // Get the specified injections to process
+    const std::vector<InjectionHandler>& sequence = sequence_handler_.getSequence();
+    std::vector<size_t> injection_indices;
+    if (injection_names.empty())
+    {
+      for (size_t i = 0; i < sequence.size(); ++i)
+      {
+        injection_indices.push_back(i);
+      }
+    }
+    else
+    {
+      for (const std::string& name : injection_names)
+      {
+        for (size_t i = 0; i < sequence.size(); ++i)
+        {
+          if (sequence[i].getMetaData().getInjectionName() == name)
+          {
+            injection_indices.push_back(i);
+            break;
+          }
+        }
+      }
+    }
+
+    // Check that the filenames is consistent with the number of injections
+    if (stage.filenames.size() < injection_indices.size())
+    {
+      throw std::invalid_argument("The number of provided filenames locations is not correct.");
+    }
+
+    for (const size_t injection_index : injection_indices)
+    {
+      addTask(injection_index, { injection_index });
+    }
+  }
+
+  void WorkflowScheduler::addSequenceSegmentStage(
+    size_t command_index,
+    const std::vector<ApplicationHandler::Command>& commands,
+    const std::set<std::string>& sequence_segment_names,
+    ISequenceSegmentProcessorObserver* observer)
+  {
+    Stage& stage = addStage(ApplicationHandler::Command::SequenceSegmentMethod, "PROCESS_SEQUENCE_SEGMENTS", command_index, commands);
+    stage.sequence_segment_observable.addSequenceSegmentProcessorObserver(observer);
+
+    const std::vector<SequenceSegmentHandler>& sequence_segments = sequence_handler_.getSequenceSegments();
+    std::vector<size_t> segment_indices;
+    for (size_t i = 0; i < sequence_segments.size(); ++i)
+    {
+      if (sequence_segment_names.empty() || sequence_segment_names.count(sequence_segments[i].getSequenceSegmentName()))
+      {
+        segment_indices.push_back(i);
+      }
+    }
+    if (stage.filenames.size() < segment_indices.size())
+    {
+      throw std::invalid_argument("The number of provided filenames_ locations is not correct.");
+    }
+
+    for (const size_t segment_index : segment_indices)
+    {
+      addTask(segment_index, sequence_segments[segment_index].getSampleIndices());
+    }
+  }
+
+  void WorkflowScheduler::addSampleGroupStage(
+    size_t command_index,
+    const std::vector<ApplicationHandler::Command>& commands,
+    const std::set<std::string>& sample_group_names,
+    ISampleGroupProcessorObserver* observer)
+  {
+    Stage& stage = addStage(ApplicationHandler::Command::SampleGroupMethod, "PROCESS_SAMPLE_GROUPS", command_index, commands);
+    stage.sample_group_observable.addSampleGroupProcessorObserver(observer);
+
+    const std::vector<SampleGroupHandler>& sample_groups = sequence_handler_.getSampleGroups();
+    std::vector<size_t> group_indices;
+    for (size_t i = 0; i < sample_groups.size(); ++i)
+    {
+      if (sample_group_names.empty() || sample_group_names.count(sample_groups[i].getSampleGroupName()))
+      {
+        group_indices.push_back(i);
+      }
+    }
+    if (stage.filenames.size() < group_indices.size())
+    {
+      throw std::invalid_argument("The number of provided filenames_ locations is not correct.");
+    }
+
+    for (const size_t group_index : group_indices)
+    {
+      addTask(group_index, sample_groups[group_index].getSampleIndices());
+    }
+  }
+
+  void WorkflowScheduler::onStageStart(Stage& stage)
+  {
+    LOGD << "START " << stage.name;
+    if (observable_)
+    {
+      for (size_t i = 0; i < stage.command_names.size(); ++i)
+      {
+        observable_->notifyApplicationProcessorCommandStart(stage.command_index + i, stage.command_names[i]);
+      }
+    }
+    switch (stage.type)
+    {
+    case ApplicationHandler::Command::RawDataMethod:
+      stage.sequence_observable.notifySequenceProcessorStart(stage.n_tasks);
+      break;
+    case ApplicationHandler::Command::SequenceSegmentMethod:
+      stage.sequence_segment_observable.notifySequenceSegmentProcessorStart(stage.n_tasks);
+      break;
+    case ApplicationHandler::Command::SampleGroupMethod:
+      stage.sample_group_observable.notifySampleGroupProcessorStart(stage.n_tasks);
+      break;
+    }
+  }
+
+  void WorkflowScheduler::onStageEnd(Stage& stage)
+  {
+    switch (stage.type)
+    {
+    case ApplicationHandler::Command::RawDataMethod:
+      stage.sequence_observable.notifySequenceProcessorEnd();
+      break;
+    case ApplicationHandler::Command::SequenceSegmentMethod:
+      sequence_handler_.notifySequenceUpdated();
+      stage.sequence_segment_observable.notifySequenceSegmentProcessorEnd();
+      break;
+    case ApplicationHandler::Command::SampleGroupMethod:
+      stage.sample_group_observable.notifySampleGroupProcessorEnd();
+      break;
+    }
+    if (observable_)
+    {
+      for (size_t i = 0; i < stage.command_names.size(); ++i)
+      {
+        observable_->notifyApplicationProcessorCommandEnd(stage.command_index + i, stage.command_names[i]);
+      }
+    }
+    LOGD << "END " << stage.name;
+  }
+
+  void WorkflowScheduler::runTask(size_t task_index)
+  {
+    const Task& task = tasks_[task_index];
+    Stage& stage = *stages_[task.stage];
+    std::call_once(stage.started, [this, &stage]() { onStageStart(stage); });
+
+    try
+    {
+      if (stage.type == ApplicationHandler::Command::RawDataMethod)
+      {
+        InjectionHandler& injection = sequence_handler_.getSequence()[task.item];
+        stage.sequence_observable.notifySequenceProcessorSampleStart(injection.getMetaData().getSampleName());
+        Filenames& filenames = stage.filenames.at(injection.getMetaData().getInjectionName());
+        try
+        {
+          processInjection(injection, filenames, stage.raw_data_methods, token_);
+          LOGD << "Injection [" << task.item << "]: done";
+        }
+        catch (const WorkflowException& e)
+        {
+          stage.sequence_observable.notifySequenceProcessorError(e.item(), e.processor(), e.what());
+        }
+        stage.sequence_observable.notifySequenceProcessorSampleEnd(injection.getMetaData().getSampleName());
+      }
+      else if (stage.type == ApplicationHandler::Command::SequenceSegmentMethod)
+      {
+        SequenceSegmentHandler& sequence_segment = sequence_handler_.getSequenceSegments()[task.item];
+        stage.sequence_segment_observable.notifySequenceSegmentProcessorSampleStart(sequence_segment.getSequenceSegmentName());
+        Filenames& filenames = stage.filenames.at(sequence_segment.getSequenceSegmentName());
+        try
+        {
+          processSegment(sequence_segment, sequence_handler_, filenames, stage.sequence_segment_methods, token_);
+          LOGI << ">>SequenceSegment [" << sequence_segment.getSequenceSegmentName() << "]: done";
+        }
+        catch (const WorkflowException& e)
+        {
+          stage.sequence_segment_observable.notifySequenceSegmentProcessorError(e.item(), e.processor(), e.what());
+        }
+        stage.sequence_segment_observable.notifySequenceSegmentProcessorSampleEnd(sequence_segment.getSequenceSegmentName());
+      }
+      else if (stage.type == ApplicationHandler::Command::SampleGroupMethod)
+      {
+        SampleGroupHandler& sample_group = sequence_handler_.getSampleGroups()[task.item];
+        stage.sample_group_observable.notifySampleGroupProcessorSampleStart(sample_group.getSampleGroupName());
+        Filenames& filenames = stage.filenames.at(sample_group.getSampleGroupName());
+        try
+        {
+          processSampleGroup(sample_group, sequence_handler_, filenames, stage.sample_group_methods, token_);
+          LOGI << ">>SampleGroup [" << sample_group.getSampleGroupName() << "]: done";
+        }
+        catch (const WorkflowException& e)
+        {
+          stage.sample_group_observable.notifySampleGroupProcessorError(e.item(), e.processor(), e.what());
+        }
+        stage.sample_group_observable.notifySampleGroupProcessorSampleEnd(sample_group.getSampleGroupName());
+      }
+    }
+    catch (const std::exception& e)
+    {
+      LOGE << stage.name << " [" << task.item << "]: " << typeid(e).name() << " : " << e.what();
+    }
+    catch (...)
+    {
+      LOGE << stage.name << " [" << task.item << "]: unknown error";
+    }
+
+    // the end of the stage is notified before its last task releases the dependents
+    bool stage_done = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stage_done = (++stage.n_done == stage.n_tasks);
+    }
+    if (stage_done)
+    {
+      onStageEnd(stage);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --n_running_;
+      ++n_done_;
+      for (const size_t dependent : task.dependents)
+      {
+        if (--tasks_[dependent].n_pending == 0)
+        {
+          ready_.emplace(stages_.size() - tasks_[dependent].stage, dependent);
+        }
+      }
+    }
+    task_done_cv_.notify_all();
+  }
+
+  void WorkflowScheduler::run(unsigned int n_threads, ApplicationProcessorObservable* observable, const CancellationToken& token)
+  {
+    observable_ = observable;
+    token_ = token;
+    const size_t n_workers = ProcessorMultithread::getNumWorkers(n_threads);
+    LOGD << "Number of workers: " << n_workers << ", number of tasks: " << tasks_.size();
+
+    ThreadPool& pool = ThreadPool::instance();
+    std::vector<std::future<void>> futures;
+    futures.reserve(tasks_.size());
+
+    for (std::unique_ptr<Stage>& stage : stages_)
+    {
+      if (stage->n_tasks == 0)
+      {
+        onStageStart(*stage);
+        onStageEnd(*stage);
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < tasks_.size(); ++i)
+    {
+      if (tasks_[i].n_pending == 0)
+      {
+        ready_.emplace(stages_.size() - tasks_[i].stage, i);
+      }
+    }
+
+    auto can_progress = [this, n_workers]() {
+      return n_done_ == tasks_.size() || (n_running_ < n_workers && !ready_.empty());
+    };
+    while (n_done_ < tasks_.size())
+    {
+      while (n_running_ < n_workers && !ready_.empty())
+      {
+        const size_t task_index = ready_.begin()->second;
+        ready_.erase(ready_.begin());
+        ++n_running_;
+        futures.push_back(pool.submit([this, task_index]() { runTask(task_index); }));
+      }
+      if (n_done_ == tasks_.size())
+      {
+        break;
+      }
+      if (pool.isWorkerThread())
+      {
+        // do not block one of the workers the tasks are waiting for
+        lock.unlock();
+        const bool ran_task = pool.runPendingTask();
+        lock.lock();
+        if (!ran_task)
+        {
+          task_done_cv_.wait_for(lock, std::chrono::milliseconds(1), can_progress);
+        }
+      }
+      else
+      {
+        task_done_cv_.wait(lock, can_progress);
+      }
+    }
+    lock.unlock();
+
+    for (std::future<void>& f : futures)
+    {
+      pool.wait(f);
+    }
+  }
+}
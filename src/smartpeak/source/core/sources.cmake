@@ -3,17 +3,21 @@ set(directory source/core)
 
 ### list all filenames of the directory here
 set(sources_list
+	AccurateMassSearchEngineRegistry.cpp
 	ApplicationHandler.cpp
 	ApplicationProcessor.cpp
 	CastValue.cpp
 	ConsoleHandler.cpp
 	EventDispatcher.cpp
 	FeatureFiltersUtils.cpp
+	FeatureMatrixCache.cpp
 	FeatureMetadata.cpp
+	FeatureTable.cpp
 	Filenames.cpp
 	Helloworld.cpp
 	InjectionHandler.cpp
 	MetaDataHandler.cpp
+	ParameterSchemaCache.cpp
 	Parameters.cpp
 	ProgessInfo.cpp
 	RawDataHandler.cpp
@@ -25,13 +29,17 @@ set(sources_list
 	SequenceProcessor.cpp
 	SequenceSegmentHandler.cpp
 	SequenceSegmentProcessor.cpp
+	SeriesPyramid.cpp
 	SessionHandler.cpp
 	ServerAppender.cpp
 	SessionLoaderGenerator.cpp
 	SharedProcessors.cpp
+	SpectralLibraryCache.cpp
 	Server.cpp
+	ThreadPool.cpp
 	Utilities.cpp
 	WorkflowManager.cpp
+	WorkflowScheduler.cpp
 )
 
 ### add path to the filenames
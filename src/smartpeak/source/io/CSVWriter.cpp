@@ -23,12 +23,124 @@
 
 #include <SmartPeak/io/CSVWriter.h>
 
+#include <charconv>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace SmartPeak
 {
+  /**
+    Writes the buffers handed over by the CSVWriter on its own thread.
+  */
+  struct CSVWriter::BackgroundWriter
+  {
+    explicit BackgroundWriter(std::ofstream& ofs) :
+      ofs_(ofs), thread_(&BackgroundWriter::run, this)
+    {
+    }
+
+    ~BackgroundWriter()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+      }
+      cv_.notify_all();
+      thread_.join();
+    }
+
+    /// hand over a full buffer, and get back an empty one (recycled if possible)
+    std::string push(std::string&& buffer)
+    {
+      std::string empty_buffer;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers_.push_back(std::move(buffer));
+        if (!free_buffers_.empty()) {
+          empty_buffer = std::move(free_buffers_.back());
+          free_buffers_.pop_back();
+        }
+      }
+      cv_.notify_all();
+      return empty_buffer;
+    }
+
+    /// wait for all the buffers handed over so far to be written
+    void wait()
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return buffers_.empty() && !writing_; });
+    }
+
+    void run()
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (true) {
+        cv_.wait(lock, [this]() { return stop_ || !buffers_.empty(); });
+        if (buffers_.empty()) {
+          break; // stop_ and nothing left to write
+        }
+        std::string buffer = std::move(buffers_.front());
+        buffers_.pop_front();
+        writing_ = true;
+        lock.unlock();
+        ofs_.write(buffer.data(), buffer.size());
+        buffer.clear();
+        lock.lock();
+        free_buffers_.push_back(std::move(buffer));
+        writing_ = false;
+        cv_.notify_all();
+      }
+    }
+
+    std::ofstream& ofs_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::string> buffers_;
+    std::vector<std::string> free_buffers_;
+    bool writing_ = false;
+    bool stop_ = false;
+    std::thread thread_; ///< declared last, so that it starts once the other members are initialized
+  };
+
+  CSVWriter::CSVWriter(const std::string& filename, const std::string& delm) :
+    filename_(filename), delimeter_(delm)
+  {
+  }
+
+  CSVWriter::CSVWriter() = default;
+
+  CSVWriter::~CSVWriter()
+  {
+    close();
+  }
+
+  CSVWriter::CSVWriter(CSVWriter&& other) noexcept = default;
+
+  CSVWriter& CSVWriter::operator=(CSVWriter&& other) noexcept
+  {
+    if (this != &other) {
+      close();
+      filename_ = std::move(other.filename_);
+      delimeter_ = std::move(other.delimeter_);
+      line_count_ = other.line_count_;
+      buffer_size_ = other.buffer_size_;
+      async_ = other.async_;
+      buffer_ = std::move(other.buffer_);
+      ofs_ = std::move(other.ofs_);
+      background_writer_ = std::move(other.background_writer_);
+    }
+    return *this;
+  }
+
   void CSVWriter::setFilename(const std::string& filename)
   {
+    close();
     filename_ = filename;
   }
   std::string CSVWriter::getFilename() const
@@ -53,4 +165,102 @@ namespace SmartPeak
   {
     return line_count_;
   }
+
+  void CSVWriter::setBufferSize(const size_t buffer_size)
+  {
+    buffer_size_ = buffer_size;
+  }
+  size_t CSVWriter::getBufferSize() const
+  {
+    return buffer_size_;
+  }
+
+  void CSVWriter::setAsync(const bool async)
+  {
+    async_ = async;
+  }
+  bool CSVWriter::getAsync() const
+  {
+    return async_;
+  }
+
+  bool CSVWriter::open()
+  {
+    if (ofs_) {
+      return true;
+    }
+    auto ofs = std::make_unique<std::ofstream>(filename_, line_count_ ? std::ios::app : std::ios::trunc);
+    if (!ofs->is_open()) {
+      return false;
+    }
+    ofs_ = std::move(ofs);
+    buffer_.reserve(buffer_size_);
+    if (async_) {
+      background_writer_ = std::make_unique<BackgroundWriter>(*ofs_);
+    }
+    return true;
+  }
+
+  void CSVWriter::flushBuffer()
+  {
+    if (!ofs_ || buffer_.empty()) {
+      return;
+    }
+    if (background_writer_) {
+      buffer_ = background_writer_->push(std::move(buffer_));
+      buffer_.reserve(buffer_size_);
+    } else {
+      ofs_->write(buffer_.data(), buffer_.size());
+      buffer_.clear();
+    }
+  }
+
+  void CSVWriter::flush()
+  {
+    flushBuffer();
+    if (background_writer_) {
+      background_writer_->wait();
+    }
+    if (ofs_) {
+      ofs_->flush();
+    }
+  }
+
+  void CSVWriter::close()
+  {
+    flushBuffer();
+    background_writer_.reset(); // writes the remaining buffers
+    if (ofs_) {
+      ofs_->close();
+      ofs_.reset();
+    }
+    buffer_.clear();
+  }
+
+  void CSVWriter::appendNumber(double value)
+  {
+    char chars[64];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const std::to_chars_result result = std::to_chars(chars, chars + sizeof(chars), value, std::chars_format::general, 6);
+    buffer_.append(chars, result.ptr);
+#else
+    // floating point std::to_chars is not available on all the supported standard libraries
+    const int n = std::snprintf(chars, sizeof(chars), "%g", value);
+    buffer_.append(chars, n);
+#endif
+  }
+
+  void CSVWriter::appendNumber(long long value)
+  {
+    char chars[32];
+    const std::to_chars_result result = std::to_chars(chars, chars + sizeof(chars), value);
+    buffer_.append(chars, result.ptr);
+  }
+
+  void CSVWriter::appendNumber(unsigned long long value)
+  {
+    char chars[32];
+    const std::to_chars_result result = std::to_chars(chars, chars + sizeof(chars), value);
+    buffer_.append(chars, result.ptr);
+  }
 }
@@ -22,7 +22,9 @@
 // --------------------------------------------------------------------------
 
 #include <SmartPeak/io/SequenceParser.h>
+#include <SmartPeak/core/FeatureMatrixCache.h>
 #include <SmartPeak/core/FeatureMetadata.h>
+#include <SmartPeak/core/FeatureTable.h>
 #include <SmartPeak/core/SampleType.h>
 #include <SmartPeak/core/SequenceHandler.h>
 #include <SmartPeak/core/ApplicationHandler.h>
@@ -32,6 +34,7 @@
 #include <SmartPeak/io/csv.h>
 #include <SmartPeak/io/CSVWriter.h>
 #include <SmartPeak/io/InputDataValidation.h>
+#include <algorithm>
 #include <ctime>
 
 #include <plog/Log.h>
@@ -613,27 +616,97 @@ namespace SmartPeak
     LOGD << "END writeSequenceFileXcalibur";
   }
 
-  void SequenceParser::makeDataTableFromMetaValue(
+  namespace
+  {
+    const std::string s_messages_delimiter {"_____"};
+
+    void appendMetaValue(FeatureTable& table, size_t col, const CastValue& datum)
+    {
+      switch (datum.getTag())
+      {
+      case CastValue::Type::FLOAT:
+        if (datum.f_ != 0.0)
+        {
+          table.appendReal(col, datum.f_);
+        }
+        else
+        {
+          table.appendEmpty(col);
+        }
+        break;
+      case CastValue::Type::INT:
+        table.appendInteger(col, datum.i_);
+        break;
+      case CastValue::Type::LONG_INT:
+        table.appendInteger(col, datum.li_);
+        break;
+      default:
+        {
+          const std::string text(datum);
+          if (text.empty())
+          {
+            table.appendEmpty(col);
+          }
+          else
+          {
+            table.appendText(col, text);
+          }
+        }
+      }
+    }
+
+    void appendMessages(FeatureTable& table, size_t col, const OpenMS::Feature& feature, const SequenceHandler::MetaValueKey& meta_value)
+    {
+      OpenMS::StringList messages = feature.getMetaValue(meta_value.index).toStringList();
+      table.appendText(col, Utilities::join(messages.begin(), messages.end(), s_messages_delimiter));
+    }
+
+    void writeFeatureTable(CSVWriter& writer, const FeatureTable& table)
+    {
+      std::vector<std::string> line;
+      for (size_t row = 0; row < table.getNRows(); ++row) {
+        table.getRow(row, line);
+        writer.writeDataInRow(line.cbegin(), line.cend());
+      }
+    }
+  }
+
+  void SequenceParser::makeFeatureTableFromMetaValue(
     const SequenceHandler& sequenceHandler,
-    std::vector<std::vector<std::string>>& rows_out,
-    std::vector<std::string>& headers_out,
+    FeatureTable& table_out,
     const std::vector<std::string>& meta_data,
     const std::set<SampleType>& sample_types,
     const std::set<std::string>& sample_names,
     const std::set<std::string>& component_group_names,
     const std::set<std::string>& component_names) {
-    std::vector<std::string> headers = {
+    const std::vector<std::string> headers = {
       "sample_name", "sample_type", "component_group_name", "replicate_group_name", "component_name", "batch_name",
       "rack_number", "plate_number", "pos_number", "inj_number", "dilution_factor", "inj_volume",
       "inj_volume_units", "operator_name", "acq_method_name", "proc_method_name",
       "original_filename", "acquisition_date_and_time", "scan_polarity", "scan_mass_low", "scan_mass_high", "injection_name", "used_"
     };
-    headers.insert(headers.end(), meta_data.cbegin(), meta_data.cend());
-    headers_out = headers;
+    table_out.clear();
+    for (const std::string& header : headers) {
+      table_out.addColumn(header);
+    }
+    for (const std::string& meta_value_name : meta_data) {
+      table_out.addColumn(meta_value_name);
+    }
+    const std::vector<SequenceHandler::MetaValueKey> meta_values = SequenceHandler::resolveMetaValues(meta_data);
 
-    const std::string delimiter {"_____"};
+    size_t n_rows = 0;
+    for (const InjectionHandler& sampleHandler : sequenceHandler.getSequence()) {
+      const MetaDataHandler& mdh = sampleHandler.getMetaData();
+      if (sample_types.count(mdh.getSampleType()) == 0)
+        continue;
+      if (sample_names.size() > 0 && sample_names.count(mdh.getSampleName()) == 0)
+        continue;
+      for (const OpenMS::Feature& feature : sampleHandler.getRawData().getFeatureMapHistory()) {
+        n_rows += std::max<size_t>(feature.getSubordinates().size(), 1);
+      }
+    }
+    table_out.reserve(n_rows);
 
-    rows_out.clear();
     for (const InjectionHandler& sampleHandler : sequenceHandler.getSequence()) {
       const MetaDataHandler& mdh = sampleHandler.getMetaData();
       if (sample_types.count(mdh.getSampleType()) == 0)
@@ -641,6 +714,47 @@ namespace SmartPeak
       if (sample_names.size() > 0 && sample_names.count(mdh.getSampleName()) == 0)
         continue;
 
+      // the injection columns are the same for all the rows of the injection
+      const FeatureTable::StringId sample_name = table_out.intern(mdh.getSampleName());
+      const FeatureTable::StringId sample_type = table_out.intern(sampleTypeToString.at(mdh.getSampleType()));
+      const FeatureTable::StringId replicate_group_name = table_out.intern(mdh.getReplicateGroupName());
+      const FeatureTable::StringId batch_name = table_out.intern(mdh.batch_name);
+      const FeatureTable::StringId inj_volume_units = table_out.intern(mdh.inj_volume_units);
+      const FeatureTable::StringId operator_name = table_out.intern(mdh.operator_name);
+      const FeatureTable::StringId acq_method_name = table_out.intern(mdh.acq_method_name);
+      const FeatureTable::StringId proc_method_name = table_out.intern(mdh.proc_method_name);
+      const FeatureTable::StringId original_filename = table_out.intern(mdh.getFilename());
+      const FeatureTable::StringId acquisition_date_and_time = table_out.intern(mdh.getAcquisitionDateAndTimeAsString());
+      const FeatureTable::StringId scan_polarity = table_out.intern(mdh.scan_polarity);
+      const FeatureTable::StringId injection_name = table_out.intern(mdh.getInjectionName());
+      const FeatureTable::StringId no_component_name = table_out.intern("");
+      auto append_injection_columns = [&](FeatureTable::StringId component_group_name, FeatureTable::StringId component_name) {
+        size_t col = 0;
+        table_out.appendText(col++, sample_name);
+        table_out.appendText(col++, sample_type);
+        table_out.appendText(col++, component_group_name);
+        table_out.appendText(col++, replicate_group_name);
+        table_out.appendText(col++, component_name);
+        table_out.appendText(col++, batch_name);
+        table_out.appendInteger(col++, mdh.rack_number);
+        table_out.appendInteger(col++, mdh.plate_number);
+        table_out.appendInteger(col++, mdh.pos_number);
+        table_out.appendInteger(col++, mdh.inj_number);
+        table_out.appendReal(col++, mdh.dilution_factor);
+        table_out.appendReal(col++, mdh.inj_volume);
+        table_out.appendText(col++, inj_volume_units);
+        table_out.appendText(col++, operator_name);
+        table_out.appendText(col++, acq_method_name);
+        table_out.appendText(col++, proc_method_name);
+        table_out.appendText(col++, original_filename);
+        table_out.appendText(col++, acquisition_date_and_time);
+        table_out.appendText(col++, scan_polarity);
+        table_out.appendReal(col++, mdh.scan_mass_low);
+        table_out.appendReal(col++, mdh.scan_mass_high);
+        table_out.appendText(col++, injection_name);
+        return col;
+      };
+
       // feature_map_history_ is needed in order to export all "used_" = true and false features
       for (const OpenMS::Feature& feature : sampleHandler.getRawData().getFeatureMapHistory()) {
         if (!feature.metaValueExists(s_PeptideRef) || feature.getMetaValue(s_PeptideRef).isEmpty()) {
@@ -650,70 +764,25 @@ namespace SmartPeak
         const std::string component_group_name = feature.getMetaValue(s_PeptideRef);
         if (component_group_names.size() > 0 && component_group_names.count(component_group_name) == 0)
           continue;
+        const FeatureTable::StringId component_group_name_id = table_out.intern(component_group_name);
 
         // Case #1: Features only
         if (feature.getSubordinates().size() <= 0) {
-          std::vector<std::string> row;
-          row.push_back(mdh.getSampleName());
-          row.push_back(sampleTypeToString.at(mdh.getSampleType()));
-          row.push_back(component_group_name);
-          row.push_back(mdh.getReplicateGroupName());
-          row.push_back("");
-          row.push_back(mdh.batch_name);
-          row.push_back(std::to_string(mdh.rack_number));
-          row.push_back(std::to_string(mdh.plate_number));
-          row.push_back(std::to_string(mdh.pos_number));
-          row.push_back(std::to_string(mdh.inj_number));
-          row.push_back(std::to_string(mdh.dilution_factor));
-          row.push_back(std::to_string(mdh.inj_volume));
-          row.push_back(mdh.inj_volume_units);
-          row.push_back(mdh.operator_name);
-          row.push_back(mdh.acq_method_name);
-          row.push_back(mdh.proc_method_name);
-          row.push_back(mdh.getFilename());
-          row.push_back(mdh.getAcquisitionDateAndTimeAsString());
-          row.push_back(mdh.scan_polarity);
-          row.push_back(std::to_string(mdh.scan_mass_low));
-          row.push_back(std::to_string(mdh.scan_mass_high));
-          row.push_back(mdh.getInjectionName());
-          row.push_back(feature.metaValueExists("used_") ? feature.getMetaValue("used_").toString() : "");
-          for (const std::string& meta_value_name : meta_data) {
-            if (feature.metaValueExists(meta_value_name) && meta_value_name == "QC_transition_group_message") {
-              OpenMS::StringList messages = feature.getMetaValue(meta_value_name).toStringList();
-              row.push_back(
-                Utilities::join(messages.begin(), messages.end(), delimiter)
-              );
+          size_t col = append_injection_columns(component_group_name_id, no_component_name);
+          table_out.appendText(col++, feature.metaValueExists("used_") ? feature.getMetaValue("used_").toString() : "");
+          for (const SequenceHandler::MetaValueKey& meta_value : meta_values) {
+            if (meta_value.name == "QC_transition_group_message" && feature.metaValueExists(meta_value.index)) {
+              appendMessages(table_out, col++, feature, meta_value);
             }
-            else 
+            else
             {
-              CastValue datum = SequenceHandler::getMetaValue(feature, feature, meta_value_name);
-              if (datum.getTag() == CastValue::Type::FLOAT)
-              {
-                if (datum.f_ != 0.0)
-                {
-                  // NOTE: to_string() rounds at 1e-6. Therefore, some precision might be lost.
-                  row.push_back(std::to_string(datum.f_));
-                }
-                else
-                {
-                  row.push_back("");
-                }
-              }
-              else
-              {
-                row.push_back(std::string(datum));
-              }
+              appendMetaValue(table_out, col++, SequenceHandler::getMetaValue(feature, feature, meta_value));
             }
           }
-          rows_out.push_back(row);
         }
 
         // Case #2: Features and subordinates
         for (const OpenMS::Feature& subordinate : feature.getSubordinates()) {
-          std::vector<std::string> row;
-          row.push_back(mdh.getSampleName());
-          row.push_back(sampleTypeToString.at(mdh.getSampleType()));
-          row.push_back(component_group_name);
           if (!subordinate.metaValueExists(s_native_id) ||
               subordinate.getMetaValue(s_native_id).isEmpty() ||
               subordinate.getMetaValue(s_native_id).toString().empty()) {
@@ -723,68 +792,27 @@ namespace SmartPeak
           const std::string component_name = subordinate.getMetaValue(s_native_id);
           if (component_names.size() > 0 && component_names.count(component_name) == 0)
             continue;
-          row.push_back(mdh.getReplicateGroupName());
-          row.push_back(component_name);
-          row.push_back(mdh.batch_name);
-          row.push_back(std::to_string(mdh.rack_number));
-          row.push_back(std::to_string(mdh.plate_number));
-          row.push_back(std::to_string(mdh.pos_number));
-          row.push_back(std::to_string(mdh.inj_number));
-          row.push_back(std::to_string(mdh.dilution_factor));
-          row.push_back(std::to_string(mdh.inj_volume));
-          row.push_back(mdh.inj_volume_units);
-          row.push_back(mdh.operator_name);
-          row.push_back(mdh.acq_method_name);
-          row.push_back(mdh.proc_method_name);
-          row.push_back(mdh.getFilename());
-          row.push_back(mdh.getAcquisitionDateAndTimeAsString());
-          row.push_back(mdh.scan_polarity);
-          row.push_back(std::to_string(mdh.scan_mass_low));
-          row.push_back(std::to_string(mdh.scan_mass_high));
-          row.push_back(mdh.getInjectionName());
-          row.push_back(subordinate.metaValueExists("used_") ? subordinate.getMetaValue("used_").toString() : "");
-          for (const std::string& meta_value_name : meta_data) {
-            if (subordinate.metaValueExists(meta_value_name) && meta_value_name == "QC_transition_message") {
-              OpenMS::StringList messages = subordinate.getMetaValue(meta_value_name).toStringList();
-              row.push_back(
-                Utilities::join(messages.begin(), messages.end(), delimiter)
-              );
+          size_t col = append_injection_columns(component_group_name_id, table_out.intern(component_name));
+          table_out.appendText(col++, subordinate.metaValueExists("used_") ? subordinate.getMetaValue("used_").toString() : "");
+          for (const SequenceHandler::MetaValueKey& meta_value : meta_values) {
+            if (meta_value.name == "QC_transition_message" && subordinate.metaValueExists(meta_value.index)) {
+              appendMessages(table_out, col++, subordinate, meta_value);
             }
-            else if (feature.metaValueExists(meta_value_name) && meta_value_name == "QC_transition_group_message") 
+            else if (meta_value.name == "QC_transition_group_message" && feature.metaValueExists(meta_value.index))
             {
-              OpenMS::StringList messages = feature.getMetaValue(meta_value_name).toStringList();
-              row.push_back(
-                Utilities::join(messages.begin(), messages.end(), delimiter)
-              );
+              appendMessages(table_out, col++, feature, meta_value);
             }
-            else 
+            else
             {
-              CastValue datum = SequenceHandler::getMetaValue(feature, subordinate, meta_value_name);
-              if (datum.getTag() == CastValue::Type::FLOAT)
-              {
-                if (datum.f_ != 0.0)
-                {
-                  // NOTE: to_string() rounds at 1e-6. Therefore, some precision might be lost.
-                  row.push_back(std::to_string(datum.f_));
-                }
-                else
-                {
-                  row.push_back("");
-                }
-              }
-              else
-              {
-                row.push_back(std::string(datum));
-              }
+              appendMetaValue(table_out, col++, SequenceHandler::getMetaValue(feature, subordinate, meta_value));
             }
           }
-          rows_out.push_back(row);
         }
       }
     }
   }
 
-  void SequenceParser::makeGroupDataTableFromMetaValue(
+  void SequenceParser::makeDataTableFromMetaValue(
     const SequenceHandler& sequenceHandler,
     std::vector<std::vector<std::string>>& rows_out,
     std::vector<std::string>& headers_out,
@@ -793,21 +821,39 @@ namespace SmartPeak
     const std::set<std::string>& sample_names,
     const std::set<std::string>& component_group_names,
     const std::set<std::string>& component_names) {
-    std::vector<std::string> headers = {
+    FeatureTable table;
+    makeFeatureTableFromMetaValue(sequenceHandler, table, meta_data, sample_types, sample_names, component_group_names, component_names);
+    headers_out = table.getHeaders();
+    rows_out = table.toRows();
+  }
+
+  void SequenceParser::makeGroupFeatureTableFromMetaValue(
+    const SequenceHandler& sequenceHandler,
+    FeatureTable& table_out,
+    const std::vector<std::string>& meta_data,
+    const std::set<SampleType>& sample_types,
+    const std::set<std::string>& sample_names,
+    const std::set<std::string>& component_group_names,
+    const std::set<std::string>& component_names) {
+    const std::vector<std::string> headers = {
       "sample_group_name", "component_group_name", "component_name", "used_"
     };
-    headers.insert(headers.end(), meta_data.cbegin(), meta_data.cend());
-    headers_out = headers;
-
-    const std::string delimiter{ "_____" };
+    table_out.clear();
+    for (const std::string& header : headers) {
+      table_out.addColumn(header);
+    }
+    for (const std::string& meta_value_name : meta_data) {
+      table_out.addColumn(meta_value_name);
+    }
+    const std::vector<SequenceHandler::MetaValueKey> meta_values = SequenceHandler::resolveMetaValues(meta_data);
 
-    rows_out.clear();
     for (const SampleGroupHandler& sample_handler : sequenceHandler.getSampleGroups())
     {
-      auto feature_map = sample_handler.getFeatureMap();
-      
+      const OpenMS::FeatureMap& feature_map = sample_handler.getFeatureMap();
+
       if (sample_names.size() > 0 && sample_names.count(sample_handler.getSampleGroupName()) == 0)
         continue;
+      const FeatureTable::StringId sample_group_name = table_out.intern(sample_handler.getSampleGroupName());
 
       for (const OpenMS::Feature& feature : feature_map)
       {
@@ -818,43 +864,24 @@ namespace SmartPeak
         const std::string component_group_name = feature.getMetaValue(s_PeptideRef);
         if (component_group_names.size() > 0 && component_group_names.count(component_group_name) == 0)
           continue;
+        const FeatureTable::StringId component_group_name_id = table_out.intern(component_group_name);
 
         // Case #1: Features only
         if (feature.getSubordinates().size() <= 0) {
-          std::vector<std::string> row;
-          row.push_back(sample_handler.getSampleGroupName());
-          row.push_back(component_group_name);
-          row.push_back("");
-          row.push_back(feature.metaValueExists("used_") ? feature.getMetaValue("used_").toString() : "");
-          for (const std::string& meta_value_name : meta_data)
+          size_t col = 0;
+          table_out.appendText(col++, sample_group_name);
+          table_out.appendText(col++, component_group_name_id);
+          table_out.appendText(col++, std::string());
+          table_out.appendText(col++, feature.metaValueExists("used_") ? feature.getMetaValue("used_").toString() : "");
+          for (const SequenceHandler::MetaValueKey& meta_value : meta_values)
           {
-            CastValue datum = SequenceHandler::getMetaValue(feature, feature, meta_value_name);
-            if (datum.getTag() == CastValue::Type::FLOAT)
-            {
-              if (datum.f_ != 0.0)
-              {
-                // NOTE: to_string() rounds at 1e-6. Therefore, some precision might be lost.
-                row.push_back(std::to_string(datum.f_));
-              }
-              else
-              {
-                row.push_back("");
-              }
-            }
-            else
-            {
-              row.push_back(std::string(datum));
-            }
+            appendMetaValue(table_out, col++, SequenceHandler::getMetaValue(feature, feature, meta_value));
           }
-          rows_out.push_back(row);
         }
 
         // Case #2: Features and subordinates
         for (const OpenMS::Feature& subordinate : feature.getSubordinates())
         {
-          std::vector<std::string> row;
-          row.push_back(sample_handler.getSampleGroupName());
-          row.push_back(component_group_name);
           if (!subordinate.metaValueExists(s_native_id) ||
             subordinate.getMetaValue(s_native_id).isEmpty() ||
             subordinate.getMetaValue(s_native_id).toString().empty()) {
@@ -864,34 +891,35 @@ namespace SmartPeak
           const std::string component_name = subordinate.getMetaValue(s_native_id);
           if (component_names.size() > 0 && component_names.count(component_name) == 0)
             continue;
-          row.push_back(component_name);
-          row.push_back(subordinate.metaValueExists("used_") ? subordinate.getMetaValue("used_").toString() : "");
-          for (const std::string& meta_value_name : meta_data)
+          size_t col = 0;
+          table_out.appendText(col++, sample_group_name);
+          table_out.appendText(col++, component_group_name_id);
+          table_out.appendText(col++, component_name);
+          table_out.appendText(col++, subordinate.metaValueExists("used_") ? subordinate.getMetaValue("used_").toString() : "");
+          for (const SequenceHandler::MetaValueKey& meta_value : meta_values)
           {
-            CastValue datum = SequenceHandler::getMetaValue(feature, subordinate, meta_value_name);
-            if (datum.getTag() == CastValue::Type::FLOAT)
-            {
-              if (datum.f_ != 0.0)
-              {
-                // NOTE: to_string() rounds at 1e-6. Therefore, some precision might be lost.
-                row.push_back(std::to_string(datum.f_));
-              }
-              else
-              {
-                row.push_back("");
-              }
-            }
-            else
-            {
-              row.push_back(std::string(datum));
-            }
+            appendMetaValue(table_out, col++, SequenceHandler::getMetaValue(feature, subordinate, meta_value));
           }
-          rows_out.push_back(row);
         }
       }
     }
   }
 
+  void SequenceParser::makeGroupDataTableFromMetaValue(
+    const SequenceHandler& sequenceHandler,
+    std::vector<std::vector<std::string>>& rows_out,
+    std::vector<std::string>& headers_out,
+    const std::vector<std::string>& meta_data,
+    const std::set<SampleType>& sample_types,
+    const std::set<std::string>& sample_names,
+    const std::set<std::string>& component_group_names,
+    const std::set<std::string>& component_names) {
+    FeatureTable table;
+    makeGroupFeatureTableFromMetaValue(sequenceHandler, table, meta_data, sample_types, sample_names, component_group_names, component_names);
+    headers_out = table.getHeaders();
+    rows_out = table.toRows();
+  }
+
   bool SequenceParser::writeDataTableFromMetaValue(
     const SequenceHandler& sequenceHandler,
     const std::filesystem::path& filename,
@@ -902,15 +930,15 @@ namespace SmartPeak
     LOGD << "START writeDataTableFromMetaValue";
     LOGI << "Storing: " << filename.generic_string();
 
-    std::vector<std::vector<std::string>> rows;
-    std::vector<std::string> headers;
+    FeatureTable table;
     std::vector<std::string> meta_data_strings;
     for (const FeatureMetadata& m : meta_data) {
       meta_data_strings.push_back(metadataToString.at(m));
     }
-    makeDataTableFromMetaValue(sequenceHandler, rows, headers, meta_data_strings, sample_types, std::set<std::string>(), std::set<std::string>(), std::set<std::string>());
+    makeFeatureTableFromMetaValue(sequenceHandler, table, meta_data_strings, sample_types, std::set<std::string>(), std::set<std::string>(), std::set<std::string>());
 
     CSVWriter writer(filename.generic_string(), ",");
+    const std::vector<std::string>& headers = table.getHeaders();
     const std::optional<size_t> cnt = writer.writeDataInRow(headers.cbegin(), headers.cend());
 
     if (!cnt || *cnt < headers.size()) {
@@ -918,9 +946,7 @@ namespace SmartPeak
       return false;
     }
 
-    for (const std::vector<std::string>& line : rows) {
-      writer.writeDataInRow(line.cbegin(), line.cend());
-    }
+    writeFeatureTable(writer, table);
 
     LOGD << "END writeDataTableFromMetaValue";
     return true;
@@ -936,15 +962,15 @@ namespace SmartPeak
     LOGD << "START writeDataTableFromMetaValue";
     LOGI << "Storing: " << filename.generic_string();
 
-    std::vector<std::vector<std::string>> rows;
-    std::vector<std::string> headers;
+    FeatureTable table;
     std::vector<std::string> meta_data_strings;
     for (const FeatureMetadata& m : meta_data) {
       meta_data_strings.push_back(metadataToString.at(m));
     }
-    makeGroupDataTableFromMetaValue(sequenceHandler, rows, headers, meta_data_strings, sample_types, std::set<std::string>(), std::set<std::string>(), std::set<std::string>());
+    makeGroupFeatureTableFromMetaValue(sequenceHandler, table, meta_data_strings, sample_types, std::set<std::string>(), std::set<std::string>(), std::set<std::string>());
 
     CSVWriter writer(filename.generic_string(), ",");
+    const std::vector<std::string>& headers = table.getHeaders();
     const std::optional<size_t> cnt = writer.writeDataInRow(headers.cbegin(), headers.cend());
 
     if (!cnt || *cnt < headers.size()) {
@@ -952,9 +978,7 @@ namespace SmartPeak
       return false;
     }
 
-    for (const std::vector<std::string>& line : rows) {
-      writer.writeDataInRow(line.cbegin(), line.cend());
-    }
+    writeFeatureTable(writer, table);
 
     LOGD << "END writeDataTableFromMetaValue";
     return true;
@@ -1000,133 +1024,9 @@ namespace SmartPeak
     const std::set<std::string>& component_names
   )
   {
-    std::set<std::string> columns;
-    std::set<Row,Row_less> rows;
-    std::map<std::string,std::map<Row,float,Row_less>> data_dict;
-
-    for (const InjectionHandler& sampleHandler : sequenceHandler.getSequence()) {
-      const MetaDataHandler& mdh = sampleHandler.getMetaData();
-      std::map<std::string, float> validation_metrics = sampleHandler.getRawData().getValidationMetrics();
-      const std::string& sample_name = mdh.getSampleName();
-      if (sample_names.size() && sample_names.count(sample_name) == 0) 
-        continue;
-      if (sample_types.count(mdh.getSampleType()) == 0) 
-        continue;
-      data_dict.insert({ sample_name, std::map<Row,float,Row_less>() });
-      for (const std::string& meta_value_name : meta_data) {
-        // feature_map_history is not needed here as we are only interested in the current/"used" features
-        for (const OpenMS::Feature& feature : sampleHandler.getRawData().getFeatureMapHistory()) {
-          if (component_group_names.size() && component_group_names.count(feature.getMetaValue(s_PeptideRef).toString()) == 0)
-            continue;
-          if (feature.metaValueExists("used_")) {
-            const std::string used = feature.getMetaValue("used_").toString();
-            if (used.empty() || used[0] == 'f' || used[0] == 'F')
-              continue;
-          }
-
-          // Case #1 Features only
-          if (feature.getSubordinates().size() <= 0) {
-            const Row row_tuple_name(
-              feature.getMetaValue(s_PeptideRef).toString(),
-              "",
-              meta_value_name
-            );
-            CastValue datum;
-            if (meta_value_name == "accuracy" || meta_value_name == "n_features") {
-              datum = validation_metrics.at(meta_value_name);
-            }
-            else 
-            {
-              datum = SequenceHandler::getMetaValue(feature, feature, meta_value_name);
-            }
-            if (datum.getTag() == CastValue::Type::FLOAT && !std::isnan(datum.f_)) { // Skip NAN (replaced by 0 later)
-              data_dict[sample_name].emplace(row_tuple_name, datum.f_);
-              columns.insert(sample_name);
-              rows.insert(row_tuple_name);
-            }
-            else
-            {
-              data_dict[sample_name].emplace(row_tuple_name, 0.0f);
-              columns.insert(sample_name);
-              rows.insert(row_tuple_name);
-            }
-          }
-
-          // Case #2 Features and subordinates
-          for (const OpenMS::Feature& subordinate : feature.getSubordinates()) {
-            if (component_names.size() && component_names.count(subordinate.getMetaValue(s_native_id).toString()) == 0) 
-              continue;
-            if (subordinate.metaValueExists("used_")) {
-              const std::string used = subordinate.getMetaValue("used_").toString();
-              if (used.empty() || used[0] == 'f' || used[0] == 'F') 
-                continue;
-            }
-            const Row row_tuple_name(
-              feature.getMetaValue(s_PeptideRef).toString(),
-              subordinate.getMetaValue(s_native_id).toString(),
-              meta_value_name
-            );
-            CastValue datum;
-            if (meta_value_name == "accuracy" || meta_value_name == "n_features") {
-              datum = validation_metrics.at(meta_value_name);
-            }
-            else 
-            {
-              datum = SequenceHandler::getMetaValue(feature, subordinate, meta_value_name);
-            }
-            if (meta_value_name == "validation") {
-              if (datum.s_ == "TP") datum = static_cast<float>(1.0);
-              else if (datum.s_ == "FP") datum = static_cast<float>(-1.0);
-              else datum = static_cast<float>(-2.0);
-            }
-            if (datum.getTag() == CastValue::Type::FLOAT && !std::isnan(datum.f_)) { // Skip NAN (replaced by 0 later)
-              data_dict[sample_name].emplace(row_tuple_name, datum.f_);
-              columns.insert(sample_name);
-              rows.insert(row_tuple_name);
-            }
-            else
-            {
-              data_dict[sample_name].emplace(row_tuple_name, 0.0f);
-              columns.insert(sample_name);
-              rows.insert(row_tuple_name);
-            }
-          }
-        }
-      }
-    }
-
-    // Copy over the rows
-    rows_out.resize((int)rows.size(), 3);
-    int row = 0;
-    for (const auto& r: rows) {
-      rows_out(row, 0) = r.component_name;
-      rows_out(row, 1) = r.component_group_name;
-      rows_out(row, 2) = r.meta_value_name;
-      ++row;
-    }
-
-    // Copy over the columns
-    columns_out.resize((int)columns.size());
-    int col = 0;
-    for (const auto& c : columns) {
-      columns_out(col) = c;
-      ++col;
-    }
-
-    // Copy over the data
-    data_out.resize((int)rows.size(), (int)columns.size());
-    data_out.setConstant(0.0); // for now, initialize to 0 instead of NAN even though there are clear benefits to using NAN in packages that support NAN
-    col = 0;
-    for (const auto& c : columns) {
-      row = 0;
-      for (const auto& r : rows) {
-        if (data_dict.count(c) && data_dict[c].count(r)) {
-          data_out(row,col) = data_dict[c][r];
-        }
-        ++row;
-      }
-      ++col;
-    }
+    FeatureMatrixCache cache;
+    cache.makeDataMatrix(sequenceHandler, data_out, columns_out, rows_out, meta_data, sample_types,
+                         sample_names, component_group_names, component_names);
   }
 
   bool SequenceParser::writeDataMatrixFromMetaValue(
@@ -1201,6 +1101,7 @@ namespace SmartPeak
 
       data_dict.insert({ sample_name, std::map<Row,float,Row_less>() });
       for (const std::string& meta_value_name : meta_data) {
+        const SequenceHandler::MetaValueKey meta_value = SequenceHandler::resolveMetaValue(meta_value_name);
         // feature_map_history is not needed here as we are only interested in the current/"used" features
         for (const OpenMS::Feature& feature : sample_handler.getFeatureMap()) {
           if (component_group_names.size() && component_group_names.count(feature.getMetaValue(s_PeptideRef).toString()) == 0)
@@ -1219,7 +1120,7 @@ namespace SmartPeak
               meta_value_name
             );
             CastValue datum;
-            datum = SequenceHandler::getMetaValue(feature, feature, meta_value_name);
+            datum = SequenceHandler::getMetaValue(feature, feature, meta_value);
             if (datum.getTag() == CastValue::Type::FLOAT && !std::isnan(datum.f_)) { // Skip NAN (replaced by 0 later)
               data_dict[sample_name].emplace(row_tuple_name, datum.f_);
               columns.insert(sample_name);
@@ -1248,8 +1149,8 @@ namespace SmartPeak
               meta_value_name
             );
             CastValue datum;
-            datum = SequenceHandler::getMetaValue(feature, subordinate, meta_value_name);
-            if (meta_value_name == "validation") {
+            datum = SequenceHandler::getMetaValue(feature, subordinate, meta_value);
+            if (meta_value.field == SequenceHandler::MetaValueKey::Field::validation) {
               if (datum.s_ == "TP") datum = static_cast<float>(1.0);
               else if (datum.s_ == "FP") datum = static_cast<float>(-1.0);
               else datum = static_cast<float>(-2.0);
@@ -24,18 +24,85 @@
 #include <SmartPeak/io/SessionDB.h>
 #include <SmartPeak/core/Utilities.h>
 #include <plog/Log.h>
-#include <regex>
+#include <mutex>
+#include <unordered_map>
 
 namespace SmartPeak
 {
+  /**
+    Connections to a session file. Idle connections are kept open, along with the
+    statements prepared on them, instead of opening the file for each table.
+  */
+  struct SessionDB::ConnectionPool
+  {
+    struct Connection
+    {
+      sqlite3* db = nullptr;
+      std::unordered_map<std::string, sqlite3_stmt*> statements;
+    };
+
+    ~ConnectionPool()
+    {
+      for (auto& connection : idle)
+      {
+        close(*connection);
+      }
+      for (auto& connection : in_use)
+      {
+        LOGD << "Session DB connection still in use when closing " << session_file_name.generic_string();
+        close(*connection.second);
+      }
+    }
+
+    static void close(Connection& connection)
+    {
+      for (auto& statement : connection.statements)
+      {
+        sqlite3_finalize(statement.second);
+      }
+      connection.statements.clear();
+      sqlite3_close_v2(connection.db); // deferred until the statements not in the cache are finalized
+    }
+
+    static constexpr size_t max_idle = 4; ///< enough for the concurrent readers of a session load
+
+    std::filesystem::path session_file_name;
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Connection>> idle;
+    std::unordered_map<sqlite3*, std::unique_ptr<Connection>> in_use;
+
+    std::mutex session_info_mutex;
+    std::string smartpeak_version = "Unknown";
+    bool session_info_logged = false;
+  };
+
+  void SessionDB::setDBFilePath(std::filesystem::path session_file_name)
+  {
+    session_file_name_ = session_file_name;
+    connection_pool_ = std::make_shared<ConnectionPool>();
+    connection_pool_->session_file_name = session_file_name;
+  }
+
   std::optional<sqlite3*> SessionDB::openSessionDB()
   {
-    if (session_file_name_.empty())
+    if (session_file_name_.empty() || !connection_pool_)
     {
       LOGE << "Can't open database, path is empty";
       return std::nullopt;
     }
 
+    {
+      std::lock_guard<std::mutex> lock(connection_pool_->mutex);
+      if (!connection_pool_->idle.empty())
+      {
+        auto connection = std::move(connection_pool_->idle.back());
+        connection_pool_->idle.pop_back();
+        sqlite3* db = connection->db;
+        connection_pool_->in_use.emplace(db, std::move(connection));
+        return db;
+      }
+    }
+
     sqlite3* db = nullptr;
     int rc;
     rc = sqlite3_open(session_file_name_.generic_string().c_str(), &db);
@@ -43,24 +110,91 @@ namespace SmartPeak
     if (rc)
     {
       LOGE << "Can't open database (" << session_file_name_.generic_string() << ") : " << sqlite3_errmsg(db);
+      sqlite3_close(db);
       return std::nullopt;
     }
-    else
+    // other connections of the pool may be writing
+    sqlite3_busy_timeout(db, 5000);
+    auto connection = std::make_unique<ConnectionPool::Connection>();
+    connection->db = db;
+    std::lock_guard<std::mutex> lock(connection_pool_->mutex);
+    connection_pool_->in_use.emplace(db, std::move(connection));
+    return db;
+  }
+
+  void SessionDB::closeSessionDB(sqlite3* db)
+  {
+    if (!connection_pool_)
+    {
+      sqlite3_close(db);
+      return;
+    }
+    std::unique_ptr<ConnectionPool::Connection> connection;
     {
-      return db;
+      std::lock_guard<std::mutex> lock(connection_pool_->mutex);
+      auto it = connection_pool_->in_use.find(db);
+      if (it == connection_pool_->in_use.end())
+      {
+        return;
+      }
+      connection = std::move(it->second);
+      connection_pool_->in_use.erase(it);
+      if (connection_pool_->idle.size() < ConnectionPool::max_idle)
+      {
+        connection_pool_->idle.push_back(std::move(connection));
+        return;
+      }
     }
+    ConnectionPool::close(*connection);
   }
 
-  void SessionDB::closeSessionDB(sqlite3* db)
+  sqlite3_stmt* SessionDB::prepareCachedStatement(sqlite3* db, const std::string& sql)
   {
-    sqlite3_close(db);
+    ConnectionPool::Connection* connection = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(connection_pool_->mutex);
+      auto it = connection_pool_->in_use.find(db);
+      if (it != connection_pool_->in_use.end())
+      {
+        connection = it->second.get();
+      }
+    }
+    if (!connection)
+    {
+      return nullptr;
+    }
+    // the connection is not shared while in use, its statements can be accessed without lock
+    auto it = connection->statements.find(sql);
+    if (it != connection->statements.end())
+    {
+      return it->second;
+    }
+    sqlite3_stmt* stmt = nullptr;
+    const int rc = sqlite3_prepare_v2(db, sql.c_str(), static_cast<int>(sql.size()), &stmt, NULL);
+    if (rc != SQLITE_OK)
+    {
+      logSQLError(sqlite3_errmsg(db), sql);
+      sqlite3_finalize(stmt);
+      return nullptr;
+    }
+    connection->statements.emplace(sql, stmt);
+    return stmt;
   }
 
   void SessionDB::endRead(SessionDB::DBContext& db_context)
   {
     if (db_context.stmt)
     {
-      sqlite3_finalize(db_context.stmt);
+      if (db_context.cached_stmt)
+      {
+        // kept for the next read
+        sqlite3_reset(db_context.stmt);
+        sqlite3_clear_bindings(db_context.stmt);
+      }
+      else
+      {
+        sqlite3_finalize(db_context.stmt);
+      }
       db_context.stmt = nullptr;
     }
     closeSessionDB(db_context.db);
@@ -73,21 +207,92 @@ namespace SmartPeak
       sqlite3_finalize(db_context.stmt);
       db_context.stmt = nullptr;
     }
+    commitTransaction(db_context);
     closeSessionDB(db_context.db);
   }
 
+  bool SessionDB::beginTransaction(sqlite3* db)
+  {
+    char* zErrMsg = nullptr;
+    if (write_ahead_log_)
+    {
+      const std::string sql = "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL;";
+      if (sqlite3_exec(db, sql.c_str(), NULL, 0, &zErrMsg) != SQLITE_OK)
+      {
+        logSQLError(zErrMsg, sql);
+        sqlite3_free(zErrMsg);
+        zErrMsg = nullptr;
+        // -- not fatal, continue with the default journal
+      }
+    }
+    const std::string sql = "BEGIN TRANSACTION;";
+    if (sqlite3_exec(db, sql.c_str(), NULL, 0, &zErrMsg) != SQLITE_OK)
+    {
+      logSQLError(zErrMsg, sql);
+      sqlite3_free(zErrMsg);
+      return false;
+    }
+    return true;
+  }
+
+  bool SessionDB::commitTransaction(SessionDB::DBContext& db_context)
+  {
+    if (!db_context.in_transaction)
+    {
+      return true;
+    }
+    db_context.in_transaction = false;
+    char* zErrMsg = nullptr;
+    const std::string sql = "COMMIT;";
+    if (sqlite3_exec(db_context.db, sql.c_str(), NULL, 0, &zErrMsg) != SQLITE_OK)
+    {
+      logSQLError(zErrMsg, sql);
+      sqlite3_free(zErrMsg);
+      sqlite3_exec(db_context.db, "ROLLBACK;", NULL, 0, NULL);
+      return false;
+    }
+    return true;
+  }
+
+  void SessionDB::bindValue(sqlite3_stmt* stmt, int column, const std::string& value)
+  {
+    sqlite3_bind_text(stmt, column, value.c_str(), static_cast<int>(value.size()), SQLITE_STATIC);
+  }
+
+  void SessionDB::bindValue(sqlite3_stmt* stmt, int column, const char* value)
+  {
+    sqlite3_bind_text(stmt, column, value, -1, SQLITE_STATIC);
+  }
+
+  void SessionDB::bindTransientValue(sqlite3_stmt* stmt, int column, const std::string& value)
+  {
+    sqlite3_bind_text(stmt, column, value.c_str(), static_cast<int>(value.size()), SQLITE_TRANSIENT);
+  }
+
+  void SessionDB::bindValue(sqlite3_stmt* stmt, int column, double value)
+  {
+    sqlite3_bind_double(stmt, column, value);
+  }
+
+  void SessionDB::bindValue(sqlite3_stmt* stmt, int column, int64_t value)
+  {
+    sqlite3_bind_int64(stmt, column, value);
+  }
+
   void SessionDB::displaySessionInfo()
   {
-    if (!session_info_logged_)
+    std::lock_guard<std::mutex> lock(connection_pool_->session_info_mutex);
+    if (!connection_pool_->session_info_logged)
     {
-      LOGI << "Generated with SmartPeak Version: " << smartpeak_version_;
-      session_info_logged_ = true;
+      LOGI << "Generated with SmartPeak Version: " << connection_pool_->smartpeak_version;
+      connection_pool_->session_info_logged = true;
     }
   }
 
   void SessionDB::updateSessionInfo(sqlite3* db)
   {
-    if (smartpeak_version_ == "Unknown")
+    std::lock_guard<std::mutex> lock(connection_pool_->session_info_mutex);
+    if (connection_pool_->smartpeak_version == "Unknown")
     {
       int rc;
       sqlite3_stmt* stmt = nullptr;
@@ -103,7 +308,7 @@ namespace SmartPeak
         switch (sqlite3_step(stmt))
         {
         case SQLITE_ROW:
-          smartpeak_version_ = (const char*)sqlite3_column_text(stmt, 0);
+          connection_pool_->smartpeak_version = (const char*)sqlite3_column_text(stmt, 0);
           break;
         case SQLITE_DONE:
           break;
@@ -159,7 +364,7 @@ namespace SmartPeak
         sqlite3_free(zErrMsg);
         return;
       }
-      smartpeak_version_ = Utilities::getSmartPeakVersion();
+      connection_pool_->smartpeak_version = Utilities::getSmartPeakVersion();
     }
   }
 
@@ -193,14 +398,6 @@ namespace SmartPeak
     value = sqlite3_column_int(db_context.stmt, column);
   }
 
-template <>
-void SessionDB::write<std::string>(std::ostringstream& os, SessionDB::DBContext& db_context, const std::string& value)
-{
-  std::string escaped_string(value);
-  escaped_string = std::regex_replace(escaped_string, std::regex("\'"), "\'\'");
-  os << "'" << escaped_string << "'";
-}
-
 void SessionDB::logSQLError(const std::string& error_message, const std::string& sql_command) const
 {
   LOGE << "SQL Error: " << error_message;
@@ -236,28 +433,6 @@ std::string valueTypeToString(const CastValue::Type value_type)
   }
 }
 
-std::string castValueToSqlString(const CastValue& cast_value)
-{
-  switch (cast_value.getTag())
-  {
-  case CastValue::Type::BOOL:
-    return (cast_value.b_ ? "1" : "0");
-  case CastValue::Type::STRING:
-  case CastValue::Type::STRING_LIST:
-  {
-    std::string escaped_string(cast_value);
-    escaped_string = std::regex_replace(escaped_string, std::regex("\'"), "\'\'");
-    return std::string("'") + escaped_string + std::string("'");
-  }
-  case CastValue::Type::BOOL_LIST:
-  case CastValue::Type::FLOAT_LIST:
-  case CastValue::Type::INT_LIST:
-    return std::string("'") + std::string(cast_value) + std::string("'");
-  default:
-    return std::string(cast_value);
-  }
-}
-
 bool SessionDB::writePropertiesHandler(const IPropertiesHandler& properties_handler)
 {
   auto table_name = properties_handler.getPropertiesHandlerName();
@@ -280,14 +455,23 @@ bool SessionDB::writePropertiesHandler(const IPropertiesHandler& properties_hand
   db_context.table = table_name;
   db_context.db = *db;
 
+  if (!beginTransaction(*db))
+  {
+    closeSessionDB(*db);
+    return false;
+  }
+  db_context.in_transaction = true;
+
   // first, we delete table (to remove)
   os.str("");
-  os << "DROP TABLE ";
+  os << "DROP TABLE IF EXISTS ";
   os << "\"" << table_name << "\"";
   os << ";";
   std::string sql = os.str();
   rc = sqlite3_exec(*db, sql.c_str(), NULL, 0, &zErrMsg);
   // -- ignore error
+  sqlite3_free(zErrMsg);
+  zErrMsg = nullptr;
 
   // create table
   auto properties = properties_handler.getPropertiesSchema();
@@ -313,57 +497,88 @@ bool SessionDB::writePropertiesHandler(const IPropertiesHandler& properties_hand
   {
     logSQLError(zErrMsg, sql);
     sqlite3_free(zErrMsg);
+    endWrite(db_context);
     return false;
   }
 
-  // write data
+  // prepare the insertion, the values are bound for each row
   os.str("");
-  auto nb_rows = properties_handler.getNbRows();
-  for (size_t i = 0; i < nb_rows; ++i)
+  os << "INSERT INTO ";
+  os << "\"" << table_name << "\"";
+  separator = "";
+  os << " (";
+  for (const auto& [column_name, column_type] : properties)
   {
-    os << "INSERT INTO ";
-    os << "\"" << table_name << "\"";
-    separator = "";
-    os << " (";
-    for (const auto& [column_name, column_type] : properties)
-    {
-      os << separator;
-      os << "\"" << column_name << "\"";
-      separator = ", ";
-    }
-    os << ") ";
+    os << separator;
+    os << "\"" << column_name << "\"";
+    separator = ", ";
+  }
+  os << ") ";
+  os << "VALUES (";
+  separator = "";
+  for (size_t i = 0; i < properties.size(); ++i)
+  {
+    os << separator << "?";
+    separator = ", ";
+  }
+  os << "); ";
+  sql = os.str();
+  rc = sqlite3_prepare_v2(*db, sql.c_str(), static_cast<int>(sql.size()), &db_context.stmt, NULL);
+  if (rc != SQLITE_OK)
+  {
+    logSQLError(sqlite3_errmsg(*db), sql);
+    endWrite(db_context);
+    return false;
+  }
 
-    os << "VALUES (";
-    separator = "";
+  // write data
+  bool success = true;
+  auto nb_rows = properties_handler.getNbRows();
+  for (size_t i = 0; i < nb_rows && success; ++i)
+  {
+    int column = 1;
     for (const auto& [column_name, column_type] : properties)
     {
-      os << separator;
-      auto value = properties_handler.getProperty(column_name);
+      auto value = properties_handler.getProperty(column_name, i);
       if (value)
       {
-        os << castValueToSqlString(*value);
+        switch (value->getTag())
+        {
+        case CastValue::Type::BOOL:
+          bindValue(db_context.stmt, column, static_cast<int64_t>(value->b_ ? 1 : 0));
+          break;
+        case CastValue::Type::INT:
+          bindValue(db_context.stmt, column, static_cast<int64_t>(value->i_));
+          break;
+        case CastValue::Type::FLOAT:
+          bindValue(db_context.stmt, column, static_cast<double>(value->f_));
+          break;
+        default:
+          // the CastValue is a temporary
+          bindTransientValue(db_context.stmt, column, std::string(*value));
+          break;
+        }
       }
-      separator = ", ";
+      ++column;
     }
-    os << "); ";
-    std::string sql = os.str();
-    rc = sqlite3_exec(db_context.db, sql.c_str(), NULL, 0, &zErrMsg);
-    if (rc != SQLITE_OK) {
-      logSQLError(zErrMsg, sql);
-      sqlite3_free(zErrMsg);
-      return false;
+    rc = sqlite3_step(db_context.stmt);
+    if (rc != SQLITE_DONE) {
+      logSQLError(sqlite3_errmsg(db_context.db), sql);
+      success = false;
     }
+    sqlite3_reset(db_context.stmt);
+    sqlite3_clear_bindings(db_context.stmt);
   }
 
   // end write
-  if (db_context.stmt)
+  if (!success)
   {
-    sqlite3_finalize(db_context.stmt);
-    db_context.stmt = nullptr;
+    sqlite3_exec(db_context.db, "ROLLBACK;", NULL, 0, NULL);
+    db_context.in_transaction = false;
   }
-  closeSessionDB(db_context.db);
+  endWrite(db_context);
 
-  return true;
+  return success;
 }
 
 bool SessionDB::readPropertiesHandler(IPropertiesHandler& properties_handler)
@@ -372,7 +587,6 @@ bool SessionDB::readPropertiesHandler(IPropertiesHandler& properties_handler)
   LOGD << "Reading " << table_name << " from session db.";
 
   std::ostringstream os;
-  int rc;
   DBContext db_context;
 
   // open DB
@@ -393,12 +607,13 @@ bool SessionDB::readPropertiesHandler(IPropertiesHandler& properties_handler)
   os << "\"" << table_name << "\"";
   os << "; ";
   std::string sql = os.str();
-  rc = sqlite3_prepare(*db, sql.c_str(), sql.size(), &db_context.stmt, NULL);
-  if (rc != SQLITE_OK)
+  db_context.stmt = prepareCachedStatement(*db, sql);
+  if (!db_context.stmt)
   {
-    logSQLError(sqlite3_errmsg(*db), sql);
+    closeSessionDB(*db);
     return false;
   }
+  db_context.cached_stmt = true;
 
   // read rows
   auto properties = properties_handler.getPropertiesSchema();
@@ -466,17 +681,13 @@ bool SessionDB::readPropertiesHandler(IPropertiesHandler& properties_handler)
       break;
     default:
       logSQLError(sqlite3_errmsg(db_context.db));
+      endRead(db_context);
       return false;
     }
   }
 
   // end reading
-  if (db_context.stmt)
-  {
-    sqlite3_finalize(db_context.stmt);
-    db_context.stmt = nullptr;
-  }
-  closeSessionDB(db_context.db);
+  endRead(db_context);
   return true;
 }
 
@@ -1,4 +1,5 @@
 set(core_executables_list
+	AccurateMassSearchEngineRegistry_test
 	ApplicationManager_test
 	ApplicationHandler_test
 	ApplicationProcessor_test
@@ -7,10 +8,14 @@ set(core_executables_list
 	ConsoleHandler_test
 	EventDispatcher_test
 	FeatureFiltersUtils_test
+	FeatureMatrixCache_test
+	FeatureTable_test
 	Filenames_test  
 	ImEntry_test
 	InjectionHandler_test
 	MetaDataHandler_test
+	MPSCRingBuffer_test
+	ParameterSchemaCache_test
 	Parameters_test
 	ParametersObservable_test
 	ProgressInfo_test
@@ -22,15 +27,21 @@ set(core_executables_list
 	SequenceProcessor_test
 	SequenceSegmentHandler_test
 	SequenceSegmentProcessor_test
+	SeriesPyramid_test
 	SessionDB_test
+	SpectralLibraryCache_test
 	Server_test
+	ServerAppender_test
 	SessionHandler_test
 	SessionLoaderGenerator_test
 	Task_test
+	ThreadPool_test
 	UIUtilities_test
 	Utilities_test
 	WorkflowObservable_test
 	WorkflowManager_test
+	WorkflowScheduler_test
+	WorkflowService_test
 )
 
 set(io_executables_list
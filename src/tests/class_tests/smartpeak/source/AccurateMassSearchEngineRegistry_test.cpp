@@ -0,0 +1,87 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <gtest/gtest.h>
+#include <SmartPeak/core/AccurateMassSearchEngineRegistry.h>
+
+#include <thread>
+
+using namespace SmartPeak;
+
+TEST(AccurateMassSearchEngineRegistry, getEngine)
+{
+  AccurateMassSearchEngineRegistry registry;
+  OpenMS::Param parameters = OpenMS::AccurateMassSearchEngine().getParameters();
+  auto engine1 = registry.getEngine(parameters);
+  auto engine2 = registry.getEngine(parameters);
+  ASSERT_NE(engine1, nullptr);
+  EXPECT_EQ(engine1, engine2);
+  EXPECT_EQ(registry.size(), 1);
+
+  // another configuration
+  parameters.setValue("mass_error_value", 10.0);
+  auto engine3 = registry.getEngine(parameters);
+  EXPECT_NE(engine1, engine3);
+  EXPECT_EQ(registry.size(), 2);
+
+  registry.clear();
+  EXPECT_EQ(registry.size(), 0);
+}
+
+TEST(AccurateMassSearchEngineRegistry, max_engines)
+{
+  AccurateMassSearchEngineRegistry registry(1);
+  OpenMS::Param parameters = OpenMS::AccurateMassSearchEngine().getParameters();
+  auto engine1 = registry.getEngine(parameters);
+  parameters.setValue("mass_error_value", 10.0);
+  auto engine2 = registry.getEngine(parameters);
+  EXPECT_EQ(registry.size(), 1);
+  EXPECT_EQ(registry.getEngine(parameters), engine2);
+  // the released engine stays valid for its users
+  ASSERT_NE(engine1, nullptr);
+  EXPECT_EQ(engine1->getParameters().getValue("mass_error_value"), OpenMS::AccurateMassSearchEngine().getParameters().getValue("mass_error_value"));
+}
+
+TEST(AccurateMassSearchEngineRegistry, concurrent_getEngine)
+{
+  AccurateMassSearchEngineRegistry registry;
+  const OpenMS::Param parameters = OpenMS::AccurateMassSearchEngine().getParameters();
+  const size_t n_threads = 4;
+  std::vector<std::shared_ptr<SharedAccurateMassSearchEngine>> engines(n_threads);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < n_threads; ++i)
+  {
+    threads.emplace_back([&, i]() { engines[i] = registry.getEngine(parameters); });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  for (const auto& engine : engines)
+  {
+    ASSERT_NE(engine, nullptr);
+    EXPECT_EQ(engine, engines.front());
+  }
+  EXPECT_EQ(registry.size(), 1);
+}
@@ -0,0 +1,473 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+/**
+  Benchmarks of the performance sensitive parts of SmartPeak.
+
+  They are built along with the class tests but are not run by ctest.
+  Run them all with `Benchmarks`, or some of them with e.g.
+  `Benchmarks --gtest_filter=Benchmarks.ThreadPoolSpawnOverhead`.
+*/
+
+#include <gtest/gtest.h>
+#include <SmartPeak/test_config.h>
+#include <SmartPeak/core/FeatureMetadata.h>
+#include <SmartPeak/core/FeatureTable.h>
+#include <SmartPeak/core/Filenames.h>
+#include <SmartPeak/core/RawDataHandler.h>
+#include <SmartPeak/core/SequenceHandler.h>
+#include <SmartPeak/core/ThreadPool.h>
+#include <SmartPeak/core/RawDataProcessors/FitFeaturesEMG.h>
+#include <SmartPeak/core/RawDataProcessors/LoadFeatures.h>
+#include <SmartPeak/core/RawDataProcessors/MergeSpectra.h>
+#include <SmartPeak/core/SampleGroupProcessors/MergeInjections.h>
+#include <SmartPeak/io/CSVWriter.h>
+#include <SmartPeak/io/SequenceParser.h>
+#include <SmartPeak/io/SessionDB.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace SmartPeak;
+
+namespace
+{
+  /**
+    @brief Runs a function once and returns its duration in milliseconds.
+  */
+  template <typename F>
+  double measure(F&& f)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  void report(const std::string& label, double ms)
+  {
+    std::cout << "  " << std::left << std::setw(48) << label
+      << std::right << std::fixed << std::setprecision(3) << std::setw(12) << ms << " ms" << std::endl;
+  }
+
+  /**
+    @brief A sequence of the given number of unknown injections, built from the
+    features of the test injections of SequenceParser_test.
+  */
+  SequenceHandler makeTestSequence(int n_injections)
+  {
+    const std::vector<std::string> sample_names = {
+      "170808_Jonathan_yeast_Sacc1_1x",
+      "170808_Jonathan_yeast_Sacc2_1x",
+      "170808_Jonathan_yeast_Sacc3_1x",
+      "170808_Jonathan_yeast_Yarr1_1x",
+      "170808_Jonathan_yeast_Yarr2_1x",
+      "170808_Jonathan_yeast_Yarr3_1x"
+    };
+    std::vector<OpenMS::FeatureMap> feature_maps;
+    for (const std::string& sample_name : sample_names)
+    {
+      MetaDataHandler metaDataHandler;
+      metaDataHandler.setSampleName(sample_name);
+      metaDataHandler.setSequenceSegmentName("sequence_segment");
+      metaDataHandler.batch_name = "FluxTest";
+      metaDataHandler.inj_number = static_cast<int>(feature_maps.size()) + 1;
+      Filenames filenames;
+      filenames.setFullPath("featureXML_i", SMARTPEAK_GET_TEST_DATA_PATH(metaDataHandler.getInjectionName() + ".featureXML"));
+      RawDataHandler rawDataHandler;
+      LoadFeatures loadFeatures;
+      loadFeatures.process(rawDataHandler, {}, filenames);
+      feature_maps.push_back(rawDataHandler.getFeatureMap());
+    }
+
+    SequenceHandler sequence_handler;
+    for (int i = 0; i < n_injections; ++i)
+    {
+      MetaDataHandler metaDataHandler;
+      metaDataHandler.setSampleName("sample_" + std::to_string(i));
+      metaDataHandler.setFilename("sample_" + std::to_string(i) + ".mzML");
+      metaDataHandler.setSampleType(SampleType::Unknown);
+      metaDataHandler.setSampleGroupName("sample_group");
+      metaDataHandler.setSequenceSegmentName("sequence_segment");
+      metaDataHandler.setReplicateGroupName("replicate_group_name");
+      metaDataHandler.inj_number = i + 1;
+      metaDataHandler.batch_name = "BatchName";
+      sequence_handler.addSampleToSequence(metaDataHandler, feature_maps.at(i % feature_maps.size()));
+    }
+    return sequence_handler;
+  }
+
+  std::vector<std::string> benchmarkMetaData()
+  {
+    std::vector<std::string> meta_data;
+    for (const auto& m : { FeatureMetadata::peak_apex_intensity, FeatureMetadata::peak_area, FeatureMetadata::retention_time,
+      FeatureMetadata::log_signal_to_noise, FeatureMetadata::integration_left_boundary, FeatureMetadata::integration_right_boundary,
+      FeatureMetadata::calculated_concentration, FeatureMetadata::qc_transition_pass })
+    {
+      meta_data.push_back(metadataToString.at(m));
+    }
+    return meta_data;
+  }
+}
+
+TEST(Benchmarks, ThreadPoolSpawnOverhead)
+{
+  // the per-item std::async scheme previously used by the sequence processors, against the shared pool
+  const int n_items = 5000;
+  std::atomic_int count { 0 };
+  auto short_step = [&count]() { ++count; };
+
+  const double async_time = measure([&]() {
+    for (int i = 0; i < n_items; ++i)
+    {
+      std::future<void> f = std::async(std::launch::async, short_step);
+      f.wait();
+    }
+  });
+
+  ThreadPool& pool = ThreadPool::instance();
+  const double pool_time = measure([&]() {
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < n_items; ++i)
+    {
+      futures.emplace_back(pool.submit(short_step));
+    }
+    for (std::future<void>& f : futures)
+    {
+      pool.wait(f);
+    }
+  });
+
+  EXPECT_EQ(count, 2 * n_items);
+  std::cout << n_items << " short steps" << std::endl;
+  report("std::async per item", async_time);
+  report("ThreadPool", pool_time);
+}
+
+TEST(Benchmarks, MergeSpectra)
+{
+  // synthetic FIA-MS full scans
+  const size_t n_spectra = 200;
+  const size_t n_peaks = 20000;
+  std::vector<OpenMS::MSSpectrum> spectra(n_spectra);
+  for (size_t s = 0; s < n_spectra; ++s)
+  {
+    spectra[s].setRT(s * 0.5);
+    for (size_t p = 0; p < n_peaks; ++p)
+    {
+      OpenMS::Peak1D peak;
+      peak.setMZ(50.0 + p * (1450.0 / n_peaks) + s * 1e-5);
+      peak.setIntensity(1000.0 + (p * 7919 + s * 104729) % 5000);
+      spectra[s].push_back(peak);
+    }
+  }
+  RawDataHandler rawDataHandler;
+  rawDataHandler.getExperiment().setSpectra(spectra);
+
+  ParameterSet params;
+  MergeSpectra mergeSpectra;
+  Filenames filenames;
+  const double elapsed = measure([&]() { mergeSpectra.process(rawDataHandler, params, filenames); });
+  ASSERT_EQ(rawDataHandler.getExperiment().getSpectra().size(), 1);
+  EXPECT_GT(rawDataHandler.getExperiment().getSpectra().front().size(), 0);
+  std::cout << n_spectra << " spectra of " << n_peaks << " peaks" << std::endl;
+  report("MergeSpectra", elapsed);
+}
+
+TEST(Benchmarks, FitFeaturesEMG)
+{
+  // synthetic MRM method of 500 transitions, 3 transitions per feature
+  const size_t n_transitions = 500;
+  const size_t n_points = 200;
+  RawDataHandler rawDataHandler;
+  std::vector<OpenMS::MSChromatogram> chromatograms(n_transitions);
+  OpenMS::FeatureMap& featureMap = rawDataHandler.getFeatureMap();
+  for (size_t t = 0; t < n_transitions; ++t)
+  {
+    const std::string native_id = "transition_" + std::to_string(t);
+    const double apex = 100.0 + (t % 50) * 10.0;
+    chromatograms[t].setNativeID(native_id);
+    for (size_t p = 0; p < n_points; ++p)
+    {
+      const double rt = apex - 10.0 + p * (20.0 / n_points);
+      const double intensity = 1e5 * std::exp(-0.5 * std::pow((rt - apex) / 1.5, 2));
+      chromatograms[t].push_back(OpenMS::ChromatogramPeak(rt, intensity));
+    }
+    if (t % 3 == 0)
+    {
+      OpenMS::Feature feature;
+      feature.setMetaValue("leftWidth", apex - 5.0);
+      feature.setMetaValue("rightWidth", apex + 5.0);
+      featureMap.push_back(feature);
+    }
+    OpenMS::Feature subordinate;
+    subordinate.setMetaValue("native_id", native_id);
+    featureMap.back().getSubordinates().push_back(subordinate);
+  }
+  rawDataHandler.getChromatogramMap().setChromatograms(chromatograms);
+
+  ParameterSet params;
+  FitFeaturesEMG emg;
+  Filenames filenames;
+  const double elapsed = measure([&]() { emg.process(rawDataHandler, params, filenames); });
+  ASSERT_EQ(rawDataHandler.getFeatureMap().size(), (n_transitions + 2) / 3);
+  EXPECT_GT(rawDataHandler.getFeatureMap()[0].getSubordinates()[0].getIntensity(), 0);
+  std::cout << n_transitions << " transitions" << std::endl;
+  report("FitFeaturesEMG", elapsed);
+}
+
+TEST(Benchmarks, MergeInjections)
+{
+  // 100 injections: 2 scan polarities x 2 mass ranges x 25 dilutions, 300 components
+  const size_t n_injections = 100;
+  const size_t n_features = 100;
+  SequenceHandler sequenceHandler;
+  for (size_t i = 0; i < n_injections; ++i)
+  {
+    OpenMS::FeatureMap feature_map;
+    for (size_t f = 0; f < n_features; ++f)
+    {
+      OpenMS::Feature mrm_feature;
+      mrm_feature.setMetaValue("PeptideRef", "component" + std::to_string(f));
+      std::vector<OpenMS::Feature> subordinates;
+      for (size_t s = 0; s < 3; ++s)
+      {
+        OpenMS::Feature subordinate;
+        subordinate.setMetaValue("native_id", "component" + std::to_string(f) + "_" + std::to_string(s));
+        subordinate.setMetaValue("peak_apex_int", 1000.0 + (i * 7919 + f * 104729 + s) % 5000);
+        subordinate.setMetaValue("QC_transition_score", 0.5 + ((i + f + s) % 10) * 0.05);
+        subordinate.setMetaValue("calculated_concentration", 0.1 * ((i * f + s) % 20));
+        subordinate.setRT(60.0 + f);
+        subordinate.setMZ(100.0 + f);
+        subordinates.push_back(subordinate);
+      }
+      mrm_feature.setSubordinates(subordinates);
+      feature_map.push_back(mrm_feature);
+    }
+    MetaDataHandler meta_data;
+    meta_data.setSampleName("sample" + std::to_string(i));
+    meta_data.setSampleGroupName("group1");
+    meta_data.setSampleType(SampleType::Unknown);
+    meta_data.setFilename("filename" + std::to_string(i));
+    meta_data.setSequenceSegmentName("segment1");
+    meta_data.scan_polarity = (i % 2 == 0) ? "positive" : "negative";
+    meta_data.scan_mass_low = ((i / 2) % 2 == 0) ? 50 : 200;
+    meta_data.scan_mass_high = ((i / 2) % 2 == 0) ? 200 : 2000;
+    meta_data.dilution_factor = static_cast<float>(1 + i / 4);
+    sequenceHandler.addSampleToSequence(meta_data, OpenMS::FeatureMap());
+    RawDataHandler rawDataHandler;
+    rawDataHandler.setFeatureMap(feature_map);
+    sequenceHandler.getSequence().at(i).setRawData(rawDataHandler);
+  }
+  SampleGroupHandler sampleGroupHandler = sequenceHandler.getSampleGroups().front();
+
+  MergeInjections sampleGroupProcessor;
+  Filenames filenames;
+  const double elapsed = measure([&]() {
+    sampleGroupProcessor.process(sampleGroupHandler, sequenceHandler, sampleGroupProcessor.getParameterSchema(), filenames);
+  });
+  EXPECT_EQ(sampleGroupHandler.getFeatureMap().size(), n_features);
+  std::cout << n_injections << " injections of " << n_features << " features" << std::endl;
+  report("MergeInjections", elapsed);
+}
+
+TEST(Benchmarks, UpdateFeatureMapHistory)
+{
+  // the time per feature should stay flat
+  for (const size_t n_features : { 1000, 5000, 10000 })
+  {
+    OpenMS::FeatureMap feature_map;
+    for (size_t i = 0; i < n_features; ++i)
+    {
+      OpenMS::Feature feature;
+      feature.setUniqueId(i + 1);
+      feature.setMetaValue("PeptideRef", "component_group_" + std::to_string(i));
+      std::vector<OpenMS::Feature> subordinates(3);
+      for (size_t j = 0; j < subordinates.size(); ++j)
+      {
+        subordinates[j].setUniqueId((i + 1) * 10 + j);
+        subordinates[j].setMetaValue("native_id", "component_" + std::to_string(i) + "_" + std::to_string(j));
+      }
+      feature.setSubordinates(subordinates);
+      feature_map.push_back(feature);
+    }
+    RawDataHandler rawDataHandler;
+    rawDataHandler.setFeatureMap(feature_map);
+    rawDataHandler.updateFeatureMapHistory();
+
+    // filter out every other feature and one subordinate of the others
+    OpenMS::FeatureMap selected;
+    for (size_t i = 0; i < feature_map.size(); i += 2)
+    {
+      selected.push_back(feature_map[i]);
+      selected.back().getSubordinates().pop_back();
+    }
+    rawDataHandler.setFeatureMap(selected);
+    const double elapsed = measure([&]() { rawDataHandler.updateFeatureMapHistory(); });
+    EXPECT_EQ(rawDataHandler.getFeatureMapHistory().size(), n_features);
+    report("updateFeatureMapHistory, " + std::to_string(n_features) + " features", elapsed);
+    report("  per feature", elapsed / n_features);
+  }
+}
+
+TEST(Benchmarks, SessionDBWrite)
+{
+  // the previous one autocommit INSERT per row against the prepared statement,
+  // on a large feature filter like table
+  const size_t n_rows = 100000;
+  auto path_db = std::tmpnam(nullptr);
+
+  // extrapolated, too slow for all the rows
+  const double autocommit_time = 100 * measure([&]() {
+    sqlite3* db = nullptr;
+    ASSERT_EQ(sqlite3_open(path_db, &db), SQLITE_OK);
+    sqlite3_exec(db, "CREATE TABLE autocommit (ID INTEGER PRIMARY KEY, component_name TEXT NOT NULL, l REAL NOT NULL, u REAL NOT NULL);", NULL, 0, NULL);
+    for (size_t i = 0; i < n_rows / 100; ++i)
+    {
+      std::ostringstream os;
+      os << "INSERT INTO autocommit (component_name, l, u) VALUES ('component_" << i << "', '" << i * 0.5 << "', '" << i * 2.0 << "');";
+      sqlite3_exec(db, os.str().c_str(), NULL, 0, NULL);
+    }
+    sqlite3_close(db);
+  });
+
+  auto write_table = [&](SessionDB& session_db) {
+    auto context = session_db.beginWrite("prepared", "component_name", "TEXT", "l", "REAL", "u", "REAL");
+    ASSERT_TRUE(context);
+    for (size_t i = 0; i < n_rows; ++i)
+    {
+      session_db.write(*context, "component_" + std::to_string(i), i * 0.5, i * 2.0);
+    }
+    session_db.endWrite(*context);
+  };
+  SessionDB session_db;
+  session_db.setDBFilePath(path_db);
+  const double prepared_time = measure([&]() { write_table(session_db); });
+  session_db.setWriteAheadLog(true);
+  const double wal_time = measure([&]() { write_table(session_db); });
+
+  std::cout << n_rows << " rows" << std::endl;
+  report("autocommit (extrapolated)", autocommit_time);
+  report("prepared", prepared_time);
+  report("prepared, WAL", wal_time);
+}
+
+TEST(Benchmarks, CSVWriterFeatureTable)
+{
+  // the previous one open per row against the buffered and the async writers, on a 1M rows feature table
+  const std::string filename = SMARTPEAK_GET_TEST_DATA_PATH("output/CSVWriterTest_benchmark.csv");
+  const size_t n_rows = 1000000;
+  std::vector<std::string> row = { "sample_name", "component_group_name", "component_name", "peak_apex_int", "0.123456", "1.5", "true" };
+
+  // extrapolated, the previous behaviour is too slow for 1M rows
+  const double reopen_time = 100 * measure([&]() {
+    for (size_t i = 0; i < n_rows / 100; ++i)
+    {
+      std::ofstream ofs(filename, i ? std::ios::app : std::ios::trunc);
+      ofs << row[0];
+      for (size_t j = 1; j < row.size(); ++j) ofs << "," << row[j];
+      ofs << "\n";
+    }
+  });
+  const double buffered_time = measure([&]() {
+    CSVWriter csvwriter(filename);
+    for (size_t i = 0; i < n_rows; ++i) csvwriter.writeDataInRow(row.cbegin(), row.cend());
+  });
+  const double async_time = measure([&]() {
+    CSVWriter csvwriter(filename);
+    csvwriter.setAsync(true);
+    for (size_t i = 0; i < n_rows; ++i) csvwriter.writeDataInRow(row.cbegin(), row.cend());
+  });
+
+  std::cout << n_rows << " rows" << std::endl;
+  report("open per row (extrapolated)", reopen_time);
+  report("buffered", buffered_time);
+  report("async", async_time);
+}
+
+TEST(Benchmarks, MakeFeatureTableFromMetaValue)
+{
+  const SequenceHandler sequence_handler = makeTestSequence(1000);
+  const std::vector<std::string> meta_data = benchmarkMetaData();
+  const std::set<SampleType> sample_types = { SampleType::Unknown };
+
+  FeatureTable table;
+  const double table_time = measure([&]() {
+    SequenceParser::makeFeatureTableFromMetaValue(sequence_handler, table, meta_data, sample_types, {}, {}, {});
+  });
+  std::vector<std::vector<std::string>> rows;
+  std::vector<std::string> headers;
+  const double rows_time = measure([&]() {
+    SequenceParser::makeDataTableFromMetaValue(sequence_handler, rows, headers, meta_data, sample_types, {}, {}, {});
+  });
+  EXPECT_EQ(rows.size(), table.getNRows());
+  std::cout << table.getNRows() << " rows" << std::endl;
+  report("typed table", table_time);
+  report("string table", rows_time);
+}
+
+TEST(Benchmarks, GetMetaValue)
+{
+  const SequenceHandler sequence_handler = makeTestSequence(100);
+  std::vector<std::string> meta_data = benchmarkMetaData();
+  meta_data.push_back("RT");
+  meta_data.push_back("absent_meta_value");
+
+  size_t n_by_name = 0;
+  const double name_time = measure([&]() {
+    for (const auto& injection : sequence_handler.getSequence()) {
+      for (const OpenMS::Feature& feature : injection.getRawData().getFeatureMapHistory()) {
+        for (const OpenMS::Feature& subordinate : feature.getSubordinates()) {
+          for (const std::string& meta_value : meta_data) {
+            n_by_name += SequenceHandler::getMetaValue(feature, subordinate, meta_value).getTag() != CastValue::Type::STRING;
+          }
+        }
+      }
+    }
+  });
+  size_t n_by_key = 0;
+  const double key_time = measure([&]() {
+    const std::vector<SequenceHandler::MetaValueKey> keys = SequenceHandler::resolveMetaValues(meta_data);
+    for (const auto& injection : sequence_handler.getSequence()) {
+      for (const OpenMS::Feature& feature : injection.getRawData().getFeatureMapHistory()) {
+        for (const OpenMS::Feature& subordinate : feature.getSubordinates()) {
+          for (const SequenceHandler::MetaValueKey& key : keys) {
+            n_by_key += SequenceHandler::getMetaValue(feature, subordinate, key).getTag() != CastValue::Type::STRING;
+          }
+        }
+      }
+    }
+  });
+  EXPECT_EQ(n_by_name, n_by_key);
+  std::cout << n_by_key << " values" << std::endl;
+  report("by name", name_time);
+  report("resolved once", key_time);
+}
@@ -28,6 +28,7 @@
 #define CSV_IO_NO_THREAD
 #endif
 #include <SmartPeak/io/csv.h>
+#include <fstream>
 
 using namespace SmartPeak;
 using namespace std;
@@ -82,6 +83,7 @@ TEST(CSVWriter, writeDataInRow)
   cnt = csvwriter.writeDataInRow(line.begin(), line.end());
   ASSERT_TRUE(cnt);
   EXPECT_EQ(*cnt, 3);
+  csvwriter.flush();
 
   // Read the data back in
   io::CSVReader<3> test_in(filename);
@@ -98,3 +100,67 @@ TEST(CSVWriter, writeDataInRow)
   EXPECT_STREQ(col2.c_str(), "2");
   EXPECT_STREQ(col3.c_str(), "3");
 }
+
+TEST(CSVWriter, writeDataInRow_numbers)
+{
+  const std::string filename = SMARTPEAK_GET_TEST_DATA_PATH("output/CSVWriterTest_numbers.csv");
+  {
+    CSVWriter csvwriter(filename, ";");
+    const std::vector<int> ints = { -1, 0, 42 };
+    const std::vector<double> doubles = { 0.5, 1234567.0, 1.0 / 3.0 };
+    const std::vector<const char*> chars = { "x", "y" };
+    EXPECT_EQ(*csvwriter.writeDataInRow(ints.begin(), ints.end()), 3);
+    EXPECT_EQ(*csvwriter.writeDataInRow(doubles.begin(), doubles.end()), 3);
+    EXPECT_EQ(*csvwriter.writeDataInRow(chars.begin(), chars.end()), 2);
+  }
+  std::ifstream ifs(filename);
+  std::string line;
+  std::getline(ifs, line);
+  EXPECT_STREQ(line.c_str(), "-1;0;42");
+  std::getline(ifs, line);
+  EXPECT_STREQ(line.c_str(), "0.5;1.23457e+06;0.333333");
+  std::getline(ifs, line);
+  EXPECT_STREQ(line.c_str(), "x;y");
+}
+
+TEST(CSVWriter, writeDataInRow_async)
+{
+  const std::string filename = SMARTPEAK_GET_TEST_DATA_PATH("output/CSVWriterTest_async.csv");
+  CSVWriter csvwriter(filename);
+  csvwriter.setAsync(true);
+  csvwriter.setBufferSize(16); // hand over almost every row to the background thread
+  const std::vector<std::string> headers = { "Column1", "Column2" };
+  csvwriter.writeDataInRow(headers.begin(), headers.end());
+  for (int i = 0; i < 1000; ++i)
+  {
+    const std::vector<int> line = { i, 2 * i };
+    csvwriter.writeDataInRow(line.begin(), line.end());
+  }
+  EXPECT_EQ(csvwriter.getLineCount(), 1001);
+  csvwriter.flush();
+
+  io::CSVReader<2> test_in(filename);
+  test_in.read_header(io::ignore_extra_column, "Column1", "Column2");
+  int col1, col2, n_rows = 0;
+  while (test_in.read_row(col1, col2))
+  {
+    EXPECT_EQ(col1, n_rows);
+    EXPECT_EQ(col2, 2 * n_rows);
+    ++n_rows;
+  }
+  EXPECT_EQ(n_rows, 1000);
+
+  // closing and writing again appends to the file
+  csvwriter.close();
+  const std::vector<int> line = { 1000, 2000 };
+  csvwriter.writeDataInRow(line.begin(), line.end());
+  csvwriter.close();
+  io::CSVReader<2> test_in2(filename);
+  test_in2.read_header(io::ignore_extra_column, "Column1", "Column2");
+  n_rows = 0;
+  while (test_in2.read_row(col1, col2))
+  {
+    ++n_rows;
+  }
+  EXPECT_EQ(n_rows, 1001);
+}
@@ -26,6 +26,9 @@
 #include <SmartPeak/test_config.h>
 #include <SmartPeak/core/EventDispatcher.h>
 
+#include <atomic>
+#include <thread>
+
 namespace std
 {
   std::ostream& operator<<(ostream& os, const tuple<string, size_t, string, std::vector<std::string> > t)
@@ -277,3 +280,119 @@ TEST_F(EventDispatcherFixture, dispatchEvents)
 
   EXPECT_THAT(event_displatcher_observer.events_, ::testing::ContainerEq(expected_commands));
 }
+
+TEST(EventDispatcher, concurrentEvents)
+{
+  // small capacity: the producers have to wait for the events to be dispatched
+  EventDispatcher event_dispatcher(16);
+  EventDispatcherFixture::EventDispatcherObserver observer;
+  event_dispatcher.addSequenceProcessorObserver(&observer);
+
+  const size_t n_threads = 8;
+  const size_t n_events = 2000;
+  std::atomic<size_t> n_done = 0;
+  std::vector<std::thread> threads;
+  for (size_t thread = 0; thread < n_threads; ++thread)
+  {
+    threads.emplace_back([&, thread]() {
+      for (size_t i = 0; i < n_events; ++i)
+      {
+        event_dispatcher.onSequenceProcessorStart(thread * n_events + i);
+      }
+      ++n_done;
+    });
+  }
+  while (n_done < n_threads)
+  {
+    event_dispatcher.dispatchEvents();
+    std::this_thread::yield();
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  event_dispatcher.dispatchEvents();
+
+  // no event is lost or reordered for a given thread
+  EXPECT_EQ(event_dispatcher.getNbDroppedEvents(), 0);
+  ASSERT_EQ(observer.events_.size(), n_threads * n_events);
+  std::vector<size_t> next(n_threads, 0);
+  for (const auto& event : observer.events_)
+  {
+    const size_t index = std::get<1>(event);
+    const size_t thread = index / n_events;
+    ASSERT_LT(thread, n_threads);
+    EXPECT_EQ(index % n_events, next[thread]);
+    ++next[thread];
+  }
+}
+
+TEST(EventDispatcher, stalledDispatcher)
+{
+  // the events are not dispatched while a worker fills the ring
+  EventDispatcher event_dispatcher(4, std::chrono::milliseconds(50));
+  EventDispatcherFixture::EventDispatcherObserver observer;
+  event_dispatcher.addApplicationProcessorObserver(&observer);
+  event_dispatcher.addSequenceProcessorObserver(&observer);
+  event_dispatcher.addSequenceObserver(&observer);
+
+  std::thread worker([&]() {
+    for (const std::string sample_name : { "sample1", "sample2", "sample3", "sample4" })
+    {
+      event_dispatcher.onSequenceProcessorSampleStart(sample_name);
+    }
+    event_dispatcher.onSequenceProcessorEnd();
+    event_dispatcher.onSequenceProcessorSampleStart("sample5");
+    event_dispatcher.onSequenceUpdated();
+    event_dispatcher.onSequenceUpdated();
+    event_dispatcher.onSequenceProcessorError("sample5", "processor1", "error1");
+    event_dispatcher.onApplicationProcessorEnd();
+  });
+  worker.join();
+  event_dispatcher.dispatchEvents();
+
+  // only the progress events are dropped, the updates are coalesced
+  std::vector<std::tuple<std::string, size_t, std::string, std::vector<std::string>>> expected_events =
+  {
+    {"onSequenceProcessorSampleStart",0,"sample1", std::vector<std::string>()},
+    {"onSequenceProcessorSampleStart",0,"sample2", std::vector<std::string>()},
+    {"onSequenceProcessorSampleStart",0,"sample3", std::vector<std::string>()},
+    {"onSequenceProcessorSampleStart",0,"sample4", std::vector<std::string>()},
+    {"onSequenceProcessorEnd",0,"", std::vector<std::string>()},
+    {"onSequenceUpdated",0,"", std::vector<std::string>()},
+    {"onSequenceProcessorError",0,"sample5", std::vector<std::string>({"processor1","error1"})},
+    {"onApplicationProcessorEnd",0,"", std::vector<std::string>()},
+  };
+  EXPECT_THAT(observer.events_, ::testing::ContainerEq(expected_events));
+  EXPECT_EQ(event_dispatcher.getNbDroppedEvents(), 1);
+
+  // the events go through the ring again once dispatched
+  event_dispatcher.onSequenceProcessorSampleStart("sample6");
+  event_dispatcher.onSequenceUpdated();
+  event_dispatcher.dispatchEvents();
+  ASSERT_EQ(observer.events_.size(), expected_events.size() + 2);
+  EXPECT_EQ(std::get<2>(observer.events_[expected_events.size()]), "sample6");
+  EXPECT_EQ(event_dispatcher.getNbDroppedEvents(), 1);
+}
+
+TEST(EventDispatcher, waitForEvents)
+{
+  EventDispatcher event_dispatcher;
+  EventDispatcherFixture::EventDispatcherObserver observer;
+  event_dispatcher.addSequenceProcessorObserver(&observer);
+
+  EXPECT_FALSE(event_dispatcher.waitForEvents(std::chrono::milliseconds(10)));
+
+  // the dispatcher thread wakes up when a worker stores an event
+  const size_t n_events = 100;
+  for (size_t i = 0; i < n_events; ++i)
+  {
+    std::thread worker([&, i]() { event_dispatcher.onSequenceProcessorStart(i); });
+    EXPECT_TRUE(event_dispatcher.waitForEvents(std::chrono::milliseconds(10000)));
+    worker.join();
+    event_dispatcher.dispatchEvents();
+  }
+  EXPECT_FALSE(event_dispatcher.waitForEvents(std::chrono::milliseconds(10)));
+  ASSERT_EQ(observer.events_.size(), n_events);
+  EXPECT_EQ(std::get<1>(observer.events_.back()), n_events - 1);
+}
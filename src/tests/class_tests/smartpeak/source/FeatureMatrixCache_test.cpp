@@ -0,0 +1,193 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <gtest/gtest.h>
+#include <SmartPeak/test_config.h>
+#include <SmartPeak/core/FeatureMatrixCache.h>
+#include <SmartPeak/core/SequenceHandler.h>
+#include <SmartPeak/core/RawDataProcessors/LoadFeatures.h>
+#include <SmartPeak/io/SequenceParser.h>
+
+using namespace SmartPeak;
+
+struct FeatureMatrixCacheFixture : public ::testing::Test
+{
+  FeatureMatrixCacheFixture()
+  {
+    for (const std::string sample_name : { "170808_Jonathan_yeast_Sacc1_1x", "170808_Jonathan_yeast_Sacc2_1x", "170808_Jonathan_yeast_Yarr1_1x" })
+    {
+      MetaDataHandler metaDataHandler;
+      metaDataHandler.setSampleName(sample_name);
+      metaDataHandler.setFilename(sample_name + ".mzML");
+      metaDataHandler.setSampleType(SampleType::Unknown);
+      metaDataHandler.setSampleGroupName("sample_group");
+      metaDataHandler.setSequenceSegmentName("sequence_segment");
+      metaDataHandler.setReplicateGroupName("replicate_group_name");
+      metaDataHandler.inj_number = static_cast<int>(sequence_handler_.getSequence().size()) + 1;
+      metaDataHandler.batch_name = "FluxTest";
+
+      Filenames filenames;
+      filenames.setFullPath("featureXML_i", SMARTPEAK_GET_TEST_DATA_PATH(metaDataHandler.getInjectionName() + ".featureXML"));
+      RawDataHandler rawDataHandler;
+      LoadFeatures loadFeatures;
+      loadFeatures.process(rawDataHandler, {}, filenames);
+
+      sequence_handler_.addSampleToSequence(metaDataHandler, rawDataHandler.getFeatureMap());
+    }
+  }
+
+  // checks that the cache returns the same matrix as SequenceParser
+  void expectSameMatrix(
+    FeatureMatrixCache& cache,
+    const std::vector<std::string>& meta_data,
+    const std::set<std::string>& sample_names,
+    const std::set<std::string>& component_group_names,
+    const std::set<std::string>& component_names)
+  {
+    const std::set<SampleType> sample_types = { SampleType::Unknown };
+    Eigen::Tensor<float, 2> data_out, expected_data_out;
+    Eigen::Tensor<std::string, 1> columns_out, expected_columns_out;
+    Eigen::Tensor<std::string, 2> rows_out, expected_rows_out;
+    cache.makeDataMatrix(sequence_handler_, data_out, columns_out, rows_out, meta_data, sample_types,
+                         sample_names, component_group_names, component_names);
+    SequenceParser::makeDataMatrixFromMetaValue(sequence_handler_, expected_data_out, expected_columns_out, expected_rows_out,
+                                                meta_data, sample_types, sample_names, component_group_names, component_names);
+    ASSERT_EQ(columns_out.size(), expected_columns_out.size());
+    for (int col = 0; col < columns_out.size(); ++col)
+    {
+      EXPECT_EQ(columns_out(col), expected_columns_out(col));
+    }
+    ASSERT_EQ(rows_out.dimension(0), expected_rows_out.dimension(0));
+    ASSERT_EQ(rows_out.dimension(1), 3);
+    for (int row = 0; row < rows_out.dimension(0); ++row)
+    {
+      for (int j = 0; j < 3; ++j)
+      {
+        EXPECT_EQ(rows_out(row, j), expected_rows_out(row, j));
+      }
+      for (int col = 0; col < columns_out.size(); ++col)
+      {
+        EXPECT_EQ(data_out(row, col), expected_data_out(row, col));
+      }
+    }
+  }
+
+  SequenceHandler sequence_handler_;
+};
+
+TEST_F(FeatureMatrixCacheFixture, makeDataMatrix)
+{
+  FeatureMatrixCache cache;
+  Eigen::Tensor<float, 2> data_out;
+  Eigen::Tensor<std::string, 1> columns_out;
+  Eigen::Tensor<std::string, 2> rows_out;
+  cache.makeDataMatrix(sequence_handler_, data_out, columns_out, rows_out,
+                       { "calculated_concentration", "leftWidth", "rightWidth" }, { SampleType::Unknown }, {}, {}, {});
+  EXPECT_EQ(cache.getNExtractions(), 9);
+  EXPECT_EQ(columns_out.size(), 3);
+  EXPECT_EQ(columns_out(0), "170808_Jonathan_yeast_Sacc1_1x");
+  EXPECT_GT(rows_out.dimension(0), 0);
+  EXPECT_EQ(rows_out.dimension(1), 3);
+  EXPECT_EQ(rows_out(0, 1), "23dpg");
+  EXPECT_EQ(data_out.dimension(0), rows_out.dimension(0));
+  EXPECT_EQ(data_out.dimension(1), 3);
+}
+
+TEST_F(FeatureMatrixCacheFixture, selection_changes)
+{
+  FeatureMatrixCache cache;
+  expectSameMatrix(cache, { "calculated_concentration", "leftWidth" }, {}, {}, {});
+  EXPECT_EQ(cache.getNExtractions(), 6);
+
+  // toggling samples, transitions and transition groups reuse the extracted values
+  expectSameMatrix(cache, { "calculated_concentration", "leftWidth" }, { "170808_Jonathan_yeast_Sacc1_1x" }, {}, {});
+  expectSameMatrix(cache, { "leftWidth" }, {}, { "23dpg" }, {});
+  expectSameMatrix(cache, { "leftWidth" }, { "170808_Jonathan_yeast_Sacc2_1x" }, { "23dpg" }, { "23dpg.23dpg_1.Light" });
+  EXPECT_EQ(cache.getNExtractions(), 6);
+
+  // a new meta value is extracted once
+  expectSameMatrix(cache, { "leftWidth", "rightWidth" }, {}, {}, {});
+  expectSameMatrix(cache, { "rightWidth" }, {}, {}, {});
+  EXPECT_EQ(cache.getNExtractions(), 9);
+
+  // updated features
+  cache.setGeneration(1);
+  EXPECT_EQ(cache.getNExtractions(), 0);
+  expectSameMatrix(cache, { "rightWidth" }, {}, {}, {});
+  EXPECT_EQ(cache.getNExtractions(), 3);
+  cache.setGeneration(1);
+  EXPECT_EQ(cache.getNExtractions(), 3);
+}
+
+TEST(FeatureMatrixCache, injections_of_a_sample)
+{
+  // two injections of the same sample, the second one with an additional component
+  SequenceHandler sequence_handler;
+  for (int inj_number : { 1, 2 })
+  {
+    OpenMS::FeatureMap feature_map;
+    for (int component = 0; component < inj_number; ++component)
+    {
+      OpenMS::Feature feature;
+      feature.setMetaValue("PeptideRef", "component_group_" + std::to_string(component));
+      OpenMS::Feature subordinate;
+      subordinate.setMetaValue("native_id", "component_" + std::to_string(component));
+      subordinate.setMetaValue("leftWidth", 10.0 * inj_number + component);
+      feature.setSubordinates({ subordinate });
+      feature_map.push_back(feature);
+    }
+    MetaDataHandler metaDataHandler;
+    metaDataHandler.setSampleName("sample");
+    metaDataHandler.setFilename("sample_" + std::to_string(inj_number) + ".mzML");
+    metaDataHandler.setSampleType(SampleType::Unknown);
+    metaDataHandler.setSampleGroupName("sample_group");
+    metaDataHandler.setSequenceSegmentName("sequence_segment");
+    metaDataHandler.inj_number = inj_number;
+    metaDataHandler.batch_name = "BatchName";
+    sequence_handler.addSampleToSequence(metaDataHandler, feature_map);
+  }
+
+  FeatureMatrixCache cache;
+  Eigen::Tensor<float, 2> data_out, expected_data_out;
+  Eigen::Tensor<std::string, 1> columns_out, expected_columns_out;
+  Eigen::Tensor<std::string, 2> rows_out, expected_rows_out;
+  cache.makeDataMatrix(sequence_handler, data_out, columns_out, rows_out, { "leftWidth" }, { SampleType::Unknown }, {}, {}, {});
+  SequenceParser::makeDataMatrixFromMetaValue(sequence_handler, expected_data_out, expected_columns_out, expected_rows_out,
+                                              { "leftWidth" }, { SampleType::Unknown }, {}, {}, {});
+  EXPECT_EQ(cache.getNExtractions(), 2);
+  ASSERT_EQ(columns_out.size(), 1);
+  EXPECT_EQ(columns_out(0), "sample");
+  ASSERT_EQ(rows_out.dimension(0), 2);
+  ASSERT_EQ(expected_rows_out.dimension(0), 2);
+  EXPECT_EQ(rows_out(0, 0), "component_0");
+  EXPECT_EQ(rows_out(1, 0), "component_1");
+  // the first injection wins, the rows of the second one are merged
+  EXPECT_FLOAT_EQ(data_out(0, 0), 10.0);
+  EXPECT_FLOAT_EQ(data_out(1, 0), 21.0);
+  for (int row = 0; row < 2; ++row)
+  {
+    EXPECT_EQ(rows_out(row, 0), expected_rows_out(row, 0));
+    EXPECT_EQ(data_out(row, 0), expected_data_out(row, 0));
+  }
+}
@@ -0,0 +1,123 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <gtest/gtest.h>
+#include <SmartPeak/core/FeatureTable.h>
+
+#include <cmath>
+
+using namespace SmartPeak;
+
+TEST(FeatureTable, typed_columns)
+{
+  FeatureTable table;
+  const size_t name = table.addColumn("name");
+  const size_t number = table.addColumn("number");
+  const size_t value = table.addColumn("value");
+  table.reserve(2);
+  table.appendText(name, "a");
+  table.appendInteger(number, 1);
+  table.appendReal(value, 1.5f);
+  EXPECT_EQ(table.getNRows(), 1);
+  table.appendText(name, table.intern("b"));
+  table.appendInteger(number, -2);
+  table.appendEmpty(value);
+
+  ASSERT_EQ(table.getNRows(), 2);
+  ASSERT_EQ(table.getNColumns(), 3);
+  EXPECT_EQ(table.getHeaders(), std::vector<std::string>({ "name", "number", "value" }));
+  EXPECT_EQ(table.getColumnType(name), FeatureTable::ColumnType::Text);
+  EXPECT_EQ(table.getColumnType(number), FeatureTable::ColumnType::Integer);
+  EXPECT_EQ(table.getColumnType(value), FeatureTable::ColumnType::Real);
+
+  EXPECT_EQ(table.getText(0, name), "a");
+  EXPECT_EQ(table.getText(1, name), "b");
+  EXPECT_EQ(table.getText(1, number), "-2");
+  EXPECT_EQ(table.getText(0, value), std::to_string(1.5f));
+  EXPECT_EQ(table.getText(1, value), "");
+  EXPECT_TRUE(std::isnan(table.getNumber(0, name)));
+  EXPECT_EQ(table.getNumber(1, number), -2.0);
+  EXPECT_EQ(table.getNumber(0, value), 1.5);
+  EXPECT_TRUE(std::isnan(table.getNumber(1, value)));
+
+  std::vector<std::string> row;
+  table.getRow(0, row);
+  EXPECT_EQ(row, std::vector<std::string>({ "a", "1", std::to_string(1.5f) }));
+  const auto rows = table.toRows();
+  ASSERT_EQ(rows.size(), 2);
+  EXPECT_EQ(rows[1], std::vector<std::string>({ "b", "-2", "" }));
+
+  EXPECT_THROW(table.getText(2, name), std::out_of_range);
+  EXPECT_THROW(table.getText(0, 3), std::out_of_range);
+  EXPECT_THROW(table.addColumn("late"), std::logic_error);
+
+  table.clear();
+  EXPECT_EQ(table.getNRows(), 0);
+  EXPECT_EQ(table.getNColumns(), 0);
+}
+
+TEST(FeatureTable, mixed_columns)
+{
+  FeatureTable table;
+  table.addColumn("mixed");
+  table.addColumn("missing_first");
+  table.addColumn("integer_then_missing");
+  table.appendReal(0, 2.0f);
+  table.appendEmpty(1);
+  table.appendInteger(2, 3);
+  table.appendText(0, "text");
+  table.appendReal(1, 4.0f);
+  table.appendEmpty(2);
+  table.appendInteger(0, 5);
+  table.appendEmpty(1);
+  table.appendInteger(2, 6);
+
+  // a column falls back to text when its values have different types
+  EXPECT_EQ(table.getColumnType(0), FeatureTable::ColumnType::Text);
+  EXPECT_EQ(table.getColumnType(1), FeatureTable::ColumnType::Real);
+  EXPECT_EQ(table.getColumnType(2), FeatureTable::ColumnType::Text);
+  const auto rows = table.toRows();
+  ASSERT_EQ(rows.size(), 3);
+  EXPECT_EQ(rows[0], std::vector<std::string>({ std::to_string(2.0f), "", "3" }));
+  EXPECT_EQ(rows[1], std::vector<std::string>({ "text", std::to_string(4.0f), "" }));
+  EXPECT_EQ(rows[2], std::vector<std::string>({ "5", "", "6" }));
+  EXPECT_EQ(table.getNumber(1, 1), 4.0);
+  EXPECT_TRUE(std::isnan(table.getNumber(2, 0)));
+}
+
+TEST(FeatureTable, intern)
+{
+  FeatureTable table;
+  const auto id_a = table.intern("a");
+  const auto id_b = table.intern("b");
+  EXPECT_NE(id_a, id_b);
+  EXPECT_EQ(table.intern("a"), id_a);
+  // interned strings stay valid as the pool grows
+  for (int i = 0; i < 1000; ++i)
+  {
+    table.intern("string_" + std::to_string(i));
+  }
+  EXPECT_EQ(table.intern("a"), id_a);
+  EXPECT_EQ(table.intern("string_10"), table.intern("string_10"));
+}
@@ -0,0 +1,112 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <gtest/gtest.h>
+#include <SmartPeak/core/MPSCRingBuffer.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace SmartPeak;
+
+TEST(MPSCRingBuffer, pushPop)
+{
+  MPSCRingBuffer<std::string> ring(3);
+  EXPECT_EQ(ring.capacity(), 4);
+  EXPECT_EQ(ring.size(), 0);
+  std::string value;
+  EXPECT_FALSE(ring.tryPop(value));
+  for (const std::string element : { "a", "b", "c", "d" })
+  {
+    value = element;
+    EXPECT_TRUE(ring.tryPush(value));
+  }
+  EXPECT_EQ(ring.size(), 4);
+  // full, the value is left untouched
+  value = "e";
+  EXPECT_FALSE(ring.tryPush(value));
+  EXPECT_EQ(value, "e");
+  EXPECT_TRUE(ring.tryPop(value));
+  EXPECT_EQ(value, "a");
+  value = "e";
+  EXPECT_TRUE(ring.tryPush(value));
+  for (const std::string expected : { "b", "c", "d", "e" })
+  {
+    EXPECT_TRUE(ring.tryPop(value));
+    EXPECT_EQ(value, expected);
+  }
+  EXPECT_FALSE(ring.tryPop(value));
+  EXPECT_EQ(ring.size(), 0);
+}
+
+TEST(MPSCRingBuffer, concurrentProducers)
+{
+  const size_t n_producers = 8;
+  const size_t n_elements = 20000;
+  MPSCRingBuffer<std::pair<size_t, size_t>> ring(64);
+  std::vector<std::thread> producers;
+  for (size_t producer = 0; producer < n_producers; ++producer)
+  {
+    producers.emplace_back([&ring, producer, n_elements]() {
+      for (size_t i = 0; i < n_elements; ++i)
+      {
+        std::pair<size_t, size_t> element(producer, i);
+        while (!ring.tryPush(element))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  // no element is lost or reordered for a given producer
+  std::vector<size_t> next(n_producers, 0);
+  size_t n_popped = 0;
+  std::pair<size_t, size_t> element;
+  while (n_popped < n_producers * n_elements)
+  {
+    if (ring.tryPop(element))
+    {
+      ASSERT_LT(element.first, n_producers);
+      ASSERT_EQ(element.second, next[element.first]);
+      ++next[element.first];
+      ++n_popped;
+    }
+    else
+    {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& producer : producers)
+  {
+    producer.join();
+  }
+  EXPECT_FALSE(ring.tryPop(element));
+  for (size_t producer = 0; producer < n_producers; ++producer)
+  {
+    EXPECT_EQ(next[producer], n_elements);
+  }
+}
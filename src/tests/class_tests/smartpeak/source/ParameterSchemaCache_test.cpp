@@ -0,0 +1,182 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <gtest/gtest.h>
+#include <SmartPeak/core/ParameterSchemaCache.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace SmartPeak;
+
+namespace
+{
+  /** Counts the builds of its schema */
+  struct CountingProcessor : IProcessorDescription
+  {
+    std::string getName() const override { return "COUNTING"; }
+    std::string getDescription() const override { return ""; }
+    ParameterSet getParameterSchema() const override
+    {
+      ++n_builds;
+      std::map<std::string, std::vector<std::map<std::string, std::string>>> param_struct({
+      {"Counting", {
+        {
+          {"name", "param_1"},
+          {"type", "int"},
+          {"value", "1"}
+        },
+        {
+          {"name", "param_2"},
+          {"type", "string"},
+          {"value", "default"}
+        }
+      }} });
+      return ParameterSet(param_struct);
+    }
+    std::vector<std::string> getRequirements() const override { return {}; }
+    std::set<std::string> getInputs() const override { return {}; }
+    std::set<std::string> getOutputs() const override { return {}; }
+    static std::atomic<int> n_builds;
+  };
+  std::atomic<int> CountingProcessor::n_builds{ 0 };
+
+  struct FailingProcessor : CountingProcessor
+  {
+    ParameterSet getParameterSchema() const override
+    {
+      ++n_builds;
+      throw std::runtime_error("schema");
+    }
+  };
+
+  ParameterSet makeUserParameters(const std::string& param_1)
+  {
+    std::map<std::string, std::vector<std::map<std::string, std::string>>> param_struct({
+    {"Counting", {
+      {
+        {"name", "param_1"},
+        {"type", "int"},
+        {"value", param_1}
+      }
+    }},
+    {"Other", {
+      {
+        {"name", "other_param"},
+        {"type", "string"},
+        {"value", "other"}
+      }
+    }} });
+    return ParameterSet(param_struct);
+  }
+}
+
+TEST(ParameterSchemaCache, getSchema)
+{
+  ParameterSchemaCache cache;
+  CountingProcessor processor;
+  CountingProcessor::n_builds = 0;
+  auto schema1 = cache.getSchema(processor);
+  auto schema2 = cache.getSchema(CountingProcessor());
+  ASSERT_NE(schema1, nullptr);
+  EXPECT_EQ(schema1, schema2);
+  EXPECT_EQ(*schema1, processor.getParameterSchema());
+  EXPECT_EQ(CountingProcessor::n_builds, 2); // once by the cache, once above
+  EXPECT_EQ(cache.size(), 1);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+  auto schema3 = cache.getSchema(processor);
+  EXPECT_NE(schema1, schema3);
+  EXPECT_EQ(CountingProcessor::n_builds, 3);
+}
+
+TEST(ParameterSchemaCache, getParameters)
+{
+  ParameterSchemaCache cache;
+  CountingProcessor processor;
+  CountingProcessor::n_builds = 0;
+  const ParameterSet user_parameters = makeUserParameters("5");
+  auto parameters1 = cache.getParameters(processor, user_parameters);
+  ASSERT_NE(parameters1, nullptr);
+
+  // same as merging the schema into the user parameters
+  ParameterSet expected(user_parameters);
+  expected.merge(processor.getParameterSchema());
+  EXPECT_EQ(*parameters1, expected);
+  ASSERT_NE(parameters1->findParameter("Counting", "param_1"), nullptr);
+  EXPECT_EQ(parameters1->findParameter("Counting", "param_1")->getValueAsString(), "5");
+  ASSERT_NE(parameters1->findParameter("Counting", "param_2"), nullptr);
+  EXPECT_EQ(parameters1->findParameter("Counting", "param_2")->getValueAsString(), "default");
+  EXPECT_EQ(parameters1->count("Other"), 1);
+
+  // resolved once while the user parameters are unchanged
+  auto parameters2 = cache.getParameters(processor, makeUserParameters("5"));
+  EXPECT_EQ(parameters1, parameters2);
+
+  // resolved again when they change, with the same schema
+  auto parameters3 = cache.getParameters(processor, makeUserParameters("6"));
+  EXPECT_NE(parameters1, parameters3);
+  EXPECT_EQ(parameters3->findParameter("Counting", "param_1")->getValueAsString(), "6");
+  EXPECT_EQ(parameters1->findParameter("Counting", "param_1")->getValueAsString(), "5");
+  EXPECT_EQ(CountingProcessor::n_builds, 2); // once by the cache, once above
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(ParameterSchemaCache, getSchema_failure)
+{
+  ParameterSchemaCache cache;
+  FailingProcessor processor;
+  CountingProcessor::n_builds = 0;
+  EXPECT_THROW(cache.getSchema(processor), std::runtime_error);
+  EXPECT_THROW(cache.getParameters(processor, makeUserParameters("5")), std::runtime_error);
+  // failures are not cached
+  EXPECT_EQ(CountingProcessor::n_builds, 2);
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(ParameterSchemaCache, concurrent_getParameters)
+{
+  ParameterSchemaCache cache;
+  CountingProcessor::n_builds = 0;
+  const ParameterSet user_parameters = makeUserParameters("5");
+  const size_t n_threads = 4;
+  std::vector<std::shared_ptr<const ParameterSet>> parameters(n_threads);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < n_threads; ++i)
+  {
+    threads.emplace_back([&, i]() { parameters[i] = cache.getParameters(CountingProcessor(), user_parameters); });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(CountingProcessor::n_builds, 1);
+  for (const auto& p : parameters)
+  {
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(*p, *parameters.front());
+  }
+}
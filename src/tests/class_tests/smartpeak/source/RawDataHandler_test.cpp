@@ -835,6 +835,54 @@ TEST(RawDataHandler, updateFeatureMapHistory)
   EXPECT_TRUE(rawDataHandler.getFeatureMapHistory()[1].getSubordinates()[1].getMetaValue("used_").toBool());
 }
 
+TEST(RawDataHandler, updateFeatureMapHistory_matching)
+{
+  RawDataHandler rawDataHandler;
+
+  OpenMS::FeatureMap fm1;
+  OpenMS::Feature f1, s1a, s1b, s1c;
+  f1.setMetaValue("PeptideRef", "component_group_1");
+  f1.setUniqueId(1);
+  s1a.setMetaValue("native_id", "component_1a");
+  s1a.setUniqueId(11);
+  s1b.setMetaValue("native_id", "component_1b");
+  s1b.setUniqueId(12);
+  f1.setSubordinates({ s1a, s1b });
+  fm1.push_back(f1);
+  rawDataHandler.setFeatureMap(fm1);
+  rawDataHandler.updateFeatureMapHistory();
+
+  // Same unique id but a different peptide ref first: the feature with the matching peptide ref is used
+  OpenMS::Feature f1_other = f1;
+  f1_other.setMetaValue("PeptideRef", "component_group_other");
+  f1_other.setIntensity(1.0);
+  s1a.setIntensity(2.0);
+  s1c.setMetaValue("native_id", "component_1c");
+  s1c.setUniqueId(13);
+  f1.setIntensity(3.0);
+  f1.setSubordinates({ s1a, s1b, s1c });
+  fm1.clear();
+  fm1.push_back(f1_other);
+  fm1.push_back(f1);
+  rawDataHandler.setFeatureMap(fm1);
+  rawDataHandler.updateFeatureMapHistory();
+
+  const OpenMS::FeatureMap& history = rawDataHandler.getFeatureMapHistory();
+  ASSERT_EQ(history.size(), 1);
+  EXPECT_STREQ(((std::string)history[0].getMetaValue("PeptideRef")).c_str(), "component_group_1");
+  EXPECT_FLOAT_EQ(history[0].getIntensity(), 3.0);
+  // the existing subordinates are prepended to the new ones in reverse order
+  ASSERT_EQ(history[0].getSubordinates().size(), 3);
+  EXPECT_STREQ(((std::string)history[0].getSubordinates()[0].getMetaValue("native_id")).c_str(), "component_1b");
+  EXPECT_STREQ(((std::string)history[0].getSubordinates()[1].getMetaValue("native_id")).c_str(), "component_1a");
+  EXPECT_FLOAT_EQ(history[0].getSubordinates()[1].getIntensity(), 2.0);
+  EXPECT_STREQ(((std::string)history[0].getSubordinates()[2].getMetaValue("native_id")).c_str(), "component_1c");
+  for (const OpenMS::Feature& subordinate : history[0].getSubordinates())
+  {
+    EXPECT_TRUE(subordinate.getMetaValue("used_").toBool());
+  }
+}
+
 TEST(RawDataHandler, makeFeatureMapFromHistory)
 {
   RawDataHandler rawDataHandler;
@@ -82,6 +82,7 @@
 #include <OpenMS/FORMAT/TraMLFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/FORMAT/MSPGenericFile.h>
+#include <cmath>
 
 using namespace SmartPeak;
 using namespace std;
@@ -242,6 +243,45 @@ TEST(RawDataProcessor, processorLoadRawData)
   EXPECT_NEAR(chromatograms3[0][3300].getIntensity(), 126.958, 1e-3);
 }
 
+TEST(RawDataProcessor, processorLoadRawData_extractChromatograms)
+{
+  RawDataHandler rawDataHandler;
+  Filenames filenames;
+  filenames.setFullPath("traML", SMARTPEAK_GET_TEST_DATA_PATH("OpenMSFile_traML_1.csv"));
+  LoadTransitions loadTransitions;
+  loadTransitions.process(rawDataHandler, {}, filenames);
+  // the transitions are shared with other injections
+  std::shared_ptr<OpenMS::TargetedExperiment> shared_targeted_exp = rawDataHandler.getTargetedExperimentShared();
+  ASSERT_GT(shared_targeted_exp->getTransitions().size(), 0);
+  const double product_mz = shared_targeted_exp->getTransitions().front().getProductMZ();
+
+  std::vector<std::map<std::string, std::string>> params_tmp = {
+    { {"name", "extract_window"}, {"type", "float"}, {"value", "0.5"} },
+    { {"name", "ppm"}, {"type", "bool"}, {"value", "false"} },
+    { {"name", "rt_extraction_window"}, {"type", "float"}, {"value", "-1"} },
+    { {"name", "filter"}, {"type", "string"}, {"value", "tophat"} },
+    { {"name", "extract_precursors"}, {"type", "bool"}, {"value", "true"} }
+  };
+  ParameterSet params_I;
+  params_I.addFunctionParameters(FunctionParameters("mzML"));
+  params_I.addFunctionParameters(FunctionParameters("ChromatogramExtractor", params_tmp));
+  filenames.setFullPath("mzML_i", SMARTPEAK_GET_TEST_DATA_PATH("RawDataProcessor_SerumTest.mzML"));
+  LoadRawData loadRawData;
+  loadRawData.process(rawDataHandler, params_I, filenames);
+
+  // one chromatogram per transition, extracted on the precursor m/z
+  const OpenMS::TargetedExperiment& targeted_exp = rawDataHandler.getTargetedExperiment();
+  EXPECT_EQ(rawDataHandler.getExperiment().getChromatograms().size(), targeted_exp.getTransitions().size());
+  EXPECT_EQ(rawDataHandler.getExperiment().getSpectra().size(), 0);
+  for (const auto& transition : targeted_exp.getTransitions())
+  {
+    EXPECT_NEAR(transition.getProductMZ(), transition.getPrecursorMZ(), 1e-6);
+  }
+  // the shared transitions are left untouched
+  EXPECT_NE(&targeted_exp, shared_targeted_exp.get());
+  EXPECT_NEAR(shared_targeted_exp->getTransitions().front().getProductMZ(), product_mz, 1e-6);
+}
+
 TEST(RawDataProcessor, extractMetaData)
 {
   // Pre-requisites: load the parameters
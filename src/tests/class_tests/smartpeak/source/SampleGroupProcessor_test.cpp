@@ -619,6 +619,74 @@ TEST(SampleGroupHandler, processMergeInjections_selectDilution)
   EXPECT_NEAR(static_cast<float>(sampleGroupHandler.getFeatureMap().at(0).getSubordinates().at(0).getMZ()), 100, 1e-4);
 }
 
+TEST(SampleGroupHandler, processMergeInjections_exactValues)
+{
+  // Max over the dilutions, Sum over the mass ranges and Mean over the scan polarities
+  ParameterSet mergeinjs_params({ {"MergeInjections", {
+    {
+      {"name", "scan_polarity_merge_rule"},
+      {"value", "Mean"}
+    },
+    {
+      {"name", "mass_range_merge_rule"},
+      {"value", "Sum"}
+    },
+    {
+      {"name", "dilution_series_merge_rule"},
+      {"value", "Max"}
+    },
+    {
+      {"name", "scan_polarity_merge_feature_name"},
+      {"value", "peak_apex_int"}
+    },
+    {
+      {"name", "mass_range_merge_feature_name"},
+      {"value", "peak_apex_int"}
+    },
+    {
+      {"name", "dilution_series_merge_feature_name"},
+      {"value", "peak_apex_int"}
+    },
+    {
+      {"name", "merge_subordinates"},
+      {"value", "true"}
+    }
+  }} });
+
+  SequenceHandler sequenceHandler;
+  makeSequence(sequenceHandler, false);
+  SampleGroupHandler sampleGroupHandler = sequenceHandler.getSampleGroups().front();
+
+  MergeInjections sampleGroupProcessor;
+  Filenames filenames;
+  sampleGroupProcessor.process(sampleGroupHandler, sequenceHandler, mergeinjs_params, filenames);
+
+  // ser-L.ser-L_1.Light, same order of operations as the merge:
+  // injections 0-3 are positive, 4-7 negative, mass ranges alternate every 2 injections
+  // and dilutions every injection
+  const std::vector<float> x = { 2.32e4f, 2.45e4f, 1.78e4f, 2.11e4f, 1.91e4f, 2.06e4f, 1.85e4f, 1.53e4f };
+  const std::vector<float> rt = { 1.00e-2f, 2.00e-2f, 4.00e-2f, 1.00e-1f, 2.00e-1f, 4.00e-1f, 1.00e0f, 2.00e0f };
+  float positive_x = 0, negative_x = 0, positive_rt = 0, negative_rt = 0;
+  positive_x += x[1]; positive_rt += rt[1]; // max of injections 0 and 1
+  positive_x += x[3]; positive_rt += rt[3]; // max of injections 2 and 3
+  negative_x += x[5]; negative_rt += rt[5]; // max of injections 4 and 5
+  negative_x += x[6]; negative_rt += rt[6]; // max of injections 6 and 7
+  float merged_x = 0, merged_rt = 0;
+  merged_x += negative_x / std::size_t(2);
+  merged_x += positive_x / std::size_t(2);
+  merged_rt += negative_rt / std::size_t(2);
+  merged_rt += positive_rt / std::size_t(2);
+
+  ASSERT_EQ(sampleGroupHandler.getFeatureMap().size(), 3);
+  const OpenMS::Feature& serl = sampleGroupHandler.getFeatureMap().at(2);
+  EXPECT_STREQ(serl.getMetaValue("PeptideRef").toString().c_str(), "ser-L");
+  ASSERT_EQ(serl.getSubordinates().size(), 2);
+  const OpenMS::Feature& light = serl.getSubordinates().at(1);
+  EXPECT_STREQ(light.getMetaValue("native_id").toString().c_str(), "ser-L.ser-L_1.Light");
+  EXPECT_EQ(static_cast<float>(light.getMetaValue("peak_apex_int")), merged_x);
+  EXPECT_EQ(static_cast<float>(light.getRT()), merged_rt);
+}
+
 /**
   LoadFeaturesSampleGroup Tests
 */
@@ -307,6 +307,54 @@ TEST(SequenceHandler, getMetaValue)
   EXPECT_STREQ(result.s_.c_str(), "FP");
 }
 
+TEST(SequenceHandler, resolveMetaValue)
+{
+  OpenMS::Feature feature;
+  feature.setRT(16.0);
+  feature.setMetaValue("logSN", 3.0);
+  OpenMS::Feature subordinate;
+  subordinate.setIntensity(1.0e2);
+  subordinate.setMetaValue("calculated_concentration", 10.0);
+  subordinate.setMetaValue("logSN", 2.0);
+
+  const std::vector<SequenceHandler::MetaValueKey> keys = SequenceHandler::resolveMetaValues(
+    { "RT", "peak_area", "calculated_concentration", "logSN", "absent_meta_value" });
+  ASSERT_EQ(keys.size(), 5);
+  EXPECT_EQ(keys[0].name, "RT");
+  EXPECT_TRUE(keys[0].field == SequenceHandler::MetaValueKey::Field::RT);
+  EXPECT_TRUE(keys[1].field == SequenceHandler::MetaValueKey::Field::peak_area);
+  EXPECT_TRUE(keys[2].field == SequenceHandler::MetaValueKey::Field::meta_value);
+  EXPECT_EQ(keys[2].index, SequenceHandler::resolveMetaValue("calculated_concentration").index);
+  // unknown names are not registered
+  EXPECT_EQ(keys[4].index, SequenceHandler::MetaValueKey::unknown_index);
+  EXPECT_EQ(OpenMS::MetaInfoInterface::metaRegistry().getIndex("absent_meta_value"), SequenceHandler::MetaValueKey::unknown_index);
+
+  CastValue result;
+
+  result = SequenceHandler::getMetaValue(feature, subordinate, keys[0]);
+  EXPECT_TRUE(result.getTag() == CastValue::Type::FLOAT);
+  EXPECT_NEAR(result.f_, 16.0, 1e-6);
+
+  result = SequenceHandler::getMetaValue(feature, subordinate, keys[1]);
+  EXPECT_TRUE(result.getTag() == CastValue::Type::FLOAT);
+  EXPECT_NEAR(result.f_, 1.0e2, 1e-6);
+
+  result = SequenceHandler::getMetaValue(feature, subordinate, keys[2]);
+  EXPECT_TRUE(result.getTag() == CastValue::Type::FLOAT);
+  EXPECT_NEAR(result.f_, 10.0, 1e-6);
+
+  // the subordinate is prioritized over the feature
+  result = SequenceHandler::getMetaValue(feature, subordinate, keys[3]);
+  EXPECT_TRUE(result.getTag() == CastValue::Type::FLOAT);
+  EXPECT_NEAR(result.f_, 2.0, 1e-6);
+  result = SequenceHandler::getMetaValue(feature, feature, keys[3]);
+  EXPECT_NEAR(result.f_, 3.0, 1e-6);
+
+  result = SequenceHandler::getMetaValue(feature, subordinate, keys[4]);
+  EXPECT_TRUE(result.getTag() == CastValue::Type::STRING);
+  EXPECT_STREQ(result.s_.c_str(), "");
+}
+
 TEST(SequenceHandler, getSamplesInSequence)
 {
   MetaDataHandler meta_data1;
@@ -25,6 +25,7 @@
 #include <gmock/gmock.h>
 #include <SmartPeak/test_config.h>
 #include <SmartPeak/io/SequenceParser.h>
+#include <SmartPeak/core/FeatureTable.h>
 #include <SmartPeak/core/MetaDataHandler.h>
 #include <SmartPeak/core/SampleType.h>
 #include <SmartPeak/core/ApplicationHandler.h>
@@ -35,6 +36,8 @@
 #endif
 #include <SmartPeak/io/csv.h>
 
+#include <cmath>
+
 using namespace SmartPeak;
 using namespace std;
 
@@ -312,6 +315,49 @@ TEST_F(SequenceParserFixture, makeDataTableFromMetaValue)
   // SequenceParser::writeDataTableFromMetaValue(sequenceHandler, pathname_output, meta_data, sample_types);
 }
 
+TEST_F(SequenceParserFixture, makeFeatureTableFromMetaValue)
+{
+  const vector<string> meta_data {
+    "peak_apex_int",
+    "logSN",
+    "QC_transition_message",
+    "QC_transition_group_message",
+    "leftWidth",
+    "rightWidth",
+  };
+  const set<SampleType> sample_types = {SampleType::Unknown};
+
+  FeatureTable table;
+  SequenceParser::makeFeatureTableFromMetaValue(sequence_handler_, table, meta_data, sample_types, std::set<std::string>(), std::set<std::string>(), std::set<std::string>());
+
+  ASSERT_EQ(table.getNRows(), 1657);
+  ASSERT_EQ(table.getNColumns(), 29);
+  EXPECT_EQ(table.getColumnType(0), FeatureTable::ColumnType::Text);
+  EXPECT_EQ(table.getColumnType(9), FeatureTable::ColumnType::Integer);
+  EXPECT_EQ(table.getColumnType(11), FeatureTable::ColumnType::Real);
+  EXPECT_EQ(table.getColumnType(23), FeatureTable::ColumnType::Real);
+  EXPECT_EQ(table.getColumnType(27), FeatureTable::ColumnType::Real);
+  EXPECT_EQ(table.getText(0, 0), "170808_Jonathan_yeast_Sacc1_1x");
+  EXPECT_EQ(table.getNumber(0, 9), 1);
+  EXPECT_FLOAT_EQ(table.getNumber(0, 11), 7.0);
+  EXPECT_FLOAT_EQ(table.getNumber(0, 23), 235.0);
+  EXPECT_FLOAT_EQ(table.getNumber(0, 27), 15.605367);
+  EXPECT_TRUE(std::isnan(table.getNumber(0, 0)));
+
+  // same text representation as the string table
+  vector<vector<string>> data_out;
+  vector<string> headers_out;
+  SequenceParser::makeDataTableFromMetaValue(sequence_handler_, data_out, headers_out, meta_data, sample_types, std::set<std::string>(), std::set<std::string>(), std::set<std::string>());
+  EXPECT_EQ(table.getHeaders(), headers_out);
+  ASSERT_EQ(data_out.size(), table.getNRows());
+  vector<string> row;
+  for (size_t i = 0; i < data_out.size(); ++i)
+  {
+    table.getRow(i, row);
+    EXPECT_EQ(row, data_out[i]);
+  }
+}
+
 TEST_F(SequenceParserFixture, makeDataMatrixFromMetaValue)
 {
   Eigen::Tensor<float, 2> data_out;
@@ -33,7 +33,11 @@
 #include <SmartPeak/core/ApplicationProcessors/LoadSession.h>
 #include <SmartPeak/core/ApplicationProcessors/SaveSession.h>
 #include <SmartPeak/core/Utilities.h>
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <mutex>
+#include <thread>
 
 using namespace SmartPeak;
 using namespace std;
@@ -352,8 +356,12 @@ TEST(SequenceHandler, processSequence)
     raw_data_processing_methods);
   const unsigned int max_threads = std::thread::hardware_concurrency();
   if (max_threads != 0 && 4 <= max_threads) {
-    EXPECT_EQ(spMT1.getNumWorkers(4), 3);
-    EXPECT_EQ(spMT2.getNumWorkers(3), 2);
+    EXPECT_EQ(spMT1.getNumWorkers(4), 4);
+    EXPECT_EQ(spMT2.getNumWorkers(3), 3);
+  }
+  else if (max_threads != 0) {
+    EXPECT_EQ(spMT1.getNumWorkers(8), max_threads);
+    EXPECT_EQ(spMT2.getNumWorkers(1), 1);
   }
   else {
     EXPECT_EQ(spMT1.getNumWorkers(8), 1);
@@ -651,3 +659,132 @@ TEST(SequenceHandler, gettersProcessSampleGroups)
   ProcessSampleGroups cs(sequenceHandler);
   EXPECT_STREQ(cs.getName().c_str(), "PROCESS_SAMPLE_GROUPS");
 }
+
+namespace
+{
+  struct LoadingLog
+  {
+    void add(const std::string& event)
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      events_.push_back(event);
+    }
+    size_t position(const std::string& event) const
+    {
+      auto it = std::find(events_.begin(), events_.end(), event);
+      return (it == events_.end()) ? events_.size() : std::distance(events_.begin(), it);
+    }
+    std::vector<std::string> events_;
+    std::mutex mutex_;
+  };
+
+  struct RecordingLoadSequence : SequenceProcessor
+  {
+    RecordingLoadSequence(SequenceHandler& sh, std::shared_ptr<LoadingLog> log) : SequenceProcessor(sh), log_(log) {}
+    std::string getName() const override { return "LOAD_SEQUENCE"; }
+    std::string getDescription() const override { return ""; }
+    void getFilenames(Filenames& filenames) const override { filenames.addFileName("sequence", "${MAIN_DIR}/sequence.csv"); }
+    void doProcess(Filenames& filenames_I) override
+    {
+      log_->add("sequence start");
+      std::vector<SequenceSegmentHandler> segments(2);
+      segments[0].setSequenceSegmentName("segment_0");
+      segments[1].setSequenceSegmentName("segment_1");
+      sequenceHandler_IO->setSequence({ InjectionHandler() });
+      sequenceHandler_IO->setSequenceSegments(segments);
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      log_->add("sequence end");
+    }
+    std::shared_ptr<LoadingLog> log_;
+  };
+
+  struct RecordingLoadRawData : RawDataProcessor
+  {
+    RecordingLoadRawData(const std::string& file_id, std::shared_ptr<LoadingLog> log) : file_id_(file_id), log_(log) {}
+    std::string getName() const override { return "LOAD_" + file_id_; }
+    std::string getDescription() const override { return ""; }
+    void getFilenames(Filenames& filenames) const override { filenames.addFileName(file_id_, "${MAIN_DIR}/" + file_id_ + ".csv"); }
+    void doProcess(RawDataHandler& rawDataHandler_IO, const ParameterSet& params_I, Filenames& filenames_I) const override
+    {
+      log_->add(file_id_ + " start");
+      log_->add(file_id_ + " end");
+    }
+    std::string file_id_;
+    std::shared_ptr<LoadingLog> log_;
+  };
+
+  struct RecordingLoadSegmentData : SequenceSegmentProcessor
+  {
+    RecordingLoadSegmentData(const std::string& file_id, const std::string& output, std::shared_ptr<LoadingLog> log)
+      : file_id_(file_id), output_(output), log_(log) {}
+    std::string getName() const override { return "LOAD_" + file_id_; }
+    std::string getDescription() const override { return ""; }
+    ParameterSet getParameterSchema() const override { return ParameterSet(); }
+    std::set<std::string> getOutputs() const override { return { output_ }; }
+    void getFilenames(Filenames& filenames) const override { filenames.addFileName(file_id_, "${MAIN_DIR}/" + file_id_ + ".csv"); }
+    void doProcess(SequenceSegmentHandler& sequenceSegmentHandler_IO, const SequenceHandler& sequenceHandler_I, const ParameterSet& params_I, Filenames& filenames_I) const override
+    {
+      log_->add(file_id_ + " start " + sequenceSegmentHandler_IO.getSequenceSegmentName());
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      log_->add(file_id_ + " end " + sequenceSegmentHandler_IO.getSequenceSegmentName());
+    }
+    std::string file_id_;
+    std::string output_;
+    std::shared_ptr<LoadingLog> log_;
+  };
+}
+
+TEST(LoadSession, readInputFiles_dependencies)
+{
+  ApplicationHandler application_handler;
+  auto log = std::make_shared<LoadingLog>();
+  application_handler.loading_processors_ = {
+    std::make_shared<RecordingLoadSequence>(application_handler.sequenceHandler_, log),
+    std::make_shared<RecordingLoadRawData>("traML", log),
+    std::make_shared<RecordingLoadRawData>("parameters", log),
+    std::make_shared<RecordingLoadSegmentData>("quantitationMethods", "Quantitation Methods", log),
+    std::make_shared<RecordingLoadSegmentData>("featureFilterComponents", "Feature Filters", log),
+    std::make_shared<RecordingLoadSegmentData>("featureFilterComponentGroups", "Feature Filters", log),
+    std::make_shared<RecordingLoadSegmentData>("notInSession", "Feature QCs", log)
+  };
+  Filenames filenames;
+  for (const std::string file_id : { "sequence", "traML", "parameters", "quantitationMethods", "featureFilterComponents", "featureFilterComponentGroups" })
+  {
+    filenames.setFullPath(file_id, "/path/to/" + file_id + ".csv");
+  }
+  WorkflowManager workflow_manager;
+  LoadSession load_session(application_handler, workflow_manager);
+  load_session.filenames_ = filenames;
+  load_session.checkConsistency = false;
+  EXPECT_TRUE(load_session.process());
+
+  const LoadingLog& loading_log = *log;
+  // sequence, 2 raw data files, 3 segment files for 2 segments
+  ASSERT_EQ(loading_log.events_.size(), 2 * (1 + 2 + 3 * 2));
+  EXPECT_EQ(loading_log.events_[0], "sequence start");
+  EXPECT_EQ(loading_log.events_[1], "sequence end");
+  for (const std::string segment_name : { "segment_0", "segment_1" })
+  {
+    // filters of the same segment fill the same data, they are loaded one after the other
+    EXPECT_LT(loading_log.position("featureFilterComponents end " + segment_name), loading_log.position("featureFilterComponentGroups start " + segment_name));
+    EXPECT_LT(loading_log.position("quantitationMethods end " + segment_name), loading_log.events_.size());
+  }
+  EXPECT_EQ(loading_log.position("notInSession start segment_0"), loading_log.events_.size());
+}
+
+TEST(LoadSession, readInputFiles_no_sequence_segments)
+{
+  ApplicationHandler application_handler;
+  auto log = std::make_shared<LoadingLog>();
+  application_handler.loading_processors_ = {
+    std::make_shared<RecordingLoadSegmentData>("quantitationMethods", "Quantitation Methods", log)
+  };
+  Filenames filenames;
+  filenames.setFullPath("quantitationMethods", "/path/to/quantitationMethods.csv");
+  WorkflowManager workflow_manager;
+  LoadSession load_session(application_handler, workflow_manager);
+  load_session.filenames_ = filenames;
+  load_session.checkConsistency = false;
+  EXPECT_FALSE(load_session.process());
+  EXPECT_TRUE(log->events_.empty());
+}
@@ -0,0 +1,95 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <gtest/gtest.h>
+#include <SmartPeak/core/SeriesPyramid.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace SmartPeak;
+
+TEST(SeriesPyramid, decimateMinMax)
+{
+  const std::vector<float> x = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  const std::vector<float> y = { 1, 5, 2, 0, 3, 3, 9, 4 };
+  std::vector<float> x_out, y_out;
+  SeriesPyramid::decimateMinMax(x.data(), y.data(), x.size(), 2, x_out, y_out);
+  // min and max of each bucket, in their original order
+  EXPECT_EQ(x_out, std::vector<float>({ 1, 3, 4, 6 }));
+  EXPECT_EQ(y_out, std::vector<float>({ 5, 0, 3, 9 }));
+
+  // nothing to decimate
+  SeriesPyramid::decimateMinMax(x.data(), y.data(), x.size(), 4, x_out, y_out);
+  EXPECT_EQ(x_out, x);
+  EXPECT_EQ(y_out, y);
+}
+
+TEST(SeriesPyramid, levels)
+{
+  std::vector<float> x, y;
+  for (int i = 0; i < 10000; ++i)
+  {
+    x.push_back(static_cast<float>(i));
+    y.push_back(i == 5001 ? 1000.0f : static_cast<float>(i % 7));
+  }
+  const SeriesPyramid pyramid(x, y, 100);
+  EXPECT_GT(pyramid.getNLevels(), 1);
+  EXPECT_EQ(pyramid.getNPoints(), x.size());
+
+  // the whole series, at a coarse level: the peak is kept
+  const auto full_view = pyramid.getView(x, y, 0, 9999, 200);
+  EXPECT_GT(full_view.level, 0);
+  EXPECT_LE(full_view.size, 200);
+  EXPECT_EQ(*std::max_element(full_view.y, full_view.y + full_view.size), 1000.0f);
+  EXPECT_EQ(*std::min_element(full_view.y, full_view.y + full_view.size), 0.0f);
+
+  // zoomed in, at full resolution, with the points around the range
+  const auto zoomed_view = pyramid.getView(x, y, 5000, 5010, 200);
+  EXPECT_EQ(zoomed_view.level, 0);
+  EXPECT_EQ(zoomed_view.size, 13);
+  EXPECT_EQ(zoomed_view.x[0], 4999.0f);
+  EXPECT_EQ(zoomed_view.x[zoomed_view.size - 1], 5011.0f);
+  EXPECT_EQ(zoomed_view.y[2], 1000.0f);
+
+  // intermediate zoom picks an intermediate level
+  const auto partial_view = pyramid.getView(x, y, 2500, 7500, 1500);
+  EXPECT_GT(partial_view.level, 0);
+  EXPECT_LT(partial_view.level, full_view.level);
+  EXPECT_LE(partial_view.size, 1500);
+  EXPECT_EQ(*std::max_element(partial_view.y, partial_view.y + partial_view.size), 1000.0f);
+}
+
+TEST(SeriesPyramid, unsorted)
+{
+  const std::vector<float> x = { 1.0f, 10.0f, 5.0f };
+  const std::vector<float> y = { 101.0f, 110.0f, 105.0f };
+  const SeriesPyramid pyramid(x, y, 1);
+  EXPECT_EQ(pyramid.getNLevels(), 1);
+  const auto view = pyramid.getView(x, y, 2, 3, 1);
+  EXPECT_EQ(view.size, 3);
+  EXPECT_EQ(view.x, x.data());
+
+  EXPECT_THROW(SeriesPyramid(x, { 1.0f }), std::invalid_argument);
+}
@@ -0,0 +1,173 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation 
+// Center for Biosustainability, Technical University of Denmark 2018-2021.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Ahmed Khalil $
+// $Authors: Ahmed Khalil $
+// --------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <SmartPeak/test_config.h>
+#include <SmartPeak/core/ServerAppender.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace SmartPeak;
+
+namespace
+{
+  void writeRecords(ServerAppender& appender, plog::Severity severity, int n_records)
+  {
+    for (int n = 0; n < n_records; ++n) {
+      plog::Record r(severity, "some func", 0, "some file", nullptr);
+      r << n;
+      appender.write(r);
+    }
+  }
+}
+
+TEST(ServerAppender, getAppenderRecordList)
+{
+  ServerAppender appender;
+  writeRecords(appender, plog::Severity::info, 2);
+  writeRecords(appender, plog::Severity::debug, 3);
+  EXPECT_EQ(appender.size(), 5);
+
+  const auto records = appender.getAppenderRecordList(plog::Severity::info);
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[0].first, plog::Severity::info);
+  EXPECT_EQ(records[0].second, PLOG_NSTR("[some func@0] 0\n"));
+  EXPECT_EQ(records[1].second, PLOG_NSTR("[some func@0] 1\n"));
+  // the records are consumed, also those filtered out
+  EXPECT_EQ(appender.size(), 0);
+  EXPECT_TRUE(appender.getAppenderRecordList(plog::Severity::verbose).empty());
+}
+
+TEST(ServerAppender, capacity)
+{
+  EXPECT_THROW(ServerAppender(0), std::invalid_argument);
+
+  ServerAppender appender(4);
+  EXPECT_EQ(appender.capacity(), 4);
+  writeRecords(appender, plog::Severity::info, 10);
+  EXPECT_EQ(appender.size(), 4);
+  EXPECT_EQ(appender.getNbDroppedRecords(), 6);
+
+  // the latest records are kept, in order
+  const auto records = appender.getAppenderRecordList(plog::Severity::verbose);
+  ASSERT_EQ(records.size(), 4);
+  EXPECT_EQ(records[0].second, PLOG_NSTR("[some func@0] 6\n"));
+  EXPECT_EQ(records[3].second, PLOG_NSTR("[some func@0] 9\n"));
+
+  writeRecords(appender, plog::Severity::info, 3);
+  EXPECT_EQ(appender.getNbDroppedRecords(), 6);
+  EXPECT_EQ(appender.getAppenderRecordList(plog::Severity::verbose).size(), 3);
+}
+
+TEST(ServerAppender, cursors)
+{
+  // each reader receives all the records, whatever the other readers read
+  ServerAppender appender(4);
+  ServerAppender::Cursor first_reader = appender.getCursor();
+  writeRecords(appender, plog::Severity::info, 3);
+  ServerAppender::Cursor second_reader = appender.getCursor();
+  EXPECT_EQ(second_reader.next_record, 0);
+
+  EXPECT_EQ(appender.getAppenderRecordList(plog::Severity::verbose).size(), 3);
+  EXPECT_EQ(appender.size(), 0);
+  const auto records = appender.getAppenderRecordList(plog::Severity::verbose, first_reader);
+  ASSERT_EQ(records.size(), 3);
+  EXPECT_EQ(records[0].second, PLOG_NSTR("[some func@0] 0\n"));
+  EXPECT_EQ(records[2].second, PLOG_NSTR("[some func@0] 2\n"));
+  EXPECT_EQ(first_reader.next_record, 3);
+  EXPECT_TRUE(appender.getAppenderRecordList(plog::Severity::verbose, first_reader).empty());
+  EXPECT_FALSE(appender.waitForRecords(first_reader, std::chrono::milliseconds(10)));
+  EXPECT_TRUE(appender.waitForRecords(second_reader, std::chrono::milliseconds(10)));
+
+  // the records overwritten are dropped only for the readers that did not read them
+  writeRecords(appender, plog::Severity::info, 3);
+  EXPECT_EQ(appender.getAppenderRecordList(plog::Severity::verbose, first_reader).size(), 3);
+  EXPECT_EQ(first_reader.nb_dropped_records, 0);
+  const auto second_records = appender.getAppenderRecordList(plog::Severity::verbose, second_reader);
+  ASSERT_EQ(second_records.size(), 4);
+  EXPECT_EQ(second_records[0].second, PLOG_NSTR("[some func@0] 2\n"));
+  EXPECT_EQ(second_reader.nb_dropped_records, 2);
+  EXPECT_EQ(appender.getNbDroppedRecords(), 0);
+
+  // a new reader starts on the oldest record kept
+  EXPECT_EQ(appender.getCursor().next_record, 2);
+}
+
+TEST(ServerAppender, waitForRecords)
+{
+  ServerAppender appender;
+  EXPECT_FALSE(appender.waitForRecords(std::chrono::milliseconds(10)));
+  std::thread writer(writeRecords, std::ref(appender), plog::Severity::info, 1);
+  EXPECT_TRUE(appender.waitForRecords(std::chrono::seconds(10)));
+  writer.join();
+  EXPECT_EQ(appender.getAppenderRecordList(plog::Severity::verbose).size(), 1);
+}
+
+TEST(ServerAppender, streaming_client)
+{
+  // a client streaming the records with its own cursor and a client polling with
+  // the default reader, while several threads are logging: every record is either
+  // received or counted as dropped by each client, and the appender never holds
+  // more than its capacity
+  const size_t capacity = 64;
+  const int n_threads = 3;
+  const int n_records = 20000;
+  ServerAppender appender(capacity);
+  std::atomic_bool writing = true;
+  size_t nb_received = 0;
+  size_t max_size = 0;
+  std::thread client([&]() {
+    while (writing || appender.size() > 0) {
+      if (appender.waitForRecords(std::chrono::milliseconds(10))) {
+        max_size = std::max(max_size, appender.size());
+        nb_received += appender.getAppenderRecordList(plog::Severity::verbose).size();
+      }
+    }
+  });
+  ServerAppender::Cursor cursor = appender.getCursor();
+  size_t nb_streamed = 0;
+  std::thread streaming_client([&]() {
+    while (writing || appender.waitForRecords(cursor, std::chrono::milliseconds(0))) {
+      if (appender.waitForRecords(cursor, std::chrono::milliseconds(10))) {
+        nb_streamed += appender.getAppenderRecordList(plog::Severity::verbose, cursor).size();
+      }
+    }
+  });
+  std::vector<std::thread> writers;
+  for (int i = 0; i < n_threads; ++i) {
+    writers.emplace_back(writeRecords, std::ref(appender), plog::Severity::info, n_records);
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  writing = false;
+  client.join();
+  streaming_client.join();
+
+  EXPECT_LE(max_size, capacity);
+  EXPECT_EQ(nb_received + appender.getNbDroppedRecords(), n_threads * n_records);
+  EXPECT_EQ(nb_streamed + cursor.nb_dropped_records, n_threads * n_records);
+  EXPECT_EQ(appender.size(), 0);
+}
@@ -26,6 +26,11 @@
 #include <SmartPeak/test_config.h>
 #include <SmartPeak/core/Server.h>
 
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
 
 TEST(Server, handleWorkflowRequest)
 {
@@ -34,6 +39,96 @@ TEST(Server, handleWorkflowRequest)
   server_manager.get_application_handler().sequenceHandler_.setWorkflow({"LOAD_FEATURES", "STORE_FEATURES"});
   bool export_all;
   EXPECT_TRUE(handleWorkflowRequest(&server_manager, true));
+  // the events of the workflow have been dispatched by the request
+  auto& observer = server_manager.get_server_event_dispatcher_observer();
+  std::vector<std::string> event_names;
+  while (const auto event = observer.popEvent())
+  {
+    event_names.push_back(std::get<0>(*event));
+  }
+  EXPECT_THAT(event_names, ::testing::Contains("onApplicationProcessorEnd"));
+}
+
+TEST(Server, handleWorkflowRequest_concurrent)
+{
+  // requests processed at the same time by an in-process server, sharing its job queue
+  SmartPeak::WorkflowManager job_queue(2);
+  std::vector<std::unique_ptr<SmartPeak::serv::ServerManager>> server_managers;
+  for (size_t i = 0; i < 2; ++i)
+  {
+    auto server_manager = std::make_unique<SmartPeak::serv::ServerManager>(&job_queue);
+    server_manager->dataset_path = std::string{SMARTPEAK_GET_TEST_DATA_PATH("workflow_csv_files")};
+    server_manager->workflow = {"LOAD_FEATURES", "STORE_FEATURES"};
+    server_manager->features_out_dir = "./features_job_" + std::to_string(i);
+    server_manager->reports_out_dir = "exports_job_" + std::to_string(i);
+    server_managers.push_back(std::move(server_manager));
+  }
+  std::vector<std::future<bool>> requests;
+  for (auto& server_manager : server_managers)
+  {
+    requests.push_back(std::async(std::launch::async, &SmartPeak::serv::handleWorkflowRequest, server_manager.get(), true));
+  }
+  for (auto& request : requests)
+  {
+    EXPECT_TRUE(request.get());
+  }
+  EXPECT_TRUE(job_queue.getJobIds().empty());
+  EXPECT_EQ(job_queue.getNumberOfRunningWorkflows(), 0);
+  for (const auto& server_manager : server_managers)
+  {
+    EXPECT_EQ(server_manager->job_id, 0);
+    EXPECT_FALSE(server_manager->cancel_workflow());
+  }
+}
+
+TEST(Server, SeverEventDispatcherObserver_cursors)
+{
+  SmartPeak::serv::SeverEventDispatcherObserver observer;
+  observer.max_events_ = 3;
+  observer.onApplicationProcessorStart({ "LOAD_FEATURES" });
+  observer.onApplicationProcessorCommandStart(0, "LOAD_FEATURES");
+
+  // a reader with its own cursor does not consume the events of the default reader
+  size_t cursor = observer.getCursor();
+  EXPECT_EQ(cursor, 0);
+  auto event = observer.getEvent(cursor);
+  ASSERT_TRUE(event);
+  EXPECT_EQ(std::get<0>(*event), "onApplicationProcessorStart");
+  EXPECT_EQ(cursor, 1);
+  EXPECT_EQ(observer.size(), 2);
+  event = observer.popEvent();
+  ASSERT_TRUE(event);
+  EXPECT_EQ(std::get<0>(*event), "onApplicationProcessorStart");
+  EXPECT_EQ(observer.size(), 1);
+
+  // the oldest events are dropped, the readers skip them
+  observer.onApplicationProcessorCommandEnd(0, "LOAD_FEATURES");
+  observer.onApplicationProcessorEnd();
+  observer.onSequenceUpdated();
+  EXPECT_EQ(observer.getCursor(), 2);
+  EXPECT_EQ(observer.size(), 3);
+  event = observer.getEvent(cursor);
+  ASSERT_TRUE(event);
+  EXPECT_EQ(std::get<0>(*event), "onApplicationProcessorCommandEnd");
+  EXPECT_EQ(cursor, 3);
+  EXPECT_TRUE(observer.getEvent(cursor));
+  EXPECT_TRUE(observer.getEvent(cursor));
+  EXPECT_FALSE(observer.getEvent(cursor));
+  EXPECT_EQ(cursor, 5);
+  event = observer.popEvent();
+  ASSERT_TRUE(event);
+  EXPECT_EQ(std::get<0>(*event), "onApplicationProcessorCommandEnd");
+  EXPECT_EQ(observer.size(), 2);
+
+  // a reader waits for the events after its cursor
+  EXPECT_TRUE(observer.waitForEvent(4, std::chrono::milliseconds(10)));
+  EXPECT_FALSE(observer.waitForEvent(cursor, std::chrono::milliseconds(10)));
+  std::thread producer([&observer]() { observer.onTransitionsUpdated(); });
+  EXPECT_TRUE(observer.waitForEvent(cursor, std::chrono::milliseconds(10000)));
+  producer.join();
+  event = observer.getEvent(cursor);
+  ASSERT_TRUE(event);
+  EXPECT_EQ(std::get<0>(*event), "onTransitionsUpdated");
 }
 
 TEST(Server, extractReportSampletypes)
@@ -24,6 +24,7 @@
 #include <gtest/gtest.h>
 #include <SmartPeak/test_config.h>
 #include <SmartPeak/io/SessionDB.h>
+#include <thread>
 
 using namespace SmartPeak;
 using namespace std;
@@ -78,6 +79,180 @@ TEST(SessionDB, WriteAndRead)
   EXPECT_FALSE(has_more);
 }
 
+TEST(SessionDB, WriteTypedValues)
+{
+  SessionDB session_db;
+  auto path_db = std::tmpnam(nullptr);
+  session_db.setDBFilePath(path_db);
+
+  auto context = session_db.beginWrite("table1", "col1", "INT", "col2", "REAL", "col3", "TEXT");
+  ASSERT_TRUE(context);
+  session_db.write(*context, 1, 1.0 / 3.0, std::string("it's quoted"));
+  session_db.write(*context, 2, 1e-12, "007");
+  EXPECT_EQ(session_db.getLastInsertedRowId(*context), 2);
+  session_db.endWrite(*context);
+
+  context = session_db.beginRead("table1", "col1", "col2", "col3");
+  ASSERT_TRUE(context);
+  int db_int = 0;
+  double db_double = 0.0;
+  std::string db_string;
+  EXPECT_TRUE(session_db.read(*context, db_int, db_double, db_string));
+  EXPECT_EQ(db_int, 1);
+  EXPECT_DOUBLE_EQ(db_double, 1.0 / 3.0); // not rounded to 6 digits any more
+  EXPECT_EQ(db_string, "it's quoted");
+  EXPECT_TRUE(session_db.read(*context, db_int, db_double, db_string));
+  EXPECT_EQ(db_int, 2);
+  EXPECT_DOUBLE_EQ(db_double, 1e-12);
+  EXPECT_EQ(db_string, "007");
+  EXPECT_FALSE(session_db.read(*context, db_int, db_double, db_string));
+  session_db.endRead(*context);
+
+  // writing again replaces the table
+  context = session_db.beginWrite("table1", "col1", "INT", "col2", "REAL", "col3", "TEXT");
+  ASSERT_TRUE(context);
+  session_db.write(*context, 3, 3.0, "three");
+  session_db.endWrite(*context);
+  context = session_db.beginRead("table1", "col1", "col2", "col3");
+  ASSERT_TRUE(context);
+  EXPECT_TRUE(session_db.read(*context, db_int, db_double, db_string));
+  EXPECT_EQ(db_int, 3);
+  EXPECT_FALSE(session_db.read(*context, db_int, db_double, db_string));
+  session_db.endRead(*context);
+}
+
+struct ComponentNameTest
+{
+  operator std::string() const { return "component_" + std::to_string(id); }
+  int id;
+};
+
+struct RatioTest
+{
+  int numerator;
+  int denominator;
+};
+
+std::ostream& operator<<(std::ostream& os, const RatioTest& ratio)
+{
+  return os << ratio.numerator << "/" << ratio.denominator;
+}
+
+TEST(SessionDB, WriteConvertedValues)
+{
+  SessionDB session_db;
+  auto path_db = std::tmpnam(nullptr);
+  session_db.setDBFilePath(path_db);
+
+  // the texts converted from these values are temporaries
+  auto context = session_db.beginWrite("table1", "col1", "TEXT", "col2", "TEXT");
+  ASSERT_TRUE(context);
+  for (int i = 0; i < 3; ++i)
+  {
+    session_db.write(*context, ComponentNameTest{ i }, RatioTest{ i, 3 });
+  }
+  session_db.endWrite(*context);
+
+  context = session_db.beginRead("table1", "col1", "col2");
+  ASSERT_TRUE(context);
+  std::string name;
+  std::string ratio;
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_TRUE(session_db.read(*context, name, ratio));
+    EXPECT_EQ(name, "component_" + std::to_string(i));
+    EXPECT_EQ(ratio, std::to_string(i) + "/3");
+  }
+  EXPECT_FALSE(session_db.read(*context, name, ratio));
+  session_db.endRead(*context);
+}
+
+TEST(SessionDB, ReadWhere)
+{
+  SessionDB session_db;
+  auto path_db = std::tmpnam(nullptr);
+  session_db.setDBFilePath(path_db);
+
+  auto context = session_db.beginWrite("table1", "feature_id", "INTEGER", "name", "TEXT");
+  ASSERT_TRUE(context);
+  for (int i = 0; i < 10; ++i)
+  {
+    session_db.write(*context, i % 3, "name_" + std::to_string(i));
+  }
+  session_db.write(*context, 42, "it's");
+  session_db.endWrite(*context);
+
+  // the same prepared statement is used for each feature id
+  for (int feature_id = 0; feature_id < 3; ++feature_id)
+  {
+    context = session_db.beginReadWhere("table1", "feature_id", feature_id, "name");
+    ASSERT_TRUE(context);
+    std::string name;
+    int n_rows = 0;
+    while (session_db.read(*context, name))
+    {
+      EXPECT_EQ(name, "name_" + std::to_string(n_rows * 3 + feature_id));
+      ++n_rows;
+    }
+    EXPECT_EQ(n_rows, feature_id == 0 ? 4 : 3);
+    session_db.endRead(*context);
+  }
+
+  // the value is bound, not pasted in the SQL
+  context = session_db.beginReadWhere("table1", "name", std::string("it's"), "feature_id");
+  ASSERT_TRUE(context);
+  int feature_id = 0;
+  EXPECT_TRUE(session_db.read(*context, feature_id));
+  EXPECT_EQ(feature_id, 42);
+  EXPECT_FALSE(session_db.read(*context, feature_id));
+  session_db.endRead(*context);
+}
+
+TEST(SessionDB, ConcurrentReads)
+{
+  SessionDB session_db;
+  auto path_db = std::tmpnam(nullptr);
+  session_db.setDBFilePath(path_db);
+
+  auto context = session_db.beginWrite("table1", "col1", "INT");
+  ASSERT_TRUE(context);
+  for (int i = 0; i < 100; ++i)
+  {
+    session_db.write(*context, i);
+  }
+  session_db.endWrite(*context);
+
+  // copies of the SessionDB share the connections to the session file
+  std::vector<std::thread> threads;
+  std::vector<int> sums(8, 0);
+  for (size_t t = 0; t < sums.size(); ++t)
+  {
+    threads.emplace_back([session_db, &sums, t]() mutable {
+      for (int n = 0; n < 10; ++n)
+      {
+        auto context = session_db.beginRead("table1", "col1");
+        if (!context) return;
+        int value = 0;
+        int sum = 0;
+        while (session_db.read(*context, value))
+        {
+          sum += value;
+        }
+        session_db.endRead(*context);
+        sums[t] = sum;
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  for (const int sum : sums)
+  {
+    EXPECT_EQ(sum, 4950);
+  }
+}
+
 struct PropertyHandlerTest : IPropertiesHandler
 {
   /**
@@ -669,19 +669,24 @@ TEST(SessionHandler, setFeatureTable1)
   EXPECT_EQ(table_data.headers_.size(), 23);
   EXPECT_STREQ(table_data.headers_(0).c_str(), "sample_name");
   EXPECT_STREQ(table_data.headers_(table_data.headers_.size() - 1).c_str(), "used_");
-  EXPECT_EQ(table_data.body_.dimension(0), 13);
-  EXPECT_EQ(table_data.body_.dimension(1), 23);
-  EXPECT_STREQ(table_data.body_(0, 0).c_str(), "150516_CM1_Level1");
-  EXPECT_STREQ(table_data.body_(table_data.body_.dimension(0) - 1, table_data.body_.dimension(1) - 1).c_str(), "true");
+  // the cells are formatted when displayed
+  EXPECT_EQ(table_data.body_.size(), 0);
+  ASSERT_NE(table_data.typed_body_, nullptr);
+  EXPECT_EQ(table_data.getNRows(), 13);
+  EXPECT_EQ(table_data.typed_body_->getNColumns(), 23);
+  EXPECT_STREQ(table_data.getText(0, 0).c_str(), "150516_CM1_Level1");
+  EXPECT_STREQ(table_data.getText(table_data.getNRows() - 1, table_data.headers_.size() - 1).c_str(), "true");
   session_handler.setMinimalDataAndFilters(testData.application_handler.sequenceHandler_);
   session_handler.setFeatureTable(testData.application_handler.sequenceHandler_, table_data);
   EXPECT_EQ(table_data.headers_.size(), 23);
   EXPECT_STREQ(table_data.headers_(0).c_str(), "sample_name");
   EXPECT_STREQ(table_data.headers_(table_data.headers_.size() - 1).c_str(), "used_");
-  EXPECT_EQ(table_data.body_.dimension(0), 13);
-  EXPECT_EQ(table_data.body_.dimension(1), 23);
-  EXPECT_STREQ(table_data.body_(0, 0).c_str(), "150516_CM1_Level1");
-  EXPECT_STREQ(table_data.body_(table_data.body_.dimension(0) - 1, table_data.body_.dimension(1) - 1).c_str(), "true");
+  EXPECT_EQ(table_data.body_.size(), 0);
+  ASSERT_NE(table_data.typed_body_, nullptr);
+  EXPECT_EQ(table_data.getNRows(), 13);
+  EXPECT_EQ(table_data.typed_body_->getNColumns(), 23);
+  EXPECT_STREQ(table_data.getText(0, 0).c_str(), "150516_CM1_Level1");
+  EXPECT_STREQ(table_data.getText(table_data.getNRows() - 1, table_data.headers_.size() - 1).c_str(), "true");
 }
 
 TEST(SessionHandler, setFeatureMatrix1)
@@ -690,6 +695,47 @@ TEST(SessionHandler, setFeatureMatrix1)
   SessionHandler session_handler;
   session_handler.setFeatureMatrix(testData.application_handler.sequenceHandler_);
 }
+
+TEST(SessionHandler, generations)
+{
+  TestData testData(true, true);
+  SessionHandler session_handler;
+  session_handler.setMinimalDataAndFilters(testData.application_handler.sequenceHandler_);
+  const auto sequence_table_generation = session_handler.sequence_table.generation_;
+  const auto transition_explorer_generation = session_handler.transition_explorer_data.generation_;
+  EXPECT_NE(sequence_table_generation, 0);
+  EXPECT_NE(transition_explorer_generation, 0);
+  // unchanged data keep their generation
+  session_handler.setMinimalDataAndFilters(testData.application_handler.sequenceHandler_);
+  EXPECT_EQ(session_handler.sequence_table.generation_, sequence_table_generation);
+  EXPECT_EQ(session_handler.transition_explorer_data.generation_, transition_explorer_generation);
+  SessionHandler::GenericTableData table_data;
+  session_handler.setFeatureTable(testData.application_handler.sequenceHandler_, table_data);
+  const auto feature_table_generation = table_data.generation_;
+  session_handler.setFeatureTable(testData.application_handler.sequenceHandler_, table_data);
+  EXPECT_EQ(table_data.generation_, feature_table_generation);
+  session_handler.setFeatureMatrix(testData.application_handler.sequenceHandler_);
+  const auto feature_matrix_generation = session_handler.feature_pivot_table.generation_;
+  session_handler.setFeatureMatrix(testData.application_handler.sequenceHandler_);
+  EXPECT_EQ(session_handler.feature_pivot_table.generation_, feature_matrix_generation);
+  // a change of the selection moves the generations
+  session_handler.transition_explorer_data.checkbox_body(0, 0) = true;
+  EXPECT_TRUE(session_handler.updateExplorerGeneration(session_handler.transition_explorer_data));
+  EXPECT_NE(session_handler.transition_explorer_data.generation_, transition_explorer_generation);
+  EXPECT_FALSE(session_handler.updateExplorerGeneration(session_handler.transition_explorer_data));
+  session_handler.setFeatureTable(testData.application_handler.sequenceHandler_, table_data);
+  EXPECT_NE(table_data.generation_, feature_table_generation);
+  session_handler.setFeatureMatrix(testData.application_handler.sequenceHandler_);
+  EXPECT_NE(session_handler.feature_pivot_table.generation_, feature_matrix_generation);
+  // so does an update of the features
+  const auto updated_feature_matrix_generation = session_handler.feature_pivot_table.generation_;
+  session_handler.onFeaturesUpdated();
+  session_handler.setFeatureMatrix(testData.application_handler.sequenceHandler_);
+  EXPECT_NE(session_handler.feature_pivot_table.generation_, updated_feature_matrix_generation);
+  // and an update of the sequence
+  session_handler.onSequenceUpdated();
+  EXPECT_NE(session_handler.sequence_table.generation_, sequence_table_generation);
+}
 TEST(SessionHandler, getSpectrumScatterPlot1)
 {
   TestData testData;
@@ -844,30 +890,40 @@ TEST(SessionHandler, GraphVizData)
   EXPECT_EQ(graph_viz_data.nb_points_, 12);
   EXPECT_EQ(graph_viz_data.max_nb_points_, 13);
 
-  // overflow
-  EXPECT_FALSE(graph_viz_data.addScatterData(scatter_data_x_1, scatter_data_y_1, "scatter_data1"));
-  EXPECT_FALSE(graph_viz_data.addScatterData(scatter_data_x_2, scatter_data_y_2, "scatter_data2"));
-  EXPECT_TRUE(std::equal(graph_viz_data.series_names_area_.begin(), graph_viz_data.series_names_area_.end(),
-    std::vector<std::string>({ "data1", "data2" }).begin()));
-  EXPECT_TRUE(std::equal(graph_viz_data.x_data_area_.begin(), graph_viz_data.x_data_area_.end(),
-    std::vector<std::vector<float>>({ { 1.0f, 10.0f, 5.0f }, { 201.0f, 210.0f, 205.0f } }).begin()));
-  EXPECT_TRUE(std::equal(graph_viz_data.y_data_area_.begin(), graph_viz_data.y_data_area_.end(),
-    std::vector<std::vector<float>>({ { 101.0f, 110.0f, 105.0f }, { 301.0f, 310.0f, 305.0f } }).begin()));
-  EXPECT_STREQ(graph_viz_data.x_axis_title_.c_str(), "x_axis");
-  EXPECT_STREQ(graph_viz_data.y_axis_title_.c_str(), "y_axis");
-  EXPECT_TRUE(graph_viz_data.z_data_area_.empty());
-  EXPECT_STREQ(graph_viz_data.z_axis_title_->c_str(), "z_axis");
-  EXPECT_TRUE(std::equal(graph_viz_data.series_names_scatter_.begin(), graph_viz_data.series_names_scatter_.end(),
-    std::vector<std::string>({ "scatter_data1", "scatter_data2" }).begin()));
-  EXPECT_TRUE(std::equal(graph_viz_data.x_data_scatter_.begin(), graph_viz_data.x_data_scatter_.end(),
-    std::vector<std::vector<float>>({ { 401.0f, 410.0f, 405.0f }, { 601.0f, 610.0f, 605.0f } }).begin()));
-  EXPECT_TRUE(std::equal(graph_viz_data.y_data_scatter_.begin(), graph_viz_data.y_data_scatter_.end(),
-    std::vector<std::vector<float>>({ { 501.0f, 510.0f, 505.0f }, { 701.0f, 710.0f, 705.0f } }).begin()));
+  // overflow: the series are kept, at a reduced resolution
+  graph_viz_data.overflow_series_points_ = 2;
+  EXPECT_TRUE(graph_viz_data.addScatterData(scatter_data_x_1, scatter_data_y_1, "scatter_data3"));
+  EXPECT_TRUE(graph_viz_data.addData(data_x_2, data_y_2, "data3"));
+  EXPECT_EQ(graph_viz_data.series_names_scatter_, std::vector<std::string>({ "scatter_data1", "scatter_data2", "scatter_data3" }));
+  EXPECT_EQ(graph_viz_data.x_data_scatter_.back(), std::vector<float>({ 401.0f, 410.0f }));
+  EXPECT_EQ(graph_viz_data.y_data_scatter_.back(), std::vector<float>({ 501.0f, 510.0f }));
+  EXPECT_EQ(graph_viz_data.series_names_area_, std::vector<std::string>({ "data1", "data2", "data3" }));
+  EXPECT_EQ(graph_viz_data.x_data_area_.back(), std::vector<float>({ 201.0f, 210.0f }));
+  EXPECT_EQ(graph_viz_data.y_data_area_.back(), std::vector<float>({ 301.0f, 310.0f }));
+  EXPECT_EQ(graph_viz_data.pyramids_area_.size(), 3);
   EXPECT_NEAR(graph_viz_data.x_min_, 1.0f, 1e-6);
   EXPECT_NEAR(graph_viz_data.x_max_, 610.0f, 1e-6);
   EXPECT_NEAR(graph_viz_data.y_min_, 101.0f, 1e-6);
   EXPECT_NEAR(graph_viz_data.y_max_, 710.0f, 1e-6);
   EXPECT_TRUE(graph_viz_data.points_overflow_);
-  EXPECT_EQ(graph_viz_data.nb_points_, 12);
+  EXPECT_EQ(graph_viz_data.nb_points_, 16);
   EXPECT_EQ(graph_viz_data.max_nb_points_, 13);
+
+  // level of details
+  const auto view = graph_viz_data.getAreaView(0, 0.0, 1000.0, 100);
+  EXPECT_EQ(view.size, 3);
+  EXPECT_EQ(view.x, graph_viz_data.x_data_area_.at(0).data());
+
+  // the levels of details are reused for the same series until the data change
+  const auto pyramid_data1 = graph_viz_data.pyramids_area_.at(0);
+  const auto pyramid_data3 = graph_viz_data.pyramids_area_.at(2);
+  graph_viz_data.reset("x", "y", {}, 100);
+  EXPECT_TRUE(graph_viz_data.addData(data_x_2, data_y_2, "data3"));
+  EXPECT_TRUE(graph_viz_data.addData(data_x_1, data_y_1, "data1"));
+  EXPECT_EQ(graph_viz_data.pyramids_area_.at(1), pyramid_data1);
+  EXPECT_NE(graph_viz_data.pyramids_area_.at(0), pyramid_data3); // was added at a reduced resolution
+  graph_viz_data.invalidateSeries();
+  graph_viz_data.reset("x", "y", {}, 100);
+  EXPECT_TRUE(graph_viz_data.addData(data_x_1, data_y_1, "data1"));
+  EXPECT_NE(graph_viz_data.pyramids_area_.at(0), pyramid_data1);
 }
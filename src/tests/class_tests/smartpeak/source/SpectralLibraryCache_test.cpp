@@ -0,0 +1,144 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <gtest/gtest.h>
+#include <SmartPeak/core/SpectralLibraryCache.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace SmartPeak;
+
+namespace
+{
+  void writeLibrary(const std::filesystem::path& path, size_t n_spectra)
+  {
+    std::ofstream stream(path);
+    for (size_t i = 0; i < n_spectra; ++i)
+    {
+      stream << "Name: compound_" << i << "\n";
+      stream << "Num Peaks: 3\n";
+      stream << 100 + i << " 10\n" << 150 + i << " 100\n" << 200 + i << " 50\n\n";
+    }
+  }
+
+  struct SpectralLibraryCacheFixture : public ::testing::Test
+  {
+    SpectralLibraryCacheFixture()
+    {
+      const std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+      dir_ = std::filesystem::temp_directory_path() / ("SpectralLibraryCache_test_" + test_name);
+      std::filesystem::create_directories(dir_);
+    }
+    ~SpectralLibraryCacheFixture()
+    {
+      std::filesystem::remove_all(dir_);
+    }
+    std::filesystem::path dir_;
+  };
+}
+
+TEST_F(SpectralLibraryCacheFixture, getComparator)
+{
+  const auto path = dir_ / "library.msp";
+  writeLibrary(path, 2);
+  SpectralLibraryCache cache;
+  auto cmp1 = cache.getComparator(path);
+  auto cmp2 = cache.getComparator(path);
+  ASSERT_NE(cmp1, nullptr);
+  EXPECT_EQ(cmp1, cmp2);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_GT(cache.getMemoryUsage(), 0);
+
+  // modified on disk
+  writeLibrary(path, 3);
+  std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(10));
+  auto cmp3 = cache.getComparator(path);
+  EXPECT_NE(cmp1, cmp3);
+  EXPECT_EQ(cache.size(), 1);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.getMemoryUsage(), 0);
+}
+
+TEST_F(SpectralLibraryCacheFixture, getComparator_missing_file)
+{
+  SpectralLibraryCache cache;
+  EXPECT_ANY_THROW(cache.getComparator(dir_ / "missing.msp"));
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(SpectralLibraryCacheFixture, eviction)
+{
+  const auto path_a = dir_ / "library_a.msp";
+  const auto path_b = dir_ / "library_b.msp";
+  writeLibrary(path_a, 10);
+  writeLibrary(path_b, 10);
+  SpectralLibraryCache cache;
+  auto cmp_a = cache.getComparator(path_a);
+  const size_t library_memory = cache.getMemoryUsage();
+  cache.setMemoryLimit(library_memory + library_memory / 2);
+
+  // library_a is the least recently used
+  auto cmp_b = cache.getComparator(path_b);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.getMemoryUsage(), library_memory);
+  EXPECT_EQ(cache.getComparator(path_b), cmp_b);
+  EXPECT_NE(cache.getComparator(path_a), cmp_a);
+  EXPECT_EQ(cache.size(), 1);
+
+  // a library larger than the limit is not cached
+  cache.setMemoryLimit(library_memory / 2);
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_NE(cache.getComparator(path_a), nullptr);
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.getMemoryUsage(), 0);
+}
+
+TEST_F(SpectralLibraryCacheFixture, concurrent_getComparator)
+{
+  const auto path = dir_ / "library.msp";
+  writeLibrary(path, 100);
+  SpectralLibraryCache cache;
+  const size_t n_threads = 8;
+  std::vector<std::shared_ptr<const SpectralLibraryCache::Comparator>> comparators(n_threads);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < n_threads; ++i)
+  {
+    threads.emplace_back([&, i]() { comparators[i] = cache.getComparator(path); });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  for (const auto& comparator : comparators)
+  {
+    ASSERT_NE(comparator, nullptr);
+    EXPECT_EQ(comparator, comparators.front());
+  }
+  EXPECT_EQ(cache.size(), 1);
+}
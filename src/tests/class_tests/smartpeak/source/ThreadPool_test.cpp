@@ -0,0 +1,124 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <SmartPeak/core/ThreadPool.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace SmartPeak;
+
+TEST(ThreadPool, constructor)
+{
+  ThreadPool pool(3);
+  EXPECT_EQ(pool.size(), 3);
+  EXPECT_FALSE(pool.isWorkerThread());
+
+  ThreadPool pool_default;
+  EXPECT_GE(pool_default.size(), 1);
+  EXPECT_GE(ThreadPool::instance().size(), 1);
+}
+
+TEST(ThreadPool, submit)
+{
+  ThreadPool pool(4);
+  std::atomic_int count { 0 };
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 1000; ++i) {
+    futures.emplace_back(pool.submit([&count, &pool]() {
+      EXPECT_TRUE(pool.isWorkerThread());
+      ++count;
+    }));
+  }
+  for (std::future<void>& f : futures) {
+    pool.wait(f);
+    f.get();
+  }
+  EXPECT_EQ(count, 1000);
+}
+
+TEST(ThreadPool, submit_exception)
+{
+  ThreadPool pool(2);
+  std::future<void> f = pool.submit([]() { throw std::invalid_argument("error"); });
+  pool.wait(f);
+  EXPECT_THROW(f.get(), std::invalid_argument);
+}
+
+TEST(ThreadPool, cancellation)
+{
+  ThreadPool pool(1);
+  std::atomic_bool release { false };
+  std::atomic_int count { 0 };
+
+  // keep the only worker busy so that the next tasks stay queued
+  std::future<void> blocker = pool.submit([&release]() {
+    while (!release) std::this_thread::yield();
+  });
+  CancellationToken token_cancelled;
+  CancellationToken token_running;
+  std::future<void> f1 = pool.submit([&count]() { ++count; }, token_cancelled);
+  std::future<void> f2 = pool.submit([&count]() { count += 10; }, token_running);
+  token_cancelled.cancel();
+  EXPECT_TRUE(token_cancelled.isCancelled());
+  EXPECT_FALSE(token_running.isCancelled());
+  release = true;
+
+  pool.wait(blocker);
+  pool.wait(f1);
+  pool.wait(f2);
+  EXPECT_NO_THROW(f1.get());
+  EXPECT_NO_THROW(f2.get());
+  EXPECT_EQ(count, 10);
+
+  // copies share the same flag
+  CancellationToken token_copy = token_running;
+  token_copy.cancel();
+  EXPECT_TRUE(token_running.isCancelled());
+}
+
+TEST(ThreadPool, nested_wait)
+{
+  // every worker waits for sub-tasks; waiting workers execute queued tasks
+  // instead of blocking, so this cannot dead-lock
+  ThreadPool pool(2);
+  std::atomic_int count { 0 };
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 8; ++i) {
+    futures.emplace_back(pool.submit([&count, &pool]() {
+      std::vector<std::future<void>> sub_futures;
+      for (int j = 0; j < 8; ++j) {
+        sub_futures.emplace_back(pool.submit([&count]() { ++count; }));
+      }
+      for (std::future<void>& f : sub_futures) {
+        pool.wait(f);
+      }
+    }));
+  }
+  for (std::future<void>& f : futures) {
+    pool.wait(f);
+  }
+  EXPECT_EQ(count, 64);
+}
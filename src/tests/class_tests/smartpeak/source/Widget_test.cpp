@@ -39,6 +39,8 @@
 #include <SmartPeak/core/RawDataProcessors/LoadFeatures.h>
 #include <SmartPeak/core/ApplicationProcessors/SaveSession.h>
 
+#include <cmath>
+
 using namespace SmartPeak;
 
 bool SmartPeak::enable_quick_help = false;
@@ -199,6 +201,49 @@ TEST(Widget, GenericTableWidget_searcher)
   }
 }
 
+TEST(TableSorter, parseNumbers)
+{
+  std::vector<double> numbers;
+  EXPECT_TRUE(TableSorter::parseNumbers({ "10", "", "-1.5", "2e3" }, numbers));
+  ASSERT_EQ(numbers.size(), 4);
+  EXPECT_DOUBLE_EQ(numbers[0], 10.0);
+  EXPECT_TRUE(std::isnan(numbers[1]));
+  EXPECT_DOUBLE_EQ(numbers[2], -1.5);
+  EXPECT_DOUBLE_EQ(numbers[3], 2000.0);
+  EXPECT_FALSE(TableSorter::parseNumbers({ "10", "150516_CM1_Level1" }, numbers));
+  EXPECT_TRUE(numbers.empty());
+}
+
+TEST(TableSorter, sortRows)
+{
+  // numeric values are not sorted as text, missing values come last
+  TableSorter::SortColumn numeric_column;
+  numeric_column.texts = { "10", "9", "", "100" };
+  EXPECT_EQ(TableSorter::sortRows({ numeric_column }, 4), std::vector<size_t>({ 1, 0, 3, 2 }));
+  numeric_column.ascending = false;
+  EXPECT_EQ(TableSorter::sortRows({ numeric_column }, 4), std::vector<size_t>({ 3, 0, 1, 2 }));
+
+  // typed numbers
+  TableSorter::SortColumn typed_column;
+  typed_column.numbers = { 3.0, 1.0, 2.0 };
+  EXPECT_EQ(TableSorter::sortRows({ typed_column }, 3), std::vector<size_t>({ 1, 2, 0 }));
+
+  // text values, ties sorted by the next column
+  TableSorter::SortColumn text_column;
+  text_column.texts = { "b", "A", "b", "a10", "a9" };
+  EXPECT_EQ(TableSorter::sortRows({ text_column }, 5), std::vector<size_t>({ 1, 4, 3, 0, 2 }));
+  TableSorter::SortColumn second_column;
+  second_column.texts = { "2", "1", "1", "1", "1" };
+  EXPECT_EQ(TableSorter::sortRows({ text_column, second_column }, 5), std::vector<size_t>({ 1, 4, 3, 2, 0 }));
+
+  EXPECT_THROW(TableSorter::sortRows({ text_column }, 3), std::invalid_argument);
+  // the numbers are sorted, matching texts do not hide a short numbers vector
+  TableSorter::SortColumn short_column;
+  short_column.texts = { "1", "2", "3" };
+  short_column.numbers = { 1.0, 2.0 };
+  EXPECT_THROW(TableSorter::sortRows({ short_column }, 3), std::invalid_argument);
+}
+
 class GraphicDataVizWidget_Test : public GraphicDataVizWidget
 {
 public:
@@ -26,6 +26,12 @@
 #include <SmartPeak/core/WorkflowManager.h>
 #include <SmartPeak/core/ApplicationProcessors/BuildCommandsFromNames.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using namespace SmartPeak;
 using namespace std;
@@ -59,4 +65,255 @@ TEST(WorkflowManager, isMissingRequirements)
   EXPECT_TRUE(workflow_manager.isMissingRequirements(filenames, requirements));
   filenames.setFullPath("sequence", SMARTPEAK_GET_TEST_DATA_PATH("SequenceParser_sequence_1.csv"));
   EXPECT_FALSE(workflow_manager.isMissingRequirements(filenames, requirements));
-}
\ No newline at end of file
+}
+
+namespace
+{
+  /** Blocks the processing until it is opened */
+  struct Gate
+  {
+    explicit Gate(bool open = false) : open_(open) {}
+    void open()
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      open_ = true;
+      cv_.notify_all();
+    }
+    void wait()
+    {
+      ++n_waiting_;
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return open_; });
+    }
+    std::atomic_size_t n_waiting_ { 0 };
+    bool open_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+  };
+
+  /** Adds a feature to each injection, once the gate is open */
+  struct GatedRawDataProcessor : RawDataProcessor
+  {
+    explicit GatedRawDataProcessor(std::shared_ptr<Gate> gate) : gate_(gate) {}
+    std::string getName() const override { return "GATED"; }
+    std::string getDescription() const override { return ""; }
+    void doProcess(RawDataHandler& rawDataHandler_IO, const ParameterSet& params_I, Filenames& filenames_I) const override
+    {
+      gate_->wait();
+      rawDataHandler_IO.getFeatureMap().push_back(OpenMS::Feature());
+    }
+    std::shared_ptr<Gate> gate_;
+  };
+
+  bool waitFor(const std::function<bool()>& predicate)
+  {
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!predicate())
+    {
+      if (std::chrono::steady_clock::now() > timeout)
+      {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  /** Two sessions of 3 injections */
+  struct WorkflowManagerFixture : public ::testing::Test
+  {
+    WorkflowManagerFixture()
+    {
+      for (ApplicationHandler* application_handler : { &application_handler_, &other_application_handler_ })
+      {
+        std::vector<InjectionHandler> sequence;
+        for (size_t i = 0; i < 3; ++i)
+        {
+          InjectionHandler injection;
+          injection.getMetaData().setSampleName("sample_" + std::to_string(i));
+          injection.getRawData().setMetaData(injection.getMetaDataShared());
+          sequence.push_back(injection);
+        }
+        application_handler->sequenceHandler_.setSequence(sequence);
+      }
+    }
+
+    std::vector<ApplicationHandler::Command> gatedWorkflow(std::shared_ptr<Gate> gate)
+    {
+      ApplicationHandler::Command cmd;
+      cmd.setMethod(std::shared_ptr<RawDataProcessor>(std::make_shared<GatedRawDataProcessor>(gate)));
+      for (const InjectionHandler& injection : application_handler_.sequenceHandler_.getSequence())
+      {
+        cmd.dynamic_filenames[injection.getMetaData().getInjectionName()] = Filenames();
+      }
+      return { cmd };
+    }
+
+    size_t submit(WorkflowManager& workflow_manager, const ApplicationHandler& application_handler, std::shared_ptr<Gate> gate)
+    {
+      return workflow_manager.submitWorkflow(application_handler, {}, {}, {}, gatedWorkflow(gate), 2);
+    }
+
+    ApplicationHandler application_handler_;
+    ApplicationHandler other_application_handler_;
+  };
+}
+
+TEST_F(WorkflowManagerFixture, submitWorkflow)
+{
+  WorkflowManager workflow_manager;
+  EXPECT_EQ(workflow_manager.getMaxConcurrentWorkflows(), 1);
+  const size_t job_id = submit(workflow_manager, application_handler_, std::make_shared<Gate>(true));
+  EXPECT_EQ(workflow_manager.getJobIds(), std::vector<size_t>({ job_id }));
+  EXPECT_EQ(workflow_manager.waitForJob(job_id), WorkflowJobStatus::FINISHED);
+  EXPECT_EQ(workflow_manager.getJobStatus(job_id), WorkflowJobStatus::FINISHED);
+  EXPECT_EQ(workflow_manager.getNumberOfRunningWorkflows(), 0);
+
+  const auto result = workflow_manager.releaseJob(job_id);
+  ASSERT_NE(result, nullptr);
+  for (const auto& injection : result->sequenceHandler_.getSequence())
+  {
+    EXPECT_EQ(injection.getRawData().getFeatureMap().size(), 1);
+  }
+  EXPECT_TRUE(workflow_manager.getJobIds().empty());
+  EXPECT_THROW(workflow_manager.getJobStatus(job_id), std::out_of_range);
+  // the workflows of submitWorkflow are not the one of addWorkflow
+  EXPECT_TRUE(workflow_manager.isWorkflowDone());
+}
+
+TEST_F(WorkflowManagerFixture, concurrentWorkflows)
+{
+  WorkflowManager workflow_manager(2);
+  auto gate = std::make_shared<Gate>();
+  const size_t job_1 = submit(workflow_manager, application_handler_, gate);
+  const size_t job_2 = submit(workflow_manager, other_application_handler_, gate);
+  const size_t job_3 = submit(workflow_manager, application_handler_, gate);
+  EXPECT_EQ(workflow_manager.getJobStatus(job_1), WorkflowJobStatus::RUNNING);
+  EXPECT_EQ(workflow_manager.getJobStatus(job_2), WorkflowJobStatus::RUNNING);
+  EXPECT_EQ(workflow_manager.getJobStatus(job_3), WorkflowJobStatus::QUEUED);
+  EXPECT_EQ(workflow_manager.getNumberOfRunningWorkflows(), 2);
+  EXPECT_THROW(workflow_manager.releaseJob(job_1), std::logic_error);
+
+  gate->open();
+  for (const size_t job_id : { job_1, job_2, job_3 })
+  {
+    EXPECT_EQ(workflow_manager.waitForJob(job_id), WorkflowJobStatus::FINISHED);
+  }
+  EXPECT_EQ(workflow_manager.getNumberOfRunningWorkflows(), 0);
+}
+
+TEST_F(WorkflowManagerFixture, cancelJob)
+{
+  WorkflowManager workflow_manager;
+  auto gate = std::make_shared<Gate>();
+  const size_t job_1 = submit(workflow_manager, application_handler_, gate);
+  const size_t job_2 = submit(workflow_manager, other_application_handler_, gate);
+  ASSERT_TRUE(waitFor([&gate]() { return gate->n_waiting_ > 0; }));
+  EXPECT_EQ(workflow_manager.getJobStatus(job_2), WorkflowJobStatus::QUEUED);
+
+  EXPECT_TRUE(workflow_manager.cancelJob(job_2));
+  EXPECT_EQ(workflow_manager.getJobStatus(job_2), WorkflowJobStatus::CANCELLED);
+  EXPECT_TRUE(workflow_manager.cancelJob(job_1));
+  gate->open();
+  EXPECT_EQ(workflow_manager.waitForJob(job_1), WorkflowJobStatus::CANCELLED);
+  EXPECT_FALSE(workflow_manager.cancelJob(job_1));
+  EXPECT_FALSE(workflow_manager.cancelJob(12345));
+}
+
+TEST_F(WorkflowManagerFixture, isolatedJobs)
+{
+  // the injections share their parameters, as in a loaded session
+  auto& sequence = application_handler_.sequenceHandler_.getSequence();
+  for (auto& injection : sequence)
+  {
+    injection.getRawData().setParameters(sequence.front().getRawData().getParametersShared());
+  }
+
+  // two jobs running on the same session at the same time
+  WorkflowManager workflow_manager(2);
+  auto gate = std::make_shared<Gate>();
+  const size_t job_1 = submit(workflow_manager, application_handler_, gate);
+  const size_t job_2 = submit(workflow_manager, application_handler_, gate);
+  EXPECT_EQ(workflow_manager.getJobStatus(job_1), WorkflowJobStatus::RUNNING);
+  EXPECT_EQ(workflow_manager.getJobStatus(job_2), WorkflowJobStatus::RUNNING);
+  gate->open();
+  EXPECT_EQ(workflow_manager.waitForJob(job_1), WorkflowJobStatus::FINISHED);
+  EXPECT_EQ(workflow_manager.waitForJob(job_2), WorkflowJobStatus::FINISHED);
+  // a job submitted once the previous ones have ended
+  const size_t job_3 = submit(workflow_manager, application_handler_, gate);
+  EXPECT_EQ(workflow_manager.waitForJob(job_3), WorkflowJobStatus::FINISHED);
+
+  const std::vector<std::shared_ptr<ApplicationHandler>> results = {
+    workflow_manager.releaseJob(job_1), workflow_manager.releaseJob(job_2), workflow_manager.releaseJob(job_3) };
+  for (size_t i = 0; i < sequence.size(); ++i)
+  {
+    // the source is left unchanged
+    EXPECT_EQ(sequence[i].getRawData().getFeatureMap().size(), 0);
+    for (size_t j = 0; j < results.size(); ++j)
+    {
+      const auto& result_sequence = results[j]->sequenceHandler_.getSequence();
+      const auto& injection = result_sequence.at(i);
+      // each job only sees its own feature
+      EXPECT_EQ(injection.getRawData().getFeatureMap().size(), 1);
+      EXPECT_NE(&injection.getRawData(), &sequence[i].getRawData());
+      EXPECT_NE(&injection.getMetaData(), &sequence[i].getMetaData());
+      EXPECT_NE(&injection.getRawData().getParameters(), &sequence[i].getRawData().getParameters());
+      if (j > 0)
+      {
+        EXPECT_NE(&injection.getRawData(), &results[j - 1]->sequenceHandler_.getSequence().at(i).getRawData());
+      }
+      // the copies are shared like the original data
+      EXPECT_EQ(&injection.getRawData().getMetaData(), &injection.getMetaData());
+      EXPECT_EQ(&injection.getRawData().getParameters(), &result_sequence.front().getRawData().getParameters());
+    }
+  }
+}
+
+TEST_F(WorkflowManagerFixture, isolatedJobCopiesWrittenData)
+{
+  auto& sequence = application_handler_.sequenceHandler_.getSequence();
+  for (auto& injection : sequence)
+  {
+    injection.getRawData().setParameters(sequence.front().getRawData().getParametersShared());
+  }
+
+  // a job processing the second injection only
+  WorkflowManager workflow_manager;
+  const std::string injection_name = sequence[1].getMetaData().getInjectionName();
+  const size_t job_id = workflow_manager.submitWorkflow(application_handler_, { injection_name }, {}, {},
+                                                        gatedWorkflow(std::make_shared<Gate>(true)), 2);
+  EXPECT_EQ(workflow_manager.waitForJob(job_id), WorkflowJobStatus::FINISHED);
+  const auto result = workflow_manager.releaseJob(job_id);
+  const auto& result_sequence = result->sequenceHandler_.getSequence();
+
+  // the processed injection and the data it shares are copied
+  EXPECT_EQ(result_sequence[1].getRawData().getFeatureMap().size(), 1);
+  EXPECT_EQ(sequence[1].getRawData().getFeatureMap().size(), 0);
+  EXPECT_NE(&result_sequence[1].getRawData(), &sequence[1].getRawData());
+  EXPECT_NE(&result_sequence[1].getRawData().getParameters(), &sequence[1].getRawData().getParameters());
+  // the other injections are still shared with the source
+  for (const size_t i : { 0, 2 })
+  {
+    EXPECT_EQ(&result_sequence[i].getRawData(), &sequence[i].getRawData());
+    EXPECT_EQ(&result_sequence[i].getRawData().getParameters(), &sequence[i].getRawData().getParameters());
+    EXPECT_EQ(result_sequence[i].getRawData().getFeatureMap().size(), 0);
+  }
+}
+
+TEST_F(WorkflowManagerFixture, addWorkflow)
+{
+  WorkflowManager workflow_manager(2);
+  workflow_manager.addWorkflow(application_handler_, {}, {}, {}, gatedWorkflow(std::make_shared<Gate>(true)), 2, nullptr, nullptr, nullptr, nullptr, true);
+  EXPECT_TRUE(workflow_manager.isWorkflowDone());
+  // the workflow writes to the data shared with the source
+  EXPECT_EQ(application_handler_.sequenceHandler_.getSequence().front().getRawData().getFeatureMap().size(), 1);
+
+  auto gate = std::make_shared<Gate>();
+  workflow_manager.addWorkflow(application_handler_, {}, {}, {}, gatedWorkflow(gate), 2);
+  EXPECT_FALSE(workflow_manager.isWorkflowDone());
+  gate->open();
+  ASSERT_TRUE(waitFor([&workflow_manager]() { return workflow_manager.isWorkflowDone(); }));
+  workflow_manager.updateApplicationHandler(application_handler_);
+  EXPECT_EQ(application_handler_.sequenceHandler_.getSequence().front().getRawData().getFeatureMap().size(), 2);
+  EXPECT_TRUE(workflow_manager.getJobIds().empty());
+}
@@ -0,0 +1,257 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <SmartPeak/core/WorkflowScheduler.h>
+#include <SmartPeak/core/ApplicationHandler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace SmartPeak;
+
+namespace
+{
+  /** Records the start and end of each processed item */
+  struct ProcessingLog
+  {
+    void add(const std::string& event)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.push_back(event);
+      }
+      event_added_.notify_all();
+    }
+    /** @brief wait for an event to be recorded, returns false on timeout */
+    bool waitFor(const std::string& event, std::chrono::milliseconds timeout)
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      return event_added_.wait_for(lock, timeout, [&]() { return position(event) < events_.size(); });
+    }
+    size_t position(const std::string& event) const
+    {
+      auto it = std::find(events_.begin(), events_.end(), event);
+      return (it == events_.end()) ? events_.size() : std::distance(events_.begin(), it);
+    }
+    std::vector<std::string> events_;
+    std::mutex mutex_;
+    std::condition_variable event_added_;
+  };
+
+  struct RecordingRawDataProcessor : RawDataProcessor
+  {
+    RecordingRawDataProcessor(const std::string& name, std::shared_ptr<ProcessingLog> log) : name_(name), log_(log) {}
+    std::string getName() const override { return name_; }
+    std::string getDescription() const override { return ""; }
+    void doProcess(RawDataHandler& rawDataHandler_IO, const ParameterSet& params_I, Filenames& filenames_I) const override
+    {
+      const std::string sample_name = rawDataHandler_IO.getMetaData().getSampleName();
+      log_->add(name_ + " start " + sample_name);
+      if (sample_name == wait_sample_name_)
+      {
+        log_->waitFor(wait_event_, std::chrono::seconds(10));
+      }
+      log_->add(name_ + " end " + sample_name);
+    }
+    std::string name_;
+    std::shared_ptr<ProcessingLog> log_;
+    std::string wait_sample_name_; ///< injection that is processed once wait_event_ is recorded
+    std::string wait_event_;
+  };
+
+  struct RecordingSampleGroupProcessor : SampleGroupProcessor
+  {
+    RecordingSampleGroupProcessor(std::shared_ptr<ProcessingLog> log) : log_(log) {}
+    std::string getName() const override { return "GROUP"; }
+    std::string getDescription() const override { return ""; }
+    ParameterSet getParameterSchema() const override { return ParameterSet(); }
+    void doProcess(SampleGroupHandler& sampleGroupHandler_IO, const SequenceHandler& sequenceHandler_I, const ParameterSet& params_I, Filenames& filenames_I) const override
+    {
+      log_->add("GROUP start " + sampleGroupHandler_IO.getSampleGroupName());
+      log_->add("GROUP end " + sampleGroupHandler_IO.getSampleGroupName());
+    }
+    std::shared_ptr<ProcessingLog> log_;
+  };
+
+  struct RecordingSequenceSegmentProcessor : SequenceSegmentProcessor
+  {
+    RecordingSequenceSegmentProcessor(std::shared_ptr<ProcessingLog> log) : log_(log) {}
+    std::string getName() const override { return "SEGMENT"; }
+    std::string getDescription() const override { return ""; }
+    ParameterSet getParameterSchema() const override { return ParameterSet(); }
+    void doProcess(SequenceSegmentHandler& sequenceSegmentHandler_IO, const SequenceHandler& sequenceHandler_I, const ParameterSet& params_I, Filenames& filenames_I) const override
+    {
+      log_->add("SEGMENT start " + sequenceSegmentHandler_IO.getSequenceSegmentName());
+      log_->add("SEGMENT end " + sequenceSegmentHandler_IO.getSequenceSegmentName());
+    }
+    std::shared_ptr<ProcessingLog> log_;
+  };
+
+  /**
+    6 injections, 2 sequence segments and 2 sample groups.
+    Injections 0-2 belong to segment_0 and group_0, injections 3-5 to segment_1 and group_1.
+  */
+  struct WorkflowSchedulerFixture : public ::testing::Test
+  {
+    WorkflowSchedulerFixture()
+    {
+      std::vector<InjectionHandler> sequence;
+      std::vector<SequenceSegmentHandler> segments(2);
+      std::vector<SampleGroupHandler> groups(2);
+      for (size_t i = 0; i < 2; ++i)
+      {
+        segments[i].setSequenceSegmentName("segment_" + std::to_string(i));
+        groups[i].setSampleGroupName("group_" + std::to_string(i));
+      }
+      for (size_t i = 0; i < 6; ++i)
+      {
+        InjectionHandler injection;
+        injection.getMetaData().setSampleName("sample_" + std::to_string(i));
+        injection.getRawData().setMetaData(injection.getMetaDataShared());
+        sequence.push_back(injection);
+        segments[i / 3].getSampleIndices().push_back(i);
+        groups[i / 3].getSampleIndices().push_back(i);
+      }
+      sequence_handler_.setSequence(sequence);
+      sequence_handler_.setSequenceSegments(segments);
+      sequence_handler_.setSampleGroups(groups);
+    }
+
+    ApplicationHandler::Command rawDataCommand(const std::string& name)
+    {
+      ApplicationHandler::Command cmd;
+      cmd.setMethod(std::shared_ptr<RawDataProcessor>(std::make_shared<RecordingRawDataProcessor>(name, log_)));
+      for (const InjectionHandler& injection : sequence_handler_.getSequence())
+      {
+        cmd.dynamic_filenames[injection.getMetaData().getInjectionName()] = Filenames();
+      }
+      return cmd;
+    }
+
+    ApplicationHandler::Command sequenceSegmentCommand()
+    {
+      ApplicationHandler::Command cmd;
+      cmd.setMethod(std::shared_ptr<SequenceSegmentProcessor>(std::make_shared<RecordingSequenceSegmentProcessor>(log_)));
+      for (const SequenceSegmentHandler& segment : sequence_handler_.getSequenceSegments())
+      {
+        cmd.dynamic_filenames[segment.getSequenceSegmentName()] = Filenames();
+      }
+      return cmd;
+    }
+
+    ApplicationHandler::Command sampleGroupCommand()
+    {
+      ApplicationHandler::Command cmd;
+      cmd.setMethod(std::shared_ptr<SampleGroupProcessor>(std::make_shared<RecordingSampleGroupProcessor>(log_)));
+      for (const SampleGroupHandler& group : sequence_handler_.getSampleGroups())
+      {
+        cmd.dynamic_filenames[group.getSampleGroupName()] = Filenames();
+      }
+      return cmd;
+    }
+
+    SequenceHandler sequence_handler_;
+    std::shared_ptr<ProcessingLog> log_ = std::make_shared<ProcessingLog>();
+  };
+}
+
+TEST_F(WorkflowSchedulerFixture, dependencies)
+{
+  WorkflowScheduler scheduler(sequence_handler_);
+  scheduler.addRawDataStage(0, { rawDataCommand("RAW1"), rawDataCommand("RAW2") }, {});
+  scheduler.addSequenceSegmentStage(2, { sequenceSegmentCommand() }, {});
+  const std::string injection_name = sequence_handler_.getSequence().front().getMetaData().getInjectionName();
+  scheduler.addRawDataStage(3, { rawDataCommand("RAW3") }, { injection_name });
+  scheduler.addSampleGroupStage(4, { sampleGroupCommand() }, {});
+
+  ASSERT_EQ(scheduler.getNumberOfTasks(), 6 + 2 + 1 + 2);
+  // first raw data stage
+  for (size_t i = 0; i < 6; ++i)
+  {
+    EXPECT_TRUE(scheduler.getDependencies(i).empty());
+  }
+  // sequence segments wait for their own injections only
+  EXPECT_EQ(scheduler.getDependencies(6), std::vector<size_t>({ 0, 1, 2 }));
+  EXPECT_EQ(scheduler.getDependencies(7), std::vector<size_t>({ 3, 4, 5 }));
+  // selected injection waits for its sequence segment
+  EXPECT_EQ(scheduler.getDependencies(8), std::vector<size_t>({ 6 }));
+  // sample groups wait for the latest task of each of their injections
+  EXPECT_EQ(scheduler.getDependencies(9), std::vector<size_t>({ 6, 8 }));
+  EXPECT_EQ(scheduler.getDependencies(10), std::vector<size_t>({ 7 }));
+}
+
+TEST_F(WorkflowSchedulerFixture, run)
+{
+  WorkflowScheduler scheduler(sequence_handler_);
+  ApplicationHandler::Command raw_data_command = rawDataCommand("RAW1");
+  const bool concurrent = std::thread::hardware_concurrency() > 1;
+  if (concurrent)
+  {
+    // the last injection is done only once segment_0 and group_0 are done
+    auto processor = std::dynamic_pointer_cast<RecordingRawDataProcessor>(raw_data_command.raw_data_method);
+    processor->wait_sample_name_ = "sample_5";
+    processor->wait_event_ = "GROUP end group_0";
+  }
+  scheduler.addRawDataStage(0, { raw_data_command }, {});
+  scheduler.addSequenceSegmentStage(1, { sequenceSegmentCommand() }, {});
+  scheduler.addSampleGroupStage(2, { sampleGroupCommand() }, {});
+  scheduler.run(4);
+
+  const ProcessingLog& log = *log_;
+  ASSERT_EQ(log.events_.size(), 6 * 2 + 2 * 2 + 2 * 2);
+  for (size_t i = 0; i < 6; ++i)
+  {
+    const std::string sample_name = "sample_" + std::to_string(i);
+    const std::string segment_name = "segment_" + std::to_string(i / 3);
+    const std::string group_name = "group_" + std::to_string(i / 3);
+    EXPECT_LT(log.position("RAW1 end " + sample_name), log.position("SEGMENT start " + segment_name));
+    EXPECT_LT(log.position("SEGMENT end " + segment_name), log.position("GROUP start " + group_name));
+  }
+  // segment_0 and group_0 do not wait for the last injection of segment_1
+  if (concurrent)
+  {
+    EXPECT_LT(log.position("GROUP end group_0"), log.position("RAW1 end sample_5"));
+  }
+}
+
+TEST_F(WorkflowSchedulerFixture, run_empty_stage)
+{
+  WorkflowScheduler scheduler(sequence_handler_);
+  scheduler.addRawDataStage(0, { rawDataCommand("RAW1") }, { "unknown_injection" });
+  EXPECT_EQ(scheduler.getNumberOfTasks(), 0);
+  scheduler.run(2);
+  EXPECT_TRUE(log_->events_.empty());
+}
+
+TEST_F(WorkflowSchedulerFixture, addStage_wrong_filenames)
+{
+  WorkflowScheduler scheduler(sequence_handler_);
+  ApplicationHandler::Command cmd = rawDataCommand("RAW1");
+  cmd.dynamic_filenames.clear();
+  EXPECT_THROW(scheduler.addRawDataStage(0, { cmd }, {}), std::invalid_argument);
+  EXPECT_THROW(scheduler.addRawDataStage(0, {}, {}), std::invalid_argument);
+}
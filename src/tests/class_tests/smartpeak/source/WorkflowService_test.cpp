@@ -0,0 +1,171 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation 
+// Center for Biosustainability, Technical University of Denmark 2018-2021.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Ahmed Khalil, Douglas McCloskey $
+// $Authors: Ahmed Khalil $
+// --------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <SmartPeak/test_config.h>
+#include "services.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace
+{
+  void set_env_var_(const std::string& name, const std::string& value)
+  {
+#ifdef _WIN32
+    _putenv((name + "=" + value).c_str());
+#else
+    setenv(name.c_str(), value.c_str(), 1);
+#endif
+  }
+
+  void create_users_db_(const std::filesystem::path& db_path)
+  {
+    sqlite3* users_db = nullptr;
+    ASSERT_EQ(sqlite3_open(db_path.string().c_str(), &users_db), SQLITE_OK);
+    EXPECT_EQ(sqlite3_exec(users_db,
+      "CREATE TABLE IF NOT EXISTS active_users (username TEXT, password TEXT);"
+      "DELETE FROM active_users;"
+      "INSERT INTO active_users VALUES ('test_user', 'test_password');",
+      nullptr, nullptr, nullptr), SQLITE_OK);
+    sqlite3_close(users_db);
+  }
+
+  std::vector<std::string> read_log_lines_(grpc::ClientReader<SmartPeakServer::LogStream>& reader)
+  {
+    std::vector<std::string> log_lines;
+    SmartPeakServer::LogStream log_stream;
+    while (reader.Read(&log_stream))
+    {
+      log_lines.push_back(log_stream.log_line());
+    }
+    EXPECT_TRUE(reader.Finish().ok());
+    return log_lines;
+  }
+
+  std::vector<std::string> get_log_stream_(SmartPeakServer::Workflow::Stub& stub)
+  {
+    grpc::ClientContext context;
+    auto reader = stub.getLogStream(&context, SmartPeakServer::InquireLogs());
+    return read_log_lines_(*reader);
+  }
+
+  std::vector<std::string> follow_log_stream_(SmartPeakServer::Workflow::Stub& stub)
+  {
+    grpc::ClientContext context;
+    auto reader = stub.followLogStream(&context, SmartPeakServer::InquireLogs());
+    return read_log_lines_(*reader);
+  }
+
+  size_t count_lines_(const std::vector<std::string>& log_lines, const std::string& text)
+  {
+    return std::count_if(log_lines.begin(), log_lines.end(),
+      [&text](const std::string& log_line) { return log_line.find(text) != std::string::npos; });
+  }
+}
+
+TEST(WorkflowService, runWorkflow_missingDataset)
+{
+  // the server and its clients in the same process
+  const auto users_db_path = std::filesystem::temp_directory_path() / "smartpeak_workflow_service_test_users.db";
+  create_users_db_(users_db_path);
+  set_env_var_("SMARTPEAK_USERS_DB", users_db_path.string());
+
+  WorkflowService workflow_service;
+  grpc::ServerBuilder builder;
+  builder.RegisterService(&workflow_service);
+  std::unique_ptr<grpc::Server> server(builder.BuildAndStart());
+  ASSERT_TRUE(server);
+  auto stub = SmartPeakServer::Workflow::NewStub(server->InProcessChannel(grpc::ChannelArguments()));
+
+  // a workflow on a missing data set is aborted after logging the error
+  const std::string dataset_path = (std::filesystem::temp_directory_path() / "smartpeak_workflow_service_test_missing").string();
+  const std::string missing_dataset_log = "No data set found at the given path : " + dataset_path;
+  {
+    SmartPeakServer::WorkflowParameters workflow_parameters;
+    workflow_parameters.set_dataset_path(dataset_path);
+    SmartPeakServer::WorkflowResult workflow_result;
+    grpc::ClientContext context;
+    context.AddMetadata("id", "test_user");
+    context.AddMetadata("password", "test_password");
+    const grpc::Status status = stub->runWorkflow(&context, workflow_parameters, &workflow_result);
+    EXPECT_EQ(status.error_code(), grpc::StatusCode::ABORTED);
+  }
+
+  // the one-shot read of the GUI gets the logs once
+  EXPECT_EQ(count_lines_(get_log_stream_(*stub), missing_dataset_log), 1);
+  EXPECT_EQ(count_lines_(get_log_stream_(*stub), missing_dataset_log), 0);
+
+  // each followed stream gets all the logs kept, whatever the other clients have read,
+  // and ends as no workflow is running
+  auto first_follower = std::async(std::launch::async, follow_log_stream_, std::ref(*stub));
+  auto second_follower = std::async(std::launch::async, follow_log_stream_, std::ref(*stub));
+  EXPECT_EQ(count_lines_(first_follower.get(), missing_dataset_log), 1);
+  EXPECT_EQ(count_lines_(second_follower.get(), missing_dataset_log), 1);
+  EXPECT_EQ(count_lines_(follow_log_stream_(*stub), missing_dataset_log), 1);
+
+  // the progress stream starts with the current status
+  {
+    grpc::ClientContext context;
+    auto reader = stub->followProgressInfo(&context, SmartPeakServer::WorkflowParameters());
+    std::vector<std::string> status_codes;
+    SmartPeakServer::ProgressInfo progress_info;
+    while (reader->Read(&progress_info))
+    {
+      status_codes.push_back(progress_info.status_code());
+    }
+    EXPECT_TRUE(reader->Finish().ok());
+    EXPECT_THAT(status_codes, ::testing::ElementsAre("NO"));
+  }
+
+  // the aborted workflow did not run any processor
+  {
+    grpc::ClientContext context;
+    auto reader = stub->followWorkflowEvents(&context, SmartPeakServer::WorkflowParameters());
+    SmartPeakServer::WorkflowEvent workflow_event;
+    size_t nb_events = 0;
+    while (reader->Read(&workflow_event))
+    {
+      ++nb_events;
+    }
+    EXPECT_TRUE(reader->Finish().ok());
+    EXPECT_EQ(nb_events, 0);
+  }
+
+  // the unary progress is unchanged
+  {
+    SmartPeakServer::ProgressInfo progress_info;
+    grpc::ClientContext context;
+    const grpc::Status status = stub->getProgressInfo(&context, SmartPeakServer::WorkflowParameters(), &progress_info);
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(progress_info.status_code(), "NO");
+  }
+
+  server->Shutdown();
+  std::filesystem::remove(users_db_path);
+}
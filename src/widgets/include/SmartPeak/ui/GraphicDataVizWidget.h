@@ -109,6 +109,8 @@ namespace SmartPeak
     bool update_plot_range_ = true;
     ImPlotLimits plot_limits_;
     bool restore_plot_limits_ = false;
+    size_t max_drawn_points_ = 200000; // points drawn per frame, shared by all the series
+    size_t min_drawn_points_per_series_ = 256;
   };
 
 }
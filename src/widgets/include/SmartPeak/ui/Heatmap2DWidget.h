@@ -73,6 +73,8 @@ namespace SmartPeak
     SessionHandler::HeatMapData heatmap_data_;
     std::string plot_title_; // used as the ID of the plot as well so this should be unique across the different Widgets
     std::string selected_feature_;
+    std::vector<std::string> feature_names_;
+    uint64_t feature_names_generation_ = 0; // generation of the feature explorer the feature names are made of
     bool invalid_data_;
     bool data_mismatch_;
     bool refresh_needed_ = false;
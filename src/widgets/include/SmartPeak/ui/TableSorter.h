@@ -0,0 +1,69 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#pragma once
+#include <string>
+#include <vector>
+
+namespace SmartPeak
+{
+  /**
+    @brief Sorting of the rows of a table, independent of the rendering.
+
+    Columns whose values are all numbers (or empty) are sorted numerically,
+    the other ones with the natural sort of ImEntry. Sorting only reads its
+    input, so that it can run out of the GUI thread.
+  */
+  struct TableSorter
+  {
+    /** @brief values of a column to sort by */
+    struct SortColumn
+    {
+      std::vector<std::string> texts; ///< values of the column, parsed as numbers when possible
+      std::vector<double> numbers; ///< numeric values of the column if known, NaN for missing values
+      bool ascending = true;
+    };
+
+    /*
+    @brief Parses the values of a column as numbers
+
+    @param[in] texts values of the column
+    @param[out] numbers the numbers, NaN for empty values
+    @param[out] returns true if all non empty values are numbers
+    */
+    static bool parseNumbers(const std::vector<std::string>& texts, std::vector<double>& numbers);
+
+    /*
+    @brief Computes the sorted order of the rows
+
+    Rows are sorted by the first column, ties by the next columns and then keep their order.
+    Missing numeric values come last.
+
+    @param[in] columns values of the columns to sort by, in priority order
+    @param[in] n_rows number of rows
+    @param[out] returns the indices of the rows, in sorted order
+    */
+    static std::vector<size_t> sortRows(std::vector<SortColumn> columns, size_t n_rows);
+  };
+}
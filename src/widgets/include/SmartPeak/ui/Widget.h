@@ -28,15 +28,19 @@
 #include <SmartPeak/core/SessionHandler.h>
 #include <SmartPeak/ui/ImEntry.h>
 #include <SmartPeak/ui/Help.h>
+#include <SmartPeak/ui/TableSorter.h>
 #include <unsupported/Eigen/CXX11/Tensor>
 #include <SmartPeak/iface/ISequenceSegmentObserver.h>
 #include <SmartPeak/iface/IFeaturesObserver.h>
 #include <SmartPeak/iface/IPropertiesHandler.h>
 
 #include <string>
+#include <tuple>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <functional>
+#include <future>
 
 /**
 Generic and base classes for Widgets
@@ -158,6 +162,19 @@ namespace SmartPeak
     */
     void sorter(std::vector<ImEntry>& Im_table_entries, ImGuiTableSortSpecs* sorts_specs, const bool& is_scanned);
 
+    /*
+    @brief Set the data to display, only if its generation differs from the one of the displayed data
+
+    @param[in] table_data the new table data
+    */
+    void setTableData(const SessionHandler::GenericTableData& table_data);
+    void setTableData(SessionHandler::GenericTableData&& table_data);
+
+    /*
+    @brief Returns the generation of the displayed data
+    */
+    uint64_t getTableGeneration() const { return table_data_.generation_; };
+
     SessionHandler::GenericTableData table_data_;
     Eigen::Tensor<bool, 1> checked_rows_;
 
@@ -183,6 +200,32 @@ namespace SmartPeak
 
   private:
     void selectCell(size_t row, size_t col);
+    void addSelectedCell(size_t row, size_t col);
+    void clearSelectedCells();
+    bool isSelectedCell(size_t row, size_t col) const;
+
+    /*
+    @brief Recompute the rows passing the checked rows and the search filter, when one of them changed
+    */
+    void updateFilteredRows(const ImGuiTextFilter& filter);
+
+    /*
+    @brief The text of a cell, formatted from the typed body when the table has one
+    */
+    std::string getCellText(const ImEntry& entry, size_t col) const;
+
+    /*
+    @brief Start sorting the rows in the background, or apply the sorted order once ready
+    */
+    void updateSortedRows(ImGuiTableSortSpecs* sorts_specs);
+
+    struct CellHash
+    {
+      size_t operator()(const std::tuple<size_t, size_t>& cell) const
+      {
+        return std::hash<size_t>()(std::get<0>(cell)) ^ (std::hash<size_t>()(std::get<1>(cell)) << 1);
+      }
+    };
 
   protected:
     const std::string table_id_;
@@ -196,14 +239,22 @@ namespace SmartPeak
     bool plot_unplot_all_deactivated_ = false;
     int selected_col_ = 0;
     int plot_idx_ = -1;
-    const int max_rows_ = 100;
-    size_t print_until_ = 0;
     unsigned int table_entries_plot_col_ = 0;
     unsigned int checkbox_columns_plot_col_ = 0;
     std::string plot_switch_ = "";
     std::vector<const char*> cols_;
     bool data_changed_ = false;
-    std::vector<std::tuple<size_t, size_t>> selected_cells_;
+    uint64_t drawn_generation_ = 0;
+    std::vector<std::tuple<size_t, size_t>> selected_cells_; ///< selected (row, col) cells, in selection order
+    std::unordered_set<std::tuple<size_t, size_t>, CellHash> selected_cells_set_; ///< selected_cells_, for lookups
+    std::vector<size_t> filtered_rows_; ///< positions in table_entries_ of the rows to display
+    bool filtered_rows_dirty_ = true;
+    std::string filtered_text_; ///< search filter the filtered rows were made with
+    int filtered_col_ = 0; ///< search column the filtered rows were made with
+    Eigen::Tensor<bool, 1> filtered_checked_rows_; ///< checked rows the filtered rows were made with
+    std::future<std::vector<size_t>> sorted_rows_; ///< order of table_entries_ being computed
+    size_t scan_count_ = 0; ///< incremented when table_entries_ are scanned again
+    size_t sorted_scan_count_ = 0; ///< scan of table_entries_ being sorted
   };
 
   struct FeaturesTableWidget : public GenericTableWidget, public IFeaturesObserver
@@ -35,6 +35,7 @@ set(sources_list_h
 	SpectraPlotWidget.h
 	SplitWindow.h
 	StatisticsWidget.h
+	TableSorter.h
 	UIUtilities.h
 	Widget.h
 	WindowSizesAndPositions.h
@@ -33,6 +33,10 @@ namespace SmartPeak
     if ((refresh_needed_) || // data changed
        ((input_component_names_ != component_names) || (input_sample_names_ != sample_names))) // user select different items
     {
+      if (refresh_needed_)
+      {
+        graph_viz_data_.invalidateSeries();
+      }
       // we may recompute the RT window, get the whole graph area
       session_handler_.getChromatogramScatterPlot(sequence_handler_, graph_viz_data_, std::make_pair(0, 1800), sample_names, component_names);
       updateRanges();
@@ -40,6 +40,10 @@ namespace SmartPeak
     if ((refresh_needed_) || // data changed
        (input_sample_names_ != sample_names)) // user select different items
     {
+      if (refresh_needed_)
+      {
+        graph_viz_data_.invalidateSeries();
+      }
       // get the whole graph area
       session_handler_.getChromatogramTIC(sequence_handler_, graph_viz_data_, std::make_pair(0, 1800), sample_names);
       updateRanges();
@@ -42,6 +42,10 @@ namespace SmartPeak
     if ((refresh_needed_) || // data changed
        ((input_component_names_ != transitions_names) || (input_sample_names_ != sample_names))) // user select different items
     {
+      if (refresh_needed_ || input_mz_ != current_mz_)
+      {
+        graph_viz_data_.invalidateSeries();
+      }
       // we may recompute the RT window, get the whole graph area
       session_handler_.getChromatogramXIC(sequence_handler_, graph_viz_data_, std::make_pair(0, 1800), sample_names, transitions_names, current_mz_);
       updateRanges();
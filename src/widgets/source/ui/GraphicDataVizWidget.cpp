@@ -26,6 +26,8 @@
 #include <imgui.h>
 #include <imgui_internal.h>
 
+#include <algorithm>
+
 namespace SmartPeak
 {
 
@@ -94,16 +96,16 @@ namespace SmartPeak
   void GraphicDataVizWidget::drawGraph()
   {
     // Main graphic
-    if (graph_viz_data_.points_overflow_)
-    {
-      ImGui::Text("Unable to draw: too much points. Please reduce scope or unselect data.");
-    }
-    else if (graph_viz_data_.x_data_area_.empty() && graph_viz_data_.y_data_area_.empty())
+    if (graph_viz_data_.x_data_area_.empty() && graph_viz_data_.y_data_area_.empty())
     {
       ImGui::Text("No data to display select data to render or adjust ranges.");
     }
     else
     {
+      if (graph_viz_data_.points_overflow_)
+      {
+        ImGui::Text("Too much points: some of the data are shown at a reduced resolution. Please reduce scope or unselect data.");
+      }
       auto window_size = ImGui::GetWindowSize();
       ImGuiCond cond;
       cond = ImGuiCond_Once;
@@ -125,30 +127,32 @@ namespace SmartPeak
       ImPlotFlags plotFlags = show_legend_ ? ImPlotFlags_Default | ImPlotFlags_Legend : ImPlotFlags_Default & ~ImPlotFlags_Legend;
       plotFlags |= ImPlotFlags_Crosshairs;
       float graphic_height = window_size.y;
-      if (ImPlot::BeginPlot(plot_title_.c_str(), graph_viz_data_.x_axis_title_.c_str(), graph_viz_data_.y_axis_title_.c_str(), ImVec2(window_size.x - 25, graphic_height - 85), plotFlags)) {
+      const ImVec2 plot_size(window_size.x - 25, graphic_height - 85);
+      if (ImPlot::BeginPlot(plot_title_.c_str(), graph_viz_data_.x_axis_title_.c_str(), graph_viz_data_.y_axis_title_.c_str(), plot_size, plotFlags)) {
+        // a min-max pair per pixel is enough to render a series faithfully,
+        // and the whole frame never draws more than max_drawn_points_
+        const ImPlotLimits visible_limits = ImPlot::GetPlotLimits();
+        const size_t n_series = std::max<size_t>(graph_viz_data_.series_names_area_.size(), 1);
+        const size_t max_series_points = std::max<size_t>(
+          std::min<size_t>(2 * static_cast<size_t>(std::max(plot_size.x, 1.0f)), max_drawn_points_ / n_series),
+          min_drawn_points_per_series_);
         int i = 0;
         for (const auto& serie_name_scatter : graph_viz_data_.series_names_area_)
         {
           if (graph_viz_data_.x_data_area_.size())
           {
             assert(graph_viz_data_.x_data_area_.at(i).size() == graph_viz_data_.y_data_area_.at(i).size());
+            const auto view = graph_viz_data_.getAreaView(i, visible_limits.X.Min, visible_limits.X.Max, max_series_points);
             ImPlot::PushStyleVar(ImPlotStyleVar_Marker, ImPlotMarker_None);
             if (!is_spectra_)
             {
-              ImPlot::PlotLine(serie_name_scatter.c_str(),
-                               graph_viz_data_.x_data_area_.at(i).data(),
-                               graph_viz_data_.y_data_area_.at(i).data(),
-                               graph_viz_data_.x_data_area_.at(i).size());
+              ImPlot::PlotLine(serie_name_scatter.c_str(), view.x, view.y, static_cast<int>(view.size));
             }
             else
             {
               static const float bar_width_in_pixel = 3.0f;
               auto bar_width = ImPlot::PixelsToPlot({ bar_width_in_pixel ,0.0f }).x - ImPlot::PixelsToPlot({ 0.0f,0.0f }).x;
-              ImPlot::PlotBars(serie_name_scatter.c_str(),
-                               graph_viz_data_.x_data_area_.at(i).data(), 
-                               graph_viz_data_.y_data_area_.at(i).data(), 
-                               graph_viz_data_.x_data_area_.at(i).size(),
-                               bar_width);
+              ImPlot::PlotBars(serie_name_scatter.c_str(), view.x, view.y, static_cast<int>(view.size), bar_width);
             }
           }
           plot_limits_ = ImPlot::GetPlotLimits();
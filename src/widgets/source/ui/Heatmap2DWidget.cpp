@@ -31,13 +31,17 @@ namespace SmartPeak
   {
     showQuickHelpToolTip("Heatmap2DWidget");
 
-    Eigen::Tensor<std::string, 2> selected_feature_names = session_handler_.feature_table.body_;
-
-    std::vector<std::string> feature_names;
-    for (int i = 0; i < selected_feature_names.size(); ++i) {
-      if (std::count(feature_names.begin(), feature_names.end(), selected_feature_names(i)) == 0 && !selected_feature_names(i).empty())
-        feature_names.push_back(selected_feature_names(i));
+    if (feature_names_generation_ != session_handler_.feature_table.generation_)
+    {
+      const Eigen::Tensor<std::string, 2>& selected_feature_names = session_handler_.feature_table.body_;
+      feature_names_.clear();
+      for (int i = 0; i < selected_feature_names.size(); ++i) {
+        if (std::count(feature_names_.begin(), feature_names_.end(), selected_feature_names(i)) == 0 && !selected_feature_names(i).empty())
+          feature_names_.push_back(selected_feature_names(i));
+      }
+      feature_names_generation_ = session_handler_.feature_table.generation_;
     }
+    const std::vector<std::string>& feature_names = feature_names_;
     if (std::find(feature_names.begin(), feature_names.end(), selected_feature_) == feature_names.end())
     {
       if (feature_names.size())
@@ -45,6 +45,10 @@ namespace SmartPeak
        (input_z_ != current_z_) // user select different rt
        ) 
     {
+      if (refresh_needed_ || input_z_ != current_z_)
+      {
+        graph_viz_data_.invalidateSeries();
+      }
       // get the whole graph area
       if (graph_viz_data_.z_data_area_.size())
       {
@@ -34,6 +34,10 @@ namespace SmartPeak
     if ((refresh_needed_) || // data changed
        ((input_sample_names_ != sample_names) || (input_component_group_names_ != component_group_names))) // user select different items
     {
+      if (refresh_needed_)
+      {
+        graph_viz_data_.invalidateSeries();
+      }
       // get the whole graph area
       session_handler_.getSpectrumScatterPlot(sequence_handler_, graph_viz_data_, std::make_pair(0, 2000), sample_names, component_group_names);
       updateRanges();
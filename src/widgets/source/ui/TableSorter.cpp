@@ -0,0 +1,104 @@
+// --------------------------------------------------------------------------
+//   SmartPeak -- Fast and Accurate CE-, GC- and LC-MS(/MS) Data Processing
+// --------------------------------------------------------------------------
+// Copyright The SmartPeak Team -- Novo Nordisk Foundation
+// Center for Biosustainability, Technical University of Denmark 2018-2022.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Douglas McCloskey, Ahmed Khalil $
+// $Authors: Douglas McCloskey $
+// --------------------------------------------------------------------------
+
+
+#include <SmartPeak/ui/TableSorter.h>
+#include <SmartPeak/ui/ImEntry.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace SmartPeak
+{
+  bool TableSorter::parseNumbers(const std::vector<std::string>& texts, std::vector<double>& numbers)
+  {
+    numbers.resize(texts.size());
+    for (size_t row = 0; row < texts.size(); ++row)
+    {
+      const std::string& text = texts[row];
+      if (text.empty())
+      {
+        numbers[row] = std::numeric_limits<double>::quiet_NaN();
+        continue;
+      }
+      char* end = nullptr;
+      numbers[row] = std::strtod(text.c_str(), &end);
+      if (end != text.c_str() + text.size())
+      {
+        numbers.clear();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<size_t> TableSorter::sortRows(std::vector<SortColumn> columns, size_t n_rows)
+  {
+    for (auto& column : columns)
+    {
+      if (column.numbers.empty())
+      {
+        parseNumbers(column.texts, column.numbers);
+      }
+      const size_t column_rows = column.numbers.empty() ? column.texts.size() : column.numbers.size();
+      if (column_rows != n_rows)
+      {
+        throw std::invalid_argument("The sort columns do not match the number of rows.");
+      }
+    }
+    std::vector<size_t> rows(n_rows);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::stable_sort(rows.begin(), rows.end(), [&columns](const size_t lhs, const size_t rhs) {
+      for (const auto& column : columns)
+      {
+        if (column.numbers.size())
+        {
+          const double lhs_number = column.numbers[lhs];
+          const double rhs_number = column.numbers[rhs];
+          const bool lhs_missing = std::isnan(lhs_number);
+          const bool rhs_missing = std::isnan(rhs_number);
+          if (lhs_missing || rhs_missing)
+          {
+            if (lhs_missing != rhs_missing)
+              return rhs_missing;
+            continue;
+          }
+          if (lhs_number != rhs_number)
+            return column.ascending ? lhs_number < rhs_number : lhs_number > rhs_number;
+        }
+        else
+        {
+          const int delta = ImEntry::lexicographical_sort(column.texts[lhs].c_str(), column.texts[rhs].c_str());
+          if (delta != 0)
+            return column.ascending ? delta < 0 : delta > 0;
+        }
+      }
+      return false;
+    });
+    return rows;
+  }
+}
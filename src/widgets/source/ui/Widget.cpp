@@ -23,8 +23,12 @@
 
 #include <SmartPeak/ui/Widget.h>
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include <map>
+#include <sstream>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <imgui.h>
@@ -68,17 +72,37 @@ namespace SmartPeak
   {
     bool is_to_filter = false;
     if (selected_entry > 0) {
-      is_to_filter = !filter.PassFilter(Im_table_entries[row].entry_contents[selected_entry - 1].c_str());
+      is_to_filter = !filter.PassFilter(getCellText(Im_table_entries[row], selected_entry - 1).c_str());
     }
     else if (selected_entry == 0) 
     { //ALL
-      is_to_filter = std::all_of(Im_table_entries[row].entry_contents.begin(),
-        Im_table_entries[row].entry_contents.end(),
-        [&filter](auto entry) {return !filter.PassFilter(entry.c_str()); });
+      if (table_data_.typed_body_ && Im_table_entries[row].entry_contents.empty())
+      {
+        is_to_filter = true;
+        for (size_t col = 0; col < static_cast<size_t>(table_data_.headers_.size()) && is_to_filter; ++col)
+        {
+          is_to_filter = !filter.PassFilter(table_data_.typed_body_->getText(Im_table_entries[row].ID, col).c_str());
+        }
+      }
+      else
+      {
+        is_to_filter = std::all_of(Im_table_entries[row].entry_contents.begin(),
+          Im_table_entries[row].entry_contents.end(),
+          [&filter](auto entry) {return !filter.PassFilter(entry.c_str()); });
+      }
     }
     return is_to_filter;
   }
 
+  std::string GenericTableWidget::getCellText(const ImEntry& entry, size_t col) const
+  {
+    if (table_data_.typed_body_ && entry.entry_contents.empty())
+    {
+      return table_data_.typed_body_->getText(entry.ID, col);
+    }
+    return entry.entry_contents[col];
+  }
+
   void GenericTableWidget::updateTableContents(std::vector<ImEntry>& Im_table_entries,
     bool& is_scanned,
     const Eigen::Tensor<std::string, 2>& columns,
@@ -111,17 +135,34 @@ namespace SmartPeak
     const unsigned int col_idx = static_cast<unsigned int>(sorts_specs->Specs->ColumnIndex);
     if (sorts_specs->SpecsDirty && is_scanned &&
       !std::all_of(Im_table_entries.begin(), Im_table_entries.end(),
-        [&, col_idx, Im_table_entries]
-    (ImEntry& entry) { return !std::strcmp(entry.entry_contents[col_idx].c_str(), Im_table_entries.begin()->entry_contents[col_idx].c_str()); }))
+        [&Im_table_entries, col_idx]
+    (const ImEntry& entry) { return entry.entry_contents[col_idx] == Im_table_entries.front().entry_contents[col_idx]; }))
     {
       ImEntry::s_current_sort_specs = sorts_specs;
-      if (Im_table_entries.size() > 1)
-        qsort(&Im_table_entries[0], (size_t)Im_table_entries.size(), sizeof(Im_table_entries[0]), ImEntry::CompareWithSortSpecs);
+      // ImEntry holds strings, it cannot be moved around by qsort
+      std::stable_sort(Im_table_entries.begin(), Im_table_entries.end(),
+        [](const ImEntry& lhs, const ImEntry& rhs) { return ImEntry::CompareWithSortSpecs(&lhs, &rhs) < 0; });
       ImEntry::s_current_sort_specs = NULL;
       sorts_specs->SpecsDirty = false;
     }
   }
 
+  void GenericTableWidget::setTableData(const SessionHandler::GenericTableData& table_data)
+  {
+    if (table_data.generation_ != table_data_.generation_)
+    {
+      table_data_ = table_data;
+    }
+  }
+
+  void GenericTableWidget::setTableData(SessionHandler::GenericTableData&& table_data)
+  {
+    if (table_data.generation_ != table_data_.generation_)
+    {
+      table_data_ = std::move(table_data);
+    }
+  }
+
   void GenericTableWidget::draw()
   {
     
@@ -168,29 +209,37 @@ namespace SmartPeak
 
     ImGui::Combo("In Column(s)", &selected_col_, cols_.data(), cols_.size());
 
-    table_scanned_ = (table_data_.body_.dimension(0) == table_entries_.size() && !data_changed_);
-
-    if (table_data_.body_.dimensions().TotalSize() > 0) {
-      if (max_rows_ < table_data_.body_.dimension(0)) {
-        print_until_ = max_rows_;
-        ImGui::Text("Showing first %i samples for performance, total nr. of samples : %li", max_rows_, table_data_.body_.dimension(0));
-      } else if (max_rows_ > table_data_.body_.dimension(0)) {
-        print_until_ = table_data_.body_.dimension(0);
-      }
-      updateTableContents(table_entries_, table_scanned_,
-        table_data_.body_, Eigen::Tensor<bool, 2>());
+    // the data may have been updated in place by the session
+    if (table_data_.generation_ != drawn_generation_)
+    {
+      data_changed_ = true;
+      drawn_generation_ = table_data_.generation_;
     }
-    
+    table_scanned_ = (table_data_.getNRows() == table_entries_.size() && !data_changed_);
+    data_changed_ = false;
+
+    // the entries of a typed table only hold the row, its cells are formatted when displayed
+    const size_t n_entry_contents = table_data_.typed_body_ ? 0 : table_data_.headers_.size();
     if (table_scanned_ && table_entries_.size() > 0) {
-      if (table_data_.headers_.size() != table_entries_[0].entry_contents.size()) {
+      if (n_entry_contents != table_entries_[0].entry_contents.size()) {
         table_scanned_ = false;
       }
     }
-    data_changed_ = false;
-    
+
     if (!table_scanned_) {
-      updateTableContents(table_entries_, table_scanned_,
-        table_data_.body_, Eigen::Tensor<bool, 2>());
+      if (table_data_.typed_body_) {
+        table_entries_.assign(table_data_.getNRows(), ImEntry());
+        for (size_t row = 0; row < table_entries_.size(); ++row) {
+          table_entries_[row].ID = row;
+        }
+        table_scanned_ = true;
+      }
+      else {
+        updateTableContents(table_entries_, table_scanned_,
+          table_data_.body_, Eigen::Tensor<bool, 2>());
+      }
+      ++scan_count_;
+      filtered_rows_dirty_ = true;
     }
 
     bool edit_cell = false;
@@ -206,85 +255,86 @@ namespace SmartPeak
       ImGui::TableSetupScrollFreeze(table_data_.headers_.size(), 1);
       ImGui::TableHeadersRow();
 
-      if (table_data_.body_.size() > 0) {
-        for (size_t row = 0; row < print_until_; ++row) {
-          if (checked_rows_.size() <= 0 || (checked_rows_.size() > 0 && checked_rows_(row))) {
-
-            if (searcher(table_entries_, selected_col_, filter, row))
-            {
-              selected_cells_.erase(std::remove_if(selected_cells_.begin(), selected_cells_.end(),
-                                    [&](const auto& selected) { return std::get<0>(selected) == row; }),
-                                    selected_cells_.end());
-              continue;
-            }
-
+      if (ImGuiTableSortSpecs* sorts_specs = ImGui::TableGetSortSpecs())
+      {
+        updateSortedRows(sorts_specs);
+      }
+      updateFilteredRows(filter);
+
+      if (table_data_.getNRows() > 0 && table_scanned_ && !table_entries_.empty()) {
+        // only the visible rows are drawn
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(filtered_rows_.size()));
+        while (clipper.Step()) {
+          for (int display_row = clipper.DisplayStart; display_row < clipper.DisplayEnd; ++display_row) {
+            const ImEntry& table_entry = table_entries_[filtered_rows_[display_row]];
+            const size_t row = table_entry.ID;
             ImGui::TableNextRow();
             for (size_t col = 0; col < table_data_.headers_.size(); ++col) {
-              if (table_scanned_ == true && !table_entries_.empty())
+              ImGui::TableSetColumnIndex(col);
+              if (isSelectedCell(row, col))
+              {
+                ImGui::TableSetBgColor(ImGuiTableBgTarget_CellBg, ImColor(ImGui::GetStyle().Colors[ImGuiCol_TabActive]));
+              }
+              const std::string cell_text = getCellText(table_entry, col);
+              bool is_editable = isEditable(row, col);
+              if (is_editable)
+              {
+                ImGui::PushStyleColor(ImGuiCol_Button, IM_COL32_BLACK_TRANS);
+                ImGui::PushStyleColor(ImGuiCol_ButtonHovered, IM_COL32_BLACK_TRANS);
+                ImGui::PushStyleColor(ImGuiCol_ButtonActive, IM_COL32_BLACK_TRANS);
+                ImGui::PushID(static_cast<int>(row * table_data_.headers_.size() + col));
+                ImGui::Button(cell_text.c_str(), ImVec2(ImGui::GetColumnWidth(),0));
+                ImGui::PopID();
+                ImGui::PopStyleColor(3);
+              }
+              else
+              {
+                ImGui::TextUnformatted(cell_text.c_str());
+              }
+              if (ImGui::IsItemHovered())
               {
-                ImGui::TableSetColumnIndex(col);
-                std::tuple<size_t, size_t> selected_tuple = std::make_tuple(row, col);
-                if (std::find(selected_cells_.begin(), selected_cells_.end(), selected_tuple) != selected_cells_.end())
+                if (is_editable)
                 {
-                  ImGui::TableSetBgColor(ImGuiTableBgTarget_CellBg, ImColor(ImGui::GetStyle().Colors[ImGuiCol_TabActive]));
+                  ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
                 }
-                bool is_editable = isEditable(row, col);
+              }
+              if (ImGui::IsItemClicked())
+              {
                 if (is_editable)
                 {
-                  ImGui::PushStyleColor(ImGuiCol_Button, IM_COL32_BLACK_TRANS);
-                  ImGui::PushStyleColor(ImGuiCol_ButtonHovered, IM_COL32_BLACK_TRANS);
-                  ImGui::PushStyleColor(ImGuiCol_ButtonActive, IM_COL32_BLACK_TRANS);
-                  ImGui::Button(table_entries_[row].entry_contents[col].c_str(), ImVec2(ImGui::GetColumnWidth(),0));
-                  ImGui::PopStyleColor(3);
+                  selectCell(row, col);
                 }
                 else
                 {
-                  ImGui::Text("%s", table_entries_[row].entry_contents[col].c_str());
-                }
-                if (ImGui::IsItemHovered())
-                {
-                  if (is_editable)
-                  {
-                    ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
-                  }
+                  clearSelectedCells();
                 }
-                if (ImGui::IsItemClicked())
+              }
+              // context menu
+              if (is_editable)
+              {
+                std::ostringstream os_id;
+                os_id << "cell_" << row << "_" << col;
+                if (ImGui::BeginPopupContextItem(os_id.str().c_str()))
                 {
-                  if (is_editable)
+                  if (ImGui::MenuItem("Edit", nullptr, nullptr, !selected_cells_.empty()))
                   {
-                    selectCell(row, col);
+                    edit_cell = true;
                   }
-                  else
+                  ImGui::Separator();
+                  if (ImGui::MenuItem("Select All"))
                   {
-                    selected_cells_.clear();
-                  }
-                }
-                // context menu
-                if (is_editable)
-                {
-                  std::ostringstream os_id;
-                  os_id << "cell_" << row << "_" << col;
-                  if (ImGui::BeginPopupContextItem(os_id.str().c_str()))
-                  {
-                    if (ImGui::MenuItem("Edit", nullptr, nullptr, !selected_cells_.empty()))
-                    {
-                      edit_cell = true;
-                    }
-                    ImGui::Separator();
-                    if (ImGui::MenuItem("Select All"))
-                    {
-                      selected_cells_.clear();
-                      for (auto i = 0; i < table_data_.body_.dimension(0); ++i)
-                      {
-                        selected_cells_.push_back(std::make_tuple(i, col));
-                      }
-                    }
-                    if (ImGui::MenuItem("Unselect All"))
+                    clearSelectedCells();
+                    for (const auto position : filtered_rows_)
                     {
-                      selected_cells_.clear();
+                      addSelectedCell(table_entries_[position].ID, col);
                     }
-                    ImGui::EndPopup();
                   }
+                  if (ImGui::MenuItem("Unselect All"))
+                  {
+                    clearSelectedCells();
+                  }
+                  ImGui::EndPopup();
                 }
               }
             }
@@ -292,11 +342,6 @@ namespace SmartPeak
         }
       }
 
-      if (ImGuiTableSortSpecs* sorts_specs = ImGui::TableGetSortSpecs())
-      {
-        sorter(table_entries_, sorts_specs, table_scanned_);
-      }
-
       // we need to call onEdit outside the drawing of the table
       if (edit_cell)
       {
@@ -308,35 +353,139 @@ namespace SmartPeak
     }
   }
 
+  void GenericTableWidget::updateFilteredRows(const ImGuiTextFilter& filter)
+  {
+    const bool checked_rows_changed = checked_rows_.size() != filtered_checked_rows_.size() ||
+      !std::equal(checked_rows_.data(), checked_rows_.data() + checked_rows_.size(), filtered_checked_rows_.data());
+    if (!filtered_rows_dirty_ && !checked_rows_changed &&
+        filtered_text_ == filter.InputBuf && filtered_col_ == selected_col_)
+    {
+      return;
+    }
+    filtered_rows_.clear();
+    filtered_rows_.reserve(table_entries_.size());
+    for (size_t position = 0; position < table_entries_.size(); ++position) {
+      const size_t row = table_entries_[position].ID;
+      if (checked_rows_.size() > 0 && (row >= static_cast<size_t>(checked_rows_.size()) || !checked_rows_(row)))
+        continue;
+      if (searcher(table_entries_, selected_col_, filter, position))
+        continue;
+      filtered_rows_.push_back(position);
+    }
+    // the hidden rows are unselected
+    if (!selected_cells_.empty()) {
+      std::unordered_set<size_t> displayed_rows;
+      for (const auto position : filtered_rows_) displayed_rows.insert(table_entries_[position].ID);
+      selected_cells_.erase(std::remove_if(selected_cells_.begin(), selected_cells_.end(),
+                            [&](const auto& selected) { return displayed_rows.count(std::get<0>(selected)) == 0; }),
+                            selected_cells_.end());
+      selected_cells_set_ = { selected_cells_.begin(), selected_cells_.end() };
+    }
+    filtered_checked_rows_ = checked_rows_;
+    filtered_text_ = filter.InputBuf;
+    filtered_col_ = selected_col_;
+    filtered_rows_dirty_ = false;
+  }
+
+  void GenericTableWidget::updateSortedRows(ImGuiTableSortSpecs* sorts_specs)
+  {
+    if (sorted_rows_.valid())
+    {
+      if (sorted_rows_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+      {
+        return; // the sort specs are left dirty, to sort again with the latest ones
+      }
+      std::vector<size_t> sorted_rows = sorted_rows_.get();
+      // the entries may have been scanned again in the meantime
+      if (sorted_scan_count_ == scan_count_ && sorted_rows.size() == table_entries_.size())
+      {
+        std::vector<ImEntry> sorted_entries;
+        sorted_entries.reserve(table_entries_.size());
+        for (const auto position : sorted_rows)
+        {
+          sorted_entries.push_back(std::move(table_entries_[position]));
+        }
+        table_entries_ = std::move(sorted_entries);
+        filtered_rows_dirty_ = true;
+      }
+    }
+    // the entries lose their order when they are scanned again
+    const bool rescanned = (sorted_scan_count_ != scan_count_);
+    if ((!sorts_specs->SpecsDirty && !rescanned) || !table_scanned_)
+    {
+      return;
+    }
+    if (sorts_specs->SpecsCount == 0 || table_entries_.size() < 2)
+    {
+      sorted_scan_count_ = scan_count_;
+      sorts_specs->SpecsDirty = false;
+      return;
+    }
+    // the values to sort by are copied, and numbers taken from the typed table when available
+    std::vector<TableSorter::SortColumn> sort_columns;
+    for (int n = 0; n < sorts_specs->SpecsCount; ++n)
+    {
+      const ImGuiTableColumnSortSpecs& sort_spec = sorts_specs->Specs[n];
+      const size_t col = sort_spec.ColumnIndex;
+      if (col >= static_cast<size_t>(table_data_.headers_.size()))
+      {
+        continue;
+      }
+      TableSorter::SortColumn sort_column;
+      sort_column.ascending = (sort_spec.SortDirection != ImGuiSortDirection_Descending);
+      const auto& typed_body = table_data_.typed_body_;
+      if (typed_body && col < typed_body->getNColumns() && typed_body->getColumnType(col) != FeatureTable::ColumnType::Text)
+      {
+        sort_column.numbers.reserve(table_entries_.size());
+        for (const auto& entry : table_entries_)
+        {
+          sort_column.numbers.push_back(typed_body->getNumber(entry.ID, col));
+        }
+      }
+      else
+      {
+        sort_column.texts.reserve(table_entries_.size());
+        for (const auto& entry : table_entries_)
+        {
+          sort_column.texts.push_back(getCellText(entry, col));
+        }
+      }
+      sort_columns.push_back(std::move(sort_column));
+    }
+    sorted_scan_count_ = scan_count_;
+    sorted_rows_ = std::async(std::launch::async, &TableSorter::sortRows, std::move(sort_columns), table_entries_.size());
+    sorts_specs->SpecsDirty = false;
+  }
+
   void GenericTableWidget::selectCell(size_t row, size_t col)
   {
     ImGuiIO& io = ImGui::GetIO();
     if ((selected_cells_.size() > 0) && (std::get<1>(selected_cells_[0]) != col))
     {
       // we have selected another column
-      selected_cells_.clear();
+      clearSelectedCells();
     }
     
     if (io.KeyShift)
     {
-      size_t starting_row = 0;
       if (selected_cells_.size() > 0)
       {
-        starting_row = std::get<0>(selected_cells_.back());
-        if (starting_row < row)
+        // select the displayed rows between the last selected row and this one, in display order
+        const size_t starting_row = std::get<0>(selected_cells_.back());
+        const auto find_position = [this](size_t row_id)
         {
-          // Shift-select top to bottom
-          for (auto i = starting_row + 1; i < row; ++i)
-          {
-            selected_cells_.push_back(std::make_tuple(i, col));
-          }
-        }
-        else
+          return std::find_if(filtered_rows_.begin(), filtered_rows_.end(),
+            [this, row_id](size_t position) { return table_entries_[position].ID == row_id; });
+        };
+        const auto starting_position = find_position(starting_row);
+        const auto position = find_position(row);
+        if (starting_position != filtered_rows_.end() && position != filtered_rows_.end())
         {
-          // Shift-select bottom to top
-          for (auto i = starting_row - 1; i > row; --i)
+          const auto first = std::min(starting_position, position);
+          const auto last = std::max(starting_position, position);
+          for (auto it = first + 1; it < last; ++it)
           {
-            selected_cells_.push_back(std::make_tuple(i, col));
+            addSelectedCell(table_entries_[*it].ID, col);
           }
         }
       }
@@ -344,9 +493,29 @@ namespace SmartPeak
     else if (!io.KeyCtrl)
     {
       // simple click, unselect all
-      selected_cells_.clear();
+      clearSelectedCells();
     }
-    selected_cells_.push_back(std::make_tuple(row, col));
+    addSelectedCell(row, col);
+  }
+
+  void GenericTableWidget::addSelectedCell(size_t row, size_t col)
+  {
+    const auto cell = std::make_tuple(row, col);
+    if (selected_cells_set_.insert(cell).second)
+    {
+      selected_cells_.push_back(cell);
+    }
+  }
+
+  void GenericTableWidget::clearSelectedCells()
+  {
+    selected_cells_.clear();
+    selected_cells_set_.clear();
+  }
+
+  bool GenericTableWidget::isSelectedCell(size_t row, size_t col) const
+  {
+    return selected_cells_set_.count(std::make_tuple(row, col)) > 0;
   }
 
   void GenericGraphicWidget::draw()
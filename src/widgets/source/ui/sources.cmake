@@ -34,6 +34,7 @@ set(sources_list
 	SpectraPlotWidget.cpp
 	SplitWindow.cpp
 	StatisticsWidget.cpp
+	TableSorter.cpp
 	UIUtilities.cpp
 	Widget.cpp
 	WindowSizesAndPositions.cpp